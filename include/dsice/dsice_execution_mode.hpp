@@ -26,7 +26,19 @@ namespace dsice {
 		/// <summary>
 		/// 反復放射型 d-Spline 探索法による並列探索
 		/// </summary>
-		P_2024B
+		P_2024B,
+		/// <summary>
+		/// 反復放射型 d-Spline 探索法によるループ単位の同期を行わない並列探索
+		/// </summary>
+		P_ASYNC,
+		/// <summary>
+		/// 初期探索の上位点を開始点とする複数の反復放射型 d-Spline 探索を同時に行う並列探索
+		/// </summary>
+		P_MULTI_START,
+		/// <summary>
+		/// 探索空間の全点を並列実測数ずつ実測する並列全探索 (小さな探索空間向け)
+		/// </summary>
+		P_FULL
 	};
 }
 
@@ -0,0 +1,18 @@
+﻿#ifndef DSICE_INITIAL_DESIGN_TYPE_HPP_
+#define DSICE_INITIAL_DESIGN_TYPE_HPP_
+
+namespace dsice {
+
+	/// <summary>
+	/// 初期探索で実測する点の配置方法を指定する列挙型
+	/// </summary>
+	enum class InitialDesignType {
+		SimpleLhd,
+		MaximinLhd,
+		Sobol,
+		Halton,
+		Stratified
+	};
+}
+
+#endif // !DSICE_INITIAL_DESIGN_TYPE_HPP_
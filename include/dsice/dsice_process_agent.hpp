@@ -28,6 +28,10 @@ namespace dsice {
 		/// 取得したパラメタ
 		/// </summary>
 		std::vector<T> parameter;
+		/// <summary>
+		/// 取得した忠実度 (渡されなかった場合は 0)
+		/// </summary>
+		double fidelity = 0;
 	public:
 		/// <summary>
 		/// DSICE が生成する一時ファイルから性能パラメタ設定値を取得するコンストラクタ
@@ -51,6 +55,11 @@ namespace dsice {
 		/// <returns>パラメタ設定値</returns>
 		const std::vector<T> getParameter(void) const;
 		/// <summary>
+		/// 実測すべき忠実度 (問題サイズの比率など) を取得
+		/// </summary>
+		/// <returns>忠実度 (多忠実度チューニングを使用しない場合は 0)</returns>
+		double getFidelity(void) const;
+		/// <summary>
 		/// DSICE に渡すために一時ファイルへ性能値を記録
 		/// </summary>
 		/// <param name="performance_value">性能値</param>
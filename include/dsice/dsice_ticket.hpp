@@ -0,0 +1,64 @@
+﻿#ifndef DSICE_TICKET_HPP_
+#define DSICE_TICKET_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace dsice {
+
+	/// <summary>
+	/// 非同期実測用に発行される実測券．<br/>
+	/// 実測すべき性能パラメタ設定値と，結果を登録する際に用いる識別子の組
+	/// </summary>
+	/// <typeparam name="T">性能パラメタの値型</typeparam>
+	template <typename T = double>
+	class Ticket final {
+	private:
+		/// <summary>
+		/// 実測券の識別子
+		/// </summary>
+		std::size_t ticket_id;
+		/// <summary>
+		/// 実測すべき性能パラメタ設定値
+		/// </summary>
+		std::vector<T> parameter;
+		/// <summary>
+		/// 実測すべき忠実度 (多忠実度探索を設定していなければ 0)
+		/// </summary>
+		double fidelity = 0;
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="ticket_id">実測券の識別子</param>
+		/// <param name="parameter">実測すべき性能パラメタ設定値</param>
+		/// <param name="fidelity">実測すべき忠実度 (多忠実度探索を設定していなければ 0)</param>
+		Ticket(std::size_t ticket_id, const std::vector<T>& parameter, double fidelity = 0);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		Ticket(const Ticket& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~Ticket(void);
+		/// <summary>
+		/// 実測券の識別子を取得
+		/// </summary>
+		/// <returns>実測券の識別子</returns>
+		std::size_t getId(void) const;
+		/// <summary>
+		/// 実測すべき性能パラメタ設定値を取得
+		/// </summary>
+		/// <returns>実測すべき性能パラメタ設定値</returns>
+		const std::vector<T>& getParameter(void) const;
+		/// <summary>
+		/// 実測すべき忠実度 (問題サイズや反復回数など) を取得
+		/// </summary>
+		/// <returns>実測すべき忠実度 (多忠実度探索を設定していなければ 0)</returns>
+		double getFidelity(void) const;
+	};
+}
+
+#endif // !DSICE_TICKET_HPP_
@@ -8,11 +8,25 @@ class DSICE_EXECUTION_MODE(Enum):
     S_IPPE = 1,
     S_2017 = 2,
     S_2018 = 3,
-    P_2024 = 4
+    P_2024 = 4,
+    P_ASYNC = 5,
+    P_MULTI_START = 6,
+    P_FULL = 7
 
 class DSICE_DATABASE_METRIC_TYPE(Enum):
     Overwritten = 0,
-    Average = 1
+    Average = 1,
+    Median = 2,
+    TrimmedAverage = 3,
+    Minimum = 4,
+    Ewma = 5
+
+class DSICE_INITIAL_DESIGN_TYPE(Enum):
+    SimpleLhd = 0,
+    MaximinLhd = 1,
+    Sobol = 2,
+    Halton = 3,
+    Stratified = 4
 
 class Tuner:
     def __init__(self):
@@ -51,14 +65,60 @@ class Tuner:
         self.call_lib.DSICE_CONFIG_SET_DSPLINE_ALPHA.restype = None
         self.call_lib.DSICE_CONFIG_SET_DATABASE_METRIC_TYPE.argtypes = [ctypes.c_size_t, ctypes.c_int]
         self.call_lib.DSICE_CONFIG_SET_DATABASE_METRIC_TYPE.restype = None
+        self.call_lib.DSICE_CONFIG_SET_ADAPTIVE_REMEASUREMENT.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.c_double]
+        self.call_lib.DSICE_CONFIG_SET_ADAPTIVE_REMEASUREMENT.restype = None
+        self.call_lib.DSICE_CONFIG_SET_SIGNIFICANCE_TEST.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.c_double]
+        self.call_lib.DSICE_CONFIG_SET_SIGNIFICANCE_TEST.restype = None
+        self.call_lib.DSICE_CONFIG_SET_LOG_MEMORY_LIMIT.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.c_char_p]
+        self.call_lib.DSICE_CONFIG_SET_LOG_MEMORY_LIMIT.restype = None
+        self.call_lib.DSICE_CONFIG_SET_PRECOMPUTATION.argtypes = [ctypes.c_size_t, ctypes.c_bool]
+        self.call_lib.DSICE_CONFIG_SET_PRECOMPUTATION.restype = None
+        self.call_lib.DSICE_CONFIG_SET_DEADLINE_FACTOR.argtypes = [ctypes.c_size_t, ctypes.c_double]
+        self.call_lib.DSICE_CONFIG_SET_DEADLINE_FACTOR.restype = None
+        self.call_lib.DSICE_CONFIG_SET_MULTI_START_NUM.argtypes = [ctypes.c_size_t, ctypes.c_size_t]
+        self.call_lib.DSICE_CONFIG_SET_MULTI_START_NUM.restype = None
+        self.call_lib.DSICE_CONFIG_SET_WORKER_NUM.argtypes = [ctypes.c_size_t, ctypes.c_size_t]
+        self.call_lib.DSICE_CONFIG_SET_WORKER_NUM.restype = None
+        self.call_lib.DSICE_CONFIG_SET_FULL_SEARCH_FACTOR.argtypes = [ctypes.c_size_t, ctypes.c_size_t]
+        self.call_lib.DSICE_CONFIG_SET_FULL_SEARCH_FACTOR.restype = None
+        self.call_lib.DSICE_CONFIG_SET_FULL_SEARCH_PRUNING.argtypes = [ctypes.c_size_t, ctypes.c_double]
+        self.call_lib.DSICE_CONFIG_SET_FULL_SEARCH_PRUNING.restype = None
+        self.call_lib.DSICE_CONFIG_SET_THREAD_POOL_SIZE.argtypes = [ctypes.c_size_t, ctypes.c_size_t]
+        self.call_lib.DSICE_CONFIG_SET_THREAD_POOL_SIZE.restype = None
+        self.call_lib.DSICE_CONFIG_SET_DIRECTION_SAMPLING.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.c_size_t]
+        self.call_lib.DSICE_CONFIG_SET_DIRECTION_SAMPLING.restype = None
+        self.call_lib.DSICE_CONFIG_SET_PARAMETER_SCREENING.argtypes = [ctypes.c_size_t, ctypes.c_double]
+        self.call_lib.DSICE_CONFIG_SET_PARAMETER_SCREENING.restype = None
+        self.call_lib.DSICE_CONFIG_SET_GRADIENT_STEP.argtypes = [ctypes.c_size_t, ctypes.c_bool]
+        self.call_lib.DSICE_CONFIG_SET_GRADIENT_STEP.restype = None
+        self.call_lib.DSICE_CONFIG_SET_SURROGATE.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.c_double]
+        self.call_lib.DSICE_CONFIG_SET_SURROGATE.restype = None
+        self.call_lib.DSICE_CONFIG_SET_INITIAL_DESIGN.argtypes = [ctypes.c_size_t, ctypes.c_int, ctypes.c_size_t, ctypes.c_ulonglong]
+        self.call_lib.DSICE_CONFIG_SET_INITIAL_DESIGN.restype = None
+        self.call_lib.DSICE_CONFIG_SET_MULTI_FIDELITY.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.POINTER(ctypes.c_double), ctypes.c_size_t, ctypes.c_size_t]
+        self.call_lib.DSICE_CONFIG_SET_MULTI_FIDELITY.restype = None
+        self.call_lib.DSICE_CONFIG_SET_COST_AWARE_ORDERING.argtypes = [ctypes.c_size_t, ctypes.c_size_t]
+        self.call_lib.DSICE_CONFIG_SET_COST_AWARE_ORDERING.restype = None
+        self.call_lib.DSICE_CONFIG_SET_BUDGET.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.c_double]
+        self.call_lib.DSICE_CONFIG_SET_BUDGET.restype = None
         self.call_lib.DSICE_BEGIN.argtypes = [ctypes.c_size_t]
         self.call_lib.DSICE_BEGIN.restype = ctypes.POINTER(ctypes.c_double)
         self.call_lib.DSICE_BEGIN_PARALLEL.argtypes = [ctypes.c_size_t]
         self.call_lib.DSICE_BEGIN_PARALLEL.restype = ctypes.POINTER(ctypes.POINTER(ctypes.c_double))
+        self.call_lib.DSICE_BEGIN_PARALLEL_K.argtypes = [ctypes.c_size_t, ctypes.c_size_t]
+        self.call_lib.DSICE_BEGIN_PARALLEL_K.restype = ctypes.POINTER(ctypes.POINTER(ctypes.c_double))
         self.call_lib.DSICE_GET_SUGGESTED_NUM.argtypes = [ctypes.c_size_t]
         self.call_lib.DSICE_GET_SUGGESTED_NUM.restype = ctypes.c_size_t
         self.call_lib.DSICE_END.argtypes = [ctypes.c_size_t, ctypes.c_double]
         self.call_lib.DSICE_END.restype = None
+        self.call_lib.DSICE_GET_DEADLINE.argtypes = [ctypes.c_size_t]
+        self.call_lib.DSICE_GET_DEADLINE.restype = ctypes.c_double
+        self.call_lib.DSICE_GET_SUGGESTED_FIDELITY.argtypes = [ctypes.c_size_t]
+        self.call_lib.DSICE_GET_SUGGESTED_FIDELITY.restype = ctypes.c_double
+        self.call_lib.DSICE_REPORT_PARTIAL.argtypes = [ctypes.c_size_t, ctypes.c_double]
+        self.call_lib.DSICE_REPORT_PARTIAL.restype = ctypes.c_bool
+        self.call_lib.DSICE_END_CENSORED.argtypes = [ctypes.c_size_t, ctypes.c_double]
+        self.call_lib.DSICE_END_CENSORED.restype = None
         self.call_lib.DSICE_GET_PARAM_NUM.argtypes = [ctypes.c_size_t]
         self.call_lib.DSICE_GET_PARAM_NUM.restype = ctypes.c_size_t
         self.call_lib.DSICE_GET_PARAM_LENGTH.argtypes = [ctypes.c_size_t, ctypes.c_size_t]
@@ -67,12 +127,38 @@ class Tuner:
         self.call_lib.DSICE_GET_TARGET_PARAMETERS.restype = ctypes.POINTER(ctypes.POINTER(ctypes.c_double))
         self.call_lib.DSICE_GET_TENTATIVE_BEST_PARAMETER.argtypes = [ctypes.c_size_t]
         self.call_lib.DSICE_GET_TENTATIVE_BEST_PARAMETER.restype = ctypes.POINTER(ctypes.c_double)
+        self.call_lib.DSICE_PREDICT.argtypes = [ctypes.c_size_t, ctypes.POINTER(ctypes.c_double)]
+        self.call_lib.DSICE_PREDICT.restype = ctypes.c_double
+        self.call_lib.DSICE_PREDICT_BATCH.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.POINTER(ctypes.c_double), ctypes.POINTER(ctypes.c_double)]
+        self.call_lib.DSICE_PREDICT_BATCH.restype = None
         self.call_lib.DSICE_IS_SEARCH_FINISHED.argtypes = [ctypes.c_size_t]
         self.call_lib.DSICE_IS_SEARCH_FINISHED.restype = ctypes.c_bool
+        self.call_lib.DSICE_GET_MEASURED_NUM.argtypes = [ctypes.c_size_t]
+        self.call_lib.DSICE_GET_MEASURED_NUM.restype = ctypes.c_size_t
+        self.call_lib.DSICE_GET_REMAINING_MEASUREMENT_NUM.argtypes = [ctypes.c_size_t]
+        self.call_lib.DSICE_GET_REMAINING_MEASUREMENT_NUM.restype = ctypes.c_size_t
+        self.call_lib.DSICE_GET_ELAPSED_TIME.argtypes = [ctypes.c_size_t]
+        self.call_lib.DSICE_GET_ELAPSED_TIME.restype = ctypes.c_double
+        self.call_lib.DSICE_GET_ESTIMATED_REMAINING_TIME.argtypes = [ctypes.c_size_t]
+        self.call_lib.DSICE_GET_ESTIMATED_REMAINING_TIME.restype = ctypes.c_double
+        self.call_lib.DSICE_GET_EXPECTED_IMPROVEMENT.argtypes = [ctypes.c_size_t]
+        self.call_lib.DSICE_GET_EXPECTED_IMPROVEMENT.restype = ctypes.c_double
         self.call_lib.DSICE_END_TIME.argtypes = [ctypes.c_size_t]
         self.call_lib.DSICE_END_TIME.restype = None
         self.call_lib.DSICE_END_PARALLEL.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.POINTER(ctypes.c_double)]
         self.call_lib.DSICE_END_PARALLEL.restype = None
+        self.call_lib.DSICE_END_PARALLEL_CENSORED.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.POINTER(ctypes.c_double), ctypes.POINTER(ctypes.c_bool)]
+        self.call_lib.DSICE_END_PARALLEL_CENSORED.restype = None
+        self.call_lib.DSICE_SET_MEASURE_DURATIONS.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.POINTER(ctypes.c_double)]
+        self.call_lib.DSICE_SET_MEASURE_DURATIONS.restype = None
+        self.call_lib.DSICE_ACQUIRE.argtypes = [ctypes.c_size_t, ctypes.POINTER(ctypes.c_double)]
+        self.call_lib.DSICE_ACQUIRE.restype = ctypes.c_size_t
+        self.call_lib.DSICE_ACQUIRE_WITH_FIDELITY.argtypes = [ctypes.c_size_t, ctypes.POINTER(ctypes.c_double), ctypes.POINTER(ctypes.c_double)]
+        self.call_lib.DSICE_ACQUIRE_WITH_FIDELITY.restype = ctypes.c_size_t
+        self.call_lib.DSICE_COMPLETE.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.c_double]
+        self.call_lib.DSICE_COMPLETE.restype = None
+        self.call_lib.DSICE_ABORT.argtypes = [ctypes.c_size_t, ctypes.c_size_t, ctypes.c_double]
+        self.call_lib.DSICE_ABORT.restype = None
         self.call_lib.DSICE_PRINT_TUNING_RESULT_STD.argtypes = [ctypes.c_size_t]
         self.call_lib.DSICE_PRINT_TUNING_RESULT_STD.restype = None
         self.call_lib.DSICE_PRINT_TUNING_RESULT_FILE.argtypes = [ctypes.c_size_t, ctypes.c_char_p]
@@ -128,6 +214,61 @@ class Tuner:
     def config_set_database_metric_type(self, metric_type:DSICE_DATABASE_METRIC_TYPE) -> None:
         self.call_lib.DSICE_CONFIG_SET_DATABASE_METRIC_TYPE(self.id, metric_type)
 
+    def config_set_adaptive_remeasurement(self, max_measurement_num:int, z_value:float=1.96) -> None:
+        self.call_lib.DSICE_CONFIG_SET_ADAPTIVE_REMEASUREMENT(self.id, max_measurement_num, z_value)
+
+    def config_set_significance_test(self, max_repetitions:int, significance_level:float=0.05) -> None:
+        self.call_lib.DSICE_CONFIG_SET_SIGNIFICANCE_TEST(self.id, max_repetitions, significance_level)
+
+    def config_set_log_memory_limit(self, max_in_memory_base_point_num:int, spill_file_path:str='dsice_log_spill.bin') -> None:
+        self.call_lib.DSICE_CONFIG_SET_LOG_MEMORY_LIMIT(self.id, max_in_memory_base_point_num, spill_file_path.encode())
+
+    def config_set_precomputation(self, precomputation_on:bool=True) -> None:
+        self.call_lib.DSICE_CONFIG_SET_PRECOMPUTATION(self.id, precomputation_on)
+
+    def config_set_deadline_factor(self, deadline_factor:float) -> None:
+        self.call_lib.DSICE_CONFIG_SET_DEADLINE_FACTOR(self.id, deadline_factor)
+
+    def config_set_multi_start_num(self, start_num:int) -> None:
+        self.call_lib.DSICE_CONFIG_SET_MULTI_START_NUM(self.id, start_num)
+
+    def config_set_worker_num(self, worker_num:int) -> None:
+        self.call_lib.DSICE_CONFIG_SET_WORKER_NUM(self.id, worker_num)
+
+    def config_set_full_search_factor(self, factor:int) -> None:
+        self.call_lib.DSICE_CONFIG_SET_FULL_SEARCH_FACTOR(self.id, factor)
+
+    def config_set_full_search_pruning(self, margin:float) -> None:
+        self.call_lib.DSICE_CONFIG_SET_FULL_SEARCH_PRUNING(self.id, margin)
+
+    def config_set_thread_pool_size(self, thread_num:int) -> None:
+        self.call_lib.DSICE_CONFIG_SET_THREAD_POOL_SIZE(self.id, thread_num)
+
+    def config_set_direction_sampling(self, max_changed_axis_num:int, direction_budget:int=64) -> None:
+        self.call_lib.DSICE_CONFIG_SET_DIRECTION_SAMPLING(self.id, max_changed_axis_num, direction_budget)
+
+    def config_set_parameter_screening(self, threshold:float) -> None:
+        self.call_lib.DSICE_CONFIG_SET_PARAMETER_SCREENING(self.id, threshold)
+
+    def config_set_gradient_step(self, gradient_step_on:bool=True) -> None:
+        self.call_lib.DSICE_CONFIG_SET_GRADIENT_STEP(self.id, gradient_step_on)
+
+    def config_set_surrogate(self, max_pair_num:int, skip_confidence:float=0) -> None:
+        self.call_lib.DSICE_CONFIG_SET_SURROGATE(self.id, max_pair_num, skip_confidence)
+
+    def config_set_initial_design(self, design_type:DSICE_INITIAL_DESIGN_TYPE=DSICE_INITIAL_DESIGN_TYPE.MaximinLhd, point_num:int=0, seed:int=0) -> None:
+        self.call_lib.DSICE_CONFIG_SET_INITIAL_DESIGN(self.id, design_type, point_num, seed)
+
+    def config_set_multi_fidelity(self, fidelities:list, eta:int=3, initial_num:int=0) -> None:
+        c_fidelities = (ctypes.c_double * len(fidelities))(*fidelities)
+        self.call_lib.DSICE_CONFIG_SET_MULTI_FIDELITY(self.id, len(fidelities), c_fidelities, eta, initial_num)
+
+    def config_set_cost_aware_ordering(self, window:int=2) -> None:
+        self.call_lib.DSICE_CONFIG_SET_COST_AWARE_ORDERING(self.id, window)
+
+    def config_set_budget(self, max_measurement_num:int, max_time_sec:float=0) -> None:
+        self.call_lib.DSICE_CONFIG_SET_BUDGET(self.id, max_measurement_num, max_time_sec)
+
     def get_suggested_next(self) -> list:
 
         param = list()
@@ -146,16 +287,67 @@ class Tuner:
 
         return params
 
+    def get_suggested_list_k(self, suggested_num:int) -> list:
+
+        suggested = self.call_lib.DSICE_BEGIN_PARALLEL_K(self.id, suggested_num)
+
+        params = list()
+        for i in range(self.call_lib.DSICE_GET_SUGGESTED_NUM(self.id)):
+            params.append(list())
+            for j in range(self.call_lib.DSICE_GET_PARAM_NUM(self.id)):
+                params[i].append(float(suggested[i][j]))
+
+        return params
+
     def set_metric_value(self, metric_value:float) -> None:
         self.call_lib.DSICE_END(self.id, metric_value)
 
+    def get_deadline(self) -> float:
+        return self.call_lib.DSICE_GET_DEADLINE(self.id)
+
+    def get_suggested_fidelity(self) -> float:
+        return self.call_lib.DSICE_GET_SUGGESTED_FIDELITY(self.id)
+
+    def report_partial(self, partial_value:float) -> bool:
+        return self.call_lib.DSICE_REPORT_PARTIAL(self.id, partial_value)
+
+    def set_censored_metric_value(self, bound:float) -> None:
+        self.call_lib.DSICE_END_CENSORED(self.id, bound)
+
     def set_time_performance(self) -> None:
         self.call_lib.DSICE_END_TIME(self.id)
 
-    def set_metric_values_list(self, metric_values_list:list) -> None:
+    def set_metric_values_list(self, metric_values_list:list, censored_flags:list=None) -> None:
         array_type = ctypes.c_double * len(metric_values_list)
         c_values = array_type(*metric_values_list)
-        self.call_lib.DSICE_END_PARALLEL(self.id, len(metric_values_list), c_values)
+        if censored_flags is None:
+            self.call_lib.DSICE_END_PARALLEL(self.id, len(metric_values_list), c_values)
+        else:
+            if len(censored_flags) != len(metric_values_list):
+                raise ValueError("censored_flags must have the same length as metric_values_list.")
+            c_flags = (ctypes.c_bool * len(censored_flags))(*censored_flags)
+            self.call_lib.DSICE_END_PARALLEL_CENSORED(self.id, len(metric_values_list), c_values, c_flags)
+
+    def set_measure_durations_list(self, durations_sec:list) -> None:
+        c_durations = (ctypes.c_double * len(durations_sec))(*durations_sec)
+        self.call_lib.DSICE_SET_MEASURE_DURATIONS(self.id, len(durations_sec), c_durations)
+
+    def acquire(self) -> tuple:
+        c_param = (ctypes.c_double * self.call_lib.DSICE_GET_PARAM_NUM(self.id))()
+        ticket_id = self.call_lib.DSICE_ACQUIRE(self.id, c_param)
+        return ticket_id, [float(v) for v in c_param]
+
+    def acquire_with_fidelity(self) -> tuple:
+        c_param = (ctypes.c_double * self.call_lib.DSICE_GET_PARAM_NUM(self.id))()
+        c_fidelity = ctypes.c_double(0)
+        ticket_id = self.call_lib.DSICE_ACQUIRE_WITH_FIDELITY(self.id, c_param, ctypes.byref(c_fidelity))
+        return ticket_id, [float(v) for v in c_param], float(c_fidelity.value)
+
+    def complete(self, ticket_id:int, metric_value:float) -> None:
+        self.call_lib.DSICE_COMPLETE(self.id, ticket_id, metric_value)
+
+    def abort(self, ticket_id:int, bound:float) -> None:
+        self.call_lib.DSICE_ABORT(self.id, ticket_id, bound)
 
     def get_param_num(self) -> int:
         return self.call_lib.DSICE_GET_PARAM_NUM(self.id)
@@ -182,9 +374,36 @@ class Tuner:
 
         return param
 
+    def predict(self, parameter:list) -> float:
+        array_type = ctypes.c_double * len(parameter)
+        c_param = array_type(*parameter)
+        return float(self.call_lib.DSICE_PREDICT(self.id, c_param))
+
+    def predict_batch(self, parameters:list) -> list:
+        flat_parameters = [value for parameter in parameters for value in parameter]
+        c_params = (ctypes.c_double * len(flat_parameters))(*flat_parameters)
+        c_values = (ctypes.c_double * len(parameters))()
+        self.call_lib.DSICE_PREDICT_BATCH(self.id, len(parameters), c_params, c_values)
+        return [float(v) for v in c_values]
+
     def is_search_finished(self) -> bool:
         return self.call_lib.DSICE_IS_SEARCH_FINISHED(self.id)
 
+    def get_measured_num(self) -> int:
+        return self.call_lib.DSICE_GET_MEASURED_NUM(self.id)
+
+    def get_remaining_measurement_num(self) -> int:
+        return self.call_lib.DSICE_GET_REMAINING_MEASUREMENT_NUM(self.id)
+
+    def get_elapsed_time(self) -> float:
+        return self.call_lib.DSICE_GET_ELAPSED_TIME(self.id)
+
+    def get_estimated_remaining_time(self) -> float:
+        return self.call_lib.DSICE_GET_ESTIMATED_REMAINING_TIME(self.id)
+
+    def get_expected_improvement(self) -> float:
+        return self.call_lib.DSICE_GET_EXPECTED_IMPROVEMENT(self.id)
+
     def print_tuning_result(self, file_path:str=None) -> None:
         if file_path is None:
             self.call_lib.DSICE_PRINT_TUNING_RESULT_STD(self.id)
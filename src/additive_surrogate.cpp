@@ -0,0 +1,413 @@
+﻿#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include "dsice_search_space.hpp"
+#include "equally_spaced_d_spline.hpp"
+#include "additive_surrogate.hpp"
+
+namespace dsice {
+
+	AdditiveSurrogate::AdditiveSurrogate(const space_size& search_space, std::size_t max_pair_num, double alpha) {
+
+		this->search_space_size = search_space;
+		this->max_pair_num = max_pair_num;
+		this->dsp_alpha = alpha;
+
+		std::size_t offset = 0;
+		for (std::size_t param_length : this->search_space_size) {
+			this->axis_offsets.push_back(offset);
+			offset += param_length;
+		}
+		this->axis_effects.assign(offset, 0);
+	}
+
+	AdditiveSurrogate::AdditiveSurrogate(const AdditiveSurrogate& original) {
+		this->search_space_size = original.search_space_size;
+		this->max_pair_num = original.max_pair_num;
+		this->dsp_alpha = original.dsp_alpha;
+		this->sample_rows = original.sample_rows;
+		this->sample_levels = original.sample_levels;
+		this->sample_values = original.sample_values;
+		this->axis_offsets = original.axis_offsets;
+		this->axis_effects = original.axis_effects;
+		this->intercept = original.intercept;
+		this->pair_axes = original.pair_axes;
+		this->pair_offsets = original.pair_offsets;
+		this->pair_effects = original.pair_effects;
+		this->pair_selected_samples_num = original.pair_selected_samples_num;
+		this->residual_deviation = original.residual_deviation;
+		this->is_outdated = original.is_outdated;
+	}
+
+	AdditiveSurrogate::~AdditiveSurrogate(void) {
+		// DO_NOTHING
+	}
+
+	void AdditiveSurrogate::setSample(const coordinate& target_coordinate, double metric_value) {
+
+		this->is_outdated = true;
+
+		auto found = this->sample_rows.find(target_coordinate);
+		if (found != this->sample_rows.end()) {
+			this->sample_values[found->second] = metric_value;
+			return;
+		}
+
+		this->sample_rows.emplace(target_coordinate, this->sample_values.size());
+		this->sample_levels.insert(this->sample_levels.end(), target_coordinate.begin(), target_coordinate.end());
+		this->sample_values.push_back(metric_value);
+	}
+
+	void AdditiveSurrogate::removeSample(const coordinate& target_coordinate) {
+
+		auto found = this->sample_rows.find(target_coordinate);
+		if (found == this->sample_rows.end()) {
+			return;
+		}
+
+		this->is_outdated = true;
+
+		// 末尾の標本を削除位置に移して詰める
+		std::size_t dimension = this->search_space_size.size();
+		std::size_t row = found->second;
+		std::size_t last_row = this->sample_values.size() - 1;
+		this->sample_rows.erase(found);
+
+		if (row != last_row) {
+			coordinate last_coordinate(this->sample_levels.begin() + last_row * dimension, this->sample_levels.end());
+			std::copy(last_coordinate.begin(), last_coordinate.end(), this->sample_levels.begin() + row * dimension);
+			this->sample_values[row] = this->sample_values[last_row];
+			this->sample_rows[last_coordinate] = row;
+		}
+
+		this->sample_levels.resize(last_row * dimension);
+		this->sample_values.pop_back();
+	}
+
+	std::size_t AdditiveSurrogate::getSamplesNum(void) const {
+		return this->sample_values.size();
+	}
+
+	double AdditiveSurrogate::predictRow(std::size_t row) const {
+
+		const std::size_t* levels = this->sample_levels.data() + row * this->search_space_size.size();
+
+		double value = this->intercept;
+		for (std::size_t i = 0; i < this->search_space_size.size(); i++) {
+			value += this->axis_effects[this->axis_offsets[i] + levels[i]];
+		}
+		for (std::size_t p = 0; p < this->pair_axes.size(); p++) {
+			const std::pair<std::size_t, std::size_t>& axes = this->pair_axes[p];
+			value += this->pair_effects[this->pair_offsets[p] + levels[axes.first] * this->search_space_size[axes.second] + levels[axes.second]];
+		}
+
+		return value;
+	}
+
+	std::vector<double> AdditiveSurrogate::estimatePairEffects(std::size_t first_axis, std::size_t second_axis, const std::vector<double>& residuals, const double* current_effects) const {
+
+		std::size_t dimension = this->search_space_size.size();
+		std::size_t rows_num = this->search_space_size[first_axis];
+		std::size_t columns_num = this->search_space_size[second_axis];
+
+		std::vector<double> cell_sums(rows_num * columns_num, 0);
+		std::vector<std::size_t> cell_counts(rows_num * columns_num, 0);
+		for (std::size_t k = 0; k < this->sample_values.size(); k++) {
+			std::size_t cell = this->sample_levels[k * dimension + first_axis] * columns_num + this->sample_levels[k * dimension + second_axis];
+			cell_sums[cell] += residuals[k] + (current_effects != nullptr ? current_effects[cell] : 0);
+			cell_counts[cell]++;
+		}
+
+		std::vector<double> effects(rows_num * columns_num, 0);
+		for (std::size_t cell = 0; cell < effects.size(); cell++) {
+			effects[cell] = cell_sums[cell] / static_cast<double>(cell_counts[cell] + 1);
+		}
+
+		// 1 行 (1 列) に 1 セルしか観測がなければ，そのセルの値は主効果と区別できないため 0 になる
+		for (std::size_t r = 0; r < rows_num; r++) {
+			double sum = 0;
+			std::size_t count = 0;
+			for (std::size_t col = 0; col < columns_num; col++) {
+				sum += effects[r * columns_num + col] * static_cast<double>(cell_counts[r * columns_num + col]);
+				count += cell_counts[r * columns_num + col];
+			}
+			for (std::size_t col = 0; col < columns_num && count > 0; col++) {
+				if (cell_counts[r * columns_num + col] > 0) {
+					effects[r * columns_num + col] -= sum / static_cast<double>(count);
+				}
+			}
+		}
+		for (std::size_t col = 0; col < columns_num; col++) {
+			double sum = 0;
+			std::size_t count = 0;
+			for (std::size_t r = 0; r < rows_num; r++) {
+				sum += effects[r * columns_num + col] * static_cast<double>(cell_counts[r * columns_num + col]);
+				count += cell_counts[r * columns_num + col];
+			}
+			for (std::size_t r = 0; r < rows_num && count > 0; r++) {
+				if (cell_counts[r * columns_num + col] > 0) {
+					effects[r * columns_num + col] -= sum / static_cast<double>(count);
+				}
+			}
+		}
+
+		return effects;
+	}
+
+	void AdditiveSurrogate::selectPairs(std::vector<double>& residuals) const {
+
+		std::size_t dimension = this->search_space_size.size();
+		std::size_t samples_num = this->sample_values.size();
+
+		// 採用中の交互作用項を外した残差に戻す
+		for (std::size_t k = 0; k < samples_num; k++) {
+			const std::size_t* levels = this->sample_levels.data() + k * dimension;
+			for (std::size_t p = 0; p < this->pair_axes.size(); p++) {
+				const std::pair<std::size_t, std::size_t>& axes = this->pair_axes[p];
+				residuals[k] += this->pair_effects[this->pair_offsets[p] + levels[axes.first] * this->search_space_size[axes.second] + levels[axes.second]];
+			}
+		}
+
+		// 交互作用項を当てはめた場合の残差平方和の減少量を組ごとに評価
+		std::vector<std::pair<double, std::pair<std::size_t, std::size_t>>> scored_pairs;
+		for (std::size_t i = 0; i < dimension; i++) {
+			for (std::size_t j = i + 1; j < dimension; j++) {
+
+				std::size_t cells_num = this->search_space_size[i] * this->search_space_size[j];
+				if (this->search_space_size[i] < 2 || this->search_space_size[j] < 2 || cells_num > AdditiveSurrogate::MAX_PAIR_CELLS_NUM) {
+					continue;
+				}
+
+				std::vector<double> effects = this->estimatePairEffects(i, j, residuals, nullptr);
+
+				double score = 0;
+				for (std::size_t k = 0; k < samples_num; k++) {
+					double h = effects[this->sample_levels[k * dimension + i] * this->search_space_size[j] + this->sample_levels[k * dimension + j]];
+					score += residuals[k] * residuals[k] - (residuals[k] - h) * (residuals[k] - h);
+				}
+				if (score > 0) {
+					scored_pairs.emplace_back(score, std::make_pair(i, j));
+				}
+			}
+		}
+
+		std::size_t selected_num = std::min(this->max_pair_num, scored_pairs.size());
+		std::partial_sort(scored_pairs.begin(), scored_pairs.begin() + selected_num, scored_pairs.end(),
+			[](const auto& a, const auto& b) { return a.first > b.first; });
+
+		this->pair_axes.clear();
+		this->pair_offsets.clear();
+		std::size_t offset = 0;
+		for (std::size_t p = 0; p < selected_num; p++) {
+			this->pair_axes.push_back(scored_pairs[p].second);
+			this->pair_offsets.push_back(offset);
+			offset += this->search_space_size[scored_pairs[p].second.first] * this->search_space_size[scored_pairs[p].second.second];
+		}
+		this->pair_effects.assign(offset, 0);
+
+		this->pair_selected_samples_num = samples_num;
+	}
+
+	void AdditiveSurrogate::refit(void) const {
+
+		this->is_outdated = false;
+
+		std::size_t dimension = this->search_space_size.size();
+		std::size_t samples_num = this->sample_values.size();
+
+		if (samples_num == 0) {
+			this->intercept = 0;
+			std::fill(this->axis_effects.begin(), this->axis_effects.end(), 0);
+			std::fill(this->pair_effects.begin(), this->pair_effects.end(), 0);
+			this->residual_deviation = std::numeric_limits<double>::infinity();
+			return;
+		}
+
+		// 前回の各項を初期値とし，切片のみ標本平均に合わせ直す
+		double mean = 0;
+		for (double v : this->sample_values) {
+			mean += v;
+		}
+		mean /= static_cast<double>(samples_num);
+		this->intercept = mean;
+
+		std::vector<double> residuals(samples_num);
+		for (std::size_t k = 0; k < samples_num; k++) {
+			residuals[k] = this->sample_values[k] - this->predictRow(k);
+		}
+
+		// 交互作用項の組は標本数が前回の選択時から 1.5 倍に増えるごとに選び直す
+		if (this->max_pair_num > 0 && 2 * samples_num >= 3 * this->pair_selected_samples_num && samples_num > dimension) {
+			this->selectPairs(residuals);
+		}
+
+		double scale = 0;
+		for (double v : this->sample_values) {
+			scale = std::max(scale, std::abs(v - mean));
+		}
+		double tolerance = scale * 1e-6;
+
+		const std::size_t max_sweep_num = 16;
+		std::vector<double> level_sums;
+		std::vector<std::size_t> level_counts;
+		for (std::size_t sweep = 0; sweep < max_sweep_num; sweep++) {
+
+			double max_change = 0;
+
+			// 主効果: 部分残差の水準ごとの平均に d-Spline を当てはめる
+			for (std::size_t i = 0; i < dimension; i++) {
+
+				std::size_t levels_num = this->search_space_size[i];
+				if (levels_num < 2) {
+					continue;
+				}
+				double* effects = this->axis_effects.data() + this->axis_offsets[i];
+
+				level_sums.assign(levels_num, 0);
+				level_counts.assign(levels_num, 0);
+				for (std::size_t k = 0; k < samples_num; k++) {
+					std::size_t level = this->sample_levels[k * dimension + i];
+					level_sums[level] += residuals[k] + effects[level];
+					level_counts[level]++;
+				}
+
+				std::vector<std::pair<std::size_t, double>> level_means;
+				for (std::size_t l = 0; l < levels_num; l++) {
+					if (level_counts[l] > 0) {
+						level_means.emplace_back(l, level_sums[l] / static_cast<double>(level_counts[l]));
+					}
+				}
+
+				// 1 水準しか観測していない性能パラメタの効果は切片と区別できない
+				std::vector<double> new_effects(levels_num, 0);
+				if (level_means.size() > 1) {
+					EquallySpacedDSpline dsp(levels_num, this->dsp_alpha);
+					dsp.update(level_means);
+					new_effects = dsp.getSampleValues();
+				}
+
+				// 標本上の平均が 0 になるよう中心化し，ずれは切片に移す
+				double center = 0;
+				for (std::size_t l = 0; l < levels_num; l++) {
+					center += new_effects[l] * static_cast<double>(level_counts[l]);
+				}
+				center /= static_cast<double>(samples_num);
+				this->intercept += center;
+
+				std::vector<double> deltas(levels_num);
+				for (std::size_t l = 0; l < levels_num; l++) {
+					new_effects[l] -= center;
+					deltas[l] = new_effects[l] - effects[l];
+					if (level_counts[l] > 0) {
+						max_change = std::max(max_change, std::abs(deltas[l]));
+					}
+					effects[l] = new_effects[l];
+				}
+				for (std::size_t k = 0; k < samples_num; k++) {
+					residuals[k] -= deltas[this->sample_levels[k * dimension + i]] + center;
+				}
+			}
+
+			// 交互作用項
+			for (std::size_t p = 0; p < this->pair_axes.size(); p++) {
+
+				std::size_t i = this->pair_axes[p].first;
+				std::size_t j = this->pair_axes[p].second;
+				double* effects = this->pair_effects.data() + this->pair_offsets[p];
+
+				std::vector<double> new_effects = this->estimatePairEffects(i, j, residuals, effects);
+
+				for (std::size_t k = 0; k < samples_num; k++) {
+					std::size_t cell = this->sample_levels[k * dimension + i] * this->search_space_size[j] + this->sample_levels[k * dimension + j];
+					residuals[k] -= new_effects[cell] - effects[cell];
+				}
+				for (std::size_t cell = 0; cell < new_effects.size(); cell++) {
+					max_change = std::max(max_change, std::abs(new_effects[cell] - effects[cell]));
+					effects[cell] = new_effects[cell];
+				}
+			}
+
+			if (max_change <= tolerance) {
+				break;
+			}
+		}
+
+		// 残差の自由度は観測した水準数とセル数から見積もる
+		double squared_error = 0;
+		for (double r : residuals) {
+			squared_error += r * r;
+		}
+
+		std::size_t parameters_num = 1;
+		for (std::size_t i = 0; i < dimension; i++) {
+			level_counts.assign(this->search_space_size[i], 0);
+			for (std::size_t k = 0; k < samples_num; k++) {
+				level_counts[this->sample_levels[k * dimension + i]]++;
+			}
+			std::size_t observed_num = static_cast<std::size_t>(std::count_if(level_counts.begin(), level_counts.end(), [](std::size_t n) { return n > 0; }));
+			parameters_num += observed_num - 1;
+		}
+		for (std::size_t p = 0; p < this->pair_axes.size(); p++) {
+			std::size_t cells_num = this->search_space_size[this->pair_axes[p].first] * this->search_space_size[this->pair_axes[p].second];
+			const double* effects = this->pair_effects.data() + this->pair_offsets[p];
+			parameters_num += static_cast<std::size_t>(std::count_if(effects, effects + cells_num, [](double v) { return v != 0; }));
+		}
+
+		if (samples_num > parameters_num) {
+			this->residual_deviation = std::sqrt(squared_error / static_cast<double>(samples_num - parameters_num));
+		}
+		else {
+			this->residual_deviation = std::numeric_limits<double>::infinity();
+		}
+	}
+
+	double AdditiveSurrogate::predict(const coordinate& target_coordinate) const {
+
+		if (this->is_outdated) {
+			this->refit();
+		}
+
+		double value = this->intercept;
+		for (std::size_t i = 0; i < this->search_space_size.size(); i++) {
+			value += this->axis_effects[this->axis_offsets[i] + target_coordinate[i]];
+		}
+		for (std::size_t p = 0; p < this->pair_axes.size(); p++) {
+			const std::pair<std::size_t, std::size_t>& axes = this->pair_axes[p];
+			value += this->pair_effects[this->pair_offsets[p] + target_coordinate[axes.first] * this->search_space_size[axes.second] + target_coordinate[axes.second]];
+		}
+
+		return value;
+	}
+
+	std::vector<double> AdditiveSurrogate::predict(const coordinate_list& target_coordinates) const {
+
+		if (this->is_outdated) {
+			this->refit();
+		}
+
+		std::vector<double> values;
+		values.reserve(target_coordinates.size());
+		for (const coordinate& c : target_coordinates) {
+			values.push_back(this->predict(c));
+		}
+
+		return values;
+	}
+
+	double AdditiveSurrogate::getResidualDeviation(void) const {
+
+		if (this->is_outdated) {
+			this->refit();
+		}
+
+		return this->residual_deviation;
+	}
+
+	bool AdditiveSurrogate::isOutdated(void) const {
+		return this->is_outdated;
+	}
+}
@@ -0,0 +1,165 @@
+﻿#ifndef ADDITIVE_SURROGATE_HPP_
+#define ADDITIVE_SURROGATE_HPP_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+
+#include "dsice_search_space.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 探索空間全体の性能評価値を，性能パラメタごとの d-Spline の和 (と任意個の 2 パラメタ間の交互作用項) で近似する加法的代理モデル．<br/>
+	/// 標本の追加時には記録のみを行い，予測値が必要になった時点で前回の各項を初期値としたバックフィッティングで再推定する
+	/// </summary>
+	class AdditiveSurrogate final {
+	private:
+		/// <summary>
+		/// 探索空間の各次元の長さ
+		/// </summary>
+		space_size search_space_size;
+		/// <summary>
+		/// 交互作用項として採用する性能パラメタ組の最大数
+		/// </summary>
+		std::size_t max_pair_num = 0;
+		/// <summary>
+		/// d-Spline の平滑化の強さ
+		/// </summary>
+		double dsp_alpha = 0.1;
+		/// <summary>
+		/// 標本点の座標から標本の行番号への対応
+		/// </summary>
+		std::unordered_map<coordinate, std::size_t> sample_rows;
+		/// <summary>
+		/// 標本点の座標 (行番号 × 次元数の一次元配列)
+		/// </summary>
+		std::vector<std::size_t> sample_levels;
+		/// <summary>
+		/// 標本の性能評価値 (行番号順)
+		/// </summary>
+		std::vector<double> sample_values;
+		/// <summary>
+		/// 各性能パラメタの主効果の axis_effects 内での開始位置
+		/// </summary>
+		std::vector<std::size_t> axis_offsets;
+		/// <summary>
+		/// 各性能パラメタの主効果 (全性能パラメタの値を連結した一次元配列)
+		/// </summary>
+		mutable std::vector<double> axis_effects;
+		/// <summary>
+		/// 切片
+		/// </summary>
+		mutable double intercept = 0;
+		/// <summary>
+		/// 交互作用項として採用した性能パラメタ組
+		/// </summary>
+		mutable std::vector<std::pair<std::size_t, std::size_t>> pair_axes;
+		/// <summary>
+		/// 各交互作用項の pair_effects 内での開始位置
+		/// </summary>
+		mutable std::vector<std::size_t> pair_offsets;
+		/// <summary>
+		/// 各交互作用項の値 (全組の表を連結した一次元配列)
+		/// </summary>
+		mutable std::vector<double> pair_effects;
+		/// <summary>
+		/// 交互作用項の組を前回選んだ時点の標本数
+		/// </summary>
+		mutable std::size_t pair_selected_samples_num = 0;
+		/// <summary>
+		/// 残差の標準偏差の推定値
+		/// </summary>
+		mutable double residual_deviation = 0;
+		/// <summary>
+		/// 標本の追加後に再推定されていないか
+		/// </summary>
+		mutable bool is_outdated = true;
+		/// <summary>
+		/// 指定行の標本点における現在のモデルの予測値
+		/// </summary>
+		/// <param name="row">行番号</param>
+		/// <returns>予測値</returns>
+		double predictRow(std::size_t row) const;
+		/// <summary>
+		/// 部分残差のセル平均を観測数に応じて 0 へ縮小し，行と列ごとに中心化した交互作用項を推定 (主効果と重複する成分は除く)
+		/// </summary>
+		/// <param name="first_axis">組の 1 つ目の性能パラメタ</param>
+		/// <param name="second_axis">組の 2 つ目の性能パラメタ</param>
+		/// <param name="residuals">各標本の残差</param>
+		/// <param name="current_effects">現在の交互作用項の値 (nullptr なら 0 とみなす)</param>
+		/// <returns>推定した交互作用項の値</returns>
+		std::vector<double> estimatePairEffects(std::size_t first_axis, std::size_t second_axis, const std::vector<double>& residuals, const double* current_effects) const;
+		/// <summary>
+		/// 交互作用項として採用する性能パラメタ組を残差から選び直す
+		/// </summary>
+		/// <param name="residuals">各標本の残差 (選び直した項の分は更新される)</param>
+		void selectPairs(std::vector<double>& residuals) const;
+		/// <summary>
+		/// 全標本を用いて各項を再推定する
+		/// </summary>
+		void refit(void) const;
+	public:
+		/// <summary>
+		/// 交互作用項の候補とする性能パラメタ組の表の最大セル数
+		/// </summary>
+		static constexpr std::size_t MAX_PAIR_CELLS_NUM = 65536;
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="search_space">探索空間の各次元の長さ</param>
+		/// <param name="max_pair_num">交互作用項として採用する性能パラメタ組の最大数</param>
+		/// <param name="alpha">d-Spline の平滑化の強さ</param>
+		AdditiveSurrogate(const space_size& search_space, std::size_t max_pair_num = 0, double alpha = 0.1);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		AdditiveSurrogate(const AdditiveSurrogate& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~AdditiveSurrogate(void);
+		/// <summary>
+		/// 標本を登録 (登録済の標本点であれば値を置き換える)
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		/// <param name="metric_value">性能評価値</param>
+		void setSample(const coordinate& target_coordinate, double metric_value);
+		/// <summary>
+		/// 標本を削除 (未登録であれば何もしない)
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		void removeSample(const coordinate& target_coordinate);
+		/// <summary>
+		/// 登録済の標本数を取得
+		/// </summary>
+		/// <returns>標本数</returns>
+		std::size_t getSamplesNum(void) const;
+		/// <summary>
+		/// 指定点の性能評価値を予測
+		/// </summary>
+		/// <param name="target_coordinate">予測対象の座標</param>
+		/// <returns>予測値 (標本がない場合は 0)</returns>
+		double predict(const coordinate& target_coordinate) const;
+		/// <summary>
+		/// 複数点の性能評価値をまとめて予測
+		/// </summary>
+		/// <param name="target_coordinates">予測対象の座標のリスト</param>
+		/// <returns>予測値のリスト</returns>
+		std::vector<double> predict(const coordinate_list& target_coordinates) const;
+		/// <summary>
+		/// 残差の標準偏差の推定値を取得
+		/// </summary>
+		/// <returns>残差の標準偏差 (自由度が足りない場合は無限大)</returns>
+		double getResidualDeviation(void) const;
+		/// <summary>
+		/// 標本の登録後に再推定されていないか (再推定は次の予測時に行われる)
+		/// </summary>
+		/// <returns>再推定が必要であれば true</returns>
+		bool isOutdated(void) const;
+	};
+}
+
+#endif // !ADDITIVE_SURROGATE_HPP_
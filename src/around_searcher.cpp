@@ -1,16 +1,18 @@
 ﻿#include <stdexcept>
 #include <memory>
+#include <vector>
 #include <algorithm>
 #include <limits>
 
 #include "dsice_search_space.hpp"
 #include "dsice_database_core.hpp"
 #include "around_points.hpp"
+#include "dsice_thread_pool.hpp"
 #include "around_searcher.hpp"
 
 namespace dsice {
 
-	AroundSearcher::AroundSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& target_coordinate, std::size_t max_changed_axis_num, bool low_value_is_better) {
+	AroundSearcher::AroundSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& target_coordinate, std::size_t max_changed_axis_num, bool low_value_is_better, std::shared_ptr<ThreadPool> pool) {
 
 		this->lower_is_better = low_value_is_better;
 		this->best_judged_point_coordinate = target_coordinate;
@@ -31,11 +33,24 @@ namespace dsice {
 		AroundPoints points(search_database->getSpaceSize(), target_coordinate, max_changed_axis_num);
 		this->around_coordinates = points.getAroundPoints();
 
-		for (const coordinate& c : this->around_coordinates) {
-			if (search_database->hasSample(c)) {
+		// 周辺点ごとのデータベース参照は互いに独立なので並列に行い，結果の反映は周辺点の順に行う
+		std::vector<int> has_samples(this->around_coordinates.size());
+		std::vector<double> point_values(this->around_coordinates.size());
+		ThreadPool::run(pool, this->around_coordinates.size(), [this, &search_database, &has_samples, &point_values](std::size_t i) {
+			has_samples[i] = search_database->hasSample(this->around_coordinates[i]) ? 1 : 0;
+			if (has_samples[i] != 0) {
+				point_values[i] = search_database->getSampleMetricValue(this->around_coordinates[i]);
+			}
+		});
+
+		for (std::size_t i = 0; i < this->around_coordinates.size(); i++) {
+
+			const coordinate& c = this->around_coordinates[i];
+
+			if (has_samples[i] != 0) {
 
 				this->measured_coordinates.insert(c);
-				double v = search_database->getSampleMetricValue(c);
+				double v = point_values[i];
 
 				if (this->lower_is_better) {
 
@@ -8,6 +8,7 @@
 #include "dsice_search_space.hpp"
 #include "dsice_database_core.hpp"
 #include "dsice_search_engine.hpp"
+#include "dsice_thread_pool.hpp"
 
 namespace dsice {
 
@@ -68,7 +69,8 @@ namespace dsice {
 		/// <param name="target_coordinate">基点座標</param>
 		/// <param name="max_changed_axis_num">同時変化させる軸数の最大値</param>
 		/// <param name="low_value_is_better">性能評価値が低い値ほど良いのであれば true</param>
-		AroundSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& target_coordinate, std::size_t max_changed_axis_num, bool low_value_is_better = true);
+		/// <param name="pool">周辺点のデータベース参照に用いるスレッドプール (nullptr の場合は逐次実行)</param>
+		AroundSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& target_coordinate, std::size_t max_changed_axis_num, bool low_value_is_better = true, std::shared_ptr<ThreadPool> pool = nullptr);
 		/// <summary>
 		/// コピーコンストラクタ
 		/// </summary>
@@ -12,9 +12,18 @@ namespace dsice {
 		this->value = init_value;
 	}
 
+	AverageDouble::AverageDouble(double mean_value, std::size_t recorded_count, double variance) {
+		this->count = recorded_count;
+		this->value = mean_value;
+		if (recorded_count >= 2) {
+			this->squared_deviation_sum = variance * (recorded_count - 1);
+		}
+	}
+
 	AverageDouble::AverageDouble(const AverageDouble& original) {
 		this->value = original.value;
 		this->count = original.count;
+		this->squared_deviation_sum = original.squared_deviation_sum;
 	}
 
 	AverageDouble::~AverageDouble(void) {
@@ -37,12 +46,24 @@ namespace dsice {
 		double effect = diff / this->count;
 
 		this->value += effect;
+
+		// 更新前後の平均値との偏差の積を加算 (Welford のアルゴリズム)
+		this->squared_deviation_sum += diff * (metric_value - this->value);
 	}
 
 	std::size_t AverageDouble::getRecordedCount(void) const {
 		return this->count;
 	}
 
+	double AverageDouble::getVariance(void) const {
+
+		if (this->count < 2) {
+			return 0;
+		}
+
+		return this->squared_deviation_sum / (this->count - 1);
+	}
+
 	std::shared_ptr<Metric> AverageDouble::makeCopy(void) const {
 		return std::make_shared<AverageDouble>(*this);
 	}
@@ -8,7 +8,8 @@ namespace dsice {
 
 	/// <summary>
 	/// 倍精度浮動小数について常に平均をとり続ける蓄積数値型．<br/>
-	/// 過去の生データを保持しない分軽量な実装を採用
+	/// 過去の生データを保持しない分軽量な実装を採用．<br/>
+	/// 平均値と同時に Welford のアルゴリズムで分散も更新する
 	/// </summary>
 	class AverageDouble final : public Metric {
 	private:
@@ -20,6 +21,10 @@ namespace dsice {
 		/// 性能評価値を登録した回数
 		/// </summary>
 		std::size_t count = 0;
+		/// <summary>
+		/// 平均値からの偏差の 2 乗和 (Welford のアルゴリズムで逐次更新)
+		/// </summary>
+		double squared_deviation_sum = 0;
 	public:
 		/// <summary>
 		/// 値無しの場合のコンストラクタ．<br/>
@@ -32,6 +37,13 @@ namespace dsice {
 		/// <param name="init_value">初期値</param>
 		AverageDouble(double init_value);
 		/// <summary>
+		/// 集計済の平均値，登録回数，不偏分散から復元するコンストラクタ
+		/// </summary>
+		/// <param name="mean_value">平均値</param>
+		/// <param name="recorded_count">登録回数</param>
+		/// <param name="variance">不偏分散 (登録回数が 2 未満の場合は無視)</param>
+		AverageDouble(double mean_value, std::size_t recorded_count, double variance);
+		/// <summary>
 		/// コピーコンストラクタ
 		/// </summary>
 		/// <param name="original">コピー元</param>
@@ -60,6 +72,12 @@ namespace dsice {
 		/// <returns>過去に保存されたデータの数</returns>
 		std::size_t getRecordedCount(void) const override;
 		/// <summary>
+		/// 過去に登録された性能評価値の不偏分散を取得．<br/>
+		/// 登録数が 2 未満の場合は 0
+		/// </summary>
+		/// <returns>過去に登録された性能評価値の不偏分散</returns>
+		double getVariance(void) const;
+		/// <summary>
 		/// コピーされた新しいインスタンスを Metric 型として作成．コピーコンストラクタ用．
 		/// </summary>
 		/// <returns>コピーされたインスタンス</returns>
@@ -0,0 +1,30 @@
+﻿#ifndef COPY_ON_WRITE_HPP_
+#define COPY_ON_WRITE_HPP_
+
+#include <memory>
+#include <atomic>
+
+namespace dsice {
+
+	/// <summary>
+	/// 参照数によるコピーオンライトで，更新前に複製が必要か (他にも所有者がいるか) を判定．<br/>
+	/// 所有者が自分だけの場合は，別スレッドの所有者が手放す前に行った読み取りがすべて完了していることも保証する
+	/// (参照数の取得自体は順序付けを伴わないため，取得フェンスで手放し側の参照数減算と同期させる)
+	/// </summary>
+	/// <typeparam name="T">共有する値の型</typeparam>
+	/// <param name="target">判定対象</param>
+	/// <returns>他にも所有者がいれば true</returns>
+	template <typename T>
+	bool isShared(const std::shared_ptr<T>& target) {
+
+		if (target.use_count() > 1) {
+			return true;
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		return false;
+	}
+}
+
+#endif // !COPY_ON_WRITE_HPP_
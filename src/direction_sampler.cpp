@@ -0,0 +1,345 @@
+﻿#include <memory>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <stdexcept>
+
+#include "dsice_search_space.hpp"
+#include "direction_line.hpp"
+#include "dsice_database_core.hpp"
+#include "dsice_database_base_point_extension.hpp"
+#include "direction_sampler.hpp"
+
+namespace dsice {
+
+	DirectionSampler::DirectionSampler(const space_size& space, std::size_t max_changed_axis_num, std::size_t direction_budget) {
+
+		if (max_changed_axis_num == 0) {
+			throw std::invalid_argument("max_changed_axis_num must be greater than zero.");
+		}
+		if (direction_budget == 0) {
+			throw std::invalid_argument("direction_budget must be greater than zero.");
+		}
+
+		this->space = space;
+		this->max_changed_axis_num = max_changed_axis_num;
+		this->direction_budget = direction_budget;
+		this->tried_direction_nums.assign(max_changed_axis_num + 1, 0);
+		this->improved_direction_nums.assign(max_changed_axis_num + 1, 0);
+		this->axis_weights.assign(space.size(), 1.0);
+
+		for (std::size_t i = 0; i < space.size(); i++) {
+			if (space[i] > 1) {
+				this->movable_axes.push_back(i);
+			}
+		}
+
+		std::random_device seed_gen;
+		this->random_engine.seed(seed_gen());
+	}
+
+	DirectionSampler::DirectionSampler(const DirectionSampler& original) {
+		this->space = original.space;
+		this->max_changed_axis_num = original.max_changed_axis_num;
+		this->direction_budget = original.direction_budget;
+		this->tried_direction_nums = original.tried_direction_nums;
+		this->improved_direction_nums = original.improved_direction_nums;
+		this->axis_weights = original.axis_weights;
+		this->movable_axes = original.movable_axes;
+		this->random_engine = original.random_engine;
+	}
+
+	DirectionSampler::~DirectionSampler(void) {
+		// DO_NOTHING
+	}
+
+	bool DirectionSampler::hasNeighbor(const coordinate& base_coordinate, const std::vector<int>& direction) const {
+
+		bool has_forward = true;
+		bool has_backward = true;
+
+		for (std::size_t i = 0; i < direction.size(); i++) {
+			if (direction[i] > 0) {
+				has_forward = has_forward && base_coordinate[i] + 1 < this->space[i];
+				has_backward = has_backward && base_coordinate[i] > 0;
+			}
+			else if (direction[i] < 0) {
+				has_forward = has_forward && base_coordinate[i] > 0;
+				has_backward = has_backward && base_coordinate[i] + 1 < this->space[i];
+			}
+		}
+
+		return has_forward || has_backward;
+	}
+
+	std::vector<std::size_t> DirectionSampler::pickAxes(std::size_t axis_num) {
+
+		std::vector<double> weights;
+		double weight_sum = 0;
+		for (std::size_t axis : this->movable_axes) {
+			weights.push_back(this->axis_weights[axis]);
+			weight_sum += this->axis_weights[axis];
+		}
+
+		std::vector<std::size_t> picked;
+		while (picked.size() < axis_num) {
+
+			double r = std::uniform_real_distribution<double>(0, weight_sum)(this->random_engine);
+
+			// 浮動小数点誤差で末尾を越えた場合は重みの残る最後の軸とする
+			std::size_t k = 0;
+			std::size_t last_k = 0;
+			for (; k < weights.size(); k++) {
+				if (weights[k] <= 0) {
+					continue;
+				}
+				last_k = k;
+				if (r < weights[k]) {
+					break;
+				}
+				r -= weights[k];
+			}
+			if (k == weights.size()) {
+				k = last_k;
+			}
+
+			picked.push_back(this->movable_axes[k]);
+			weight_sum -= weights[k];
+			weights[k] = 0;
+		}
+
+		return picked;
+	}
+
+	void DirectionSampler::enumerateDirections(std::size_t axis_num, const std::function<bool(const std::vector<int>&)>& visitor) const {
+
+		if (axis_num == 0 || axis_num > this->movable_axes.size()) {
+			return;
+		}
+
+		// 軸の組み合わせを辞書順に，各組み合わせで先頭軸を正とした符号の組を列挙
+		std::vector<std::size_t> combination(axis_num);
+		for (std::size_t i = 0; i < axis_num; i++) {
+			combination[i] = i;
+		}
+
+		while (true) {
+
+			for (std::size_t signs = 0; signs < (static_cast<std::size_t>(1) << (axis_num - 1)); signs++) {
+
+				std::vector<int> direction(this->space.size(), 0);
+				direction[this->movable_axes[combination[0]]] = 1;
+				for (std::size_t i = 1; i < axis_num; i++) {
+					direction[this->movable_axes[combination[i]]] = ((signs >> (i - 1)) & 1) != 0 ? -1 : 1;
+				}
+
+				if (!visitor(direction)) {
+					return;
+				}
+			}
+
+			std::size_t i = axis_num;
+			while (i > 0 && combination[i - 1] == this->movable_axes.size() - axis_num + i - 1) {
+				i--;
+			}
+			if (i == 0) {
+				return;
+			}
+
+			combination[i - 1]++;
+			for (std::size_t j = i; j < axis_num; j++) {
+				combination[j] = combination[j - 1] + 1;
+			}
+		}
+	}
+
+	std::size_t DirectionSampler::getMaxChangedAxisNum(void) const {
+		return this->max_changed_axis_num;
+	}
+
+	void DirectionSampler::freezeAxes(const std::vector<std::size_t>& frozen_axes) {
+		std::erase_if(this->movable_axes, [&frozen_axes](std::size_t axis) {
+			return std::find(frozen_axes.begin(), frozen_axes.end(), axis) != frozen_axes.end();
+		});
+	}
+
+	const std::vector<std::size_t>& DirectionSampler::getMovableAxes(void) const {
+		return this->movable_axes;
+	}
+
+	std::vector<std::size_t> DirectionSampler::getDirectionBudgets(std::size_t total_budget) const {
+
+		std::size_t max_axis_num = std::min(this->max_changed_axis_num, this->movable_axes.size());
+		std::vector<std::size_t> budgets(max_axis_num + 1, 0);
+
+		// 軸数 c の方向の総数は C(n, c) * 2^(c - 1) (境界の影響は無視)
+		std::vector<double> capacities(max_axis_num + 1, 0);
+		double combination = 1;
+		for (std::size_t c = 1; c <= max_axis_num; c++) {
+			combination = combination * static_cast<double>(this->movable_axes.size() - c + 1) / static_cast<double>(c);
+			capacities[c] = combination * std::pow(2.0, static_cast<double>(c - 1));
+		}
+
+		// 改善割合に比例する配分を，1 方向ずつ最も不足している軸数に割り当てて求める
+		for (std::size_t n = 0; n < total_budget; n++) {
+
+			std::size_t target = 0;
+			double target_quotient = 0;
+
+			for (std::size_t c = 1; c <= max_axis_num; c++) {
+
+				if (static_cast<double>(budgets[c]) >= capacities[c]) {
+					continue;
+				}
+
+				double rate = (static_cast<double>(this->improved_direction_nums[c]) + 1.0) / (static_cast<double>(this->tried_direction_nums[c]) + 2.0);
+				double quotient = rate / static_cast<double>(budgets[c] + 1);
+
+				if (quotient > target_quotient) {
+					target = c;
+					target_quotient = quotient;
+				}
+			}
+
+			if (target == 0) {
+				break;
+			}
+
+			budgets[target]++;
+		}
+
+		return budgets;
+	}
+
+	std::vector<DirectionLine> DirectionSampler::sampleDirections(std::shared_ptr<const DatabaseCore> database, const coordinate& base_coordinate, const std::unordered_set<DirectionLine>& excluded_directions) {
+
+		std::shared_ptr<const DatabaseBasePointExtension> basepoint_database = std::dynamic_pointer_cast<const DatabaseBasePointExtension>(database);
+
+		// 同じ基準点で探索を続ける場合は 1 巡ごとに方向数を倍増させ，いずれ全方向を探索する
+		std::size_t total_budget = this->direction_budget;
+		const std::unordered_map<coordinate, std::unordered_set<DirectionLine>>& base_points = basepoint_database->getBasePoints();
+		std::unordered_map<coordinate, std::unordered_set<DirectionLine>>::const_iterator searched = base_points.find(base_coordinate);
+		if (searched != base_points.end()) {
+			total_budget = std::max(total_budget, searched->second.size());
+		}
+
+		std::vector<std::size_t> budgets = this->getDirectionBudgets(total_budget);
+		std::vector<DirectionLine> sampled;
+		std::unordered_set<DirectionLine> listed = excluded_directions;
+
+		for (std::size_t c = 1; c < budgets.size(); c++) {
+
+			if (budgets[c] == 0) {
+				continue;
+			}
+
+			std::size_t sampled_num = 0;
+
+			// 配分が総数の半分以上であれば，無作為に引き続けるより列挙した中から選ぶ方が早い
+			double capacity = std::pow(2.0, static_cast<double>(c - 1));
+			for (std::size_t i = 0; i < c; i++) {
+				capacity = capacity * static_cast<double>(this->movable_axes.size() - i) / static_cast<double>(i + 1);
+			}
+
+			if (static_cast<double>(budgets[c]) * 2 >= capacity) {
+
+				std::vector<DirectionLine> candidates;
+				this->enumerateDirections(c, [this, &candidates, &listed, &basepoint_database, &base_coordinate](const std::vector<int>& direction) {
+					DirectionLine line(direction);
+					if (this->hasNeighbor(base_coordinate, direction) && !listed.contains(line) && !basepoint_database->isSearchedDirection(base_coordinate, line)) {
+						candidates.push_back(line);
+					}
+					return true;
+				});
+
+				std::shuffle(candidates.begin(), candidates.end(), this->random_engine);
+				for (std::size_t i = 0; i < candidates.size() && sampled_num < budgets[c]; i++) {
+					listed.insert(candidates[i]);
+					sampled.push_back(candidates[i]);
+					sampled_num++;
+				}
+
+				continue;
+			}
+
+			std::uniform_int_distribution<int> sign_distribution(0, 1);
+
+			// 探索済の方向を引き続けることもあるため試行回数に上限を設ける
+			std::size_t max_trial = budgets[c] * 16 + 16;
+
+			for (std::size_t trial = 0; trial < max_trial && sampled_num < budgets[c]; trial++) {
+
+				std::vector<int> direction(this->space.size(), 0);
+				for (std::size_t axis : this->pickAxes(c)) {
+					direction[axis] = sign_distribution(this->random_engine) == 0 ? -1 : 1;
+				}
+
+				DirectionLine line(direction);
+
+				if (!this->hasNeighbor(base_coordinate, direction) || listed.contains(line) || basepoint_database->isSearchedDirection(base_coordinate, line)) {
+					continue;
+				}
+
+				listed.insert(line);
+				sampled.push_back(line);
+				sampled_num++;
+			}
+		}
+
+		return sampled;
+	}
+
+	bool DirectionSampler::hasUnsearchedDirection(std::shared_ptr<const DatabaseCore> database, const coordinate& base_coordinate) const {
+
+		std::shared_ptr<const DatabaseBasePointExtension> basepoint_database = std::dynamic_pointer_cast<const DatabaseBasePointExtension>(database);
+
+		bool has_unsearched = false;
+
+		for (std::size_t c = 1; c <= this->max_changed_axis_num && !has_unsearched; c++) {
+			this->enumerateDirections(c, [this, &has_unsearched, &basepoint_database, &base_coordinate](const std::vector<int>& direction) {
+				if (this->hasNeighbor(base_coordinate, direction) && !basepoint_database->isSearchedDirection(base_coordinate, DirectionLine(direction))) {
+					has_unsearched = true;
+				}
+				return !has_unsearched;
+			});
+		}
+
+		return has_unsearched;
+	}
+
+	void DirectionSampler::recordRound(const coordinate& base_coordinate, const std::unordered_set<DirectionLine>& searched_directions, const coordinate& best_coordinate) {
+
+		for (const DirectionLine& line : searched_directions) {
+			std::size_t c = line.getDirectionDimension();
+			if (c >= 1 && c <= this->max_changed_axis_num) {
+				this->tried_direction_nums[c]++;
+			}
+		}
+
+		if (best_coordinate.empty() || best_coordinate == base_coordinate) {
+			return;
+		}
+
+		DirectionLine improved_line(base_coordinate, best_coordinate);
+		std::size_t c = improved_line.getDirectionDimension();
+		if (c < 1 || c > this->max_changed_axis_num) {
+			return;
+		}
+
+		// 探索途中で移動した場合は改善方向が探索済に含まれない
+		if (!searched_directions.contains(improved_line)) {
+			this->tried_direction_nums[c]++;
+		}
+		this->improved_direction_nums[c]++;
+
+		for (std::size_t i = 0; i < improved_line.getDirection().size(); i++) {
+			if (improved_line.getDirection()[i] != 0) {
+				this->axis_weights[i] += 1.0;
+			}
+		}
+	}
+}
@@ -0,0 +1,139 @@
+﻿#ifndef DIRECTION_SAMPLER_HPP_
+#define DIRECTION_SAMPLER_HPP_
+
+#include <memory>
+#include <vector>
+#include <random>
+#include <functional>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "direction_line.hpp"
+#include "dsice_database_core.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// パラメタ数が多く全周辺方向 (3^n - 1 方向) を探索できない場合に，探索する方向を間引いて選ぶ機構．<br/>
+	/// 同時変化軸数が上限以下の方向を，1 巡 (1 つの探索基準点での放射状探索) あたりの方向数の上限まで無作為に選ぶ．<br/>
+	/// 同時変化軸数ごとの方向数の配分はその軸数の方向がこれまでに改善をもたらした割合に比例させ，軸は改善をもたらした方向に含まれていたものほど選ばれやすくする
+	/// </summary>
+	class DirectionSampler final {
+	private:
+		/// <summary>
+		/// 探索空間の大きさ
+		/// </summary>
+		space_size space;
+		/// <summary>
+		/// 同時変化させる軸数の最大値
+		/// </summary>
+		std::size_t max_changed_axis_num;
+		/// <summary>
+		/// 1 巡あたりに選ぶ方向数の上限 (同じ基準点で探索を続ける場合はその基準点での探索済方向数まで増える)
+		/// </summary>
+		std::size_t direction_budget;
+		/// <summary>
+		/// 同時変化軸数ごとの探索した方向数 (添字は同時変化軸数)
+		/// </summary>
+		std::vector<std::size_t> tried_direction_nums;
+		/// <summary>
+		/// 同時変化軸数ごとの改善をもたらした方向数 (添字は同時変化軸数)
+		/// </summary>
+		std::vector<std::size_t> improved_direction_nums;
+		/// <summary>
+		/// 各軸を選ぶ際の重み (改善をもたらした方向に含まれるたびに増える)
+		/// </summary>
+		std::vector<double> axis_weights;
+		/// <summary>
+		/// 変化させられる軸 (設定値が 2 つ以上あり，固定されていない軸) の一覧
+		/// </summary>
+		std::vector<std::size_t> movable_axes;
+		/// <summary>
+		/// 乱数生成器
+		/// </summary>
+		std::mt19937_64 random_engine;
+		/// <summary>
+		/// 基点から指定方向へ 1 つ以上の点が探索空間内にあるかどうか
+		/// </summary>
+		/// <param name="base_coordinate">基点座標</param>
+		/// <param name="direction">方向 (各要素は -1，0，1 のいずれか)</param>
+		/// <returns>正負いずれかの向きに隣接点があれば true</returns>
+		bool hasNeighbor(const coordinate& base_coordinate, const std::vector<int>& direction) const;
+		/// <summary>
+		/// 変化させられる軸から，重みに従って指定数の軸を重複なく選ぶ
+		/// </summary>
+		/// <param name="axis_num">選ぶ軸数</param>
+		/// <returns>選んだ軸の一覧</returns>
+		std::vector<std::size_t> pickAxes(std::size_t axis_num);
+		/// <summary>
+		/// 指定した同時変化軸数の方向をすべて列挙 (向きのみ異なる方向は 1 つとする)
+		/// </summary>
+		/// <param name="axis_num">同時変化軸数</param>
+		/// <param name="visitor">各方向に対する処理 (false を返すと列挙を打ち切る)</param>
+		void enumerateDirections(std::size_t axis_num, const std::function<bool(const std::vector<int>&)>& visitor) const;
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="space">探索空間の大きさ</param>
+		/// <param name="max_changed_axis_num">同時変化させる軸数の最大値</param>
+		/// <param name="direction_budget">1 巡あたりに選ぶ方向数の上限</param>
+		DirectionSampler(const space_size& space, std::size_t max_changed_axis_num, std::size_t direction_budget);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		DirectionSampler(const DirectionSampler& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~DirectionSampler(void);
+		/// <summary>
+		/// 同時変化させる軸数の最大値を取得
+		/// </summary>
+		/// <returns>同時変化させる軸数の最大値</returns>
+		std::size_t getMaxChangedAxisNum(void) const;
+		/// <summary>
+		/// 指定した軸を固定し，以降に選ぶ方向から除く
+		/// </summary>
+		/// <param name="frozen_axes">固定する軸の番号</param>
+		void freezeAxes(const std::vector<std::size_t>& frozen_axes);
+		/// <summary>
+		/// 変化させられる軸 (設定値が 2 つ以上あり，固定されていない軸) の一覧を取得
+		/// </summary>
+		/// <returns>変化させられる軸の番号</returns>
+		const std::vector<std::size_t>& getMovableAxes(void) const;
+		/// <summary>
+		/// 同時変化軸数ごとの 1 巡あたりの方向数の配分を取得．<br/>
+		/// 改善をもたらした割合 (事前分布として 1/2 を加えた推定値) に比例して，各軸数の方向の総数を超えない範囲で配分する
+		/// </summary>
+		/// <param name="total_budget">配分する方向数</param>
+		/// <returns>同時変化軸数ごとの方向数 (添字は同時変化軸数)</returns>
+		std::vector<std::size_t> getDirectionBudgets(std::size_t total_budget) const;
+		/// <summary>
+		/// 探索する方向を選ぶ．<br/>
+		/// 改善が見られず同じ基準点で探索を続ける場合は，その基準点での探索済方向数まで選ぶ方向数を増やす
+		/// </summary>
+		/// <param name="database">データベース (探索済方向の確認に用いる)</param>
+		/// <param name="base_coordinate">探索基準点</param>
+		/// <param name="excluded_directions">データベースに未記録だが探索済として扱う方向</param>
+		/// <returns>探索する方向の一覧</returns>
+		std::vector<DirectionLine> sampleDirections(std::shared_ptr<const DatabaseCore> database, const coordinate& base_coordinate, const std::unordered_set<DirectionLine>& excluded_directions = {});
+		/// <summary>
+		/// 同時変化軸数が上限以下の未探索の方向が残っているかどうか
+		/// </summary>
+		/// <param name="database">データベース</param>
+		/// <param name="base_coordinate">探索基準点</param>
+		/// <returns>残っていれば true</returns>
+		bool hasUnsearchedDirection(std::shared_ptr<const DatabaseCore> database, const coordinate& base_coordinate) const;
+		/// <summary>
+		/// 1 巡の探索結果を記録し，以降の配分と軸の重みに反映
+		/// </summary>
+		/// <param name="base_coordinate">探索基準点</param>
+		/// <param name="searched_directions">探索した方向</param>
+		/// <param name="best_coordinate">この巡で見つかった最良点 (改善がなければ探索基準点)</param>
+		void recordRound(const coordinate& base_coordinate, const std::unordered_set<DirectionLine>& searched_directions, const coordinate& best_coordinate);
+	};
+}
+
+#endif // !DIRECTION_SAMPLER_HPP_
@@ -1,6 +1,7 @@
 ﻿#include <stdexcept>
 #include <memory>
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
 
 #include "dsice_tuner.hpp"
@@ -134,6 +135,15 @@ namespace dsice {
 			break;
 		case DSICE_MODE_P_2024B:
 			target_tuner->selectMode(ExecutionMode::P_2024B);
+			break;
+		case DSICE_MODE_P_ASYNC:
+			target_tuner->selectMode(ExecutionMode::P_ASYNC);
+			break;
+		case DSICE_MODE_P_MULTI_START:
+			target_tuner->selectMode(ExecutionMode::P_MULTI_START);
+			break;
+		case DSICE_MODE_P_FULL:
+			target_tuner->selectMode(ExecutionMode::P_FULL);
 		}
 	}
 
@@ -202,9 +212,165 @@ namespace dsice {
 		case DSICE_METRIC_TYPE_AVERAGE:
 			target_tuner->config_setDatabaseMetricType(DatabaseMetricType::AverageDouble);
 			break;
+		case DSICE_METRIC_TYPE_MEDIAN:
+			target_tuner->config_setDatabaseMetricType(DatabaseMetricType::MedianDouble);
+			break;
+		case DSICE_METRIC_TYPE_TRIMMED_AVERAGE:
+			target_tuner->config_setDatabaseMetricType(DatabaseMetricType::TrimmedAverageDouble);
+			break;
+		case DSICE_METRIC_TYPE_MINIMUM:
+			target_tuner->config_setDatabaseMetricType(DatabaseMetricType::MinimumDouble);
+			break;
+		case DSICE_METRIC_TYPE_EWMA:
+			target_tuner->config_setDatabaseMetricType(DatabaseMetricType::EwmaDouble);
+			break;
+		}
+	}
+
+	void DSICE_CONFIG_SET_ADAPTIVE_REMEASUREMENT(dsice_tuner_id tuner_id, size_t max_measurement_num, double z_value) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setAdaptiveRemeasurement(max_measurement_num, z_value);
+	}
+
+	void DSICE_CONFIG_SET_SIGNIFICANCE_TEST(dsice_tuner_id tuner_id, size_t max_repetitions, double significance_level) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setSignificanceTest(max_repetitions, significance_level);
+	}
+
+	void DSICE_CONFIG_SET_LOG_MEMORY_LIMIT(dsice_tuner_id tuner_id, size_t max_in_memory_base_point_num, const char* spill_file_path) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setLogMemoryLimit(max_in_memory_base_point_num, spill_file_path);
+	}
+
+	void DSICE_CONFIG_SET_PRECOMPUTATION(dsice_tuner_id tuner_id, bool precomputation_on) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setPrecomputation(precomputation_on);
+	}
+
+	void DSICE_CONFIG_SET_DEADLINE_FACTOR(dsice_tuner_id tuner_id, double deadline_factor) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setDeadlineFactor(deadline_factor);
+	}
+
+	void DSICE_CONFIG_SET_MULTI_START_NUM(dsice_tuner_id tuner_id, size_t start_num) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setMultiStartNum(start_num);
+	}
+
+	void DSICE_CONFIG_SET_WORKER_NUM(dsice_tuner_id tuner_id, size_t worker_num) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setWorkerNum(worker_num);
+	}
+
+	void DSICE_CONFIG_SET_FULL_SEARCH_FACTOR(dsice_tuner_id tuner_id, size_t factor) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setFullSearchFactor(factor);
+	}
+
+	void DSICE_CONFIG_SET_FULL_SEARCH_PRUNING(dsice_tuner_id tuner_id, double margin) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setFullSearchPruning(margin);
+	}
+
+	void DSICE_CONFIG_SET_THREAD_POOL_SIZE(dsice_tuner_id tuner_id, size_t thread_num) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setThreadPoolSize(thread_num);
+	}
+
+	void DSICE_CONFIG_SET_DIRECTION_SAMPLING(dsice_tuner_id tuner_id, size_t max_changed_axis_num, size_t direction_budget) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setDirectionSampling(max_changed_axis_num, direction_budget);
+	}
+
+	void DSICE_CONFIG_SET_PARAMETER_SCREENING(dsice_tuner_id tuner_id, double threshold) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setParameterScreening(threshold);
+	}
+
+	void DSICE_CONFIG_SET_GRADIENT_STEP(dsice_tuner_id tuner_id, bool gradient_step_on) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setGradientStep(gradient_step_on);
+	}
+
+	void DSICE_CONFIG_SET_SURROGATE(dsice_tuner_id tuner_id, size_t max_pair_num, double skip_confidence) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setSurrogate(max_pair_num, skip_confidence);
+	}
+
+	void DSICE_CONFIG_SET_INITIAL_DESIGN(dsice_tuner_id tuner_id, DSICE_INITIAL_DESIGN_TYPE design_type, size_t point_num, unsigned long long seed) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		switch (design_type) {
+		case DSICE_INITIAL_DESIGN_SIMPLE_LHD:
+			target_tuner->config_setInitialDesign(InitialDesignType::SimpleLhd, point_num, seed);
+			break;
+		case DSICE_INITIAL_DESIGN_MAXIMIN_LHD:
+			target_tuner->config_setInitialDesign(InitialDesignType::MaximinLhd, point_num, seed);
+			break;
+		case DSICE_INITIAL_DESIGN_SOBOL:
+			target_tuner->config_setInitialDesign(InitialDesignType::Sobol, point_num, seed);
+			break;
+		case DSICE_INITIAL_DESIGN_HALTON:
+			target_tuner->config_setInitialDesign(InitialDesignType::Halton, point_num, seed);
+			break;
+		case DSICE_INITIAL_DESIGN_STRATIFIED:
+			target_tuner->config_setInitialDesign(InitialDesignType::Stratified, point_num, seed);
+			break;
 		}
 	}
 
+	void DSICE_CONFIG_SET_MULTI_FIDELITY(dsice_tuner_id tuner_id, size_t fidelity_num, const double* fidelities, size_t eta, size_t initial_num) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		std::vector<double> tmp_fidelities(fidelities, fidelities + fidelity_num);
+
+		target_tuner->config_setMultiFidelity(tmp_fidelities, eta, initial_num);
+	}
+
+	void DSICE_CONFIG_SET_COST_AWARE_ORDERING(dsice_tuner_id tuner_id, size_t window) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setCostAwareOrdering(window);
+	}
+
+	void DSICE_CONFIG_SET_BUDGET(dsice_tuner_id tuner_id, size_t max_measurement_num, double max_time_sec) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->config_setBudget(max_measurement_num, max_time_sec);
+	}
+
 	const double* DSICE_BEGIN(dsice_tuner_id tuner_id) {
 
 		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
@@ -227,6 +393,21 @@ namespace dsice {
 		return suggested_c_buffer.data();
 	}
 
+	const double** DSICE_BEGIN_PARALLEL_K(dsice_tuner_id tuner_id, size_t suggested_num) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+		std::vector<const double*>& suggested_c_buffer = getSuggestBuffer(tuner_id);
+
+		suggested_c_buffer.clear();
+
+		const std::vector<std::vector<double>>& suggested = target_tuner->getSuggestedList(suggested_num);
+		for (std::size_t i = 0; i < suggested.size(); i++) {
+			suggested_c_buffer.push_back(suggested[i].data());
+		}
+
+		return suggested_c_buffer.data();
+	}
+
 	size_t DSICE_GET_SUGGESTED_NUM(dsice_tuner_id tuner_id) {
 		return getSuggestBuffer(tuner_id).size();
 	}
@@ -238,6 +419,34 @@ namespace dsice {
 		target_tuner->setMetricValue(performance_value);
 	}
 
+	double DSICE_GET_DEADLINE(dsice_tuner_id tuner_id) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		return target_tuner->getDeadline();
+	}
+
+	double DSICE_GET_SUGGESTED_FIDELITY(dsice_tuner_id tuner_id) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		return target_tuner->getSuggestedFidelity();
+	}
+
+	bool DSICE_REPORT_PARTIAL(dsice_tuner_id tuner_id, double partial_value) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		return target_tuner->reportPartial(partial_value);
+	}
+
+	void DSICE_END_CENSORED(dsice_tuner_id tuner_id, double bound) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->setCensoredMetricValue(bound);
+	}
+
 	size_t DSICE_GET_PARAM_NUM(dsice_tuner_id tuner_id) {
 		
 		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
@@ -276,6 +485,30 @@ namespace dsice {
 		return buffers.data();
 	}
 
+	double DSICE_PREDICT(dsice_tuner_id tuner_id, const double* parameter) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		std::vector<double> parameter_vec(parameter, parameter + target_tuner->getParametersNum());
+
+		return target_tuner->predict(parameter_vec);
+	}
+
+	void DSICE_PREDICT_BATCH(dsice_tuner_id tuner_id, size_t parameter_num, const double* parameters, double* predicted_values) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+		std::size_t dimension = target_tuner->getParametersNum();
+
+		std::vector<std::vector<double>> parameters_vec;
+		parameters_vec.reserve(parameter_num);
+		for (std::size_t i = 0; i < parameter_num; i++) {
+			parameters_vec.emplace_back(parameters + i * dimension, parameters + (i + 1) * dimension);
+		}
+
+		std::vector<double> values = target_tuner->predictBatch(parameters_vec);
+		std::copy(values.begin(), values.end(), predicted_values);
+	}
+
 	bool DSICE_IS_SEARCH_FINISHED(dsice_tuner_id tuner_id) {
 
 		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
@@ -283,6 +516,41 @@ namespace dsice {
 		return target_tuner->isSearchFinished();
 	}
 
+	size_t DSICE_GET_MEASURED_NUM(dsice_tuner_id tuner_id) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		return target_tuner->getMeasuredNum();
+	}
+
+	size_t DSICE_GET_REMAINING_MEASUREMENT_NUM(dsice_tuner_id tuner_id) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		return target_tuner->getRemainingMeasurementNum();
+	}
+
+	double DSICE_GET_ELAPSED_TIME(dsice_tuner_id tuner_id) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		return target_tuner->getElapsedTime();
+	}
+
+	double DSICE_GET_ESTIMATED_REMAINING_TIME(dsice_tuner_id tuner_id) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		return target_tuner->getEstimatedRemainingTime();
+	}
+
+	double DSICE_GET_EXPECTED_IMPROVEMENT(dsice_tuner_id tuner_id) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		return target_tuner->getExpectedImprovement();
+	}
+
 	void DSICE_END_TIME(dsice_tuner_id tuner_id) {
 
 		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
@@ -302,6 +570,68 @@ namespace dsice {
 		target_tuner->setMetricValuesList(tmp_performances);
 	}
 
+	void DSICE_END_PARALLEL_CENSORED(dsice_tuner_id tuner_id, size_t value_num, const double* performance_value, const bool* censored_flags) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		std::vector<double> tmp_performances;
+		std::vector<bool> tmp_flags;
+		for (std::size_t i = 0; i < value_num; i++) {
+			tmp_performances.push_back(performance_value[i]);
+			tmp_flags.push_back(censored_flags[i]);
+		}
+
+		target_tuner->setMetricValuesList(tmp_performances, tmp_flags);
+	}
+
+	void DSICE_SET_MEASURE_DURATIONS(dsice_tuner_id tuner_id, size_t value_num, const double* durations_sec) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		std::vector<double> tmp_durations(durations_sec, durations_sec + value_num);
+
+		target_tuner->setMeasureDurationsList(tmp_durations);
+	}
+
+	size_t DSICE_ACQUIRE(dsice_tuner_id tuner_id, double* parameter_buffer) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		Ticket<double> ticket = target_tuner->acquire();
+		for (std::size_t i = 0; i < ticket.getParameter().size(); i++) {
+			parameter_buffer[i] = ticket.getParameter()[i];
+		}
+
+		return ticket.getId();
+	}
+
+	size_t DSICE_ACQUIRE_WITH_FIDELITY(dsice_tuner_id tuner_id, double* parameter_buffer, double* fidelity) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		Ticket<double> ticket = target_tuner->acquire();
+		for (std::size_t i = 0; i < ticket.getParameter().size(); i++) {
+			parameter_buffer[i] = ticket.getParameter()[i];
+		}
+		*fidelity = ticket.getFidelity();
+
+		return ticket.getId();
+	}
+
+	void DSICE_COMPLETE(dsice_tuner_id tuner_id, size_t ticket_id, double performance_value) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->complete(ticket_id, performance_value);
+	}
+
+	void DSICE_ABORT(dsice_tuner_id tuner_id, size_t ticket_id, double bound) {
+
+		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
+
+		target_tuner->abort(ticket_id, bound);
+	}
+
 	void DSICE_PRINT_TUNING_RESULT_STD(dsice_tuner_id tuner_id) {
 
 		std::shared_ptr<Tuner<double>> target_tuner = getTuner(tuner_id);
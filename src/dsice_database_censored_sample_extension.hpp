@@ -0,0 +1,29 @@
+﻿#ifndef DSICE_DATABASE_CENSORED_SAMPLE_EXTENSION_HPP_
+#define DSICE_DATABASE_CENSORED_SAMPLE_EXTENSION_HPP_
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_core.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// DSICE のデータベース型に登録された打ち切り標本 (実測を途中で打ち切り，性能評価値の限界値のみが分かっている標本) に関する機能を定義
+	/// </summary>
+	class DatabaseCensoredSampleExtension : virtual public DatabaseCore {
+	public:
+		/// <summary>
+		/// 直近に登録した標本点の性能評価値を，打ち切り時点の限界値として扱うよう設定．<br/>
+		/// 以降に同じ標本点へ通常の性能評価値が登録された場合は解除される
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		virtual void setSampleCensored(const coordinate& target_coordinate) = 0;
+		/// <summary>
+		/// 標本点の性能評価値が打ち切り時点の限界値かどうか
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		/// <returns>打ち切り標本なら true</returns>
+		virtual bool isSampleCensored(const coordinate& target_coordinate) const = 0;
+	};
+}
+
+#endif // !DSICE_DATABASE_CENSORED_SAMPLE_EXTENSION_HPP_
\ No newline at end of file
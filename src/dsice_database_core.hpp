@@ -40,6 +40,11 @@ namespace dsice {
 		/// <returns>登録済標本点の数</returns>
 		virtual std::size_t getExistSamplesNum(void) const = 0;
 		/// <summary>
+		/// 登録済標本点の座標一覧を取得
+		/// </summary>
+		/// <returns>登録済標本点の座標一覧 (順序は不定)</returns>
+		virtual coordinate_list getExistSampleCoordinates(void) const = 0;
+		/// <summary>
 		/// 登録済の標本の性能評価値を取得
 		/// </summary>
 		/// <param name="target_coordinate">取得したい標本データの座標</param>
@@ -9,6 +9,7 @@
 #include "sampling_log.hpp"
 #include "suggest_group_log.hpp"
 #include "base_point_log.hpp"
+#include "measuring_log_iterator.hpp"
 
 namespace dsice {
 
@@ -34,10 +35,21 @@ namespace dsice {
 		/// <returns>実測データの一覧</returns>
 		virtual std::vector<dsice_measure_data> getMeasuredDataLog(void) const = 0;
 		/// <summary>
-		/// 基準点，実測候補，実測データの全ログデータを取得
+		/// 基準点，実測候補，実測データの全ログデータを取得．<br/>
+		/// ファイルに書き出されたログもすべて読み出すため，ログが大きい場合は beginMeasuringLog() による逐次読み出しを推奨
 		/// </summary>
 		/// <returns>全ログデータ</returns>
-		virtual const std::vector<BasePointLog>& getAllMeasuringLog(void) const = 0;
+		virtual std::vector<BasePointLog> getAllMeasuringLog(void) const = 0;
+		/// <summary>
+		/// 全ログデータを古い順に逐次読み出すイテレータの先頭を取得
+		/// </summary>
+		/// <returns>先頭を指すイテレータ</returns>
+		virtual MeasuringLogIterator beginMeasuringLog(void) const = 0;
+		/// <summary>
+		/// 全ログデータを古い順に逐次読み出すイテレータの終端を取得
+		/// </summary>
+		/// <returns>終端を指すイテレータ</returns>
+		virtual MeasuringLogIterator endMeasuringLog(void) const = 0;
 	};
 }
 
@@ -0,0 +1,41 @@
+﻿#ifndef DSICE_DATABASE_MEASURE_DURATION_EXTENSION_HPP_
+#define DSICE_DATABASE_MEASURE_DURATION_EXTENSION_HPP_
+
+#include <cstddef>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_core.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// DSICE のデータベース型に，各標本点の実測に要した時間 (実測コスト) を記録し，未実測点の実測時間を予測する機能を定義
+	/// </summary>
+	class DatabaseMeasureDurationExtension : virtual public DatabaseCore {
+	public:
+		/// <summary>
+		/// 実測時間の対数をとる際の下限 [秒] (0 秒の実測時間を扱うため)
+		/// </summary>
+		static constexpr double MIN_MODELED_DURATION_SEC = 1e-9;
+		/// <summary>
+		/// 標本点の実測に要した時間を登録 (同じ点を複数回登録した場合は平均をとる)
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		/// <param name="duration_sec">実測に要した時間 [秒]</param>
+		virtual void setSampleMeasureDuration(const coordinate& target_coordinate, double duration_sec) = 0;
+		/// <summary>
+		/// 実測時間が登録済の標本点の数を取得
+		/// </summary>
+		/// <returns>実測時間が登録済の標本点の数</returns>
+		virtual std::size_t getMeasureDurationSamplesNum(void) const = 0;
+		/// <summary>
+		/// 指定点の実測時間を予測．<br/>
+		/// 実測時間が登録済の点はその平均を，それ以外の点は登録済の実測時間の対数に当てはめた加法的代理モデルの予測値を返す
+		/// </summary>
+		/// <param name="target_coordinate">予測対象の座標</param>
+		/// <returns>実測時間の予測値 [秒] (実測時間が 1 点も登録されていない場合は 0)</returns>
+		virtual double predictMeasureDuration(const coordinate& target_coordinate) const = 0;
+	};
+}
+
+#endif // !DSICE_DATABASE_MEASURE_DURATION_EXTENSION_HPP_
@@ -8,7 +8,11 @@ namespace dsice {
 	/// </summary>
 	enum class DatabaseMetricType {
 		OverwrittenDouble,
-		AverageDouble
+		AverageDouble,
+		MedianDouble,
+		TrimmedAverageDouble,
+		MinimumDouble,
+		EwmaDouble
 	};
 }
 
@@ -0,0 +1,31 @@
+﻿#ifndef DSICE_DATABASE_SAMPLE_STATISTICS_EXTENSION_HPP_
+#define DSICE_DATABASE_SAMPLE_STATISTICS_EXTENSION_HPP_
+
+#include <cstddef>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_core.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// DSICE のデータベース型に登録された標本点ごとの登録回数と，登録された性能評価値のばらつきに関する機能を定義
+	/// </summary>
+	class DatabaseSampleStatisticsExtension : virtual public DatabaseCore {
+	public:
+		/// <summary>
+		/// 標本点に性能評価値を登録した回数を取得
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		/// <returns>登録回数 (未登録の場合は 0)</returns>
+		virtual std::size_t getSampleRecordedCount(const coordinate& target_coordinate) const = 0;
+		/// <summary>
+		/// 標本点に登録された性能評価値の不偏分散を取得
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		/// <returns>不偏分散．ただし，登録回数が 2 未満の場合や，性能評価値の型が分散を保持しない場合は NaN</returns>
+		virtual double getSampleVariance(const coordinate& target_coordinate) const = 0;
+	};
+}
+
+#endif // !DSICE_DATABASE_SAMPLE_STATISTICS_EXTENSION_HPP_
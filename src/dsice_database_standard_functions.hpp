@@ -4,6 +4,10 @@
 #include "dsice_database_base_point_extension.hpp"
 #include "dsice_database_latest_sample_extension.hpp"
 #include "dsice_database_latest_base_extension.hpp"
+#include "dsice_database_censored_sample_extension.hpp"
+#include "dsice_database_surrogate_extension.hpp"
+#include "dsice_database_measure_duration_extension.hpp"
+#include "dsice_database_sample_statistics_extension.hpp"
 
 namespace dsice {
 
@@ -13,7 +17,11 @@ namespace dsice {
 	class DatabaseStandardFunctions :
 		virtual public DatabaseBasePointExtension,
 		virtual public DatabaseLatestSampleExtension,
-		virtual public DatabaseLatestBaseExtension {};
+		virtual public DatabaseLatestBaseExtension,
+		virtual public DatabaseCensoredSampleExtension,
+		virtual public DatabaseSurrogateExtension,
+		virtual public DatabaseMeasureDurationExtension,
+		virtual public DatabaseSampleStatisticsExtension {};
 }
 
 #endif // !DSICE_DATABASE_STANDARD_FUNCTIONS_HPP_
@@ -0,0 +1,30 @@
+﻿#ifndef DSICE_DATABASE_SURROGATE_EXTENSION_HPP_
+#define DSICE_DATABASE_SURROGATE_EXTENSION_HPP_
+
+#include <cstddef>
+
+#include "additive_surrogate.hpp"
+#include "dsice_database_core.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// DSICE のデータベース型に登録された標本 (打ち切り標本を除く) 全体から推定する代理モデルに関する機能を定義
+	/// </summary>
+	class DatabaseSurrogateExtension : virtual public DatabaseCore {
+	public:
+		/// <summary>
+		/// 登録済の標本に基づく代理モデルを取得．<br/>
+		/// 初めて取得した時点で構築し，以降は標本の登録に合わせて更新される
+		/// </summary>
+		/// <returns>代理モデル</returns>
+		virtual const AdditiveSurrogate& getSurrogate(void) const = 0;
+		/// <summary>
+		/// 代理モデルで交互作用項として採用する性能パラメタ組の最大数を設定 (構築済の代理モデルは破棄される)
+		/// </summary>
+		/// <param name="max_pair_num">性能パラメタ組の最大数</param>
+		virtual void setSurrogatePairNum(std::size_t max_pair_num) = 0;
+	};
+}
+
+#endif // !DSICE_DATABASE_SURROGATE_EXTENSION_HPP_
@@ -1,10 +1,26 @@
 ﻿#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <deque>
 #include <limits>
+#include <stdexcept>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
 
 #include "dsice_metric.hpp"
 #include "overwritten_double.hpp"
 #include "average_double.hpp"
+#include "median_double.hpp"
+#include "trimmed_average_double.hpp"
+#include "minimum_double.hpp"
+#include "ewma_double.hpp"
 #include "dsice_search_space.hpp"
+#include "additive_surrogate.hpp"
+#include "log_spill_file.hpp"
+#include "measuring_log_iterator.hpp"
+#include "copy_on_write.hpp"
 #include "dsice_logging_database.hpp"
 
 namespace dsice {
@@ -12,26 +28,90 @@ namespace dsice {
 	LoggingDatabase::LoggingDatabase(const space_size& search_space, DatabaseMetricType database_metric_type) {
 		this->search_space_size = search_space;
 		this->metric_type = database_metric_type;
-		this->log.emplace_back(coordinate());
+		this->base_points = std::make_shared<std::unordered_map<coordinate, std::unordered_set<DirectionLine>>>();
+		this->censored_samples = std::make_shared<std::unordered_set<coordinate>>();
+		this->log.push_back(std::make_shared<BasePointLog>(coordinate()));
 	}
 
 	LoggingDatabase::LoggingDatabase(const LoggingDatabase& original) {
 
 		this->search_space_size = original.search_space_size;
 
-		for (const std::pair<const coordinate, std::shared_ptr<Metric>>& original_sample : original.samples) {
-			this->samples.emplace(original_sample.first, original_sample.second->makeCopy());
-		}
-
+		// 標本や基準点はコピー元と共有し，どちらかが更新する時点で更新する部分のみ複製する (コピーオンライト)
+		this->samples = original.samples;
 		this->base_points = original.base_points;
+		this->censored_samples = original.censored_samples;
+
+		// 代理モデルは推定済であれば共有する (共有中に遅延再推定が走らないよう，未推定のものは複製する)
+		if (original.surrogate != nullptr) {
+			if (original.surrogate->isOutdated()) {
+				this->surrogate = std::make_shared<AdditiveSurrogate>(*original.surrogate);
+			}
+			else {
+				this->surrogate = original.surrogate;
+			}
+		}
+		this->surrogate_pair_num = original.surrogate_pair_num;
+		this->measure_durations = original.measure_durations;
+		if (original.duration_model != nullptr) {
+			if (original.duration_model->isOutdated()) {
+				this->duration_model = std::make_shared<AdditiveSurrogate>(*original.duration_model);
+			}
+			else {
+				this->duration_model = original.duration_model;
+			}
+		}
+		this->pending_measure_durations = original.pending_measure_durations;
 		this->metric_type = original.metric_type;
 		this->log = original.log;
+		this->max_in_memory_log_num = original.max_in_memory_log_num;
+
+		// 書き出し済ログはコピー元と共有し，以降のログのみ別ファイルに書き出す
+		if (original.spill_file != nullptr) {
+			this->spill_file = std::make_shared<LogSpillFile>(original.spill_file);
+		}
 	}
 
 	LoggingDatabase::~LoggingDatabase(void) {
 		// DO_NOTHING
 	}
 
+	std::unordered_map<coordinate, std::unordered_set<DirectionLine>>& LoggingDatabase::getWritableBasePoints(void) {
+
+		if (isShared(this->base_points)) {
+			this->base_points = std::make_shared<std::unordered_map<coordinate, std::unordered_set<DirectionLine>>>(*this->base_points);
+		}
+
+		return *this->base_points;
+	}
+
+	std::unordered_set<coordinate>& LoggingDatabase::getWritableCensoredSamples(void) {
+
+		if (isShared(this->censored_samples)) {
+			this->censored_samples = std::make_shared<std::unordered_set<coordinate>>(*this->censored_samples);
+		}
+
+		return *this->censored_samples;
+	}
+
+	AdditiveSurrogate& LoggingDatabase::getWritableSurrogate(void) {
+
+		if (isShared(this->surrogate)) {
+			this->surrogate = std::make_shared<AdditiveSurrogate>(*this->surrogate);
+		}
+
+		return *this->surrogate;
+	}
+
+	AdditiveSurrogate& LoggingDatabase::getWritableDurationModel(void) {
+
+		if (isShared(this->duration_model)) {
+			this->duration_model = std::make_shared<AdditiveSurrogate>(*this->duration_model);
+		}
+
+		return *this->duration_model;
+	}
+
 	dimension_size LoggingDatabase::getSpaceDimension(void) const {
 		return this->search_space_size.size();
 	}
@@ -42,16 +122,32 @@ namespace dsice {
 
 	void LoggingDatabase::setSampleMetricValue(const coordinate& target_coordinate, double metric_value) {
 
-		if (this->log.back().getSuggestLogList().size() == 0) {
-			this->log.back().updateCandidateList(coordinate_list());
+		BasePointLog& latest_log = this->getWritableLatestLog();
+		if (latest_log.getSuggestLogList().size() == 0) {
+			latest_log.updateCandidateList(coordinate_list());
+		}
+		if (this->pending_measure_durations.contains(target_coordinate)) {
+			std::chrono::system_clock::time_point measure_end_time = std::chrono::system_clock::now();
+			std::chrono::system_clock::duration measure_duration = std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::duration<double>(this->pending_measure_durations.at(target_coordinate)));
+			latest_log.appendMeasuredData(target_coordinate, metric_value, measure_end_time - measure_duration, measure_end_time);
+			this->pending_measure_durations.erase(target_coordinate);
+		}
+		else {
+			latest_log.appendMeasuredData(target_coordinate, metric_value);
 		}
-		this->log.back().appendMeasuredData(target_coordinate, metric_value);
 
 		this->latest_sample_coordinates.push_back(target_coordinate);
 		this->latest_measured_values.push_back(metric_value);
+		if (this->censored_samples->contains(target_coordinate)) {
+			this->getWritableCensoredSamples().erase(target_coordinate);
+		}
 
 		if (this->samples.contains(target_coordinate)) {
-			this->samples.at(target_coordinate)->setValue(metric_value);
+			std::shared_ptr<Metric>& target_metric = this->samples.getWritable(target_coordinate);
+			if (isShared(target_metric)) {
+				target_metric = target_metric->makeCopy();
+			}
+			target_metric->setValue(metric_value);
 		}
 		else {
 			switch (this->metric_type) {
@@ -61,8 +157,24 @@ namespace dsice {
 			case DatabaseMetricType::AverageDouble:
 				this->samples.emplace(target_coordinate, std::make_shared<AverageDouble>(metric_value));
 				break;
+			case DatabaseMetricType::MedianDouble:
+				this->samples.emplace(target_coordinate, std::make_shared<MedianDouble>(metric_value));
+				break;
+			case DatabaseMetricType::TrimmedAverageDouble:
+				this->samples.emplace(target_coordinate, std::make_shared<TrimmedAverageDouble>(metric_value));
+				break;
+			case DatabaseMetricType::MinimumDouble:
+				this->samples.emplace(target_coordinate, std::make_shared<MinimumDouble>(metric_value));
+				break;
+			case DatabaseMetricType::EwmaDouble:
+				this->samples.emplace(target_coordinate, std::make_shared<EwmaDouble>(metric_value));
+				break;
 			}
 		}
+
+		if (this->surrogate != nullptr) {
+			this->getWritableSurrogate().setSample(target_coordinate, this->samples.at(target_coordinate)->getValue());
+		}
 	}
 
 	bool LoggingDatabase::hasSample(const coordinate& target_coordinate) const {
@@ -73,6 +185,17 @@ namespace dsice {
 		return this->samples.size();
 	}
 
+	coordinate_list LoggingDatabase::getExistSampleCoordinates(void) const {
+
+		coordinate_list sample_coordinates;
+		sample_coordinates.reserve(this->samples.size());
+		for (const std::pair<const coordinate, std::shared_ptr<Metric>>& sample : this->samples) {
+			sample_coordinates.push_back(sample.first);
+		}
+
+		return sample_coordinates;
+	}
+
 	double LoggingDatabase::getSampleMetricValue(const coordinate& target_coordinate) const {
 
 		if (this->samples.contains(target_coordinate)) {
@@ -85,44 +208,41 @@ namespace dsice {
 
 	void LoggingDatabase::setBasePoint(const coordinate& target_coordinate) {
 
-		if (this->log.back().getBasePoint() == target_coordinate) {
+		if (this->log.back()->getBasePoint() == target_coordinate) {
 			this->has_base_coordinate_changed = false;
 			return;
 		}
 
-		this->log.emplace_back(target_coordinate);
+		this->log.push_back(std::make_shared<BasePointLog>(target_coordinate));
 		this->has_base_coordinate_changed = true;
+		this->spillOldLogs();
 		
-		if (!this->base_points.contains(target_coordinate)) {
-			this->base_points.emplace(target_coordinate, std::unordered_set<DirectionLine>());
+		if (!this->base_points->contains(target_coordinate)) {
+			this->getWritableBasePoints().emplace(target_coordinate, std::unordered_set<DirectionLine>());
 		}
 	}
 
 	void LoggingDatabase::updateCandidateList(const coordinate_list candidates_list) {
-		this->log.back().updateCandidateList(candidates_list);
+		this->getWritableLatestLog().updateCandidateList(candidates_list);
 	}
 
 	const std::unordered_map<coordinate, std::unordered_set<DirectionLine>>& LoggingDatabase::getBasePoints(void) const {
-		return this->base_points;
+		return *this->base_points;
 	}
 
 	bool LoggingDatabase::hasBeenBasePoint(const coordinate& target_coordinate) const {
-		return this->base_points.contains(target_coordinate);
+		return this->base_points->contains(target_coordinate);
 	}
 
 	void LoggingDatabase::recordSearchedDirection(const coordinate& base_coordinate, const DirectionLine& line_info) {
 
-		if (!this->base_points.contains(base_coordinate)) {
-			this->base_points.emplace(base_coordinate, std::unordered_set<DirectionLine>());
-		}
-
-		this->base_points.at(base_coordinate).insert(line_info);
+		this->getWritableBasePoints()[base_coordinate].insert(line_info);
 	}
 
 	bool LoggingDatabase::isSearchedDirection(const coordinate& base_coordinate, const DirectionLine& line_info) const {
 
-		if (this->base_points.contains(base_coordinate)) {
-			if (this->base_points.at(base_coordinate).contains(line_info)) {
+		if (this->base_points->contains(base_coordinate)) {
+			if (this->base_points->at(base_coordinate).contains(line_info)) {
 				return true;
 			}
 		}
@@ -144,20 +264,99 @@ namespace dsice {
 	}
 
 	const coordinate& LoggingDatabase::getLatestBaseCoordinate(void) const {
-		return this->log.back().getBasePoint();
+		return this->log.back()->getBasePoint();
 	}
 
 	bool LoggingDatabase::hasBaseCoordinateChanged(void) const {
 		return this->has_base_coordinate_changed;
 	}
 
+	void LoggingDatabase::setSampleCensored(const coordinate& target_coordinate) {
+
+		this->getWritableCensoredSamples().insert(target_coordinate);
+
+		// 限界値は代理モデルの当てはめに使わない
+		if (this->surrogate != nullptr) {
+			this->getWritableSurrogate().removeSample(target_coordinate);
+		}
+	}
+
+	bool LoggingDatabase::isSampleCensored(const coordinate& target_coordinate) const {
+		return this->censored_samples->contains(target_coordinate);
+	}
+
+	const AdditiveSurrogate& LoggingDatabase::getSurrogate(void) const {
+
+		if (this->surrogate == nullptr) {
+			this->surrogate = std::make_shared<AdditiveSurrogate>(this->search_space_size, this->surrogate_pair_num);
+			for (const std::pair<const coordinate, std::shared_ptr<Metric>>& sample : this->samples) {
+				if (!this->censored_samples->contains(sample.first)) {
+					this->surrogate->setSample(sample.first, sample.second->getValue());
+				}
+			}
+		}
+
+		return *this->surrogate;
+	}
+
+	void LoggingDatabase::setSurrogatePairNum(std::size_t max_pair_num) {
+		this->surrogate_pair_num = max_pair_num;
+		this->surrogate = nullptr;
+	}
+
+	void LoggingDatabase::setSampleMeasureDuration(const coordinate& target_coordinate, double duration_sec) {
+
+		if (!(duration_sec >= 0)) {
+			throw std::invalid_argument("duration_sec must be zero or more.");
+		}
+
+		this->pending_measure_durations[target_coordinate] = duration_sec;
+
+		AverageDouble& durations = this->measure_durations[target_coordinate];
+		durations.setValue(duration_sec);
+
+		// 実測時間はパラメタ間で乗法的に効くことが多いため，対数をとって加法モデルに当てはめる
+		if (this->duration_model != nullptr) {
+			this->getWritableDurationModel().setSample(target_coordinate, std::log(std::max(durations.getValue(), MIN_MODELED_DURATION_SEC)));
+		}
+	}
+
+	std::size_t LoggingDatabase::getMeasureDurationSamplesNum(void) const {
+		return this->measure_durations.size();
+	}
+
+	double LoggingDatabase::predictMeasureDuration(const coordinate& target_coordinate) const {
+
+		if (this->measure_durations.empty()) {
+			return 0;
+		}
+
+		if (this->measure_durations.contains(target_coordinate)) {
+			return this->measure_durations.at(target_coordinate).getValue();
+		}
+
+		if (this->duration_model == nullptr) {
+			this->duration_model = std::make_shared<AdditiveSurrogate>(this->search_space_size);
+			for (const std::pair<const coordinate, AverageDouble>& duration : this->measure_durations) {
+				this->duration_model->setSample(duration.first, std::log(std::max(duration.second.getValue(), MIN_MODELED_DURATION_SEC)));
+			}
+		}
+
+		return std::exp(this->duration_model->predict(target_coordinate));
+	}
+
 	coordinate_list LoggingDatabase::getBaseCoordinateListLog(void) const {
 
 		coordinate_list tmp_l;
 
 		// log の最初は未登録状態の場合のダミー基準点だから除外
-		for (std::size_t i = 1; i < this->log.size(); i++) {
-			tmp_l.push_back(this->log[i].getBasePoint());
+		MeasuringLogIterator itr = this->beginMeasuringLog();
+		MeasuringLogIterator end = this->endMeasuringLog();
+		if (itr != end) {
+			++itr;
+		}
+		for (; itr != end; ++itr) {
+			tmp_l.push_back(itr->getBasePoint());
 		}
 
 		return tmp_l;
@@ -167,8 +366,8 @@ namespace dsice {
 
 		std::vector<coordinate_list> tmp_l;
 
-		for (const BasePointLog& b_log : this->log) {
-			for (const SuggestGroupLog& sg_log : b_log.getSuggestLogList()) {
+		for (MeasuringLogIterator itr = this->beginMeasuringLog(); itr != this->endMeasuringLog(); ++itr) {
+			for (const SuggestGroupLog& sg_log : itr->getSuggestLogList()) {
 				tmp_l.push_back(sg_log.getCandidateList());
 			}
 		}
@@ -180,8 +379,8 @@ namespace dsice {
 
 		std::vector<dsice_measure_data> tmp_d;
 
-		for (const BasePointLog& b_log : this->log) {
-			for (const SuggestGroupLog& sg_log : b_log.getSuggestLogList()) {
+		for (MeasuringLogIterator itr = this->beginMeasuringLog(); itr != this->endMeasuringLog(); ++itr) {
+			for (const SuggestGroupLog& sg_log : itr->getSuggestLogList()) {
 				for (const SamplingLog& sl_log : sg_log.getMeasuredDataList()) {
 					tmp_d.emplace_back(sl_log.getSampleCoordinate(), sl_log.getMetricValue());
 				}
@@ -191,7 +390,99 @@ namespace dsice {
 		return tmp_d;
 	}
 
-	const std::vector<BasePointLog>& LoggingDatabase::getAllMeasuringLog(void) const {
-		return this->log;
+	std::vector<BasePointLog> LoggingDatabase::getAllMeasuringLog(void) const {
+
+		std::vector<BasePointLog> tmp_l;
+
+		for (MeasuringLogIterator itr = this->beginMeasuringLog(); itr != this->endMeasuringLog(); ++itr) {
+			tmp_l.push_back(*itr);
+		}
+
+		return tmp_l;
+	}
+
+	MeasuringLogIterator LoggingDatabase::beginMeasuringLog(void) const {
+
+		if (this->spill_file == nullptr) {
+			return MeasuringLogIterator(std::vector<std::pair<std::string, std::size_t>>(), this->log);
+		}
+		else {
+			return MeasuringLogIterator(this->spill_file->getSpilledSegments(), this->log);
+		}
+	}
+
+	MeasuringLogIterator LoggingDatabase::endMeasuringLog(void) const {
+
+		if (this->spill_file == nullptr) {
+			return MeasuringLogIterator(0, this->log);
+		}
+		else {
+			return MeasuringLogIterator(this->spill_file->getSpilledNum(), this->log);
+		}
+	}
+
+	void LoggingDatabase::setLogSpill(std::size_t max_in_memory_base_point_num, const std::string& spill_file_path) {
+
+		if (max_in_memory_base_point_num == 0) {
+			throw std::invalid_argument("max_in_memory_base_point_num must be 1 or more");
+		}
+
+		this->max_in_memory_log_num = max_in_memory_base_point_num;
+		this->spill_file = std::make_shared<LogSpillFile>(spill_file_path);
+
+		this->spillOldLogs();
+	}
+
+	BasePointLog& LoggingDatabase::getWritableLatestLog(void) {
+
+		if (isShared(this->log.back())) {
+			this->log.back() = std::make_shared<BasePointLog>(*this->log.back());
+		}
+
+		return *this->log.back();
+	}
+
+	void LoggingDatabase::spillOldLogs(void) {
+
+		if (this->spill_file == nullptr) {
+			return;
+		}
+
+		// 末尾は記録中のため必ずメモリ上に残す
+		while (this->log.size() > this->max_in_memory_log_num) {
+			this->spill_file->append(*this->log.front());
+			this->log.pop_front();
+		}
+	}
+
+	std::size_t LoggingDatabase::getSampleRecordedCount(const coordinate& target_coordinate) const {
+
+		if (this->samples.contains(target_coordinate)) {
+			return this->samples.at(target_coordinate)->getRecordedCount();
+		}
+		else {
+			return 0;
+		}
+	}
+
+	double LoggingDatabase::getSampleVariance(const coordinate& target_coordinate) const {
+
+		// 分散を保持するのは平均，中央値，両端を除いた平均をとる型のみ
+		if (this->samples.contains(target_coordinate) && this->samples.at(target_coordinate)->getRecordedCount() >= 2) {
+
+			std::shared_ptr<const Metric> sample = this->samples.at(target_coordinate);
+
+			if (std::shared_ptr<const AverageDouble> average = std::dynamic_pointer_cast<const AverageDouble>(sample)) {
+				return average->getVariance();
+			}
+			if (std::shared_ptr<const MedianDouble> median = std::dynamic_pointer_cast<const MedianDouble>(sample)) {
+				return median->getVariance();
+			}
+			if (std::shared_ptr<const TrimmedAverageDouble> trimmed = std::dynamic_pointer_cast<const TrimmedAverageDouble>(sample)) {
+				return trimmed->getVariance();
+			}
+		}
+
+		return std::numeric_limits<double>::quiet_NaN();
 	}
 }
\ No newline at end of file
@@ -2,15 +2,22 @@
 #define DSICE_LOGGING_DATABASE_HPP_
 
 #include <memory>
+#include <string>
 #include <vector>
+#include <deque>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "dsice_search_space.hpp"
+#include "additive_surrogate.hpp"
+#include "shared_shard_map.hpp"
+#include "average_double.hpp"
 #include "dsice_database_logging_extension.hpp"
 #include "sampling_log.hpp"
 #include "suggest_group_log.hpp"
 #include "base_point_log.hpp"
+#include "log_spill_file.hpp"
+#include "measuring_log_iterator.hpp"
 
 namespace dsice {
 
@@ -24,21 +31,56 @@ namespace dsice {
 		/// </summary>
 		space_size search_space_size;
 		/// <summary>
-		/// 実測標本データ
+		/// 実測標本データ (コピー元と区画単位で共有し，更新する区画のみ複製)
 		/// </summary>
-		std::unordered_map<coordinate, std::shared_ptr<Metric>> samples;
+		SharedShardMap<coordinate, std::shared_ptr<Metric>> samples;
 		/// <summary>
-		/// 探索時の基準点データ (基準点と探索済方向の組)
+		/// 探索時の基準点データ (基準点と探索済方向の組，コピー元と共有し更新時に複製)
 		/// </summary>
-		std::unordered_map<coordinate, std::unordered_set<DirectionLine>> base_points;
+		std::shared_ptr<std::unordered_map<coordinate, std::unordered_set<DirectionLine>>> base_points;
+		/// <summary>
+		/// 性能評価値が打ち切り時点の限界値である標本点 (コピー元と共有し更新時に複製)
+		/// </summary>
+		std::shared_ptr<std::unordered_set<coordinate>> censored_samples;
+		/// <summary>
+		/// 打ち切り標本を除く標本から推定する代理モデル (初めて取得されるまでは nullptr)．<br/>
+		/// 推定済のものに限りコピー元と共有し，標本の更新時に複製する
+		/// </summary>
+		mutable std::shared_ptr<AdditiveSurrogate> surrogate;
+		/// <summary>
+		/// 代理モデルで交互作用項として採用する性能パラメタ組の最大数
+		/// </summary>
+		std::size_t surrogate_pair_num = 0;
+		/// <summary>
+		/// 各標本点の実測に要した時間 [秒] (コピー元と区画単位で共有し，更新する区画のみ複製)
+		/// </summary>
+		SharedShardMap<coordinate, AverageDouble> measure_durations;
+		/// <summary>
+		/// 実測時間の対数から推定する代理モデル (初めて予測されるまでは nullptr)．<br/>
+		/// 推定済のものに限りコピー元と共有し，実測時間の更新時に複製する
+		/// </summary>
+		mutable std::shared_ptr<AdditiveSurrogate> duration_model;
+		/// <summary>
+		/// 性能評価値より先に実測時間が登録された標本点とその実測時間 (ログの実測開始時刻の算出に用いる)
+		/// </summary>
+		std::unordered_map<coordinate, double> pending_measure_durations;
 		/// <summary>
 		/// データベース内部で性能評価値を保持する際の型
 		/// </summary>
 		DatabaseMetricType metric_type = DatabaseMetricType::AverageDouble;
 		/// <summary>
-		/// 実測のログ．コンストラクタでダミー基準点を保持
+		/// メモリ上に保持する実測のログ．コンストラクタでダミー基準点を保持．<br/>
+		/// 記録済の基準点ログはコピー元と共有し，記録中の末尾のみ更新時に複製する
+		/// </summary>
+		std::deque<std::shared_ptr<BasePointLog>> log;
+		/// <summary>
+		/// メモリ上に保持する探索基準点ログの最大数 (0 なら無制限)
 		/// </summary>
-		std::vector<BasePointLog> log;
+		std::size_t max_in_memory_log_num = 0;
+		/// <summary>
+		/// メモリ上から追い出したログの書き出し先 (書き出さない場合は nullptr)
+		/// </summary>
+		std::shared_ptr<LogSpillFile> spill_file = nullptr;
 		/// <summary>
 		/// 直近で基準点が登録された際，異なる基準点になったかどうか
 		/// </summary>
@@ -51,6 +93,35 @@ namespace dsice {
 		/// 直近ループで登録された性能評価値一覧 (※ 標本登録なしで基準点移動が繰り返されると逆順走査のコストが大きくなるため，ログと重複して持つ)
 		/// </summary>
 		std::vector<double> latest_measured_values;
+		/// <summary>
+		/// メモリ上のログが上限を超えている場合，古いものからファイルへ書き出す
+		/// </summary>
+		void spillOldLogs(void);
+		/// <summary>
+		/// 記録中の (末尾の) 基準点ログを更新用に取得．コピー元と共有している場合は複製してから返す
+		/// </summary>
+		/// <returns>記録中の基準点ログ</returns>
+		BasePointLog& getWritableLatestLog(void);
+		/// <summary>
+		/// 基準点データを更新用に取得．コピー元と共有している場合は複製してから返す
+		/// </summary>
+		/// <returns>基準点データ</returns>
+		std::unordered_map<coordinate, std::unordered_set<DirectionLine>>& getWritableBasePoints(void);
+		/// <summary>
+		/// 打ち切り標本点の一覧を更新用に取得．コピー元と共有している場合は複製してから返す
+		/// </summary>
+		/// <returns>打ち切り標本点の一覧</returns>
+		std::unordered_set<coordinate>& getWritableCensoredSamples(void);
+		/// <summary>
+		/// 代理モデルを更新用に取得 (推定済であることが前提)．コピー元と共有している場合は複製してから返す
+		/// </summary>
+		/// <returns>代理モデル</returns>
+		AdditiveSurrogate& getWritableSurrogate(void);
+		/// <summary>
+		/// 実測時間の代理モデルを更新用に取得 (推定済であることが前提)．コピー元と共有している場合は複製してから返す
+		/// </summary>
+		/// <returns>実測時間の代理モデル</returns>
+		AdditiveSurrogate& getWritableDurationModel(void);
 	public:
 		/// <summary>
 		/// コンストラクタ
@@ -96,6 +167,11 @@ namespace dsice {
 		/// <returns>登録済標本点の数</returns>
 		std::size_t getExistSamplesNum(void) const override;
 		/// <summary>
+		/// 登録済標本点の座標一覧を取得
+		/// </summary>
+		/// <returns>登録済標本点の座標一覧 (順序は不定)</returns>
+		coordinate_list getExistSampleCoordinates(void) const override;
+		/// <summary>
 		/// 登録済の標本の性能評価値を取得
 		/// </summary>
 		/// <param name="target_coordinate">取得したい標本データの座標</param>
@@ -161,6 +237,59 @@ namespace dsice {
 		/// <returns>変化した (直近基準点がその前の基準点と異なる座標の) 場合は true</returns>
 		bool hasBaseCoordinateChanged(void) const override;
 		/// <summary>
+		/// 直近に登録した標本点の性能評価値を，打ち切り時点の限界値として扱うよう設定
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		void setSampleCensored(const coordinate& target_coordinate) override;
+		/// <summary>
+		/// 標本点の性能評価値が打ち切り時点の限界値かどうか
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		/// <returns>打ち切り標本なら true</returns>
+		bool isSampleCensored(const coordinate& target_coordinate) const override;
+		/// <summary>
+		/// 登録済の標本に基づく代理モデルを取得．<br/>
+		/// 初めて取得した時点で構築し，以降は標本の登録に合わせて更新される
+		/// </summary>
+		/// <returns>代理モデル</returns>
+		const AdditiveSurrogate& getSurrogate(void) const override;
+		/// <summary>
+		/// 代理モデルで交互作用項として採用する性能パラメタ組の最大数を設定 (構築済の代理モデルは破棄される)
+		/// </summary>
+		/// <param name="max_pair_num">性能パラメタ組の最大数</param>
+		void setSurrogatePairNum(std::size_t max_pair_num) override;
+		/// <summary>
+		/// 標本点の実測に要した時間を登録 (同じ点を複数回登録した場合は平均をとる)．<br/>
+		/// 直後に登録される同じ点の性能評価値のログには，この時間から逆算した実測開始時刻を記録する
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		/// <param name="duration_sec">実測に要した時間 [秒]</param>
+		void setSampleMeasureDuration(const coordinate& target_coordinate, double duration_sec) override;
+		/// <summary>
+		/// 実測時間が登録済の標本点の数を取得
+		/// </summary>
+		/// <returns>実測時間が登録済の標本点の数</returns>
+		std::size_t getMeasureDurationSamplesNum(void) const override;
+		/// <summary>
+		/// 指定点の実測時間を予測．<br/>
+		/// 実測時間が登録済の点はその平均を，それ以外の点は登録済の実測時間の対数に当てはめた加法的代理モデルの予測値を返す
+		/// </summary>
+		/// <param name="target_coordinate">予測対象の座標</param>
+		/// <returns>実測時間の予測値 [秒] (実測時間が 1 点も登録されていない場合は 0)</returns>
+		double predictMeasureDuration(const coordinate& target_coordinate) const override;
+		/// <summary>
+		/// 標本点に性能評価値を登録した回数を取得
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		/// <returns>登録回数 (未登録の場合は 0)</returns>
+		std::size_t getSampleRecordedCount(const coordinate& target_coordinate) const override;
+		/// <summary>
+		/// 標本点に登録された性能評価値の不偏分散を取得
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		/// <returns>不偏分散．ただし，登録回数が 2 未満の場合や，性能評価値の型が AverageDouble 以外の場合は NaN</returns>
+		double getSampleVariance(const coordinate& target_coordinate) const override;
+		/// <summary>
 		/// 歴代探索基準点の一覧を取得
 		/// </summary>
 		/// <returns>歴代探索基準点の一覧</returns>
@@ -179,7 +308,24 @@ namespace dsice {
 		/// 基準点，実測候補，実測データの全ログデータを取得
 		/// </summary>
 		/// <returns>全ログデータ</returns>
-		const std::vector<BasePointLog>& getAllMeasuringLog(void) const override;
+		std::vector<BasePointLog> getAllMeasuringLog(void) const override;
+		/// <summary>
+		/// 全ログデータを古い順に逐次読み出すイテレータの先頭を取得
+		/// </summary>
+		/// <returns>先頭を指すイテレータ</returns>
+		MeasuringLogIterator beginMeasuringLog(void) const override;
+		/// <summary>
+		/// 全ログデータを古い順に逐次読み出すイテレータの終端を取得
+		/// </summary>
+		/// <returns>終端を指すイテレータ</returns>
+		MeasuringLogIterator endMeasuringLog(void) const override;
+		/// <summary>
+		/// メモリ上に保持するログの上限を設定し，超えた分を古い順にファイルへ書き出すようにする．<br/>
+		/// 書き出されたログは差分符号化・可変長整数で圧縮され，beginMeasuringLog() で逐次読み出される
+		/// </summary>
+		/// <param name="max_in_memory_base_point_num">メモリ上に保持する探索基準点ログの最大数 (1 以上)</param>
+		/// <param name="spill_file_path">書き出し先ファイルのパス</param>
+		void setLogSpill(std::size_t max_in_memory_base_point_num, const std::string& spill_file_path);
 	};
 }
 
@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include <ios>
+#include <unordered_set>
 
 #include "dsice_database_core.hpp"
 
@@ -48,16 +49,50 @@ namespace dsice {
 		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
 		virtual const coordinate_list& getSuggestedList(void) = 0;
 		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを，指定した座標を除いて指定件数で取得．<br/>
+		/// 並列実測に対応しない探索機構では引数を無視し，getSuggestedList() と同じリストを返します．
+		/// </summary>
+		/// <param name="suggested_num">取得する候補数</param>
+		/// <param name="excluded_coordinates">除外する座標 (実測中の点など)</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		virtual const coordinate_list& getSuggestedList(std::size_t suggested_num, const std::unordered_set<coordinate>& excluded_coordinates) = 0;
+		/// <summary>
 		/// 実測データを記録
 		/// </summary>
 		/// <param name="measured_coordinate">実測した座標</param>
 		/// <param name="metric_value">実測した値</param>
 		virtual void setMetricValue(const coordinate& measured_coordinate, double metric_value) = 0;
 		/// <summary>
+		/// 実測データをデータベースにのみ記録 (探索機構には渡さない)．<br/>
+		/// 同じ点を繰り返し実測する間に用い，実測を終えた時点で commitMetricValue() によりデータベースの集計値を探索機構に渡します．
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		virtual void recordMetricValue(const coordinate& measured_coordinate, double metric_value) = 0;
+		/// <summary>
+		/// データベースで集計済の性能評価値を探索機構に渡す
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		virtual void commitMetricValue(const coordinate& measured_coordinate) = 0;
+		/// <summary>
+		/// 実測を途中で打ち切ったデータを記録 (性能評価値は打ち切り時点の限界値で，実際はこれより悪い)
+		/// </summary>
+		/// <param name="measured_coordinate">実測を打ち切った座標</param>
+		/// <param name="bound">打ち切り時点の限界値</param>
+		virtual void setCensoredMetricValue(const coordinate& measured_coordinate, double bound) = 0;
+		/// <summary>
 		/// 状態を更新
 		/// </summary>
 		virtual void updateState(void) = 0;
 		/// <summary>
+		/// 残りの実測予算を設定．<br/>
+		/// 予算に応じた計画を行わない探索機構では何もしません．
+		/// </summary>
+		/// <param name="remaining_num">残りの実測数</param>
+		virtual void setRemainingBudget([[maybe_unused]] std::size_t remaining_num) {
+			// DO_NOTHING
+		}
+		/// <summary>
 		/// 探索アルゴリズムが終了条件を満たしたかを取得．<br/>
 		/// 終了条件を持たない探索アルゴリズムの場合，この関数の挙動は各実装クラス依存です．
 		/// </summary>
@@ -1,6 +1,12 @@
 ﻿#include <memory>
 #include <limits>
 #include <string>
+#include <unordered_set>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <unordered_map>
+#include <future>
 
 #include "dsice_search_space.hpp"
 #include "direction_line.hpp"
@@ -8,27 +14,48 @@
 #include "dsice_standard_database.hpp"
 #include "dsice_logging_database.hpp"
 #include "simple_lhd_searcher.hpp"
+#include "dsice_database_base_point_extension.hpp"
+#include "one_dim_dsp_searcher.hpp"
 #include "radial_dsp_searcher.hpp"
+#include "parameter_screening_searcher.hpp"
+#include "around_points.hpp"
 #include "uni_measurer.hpp"
+#include "welch_test_measurer.hpp"
+#include "dsice_thread_pool.hpp"
+#include "initial_design.hpp"
+#include "direction_sampler.hpp"
+#include "additive_surrogate.hpp"
 #include "dsice_operator_p_2024b.hpp"
 
 namespace dsice {
 
-	Operator_P_2024B::Operator_P_2024B(const space_size& parameters, bool low_value_is_better, bool logging_on, OperatorInitializeWay initialize_way, double alpha, DatabaseMetricType metric_type, coordinate initial_coordinate) {
+	Operator_P_2024B::Operator_P_2024B(const space_size& parameters, const ParallelOperatorOptions& options) {
 
 		if (parameters.empty()) {
 			throw std::invalid_argument("need one parameter at least.");
 		}
 		
-		this->lower_is_better = low_value_is_better;
-		this->is_logging_mode_on = logging_on;
-		this->dsp_alpha = alpha;
+		this->lower_is_better = options.lower_is_better;
+		this->is_logging_mode_on = options.logging_on;
+		this->dsp_alpha = options.alpha;
+		this->worker_num = options.worker_num;
+		this->thread_pool = options.thread_pool;
+		this->significance_test_repetitions = options.significance_test_repetitions;
+		this->significance_level = options.significance_level;
+		this->is_precomputation_on = options.precomputation_on;
+		this->screening_threshold = options.screening_threshold;
+		this->is_gradient_step_on = options.gradient_step_on;
+		this->surrogate_skip_confidence = options.surrogate_skip_confidence;
+
+		if (options.sampled_max_changed_axis_num > 0) {
+			this->direction_sampler = std::make_shared<DirectionSampler>(parameters, options.sampled_max_changed_axis_num, options.sampled_direction_budget);
+		}
 
 		if (this->is_logging_mode_on) {
-			this->database = std::make_shared<LoggingDatabase>(parameters, metric_type);
+			this->database = std::make_shared<LoggingDatabase>(parameters, options.metric_type);
 		}
 		else {
-			this->database = std::make_shared<StandardDatabase>(parameters, metric_type);
+			this->database = std::make_shared<StandardDatabase>(parameters, options.metric_type);
 		}
 
 		if (this->lower_is_better) {
@@ -38,12 +65,21 @@ namespace dsice {
 			this->base_value = std::numeric_limits<double>::lowest();
 		}
 
-		switch (initialize_way) {
+		switch (options.initialize_way) {
 		case OperatorInitializeWay::SPECIFIED:
-			this->base_coordinate = initial_coordinate;
+			this->base_coordinate = options.initial_coordinate;
 			this->database->setBasePoint(this->base_coordinate);
 
-			this->searcher = std::make_shared<RadialDspSearcher>(this->database, this->base_coordinate, this->database->getSpaceDimension(), this->lower_is_better, this->dsp_alpha);
+			if (this->screening_threshold > 0) {
+				this->startScreening();
+				break;
+			}
+			if (this->is_gradient_step_on) {
+				this->startAxisSearch();
+				break;
+			}
+
+			this->searcher = this->buildRadialSearcher(this->base_coordinate);
 			this->searching_phase = 1;
 			if (this->is_logging_mode_on) {
 				std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
@@ -51,7 +87,12 @@ namespace dsice {
 			}
 			break;
 		case OperatorInitializeWay::INITIAL_SEARCH:
-			this->searcher = std::make_shared<SimpleLhdSearcher>(this->database, this->lower_is_better);
+			if (options.initial_design != nullptr) {
+				this->searcher = std::make_shared<SimpleLhdSearcher>(this->database, options.initial_design->generate(*this->database, this->thread_pool), this->lower_is_better);
+			}
+			else {
+				this->searcher = std::make_shared<SimpleLhdSearcher>(this->database, this->lower_is_better);
+			}
 
 			this->base_coordinate = this->searcher->getSuggested();
 			this->database->setBasePoint(this->base_coordinate);
@@ -74,7 +115,16 @@ namespace dsice {
 			this->base_coordinate = center_point;
 			this->database->setBasePoint(this->base_coordinate);
 
-			this->searcher = std::make_shared<RadialDspSearcher>(this->database, this->base_coordinate, this->database->getSpaceDimension(), this->lower_is_better, this->dsp_alpha);
+			if (this->screening_threshold > 0) {
+				this->startScreening();
+				break;
+			}
+			if (this->is_gradient_step_on) {
+				this->startAxisSearch();
+				break;
+			}
+
+			this->searcher = this->buildRadialSearcher(this->base_coordinate);
 			this->searching_phase = 1;
 			if (this->is_logging_mode_on) {
 				std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
@@ -90,9 +140,26 @@ namespace dsice {
 		this->lower_is_better = original.lower_is_better;
 		this->is_logging_mode_on = original.is_logging_mode_on;
 		this->dsp_alpha = original.dsp_alpha;
+		this->worker_num = original.worker_num;
+		this->thread_pool = original.thread_pool;
+		if (original.direction_sampler != nullptr) {
+			this->direction_sampler = std::make_shared<DirectionSampler>(*original.direction_sampler);
+		}
 		this->base_coordinate = original.base_coordinate;
 		this->base_value = original.base_value;
 		this->loop_count = original.loop_count;
+		this->significance_test_repetitions = original.significance_test_repetitions;
+		this->significance_level = original.significance_level;
+		this->fixed_width_suggested_list = original.fixed_width_suggested_list;
+		this->is_precomputation_on = original.is_precomputation_on;
+		this->screening_threshold = original.screening_threshold;
+		this->is_gradient_step_on = original.is_gradient_step_on;
+		this->axis_best_coordinate = original.axis_best_coordinate;
+		this->is_radial_fan_skipped = original.is_radial_fan_skipped;
+		this->surrogate_skip_confidence = original.surrogate_skip_confidence;
+		this->remaining_budget = original.remaining_budget;
+
+		// 先読み中の探索機構はコピー元のデータベースを参照するため引き継がない
 
 		if (std::shared_ptr<StandardDatabase> sd = std::dynamic_pointer_cast<StandardDatabase>(original.database)) {
 			this->database = std::make_shared<StandardDatabase>(*sd);
@@ -100,22 +167,39 @@ namespace dsice {
 		else {
 			this->database = std::make_shared<LoggingDatabase>(*(std::dynamic_pointer_cast<LoggingDatabase>(original.database)));
 		}
+		if (original.skipped_database != nullptr) {
+			this->skipped_database = std::make_shared<SkippedSampleDatabase>(*original.skipped_database, this->database);
+		}
 
 		switch (this->searching_phase) {
 		case 0:
 			this->searcher = std::make_shared<SimpleLhdSearcher>(*(std::dynamic_pointer_cast<SimpleLhdSearcher>(original.searcher)));
 			break;
 		case 1:
-			this->searcher = std::make_shared<RadialDspSearcher>(*(std::dynamic_pointer_cast<RadialDspSearcher>(original.searcher)));
+		case 5:
+		case 6:
+			// 放射状探索は実測を省略した点の覆いを通してデータベースを参照する
+			if (this->skipped_database != nullptr) {
+				this->searcher = std::make_shared<RadialDspSearcher>(*(std::dynamic_pointer_cast<RadialDspSearcher>(original.searcher)), this->skipped_database);
+			}
+			else {
+				this->searcher = std::make_shared<RadialDspSearcher>(*(std::dynamic_pointer_cast<RadialDspSearcher>(original.searcher)), this->database);
+			}
 			break;
 		case 2:
 			this->searcher = std::make_shared<UniMeasurer>(*(std::dynamic_pointer_cast<UniMeasurer>(original.searcher)));
 			break;
+		case 3:
+			this->searcher = std::make_shared<WelchTestMeasurer>(*(std::dynamic_pointer_cast<WelchTestMeasurer>(original.searcher)));
+			break;
+		case 4:
+			this->searcher = std::make_shared<ParameterScreeningSearcher>(*(std::dynamic_pointer_cast<ParameterScreeningSearcher>(original.searcher)), this->database);
+			break;
 		}
 	}
 
 	Operator_P_2024B::~Operator_P_2024B(void) {
-		// DO_NOTHING
+		this->waitPrecomputation();
 	}
 
 	const coordinate& Operator_P_2024B::getBaseCoordinate(void) const {
@@ -136,19 +220,164 @@ namespace dsice {
 		return this->searcher->getSuggestedList();
 	}
 
+	const coordinate_list& Operator_P_2024B::getSuggestedList(std::size_t suggested_num) {
+		return this->getSuggestedList(suggested_num, std::unordered_set<coordinate>());
+	}
+
+	const coordinate_list& Operator_P_2024B::getSuggestedList(std::size_t suggested_num, const std::unordered_set<coordinate>& excluded_coordinates) {
+
+		this->updateState();
+
+		this->fixed_width_suggested_list.clear();
+		std::unordered_set<coordinate> listed = excluded_coordinates;
+
+		std::shared_ptr<RadialDspSearcher> radial_searcher = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher);
+		if (radial_searcher != nullptr) {
+
+			// 放射状探索中は全体のリストを作らずにキューの先頭から必要数だけ取り出す (実測中の点は除く)
+			this->fixed_width_suggested_list = radial_searcher->getSuggestedList(suggested_num, excluded_coordinates);
+			listed.insert(this->fixed_width_suggested_list.begin(), this->fixed_width_suggested_list.end());
+		}
+		else {
+			for (const coordinate& c : this->searcher->getSuggestedList()) {
+				if (this->fixed_width_suggested_list.size() >= suggested_num) {
+					break;
+				}
+				if (listed.insert(c).second) {
+					this->fixed_width_suggested_list.push_back(c);
+				}
+			}
+		}
+
+		// 探索終了後は投機的に実測する意味がない
+		if (this->fixed_width_suggested_list.size() >= suggested_num || this->searching_phase == 2) {
+			return this->fixed_width_suggested_list;
+		}
+
+		if (radial_searcher != nullptr) {
+
+			// 放射状探索中は直線上の点，次の基準点の隣接点，基準点の周辺点の順で補う
+			coordinate_list speculative = radial_searcher->getSpeculativeCandidates(listed, suggested_num - this->fixed_width_suggested_list.size());
+			std::erase_if(speculative, [this](const coordinate& c) { return this->isConfidentlyWorse(c); });
+			this->fixed_width_suggested_list.insert(this->fixed_width_suggested_list.end(), speculative.begin(), speculative.end());
+		}
+		else {
+
+			// 初期探索中や性能パラメタの選別中，有意差検定中は基準点の周辺点で補う
+			std::size_t around_axis_num = this->direction_sampler != nullptr ? this->direction_sampler->getMaxChangedAxisNum() : this->database->getSpaceDimension();
+			AroundPoints base_around(this->database->getSpaceSize(), this->base_coordinate, around_axis_num);
+			for (const coordinate& c : base_around.getAroundPoints()) {
+				if (this->fixed_width_suggested_list.size() >= suggested_num) {
+					break;
+				}
+				if (!this->database->hasSample(c) && listed.insert(c).second) {
+					this->fixed_width_suggested_list.push_back(c);
+				}
+			}
+		}
+
+		return this->fixed_width_suggested_list;
+	}
+
 	void Operator_P_2024B::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
-		this->database->setSampleMetricValue(measured_coordinate, metric_value);
+		this->recordMetricValue(measured_coordinate, metric_value);
 		this->searcher->setMetricValue(measured_coordinate, metric_value);
 	}
 
+	void Operator_P_2024B::recordMetricValue(const coordinate& measured_coordinate, double metric_value) {
+
+		if (this->precomputed_searcher.valid()) {
+
+			this->waitPrecomputation();
+
+			// 先読み時に読んだ値が変わる場合は，後から反映しても新規に構築した場合と一致しない
+			if (this->database->hasSample(measured_coordinate)) {
+				this->is_precomputation_outdated = true;
+			}
+			this->precomputation_pending_coordinates.push_back(measured_coordinate);
+		}
+
+		this->database->setSampleMetricValue(measured_coordinate, metric_value);
+	}
+
+	void Operator_P_2024B::commitMetricValue(const coordinate& measured_coordinate) {
+		this->searcher->setMetricValue(measured_coordinate, this->database->getSampleMetricValue(measured_coordinate));
+	}
+
+	void Operator_P_2024B::setCensoredMetricValue(const coordinate& measured_coordinate, double bound) {
+		this->setMetricValue(measured_coordinate, bound);
+		this->database->setSampleCensored(measured_coordinate);
+	}
+
 	void Operator_P_2024B::updateState(void) {
 
+		this->updateSearcherState();
+
+		// 省略した候補の打ち切り値を反映すると次の候補が現れるため，省略する候補がなくなるまで繰り返す
+		while (this->skipConfidentlyWorse()) {
+			this->updateSearcherState();
+		}
+	}
+
+	bool Operator_P_2024B::isConfidentlyWorse(const coordinate& target_coordinate) const {
+
+		if (this->surrogate_skip_confidence <= 0 || target_coordinate == this->base_coordinate) {
+			return false;
+		}
+
+		const AdditiveSurrogate& surrogate = this->database->getSurrogate();
+		double margin = this->surrogate_skip_confidence * surrogate.getResidualDeviation();
+		if (!std::isfinite(margin)) {
+			return false;
+		}
+
+		if (this->lower_is_better) {
+			return surrogate.predict(target_coordinate) - margin > this->base_value;
+		}
+		else {
+			return surrogate.predict(target_coordinate) + margin < this->base_value;
+		}
+	}
+
+	bool Operator_P_2024B::skipConfidentlyWorse(void) {
+
+		// 直線探索中のみ省略する (初期探索や選別，有意差検定の実測は省略しない)
+		if (this->skipped_database == nullptr || (this->searching_phase != 1 && this->searching_phase != 5 && this->searching_phase != 6)) {
+			return false;
+		}
+
+		const AdditiveSurrogate& surrogate = this->database->getSurrogate();
+		double margin = this->surrogate_skip_confidence * surrogate.getResidualDeviation();
+
+		// 判定中に探索機構の候補リストが変わらないよう，判定を終えてからまとめて渡す
+		coordinate_list skipped_coordinates;
+		std::vector<double> skipped_bounds;
+		for (const coordinate& c : this->searcher->getSuggestedList()) {
+			if (!this->skipped_database->hasSample(c) && this->isConfidentlyWorse(c)) {
+				skipped_coordinates.push_back(c);
+				skipped_bounds.push_back(this->lower_is_better ? surrogate.predict(c) - margin : surrogate.predict(c) + margin);
+			}
+		}
+
+		// 実測値ではないためデータベースには登録せず，実行中の直線探索にのみ打ち切り標本として見せる
+		for (std::size_t i = 0; i < skipped_coordinates.size(); i++) {
+			this->skipped_database->setSkippedSample(skipped_coordinates[i], skipped_bounds[i]);
+			this->searcher->setMetricValue(skipped_coordinates[i], skipped_bounds[i]);
+		}
+
+		return !skipped_coordinates.empty();
+	}
+
+	void Operator_P_2024B::updateSearcherState(void) {
+
 		bool searcher_updated = this->searcher->updateState();
 
 		if (!searcher_updated) {
 			return;
 		}
 
+		this->waitPrecomputation();
+
 		this->loop_count++;
 		
 		if (this->is_logging_mode_on) {
@@ -165,7 +394,16 @@ namespace dsice {
 				this->database->setBasePoint(this->base_coordinate);
 				this->base_value = this->database->getSampleMetricValue(this->base_coordinate);
 
-				this->searcher = std::make_shared<RadialDspSearcher>(this->database, this->base_coordinate, this->database->getSpaceDimension(), this->lower_is_better, this->dsp_alpha);
+				if (this->screening_threshold > 0) {
+					this->startScreening();
+					break;
+				}
+				if (this->is_gradient_step_on) {
+					this->startAxisSearch();
+					break;
+				}
+
+				this->searcher = this->buildRadialSearcher(this->base_coordinate);
 				this->searching_phase = 1;
 				if (this->is_logging_mode_on) {
 					std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
@@ -180,83 +418,617 @@ namespace dsice {
 						this->database->recordSearchedDirection(this->base_coordinate, direction);
 					}
 
-					this->searcher = std::make_shared<UniMeasurer>(this->base_coordinate);
-					this->searching_phase = 2;
-					if (this->is_logging_mode_on) {
-						std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
-						ld->updateCandidateList(this->searcher->getSuggestedList());
-					}
+					this->finishRadialSearch();
 				}
 
 				break;
-			case 1:
+			case 1: {
 
 				const std::unordered_set<DirectionLine>& searched_directions = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher)->getFinishedDirections();
 				for (const DirectionLine& direction : searched_directions) {
 					this->database->recordSearchedDirection(this->base_coordinate, direction);
 				}
 
-				const coordinate& tmp_good_coordinate = this->searcher->getBestMeasuredCoordinate();
+				// Searcher の差し替え後も使うためコピー
+				coordinate tmp_good_coordinate = this->searcher->getBestMeasuredCoordinate();
 				double tmp_good_value = this->database->getSampleMetricValue(tmp_good_coordinate);
-				
+
+				bool is_improved;
 				if (this->lower_is_better) {
-					if (tmp_good_value < this->base_value) {
-
-						DirectionLine trajectry_line = DirectionLine(this->base_coordinate, tmp_good_coordinate);
-						this->base_coordinate = tmp_good_coordinate;
-						this->database->setBasePoint(this->base_coordinate);
-						this->database->recordSearchedDirection(this->base_coordinate, trajectry_line);
-						this->base_value = tmp_good_value;
-						this->searcher = std::make_shared<RadialDspSearcher>(this->database, this->base_coordinate, this->database->getSpaceDimension(), this->lower_is_better, this->dsp_alpha);
-
-						if (this->searcher->isSearchFinished()) {
-							this->searcher = std::make_shared<UniMeasurer>(this->base_coordinate);
-							this->searching_phase = 2;
-						}
-					}
-					else {
-						this->searcher = std::make_shared<UniMeasurer>(this->base_coordinate);
-						this->searching_phase = 2;
-					}
+					is_improved = tmp_good_value < this->base_value;
 				}
 				else {
-					if (tmp_good_value > this->base_value) {
-						
-						DirectionLine trajectry_line = DirectionLine(this->base_coordinate, tmp_good_coordinate);
-						this->base_coordinate = this->searcher->getBestMeasuredCoordinate();
-						this->database->setBasePoint(this->base_coordinate);
-						this->database->recordSearchedDirection(this->base_coordinate, trajectry_line);
-						this->base_value = tmp_good_value;
-						
-						this->searcher = std::make_shared<RadialDspSearcher>(this->database, this->base_coordinate, this->database->getSpaceDimension(), this->lower_is_better, this->dsp_alpha);
-						if (this->is_logging_mode_on) {
-							std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
-							ld->updateCandidateList(this->searcher->getSuggestedList());
-						}
-						
-						if (this->searcher->isSearchFinished()) {
-							this->searcher = std::make_shared<UniMeasurer>(this->base_coordinate);
-							this->searching_phase = 2;
-							if (this->is_logging_mode_on) {
-								std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
-								ld->updateCandidateList(this->searcher->getSuggestedList());
-							}
-						}
-					}
-					else {
-						this->searcher = std::make_shared<UniMeasurer>(this->base_coordinate);
-						this->searching_phase = 2;
-						if (this->is_logging_mode_on) {
-							std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
-							ld->updateCandidateList(this->searcher->getSuggestedList());
-						}
-					}
+					is_improved = tmp_good_value > this->base_value;
+				}
+
+				if (this->direction_sampler != nullptr) {
+					this->direction_sampler->recordRound(this->base_coordinate, searched_directions, is_improved ? tmp_good_coordinate : this->base_coordinate);
+				}
+
+				if (!is_improved) {
+					this->finishRadialSearch();
+				}
+				else {
+					this->acceptBetterPoint(tmp_good_coordinate);
+				}
+
+				break;
+			}
+			case 3: {
+
+				// 有意に良い場合のみ移動
+				coordinate judged_coordinate = this->searcher->getBestJudgedCoordinate();
+				if (judged_coordinate == this->base_coordinate) {
+					this->base_value = this->database->getSampleMetricValue(this->base_coordinate);
+					this->rejectBetterPoint();
+				}
+				else {
+					this->moveBasePoint(judged_coordinate);
 				}
+
+				break;
+			}
+			case 4:
+				this->finishScreening();
 				break;
+			case 5:
+				this->finishAxisSearch();
+				break;
+			case 6:
+				this->finishGradientSearch();
+				break;
+			}
+		}
+		else if (this->searching_phase == 1) {
+			this->acceptBetterPointEarly();
+		}
+
+		this->startPrecomputation();
+	}
+
+	void Operator_P_2024B::moveBasePoint(const coordinate& new_base_coordinate) {
+
+		DirectionLine trajectry_line = DirectionLine(this->base_coordinate, new_base_coordinate);
+		this->base_coordinate = new_base_coordinate;
+		this->database->setBasePoint(this->base_coordinate);
+		this->database->recordSearchedDirection(this->base_coordinate, trajectry_line);
+		this->base_value = this->database->getSampleMetricValue(this->base_coordinate);
+
+		if (this->is_gradient_step_on) {
+			this->startAxisSearch();
+			return;
+		}
+
+		std::shared_ptr<RadialDspSearcher> precomputed = this->takePrecomputedSearcher(this->base_coordinate);
+		if (precomputed != nullptr) {
+			this->searcher = precomputed;
+		}
+		else {
+			this->searcher = this->buildRadialSearcher(this->base_coordinate);
+		}
+		this->searching_phase = 1;
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+
+		if (this->searcher->isSearchFinished()) {
+			this->finishRadialSearch();
+		}
+	}
+
+	void Operator_P_2024B::startPrecomputation(void) {
+
+		// 最急降下方向の直線探索を行う場合，次の基準点では全周辺方向の探索機構をすぐには使わない
+		if (!this->is_precomputation_on || this->searching_phase != 1 || this->is_gradient_step_on) {
+			return;
+		}
+
+		std::shared_ptr<RadialDspSearcher> radial_searcher = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher);
+		if (!radial_searcher->isFoundBetterPoint()) {
+			return;
+		}
+
+		// 暫定最良点が次の基準点になる見込みが高い
+		const coordinate& next_base_coordinate = radial_searcher->getBestMeasuredCoordinate();
+		if (this->precomputed_searcher.valid() && next_base_coordinate == this->precomputed_base_coordinate) {
+			return;
+		}
+
+		this->waitPrecomputation();
+		if (this->precomputed_searcher.valid()) {
+			this->precomputed_searcher.get();
+		}
+
+		this->precomputed_base_coordinate = next_base_coordinate;
+		this->precomputation_pending_coordinates.clear();
+		this->is_precomputation_outdated = false;
+
+		// 移動時に記録される軌跡の方向は先読み時点ではデータベースに無いため明示的に除外
+		std::unordered_set<DirectionLine> excluded_directions;
+		excluded_directions.insert(DirectionLine(this->base_coordinate, next_base_coordinate));
+
+		// 実測を省略する場合は，採用時まで使われない専用の覆いを渡す
+		this->precomputed_skipped_database = this->surrogate_skip_confidence > 0 ? std::make_shared<SkippedSampleDatabase>(this->database) : nullptr;
+		std::shared_ptr<const DatabaseCore> tmp_database = this->precomputed_skipped_database != nullptr ? std::shared_ptr<const DatabaseCore>(this->precomputed_skipped_database) : std::shared_ptr<const DatabaseCore>(this->database);
+		coordinate tmp_base_coordinate = next_base_coordinate;
+		std::size_t dimension = this->database->getSpaceDimension();
+		bool tmp_lower_is_better = this->lower_is_better;
+		double tmp_alpha = this->dsp_alpha;
+		std::size_t tmp_worker_num = this->worker_num;
+		std::shared_ptr<ThreadPool> tmp_pool = this->thread_pool;
+
+		// 方向を間引く場合は乱数生成器を共有しないよう，方向の選択のみここで行う
+		if (this->direction_sampler != nullptr) {
+
+			std::vector<DirectionLine> target_directions = this->direction_sampler->sampleDirections(this->database, next_base_coordinate, excluded_directions);
+
+			this->precomputed_searcher = std::async(std::launch::async, [tmp_database, tmp_base_coordinate, target_directions, tmp_lower_is_better, tmp_alpha, tmp_worker_num, tmp_pool]() {
+				return std::make_shared<RadialDspSearcher>(tmp_database, tmp_base_coordinate, target_directions, tmp_lower_is_better, tmp_alpha, tmp_worker_num, tmp_pool);
+			});
+			return;
+		}
+
+		this->precomputed_searcher = std::async(std::launch::async, [tmp_database, tmp_base_coordinate, dimension, tmp_lower_is_better, tmp_alpha, excluded_directions, tmp_worker_num, tmp_pool]() {
+			return std::make_shared<RadialDspSearcher>(tmp_database, tmp_base_coordinate, dimension, tmp_lower_is_better, tmp_alpha, excluded_directions, tmp_worker_num, tmp_pool);
+		});
+	}
+
+	void Operator_P_2024B::waitPrecomputation(void) {
+		if (this->precomputed_searcher.valid()) {
+			this->precomputed_searcher.wait();
+		}
+	}
+
+	std::shared_ptr<RadialDspSearcher> Operator_P_2024B::takePrecomputedSearcher(const coordinate& new_base_coordinate) {
+
+		if (!this->precomputed_searcher.valid()) {
+			return nullptr;
+		}
+
+		std::shared_ptr<RadialDspSearcher> precomputed = this->precomputed_searcher.get();
+
+		if (this->precomputed_base_coordinate != new_base_coordinate || this->is_precomputation_outdated) {
+			return nullptr;
+		}
+
+		// 先読み開始後の実測結果を，新規に構築した場合と同じく探索機構へ反映
+		std::unordered_set<coordinate> delivered;
+		bool has_delivered = false;
+		for (const coordinate& c : this->precomputation_pending_coordinates) {
+			if (delivered.insert(c).second) {
+				precomputed->setMetricValue(c, this->database->getSampleMetricValue(c));
+				has_delivered = true;
+			}
+		}
+		if (has_delivered) {
+			precomputed->updateState();
+		}
+
+		this->precomputation_pending_coordinates.clear();
+		this->skipped_database = this->precomputed_skipped_database;
+
+		return precomputed;
+	}
+
+	void Operator_P_2024B::finishSearching(void) {
+
+		this->searcher = std::make_shared<UniMeasurer>(this->base_coordinate);
+		this->searching_phase = 2;
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+	}
+
+	void Operator_P_2024B::finishRadialSearch(void) {
+
+		// 方向を間引いている場合，同時変化軸数が上限以下の方向をすべて探索するまでは局所最適と判断しない
+		while (this->direction_sampler != nullptr && this->direction_sampler->hasUnsearchedDirection(this->database, this->base_coordinate)) {
+
+			this->searcher = this->buildRadialSearcher(this->base_coordinate);
+			this->searching_phase = 1;
+			if (this->is_logging_mode_on) {
+				std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+				ld->updateCandidateList(this->searcher->getSuggestedList());
+			}
+
+			if (!this->searcher->isSearchFinished()) {
+				return;
 			}
+
+			const std::unordered_set<DirectionLine>& searched_directions = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher)->getFinishedDirections();
+			for (const DirectionLine& direction : searched_directions) {
+				this->database->recordSearchedDirection(this->base_coordinate, direction);
+			}
+		}
+
+		this->finishSearching();
+	}
+
+	void Operator_P_2024B::startScreening(void) {
+
+		this->searcher = std::make_shared<ParameterScreeningSearcher>(this->database, this->base_coordinate, this->lower_is_better);
+		this->searching_phase = 4;
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+
+		if (this->searcher->isSearchFinished()) {
+			this->finishScreening();
 		}
 	}
 
+	void Operator_P_2024B::finishScreening(void) {
+
+		std::shared_ptr<ParameterScreeningSearcher> screening_searcher = std::dynamic_pointer_cast<ParameterScreeningSearcher>(this->searcher);
+		std::vector<double> effect_sizes = screening_searcher->getEffectSizes();
+		double max_effect_size = *std::max_element(effect_sizes.begin(), effect_sizes.end());
+
+		// 最大の効果をもつ軸は閾値によらず固定しない
+		const space_size& space = this->database->getSpaceSize();
+		std::vector<std::size_t> frozen_axes;
+		std::size_t active_axis_num = 0;
+		for (std::size_t i = 0; i < space.size(); i++) {
+			if (space[i] <= 1) {
+				continue;
+			}
+			if (effect_sizes[i] < max_effect_size && effect_sizes[i] < max_effect_size * this->screening_threshold) {
+				frozen_axes.push_back(i);
+			}
+			else {
+				active_axis_num++;
+			}
+		}
+
+		if (!frozen_axes.empty()) {
+
+			// 方向を間引かない場合は，固定しない軸のみからなる全方向を探索する機構で代用
+			if (this->direction_sampler == nullptr) {
+				this->direction_sampler = std::make_shared<DirectionSampler>(space, active_axis_num, std::numeric_limits<std::size_t>::max());
+			}
+			this->direction_sampler->freezeAxes(frozen_axes);
+		}
+
+		// 固定する軸は選別中の最良点の値とする
+		this->base_coordinate = screening_searcher->getBestMeasuredCoordinate();
+		this->database->setBasePoint(this->base_coordinate);
+		this->base_value = this->database->getSampleMetricValue(this->base_coordinate);
+
+		if (this->is_gradient_step_on) {
+			this->startAxisSearch();
+			return;
+		}
+
+		this->searcher = this->buildRadialSearcher(this->base_coordinate);
+		this->searching_phase = 1;
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+
+		if (this->searcher->isSearchFinished()) {
+
+			const std::unordered_set<DirectionLine>& searched_directions = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher)->getFinishedDirections();
+			for (const DirectionLine& direction : searched_directions) {
+				this->database->recordSearchedDirection(this->base_coordinate, direction);
+			}
+
+			this->finishRadialSearch();
+		}
+	}
+
+	void Operator_P_2024B::startAxisSearch(void) {
+
+		std::shared_ptr<const DatabaseBasePointExtension> basepoint_database = std::dynamic_pointer_cast<const DatabaseBasePointExtension>(this->database);
+		const space_size& space = this->database->getSpaceSize();
+
+		// 性能パラメタの選別で固定された軸は除く
+		std::vector<std::size_t> target_axes;
+		if (this->direction_sampler != nullptr) {
+			target_axes = this->direction_sampler->getMovableAxes();
+		}
+		else {
+			for (std::size_t i = 0; i < space.size(); i++) {
+				if (space[i] > 1) {
+					target_axes.push_back(i);
+				}
+			}
+		}
+
+		std::vector<DirectionLine> target_directions;
+		for (std::size_t axis : target_axes) {
+			std::vector<int> direction(space.size(), 0);
+			direction[axis] = 1;
+			DirectionLine line(direction);
+			if (!basepoint_database->isSearchedDirection(this->base_coordinate, line)) {
+				target_directions.push_back(line);
+			}
+		}
+
+		this->searcher = std::make_shared<RadialDspSearcher>(this->prepareLineSearchDatabase(), this->base_coordinate, target_directions, this->lower_is_better, this->dsp_alpha, this->worker_num, this->thread_pool);
+		this->searching_phase = 5;
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+
+		if (this->searcher->isSearchFinished()) {
+			this->finishAxisSearch();
+		}
+	}
+
+	void Operator_P_2024B::finishAxisSearch(void) {
+
+		std::shared_ptr<RadialDspSearcher> axis_searcher = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher);
+
+		const std::unordered_set<DirectionLine>& searched_directions = axis_searcher->getFinishedDirections();
+		for (const DirectionLine& direction : searched_directions) {
+			this->database->recordSearchedDirection(this->base_coordinate, direction);
+		}
+
+		// 基準点の値は各軸の直線探索で実測済
+		if (this->database->hasSample(this->base_coordinate)) {
+			this->base_value = this->database->getSampleMetricValue(this->base_coordinate);
+		}
+
+		this->axis_best_coordinate = axis_searcher->getBestMeasuredCoordinate();
+		if (this->axis_best_coordinate.empty()) {
+			this->axis_best_coordinate = this->base_coordinate;
+		}
+
+		if (this->direction_sampler != nullptr) {
+			this->direction_sampler->recordRound(this->base_coordinate, searched_directions, this->axis_best_coordinate);
+		}
+
+		// 探索済の軸も含め，各軸の近似曲線の傾きを集める (今回探索しなかった軸はデータベースの実測値から近似し直す)
+		std::unordered_map<std::size_t, double> slopes = axis_searcher->getAxisSlopes();
+		const space_size& space = this->database->getSpaceSize();
+		std::vector<double> descent(space.size(), 0);
+		double max_descent = 0;
+
+		for (std::size_t i = 0; i < space.size(); i++) {
+
+			if (space[i] <= 1 || (this->direction_sampler != nullptr && std::find(this->direction_sampler->getMovableAxes().begin(), this->direction_sampler->getMovableAxes().end(), i) == this->direction_sampler->getMovableAxes().end())) {
+				continue;
+			}
+
+			if (!slopes.contains(i)) {
+				std::vector<int> direction(space.size(), 0);
+				direction[i] = 1;
+				slopes[i] = OneDimDspSearcher(this->database, this->base_coordinate, DirectionLine(direction), this->lower_is_better, this->dsp_alpha).getFittedSlope(this->base_coordinate);
+			}
+
+			descent[i] = this->lower_is_better ? -slopes[i] : slopes[i];
+			max_descent = std::max(max_descent, std::abs(descent[i]));
+		}
+
+		// 最急降下方向を，最大成分に対する比が 1/4 未満の成分を 0 とした 2 点刻みの格子方向に丸める
+		std::vector<long long> gradient_direction(space.size(), 0);
+		std::size_t changed_axis_num = 0;
+		bool is_all_even = true;
+		if (max_descent > 0) {
+			for (std::size_t i = 0; i < space.size(); i++) {
+				gradient_direction[i] = std::llround(2.0 * descent[i] / max_descent);
+				if (gradient_direction[i] != 0) {
+					changed_axis_num++;
+					is_all_even = is_all_even && gradient_direction[i] % 2 == 0;
+				}
+			}
+		}
+		if (is_all_even) {
+			for (long long& d : gradient_direction) {
+				d /= 2;
+			}
+		}
+
+		// 軸方向は探索済のため，斜め方向が得られ，その方向に隣接点がある場合のみ直線探索する
+		bool has_neighbor = false;
+		if (changed_axis_num >= 2) {
+			for (long long sign : { 1LL, -1LL }) {
+				bool in_space = true;
+				for (std::size_t i = 0; i < space.size(); i++) {
+					long long p = static_cast<long long>(this->base_coordinate[i]) + sign * gradient_direction[i];
+					in_space = in_space && p >= 0 && p < static_cast<long long>(space[i]);
+				}
+				has_neighbor = has_neighbor || in_space;
+			}
+		}
+
+		std::shared_ptr<const DatabaseBasePointExtension> basepoint_database = std::dynamic_pointer_cast<const DatabaseBasePointExtension>(this->database);
+		DirectionLine gradient_line(gradient_direction);
+		if (!has_neighbor || basepoint_database->isSearchedDirection(this->base_coordinate, gradient_line)) {
+			this->concludeGradientStep(this->axis_best_coordinate);
+			return;
+		}
+
+		this->searcher = std::make_shared<RadialDspSearcher>(this->prepareLineSearchDatabase(), this->base_coordinate, std::vector<DirectionLine>{ gradient_line }, this->lower_is_better, this->dsp_alpha, this->worker_num, this->thread_pool);
+		this->searching_phase = 6;
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+
+		if (this->searcher->isSearchFinished()) {
+			this->finishGradientSearch();
+		}
+	}
+
+	void Operator_P_2024B::finishGradientSearch(void) {
+
+		std::shared_ptr<RadialDspSearcher> gradient_searcher = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher);
+
+		const std::unordered_set<DirectionLine>& searched_directions = gradient_searcher->getFinishedDirections();
+		for (const DirectionLine& direction : searched_directions) {
+			this->database->recordSearchedDirection(this->base_coordinate, direction);
+		}
+
+		coordinate good_coordinate = this->axis_best_coordinate;
+		const coordinate& gradient_best_coordinate = gradient_searcher->getBestMeasuredCoordinate();
+		if (!gradient_best_coordinate.empty()) {
+			double axis_best_value = this->database->getSampleMetricValue(this->axis_best_coordinate);
+			double gradient_best_value = this->database->getSampleMetricValue(gradient_best_coordinate);
+			if (this->lower_is_better ? gradient_best_value < axis_best_value : gradient_best_value > axis_best_value) {
+				good_coordinate = gradient_best_coordinate;
+			}
+		}
+
+		if (this->direction_sampler != nullptr) {
+			this->direction_sampler->recordRound(this->base_coordinate, searched_directions, good_coordinate);
+		}
+
+		this->concludeGradientStep(good_coordinate);
+	}
+
+	void Operator_P_2024B::concludeGradientStep(const coordinate& good_coordinate) {
+
+		double good_value = this->database->getSampleMetricValue(good_coordinate);
+
+		bool is_improved;
+		if (this->lower_is_better) {
+			is_improved = good_value < this->base_value;
+		}
+		else {
+			is_improved = good_value > this->base_value;
+		}
+
+		if (is_improved) {
+			this->is_radial_fan_skipped = true;
+			this->acceptBetterPoint(good_coordinate);
+			return;
+		}
+
+		// 改善しなかった場合のみ，探索済の軸と最急降下方向を除いた全周辺方向を探索する
+		this->startFullRadialSearch();
+	}
+
+	void Operator_P_2024B::startFullRadialSearch(void) {
+
+		this->is_radial_fan_skipped = false;
+
+		this->searcher = this->buildRadialSearcher(this->base_coordinate);
+		this->searching_phase = 1;
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+
+		if (this->searcher->isSearchFinished()) {
+
+			const std::unordered_set<DirectionLine>& searched_directions = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher)->getFinishedDirections();
+			for (const DirectionLine& direction : searched_directions) {
+				this->database->recordSearchedDirection(this->base_coordinate, direction);
+			}
+
+			this->finishRadialSearch();
+		}
+	}
+
+	void Operator_P_2024B::acceptBetterPoint(const coordinate& good_coordinate) {
+
+		if (this->significance_test_repetitions == 0) {
+			this->moveBasePoint(good_coordinate);
+			return;
+		}
+
+		// 雑音による見かけの改善でないことを検定してから移動
+		this->searcher = std::make_shared<WelchTestMeasurer>(this->database, this->base_coordinate, good_coordinate, this->lower_is_better, this->significance_test_repetitions, this->significance_level);
+		this->searching_phase = 3;
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+
+		if (this->searcher->isSearchFinished()) {
+			if (this->searcher->getBestJudgedCoordinate() == this->base_coordinate) {
+				this->rejectBetterPoint();
+			}
+			else {
+				this->moveBasePoint(good_coordinate);
+			}
+		}
+	}
+
+	bool Operator_P_2024B::acceptBetterPointEarly(void) {
+
+		std::shared_ptr<RadialDspSearcher> radial_searcher = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher);
+
+		// 予算内にすべての直線を完了できる見込みがあれば，通常どおり放射状探索の完了を待つ
+		if (this->remaining_budget / Operator_P_2024B::LINE_COMPLETION_COST >= radial_searcher->getRunningSearchersNum()) {
+			return false;
+		}
+
+		// 基準点の値が確定するまでは比較できない
+		if (!radial_searcher->isFoundBetterPoint() || !this->database->hasSample(this->base_coordinate)) {
+			return false;
+		}
+
+		// Searcher の差し替え後も使うためコピー
+		coordinate tmp_good_coordinate = radial_searcher->getBestMeasuredCoordinate();
+		double tmp_good_value = this->database->getSampleMetricValue(tmp_good_coordinate);
+		this->base_value = this->database->getSampleMetricValue(this->base_coordinate);
+
+		bool is_improved;
+		if (this->lower_is_better) {
+			is_improved = tmp_good_value < this->base_value;
+		}
+		else {
+			is_improved = tmp_good_value > this->base_value;
+		}
+
+		if (!is_improved) {
+			return false;
+		}
+
+		// 完了した直線のみ探索済として記録 (途中の直線は移動後に再び探索対象となりうる)
+		const std::unordered_set<DirectionLine>& searched_directions = radial_searcher->getFinishedDirections();
+		for (const DirectionLine& direction : searched_directions) {
+			this->database->recordSearchedDirection(this->base_coordinate, direction);
+		}
+
+		if (this->direction_sampler != nullptr) {
+			this->direction_sampler->recordRound(this->base_coordinate, searched_directions, tmp_good_coordinate);
+		}
+
+		this->acceptBetterPoint(tmp_good_coordinate);
+
+		return true;
+	}
+
+	void Operator_P_2024B::rejectBetterPoint(void) {
+
+		if (this->is_radial_fan_skipped) {
+			this->startFullRadialSearch();
+		}
+		else {
+			this->finishRadialSearch();
+		}
+	}
+
+	std::shared_ptr<RadialDspSearcher> Operator_P_2024B::buildRadialSearcher(const coordinate& new_base_coordinate) {
+
+		std::shared_ptr<const DatabaseCore> search_database = this->prepareLineSearchDatabase();
+
+		if (this->direction_sampler != nullptr) {
+			return std::make_shared<RadialDspSearcher>(search_database, new_base_coordinate, this->direction_sampler->sampleDirections(this->database, new_base_coordinate), this->lower_is_better, this->dsp_alpha, this->worker_num, this->thread_pool);
+		}
+
+		return std::make_shared<RadialDspSearcher>(search_database, new_base_coordinate, this->database->getSpaceDimension(), this->lower_is_better, this->dsp_alpha, std::unordered_set<DirectionLine>(), this->worker_num, this->thread_pool);
+	}
+
+	std::shared_ptr<const DatabaseCore> Operator_P_2024B::prepareLineSearchDatabase(void) {
+
+		// 省略した点の予測値は基準点ごとの判定のため，直線探索を始めるたびに破棄する
+		if (this->surrogate_skip_confidence <= 0) {
+			return this->database;
+		}
+
+		this->skipped_database = std::make_shared<SkippedSampleDatabase>(this->database);
+
+		return this->skipped_database;
+	}
+
 	bool Operator_P_2024B::isSearchFinished(void) {
 		return this->searching_phase == 2;
 	}
@@ -269,6 +1041,10 @@ namespace dsice {
 		return this->base_coordinate;
 	}
 
+	void Operator_P_2024B::setRemainingBudget(std::size_t remaining_num) {
+		this->remaining_budget = remaining_num;
+	}
+
 	std::string Operator_P_2024B::getAlgorithmId(void) const {
 		return "P_2024B";
 	}
@@ -287,6 +1063,14 @@ namespace dsice {
 			return "Initial Search";
 		case 1:
 			return "Radial d-Spline Search";
+		case 3:
+			return "Significance Test";
+		case 4:
+			return "Parameter Screening";
+		case 5:
+			return "Axis d-Spline Search";
+		case 6:
+			return "Gradient Line Search";
 		default:
 			return "Finished";
 		}
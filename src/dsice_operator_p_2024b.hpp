@@ -2,13 +2,22 @@
 #define DSICE_OPERATOR_P_2024B_HPP_
 
 #include <memory>
+#include <limits>
 #include <string>
+#include <unordered_set>
+#include <future>
 
 #include "dsice_search_space.hpp"
 #include "dsice_database_metric_type.hpp"
 #include "dsice_database_standard_functions.hpp"
 #include "dsice_searcher.hpp"
+#include "radial_dsp_searcher.hpp"
+#include "dsice_thread_pool.hpp"
+#include "initial_design.hpp"
+#include "direction_sampler.hpp"
+#include "skipped_sample_database.hpp"
 #include "dsice_operator.hpp"
+#include "parallel_operator_options.hpp"
 
 namespace dsice {
 
@@ -45,6 +54,18 @@ namespace dsice {
 		/// </summary>
 		double dsp_alpha;
 		/// <summary>
+		/// 並列に実測できる数 (直線探索の初期探索の分割数を決める，0 なら 3 分割)
+		/// </summary>
+		std::size_t worker_num = 0;
+		/// <summary>
+		/// 探索機構の構築や状態更新に用いるスレッドプール (nullptr の場合は逐次実行)
+		/// </summary>
+		std::shared_ptr<ThreadPool> thread_pool;
+		/// <summary>
+		/// 探索する方向を間引いて選ぶ機構 (nullptr の場合は全周辺方向を探索)
+		/// </summary>
+		std::shared_ptr<DirectionSampler> direction_sampler;
+		/// <summary>
 		/// 探索基準点
 		/// </summary>
 		coordinate base_coordinate;
@@ -56,25 +77,186 @@ namespace dsice {
 		/// 何ループ目か (setMetricValue() が呼ばれた回数)
 		/// </summary>
 		std::size_t loop_count = 0;
+		/// <summary>
+		/// 基準点移動前の有意差検定で 1 点あたりに許す最大実測回数 (0 なら検定しない)
+		/// </summary>
+		std::size_t significance_test_repetitions = 0;
+		/// <summary>
+		/// 基準点移動前の有意差検定の有意水準
+		/// </summary>
+		double significance_level = 0.05;
+		/// <summary>
+		/// 件数指定で取得された実測候補リスト (不足分を投機的実測候補で補ったもの)
+		/// </summary>
+		coordinate_list fixed_width_suggested_list;
+		/// <summary>
+		/// 実測待ちの間に次の基準点の探索機構を先読みで構築するかどうか
+		/// </summary>
+		bool is_precomputation_on = false;
+		/// <summary>
+		/// 先読みで構築中の探索機構 (先読みしていない場合は無効)
+		/// </summary>
+		std::future<std::shared_ptr<RadialDspSearcher>> precomputed_searcher;
+		/// <summary>
+		/// 先読みで想定した次の基準点
+		/// </summary>
+		coordinate precomputed_base_coordinate;
+		/// <summary>
+		/// 先読み開始後に実測された点 (採用時に先読みした探索機構へ反映する)
+		/// </summary>
+		coordinate_list precomputation_pending_coordinates;
+		/// <summary>
+		/// 先読み開始時点で実測済の点の値が変わり，先読みした探索機構が使えなくなったかどうか
+		/// </summary>
+		bool is_precomputation_outdated = false;
+		/// <summary>
+		/// 放射状探索前の性能パラメタの選別で固定する効果の大きさの閾値 (最大の効果に対する比，0 なら選別しない)
+		/// </summary>
+		double screening_threshold = 0;
+		/// <summary>
+		/// 全周辺方向の探索の前に，各軸の近似曲線の傾きから求めた最急降下方向の直線探索を行うかどうか
+		/// </summary>
+		bool is_gradient_step_on = false;
+		/// <summary>
+		/// 各軸の直線探索で見つかった最良点 (最急降下方向の直線探索の結果と比較する)
+		/// </summary>
+		coordinate axis_best_coordinate;
+		/// <summary>
+		/// 全周辺方向を探索せずに見つけた点の有意差検定中かどうか (有意でなければ全周辺方向の探索に進む)
+		/// </summary>
+		bool is_radial_fan_skipped = false;
+		/// <summary>
+		/// 代理モデルの予測値がこの標準偏差倍だけずれても基準点より悪い候補の実測を省略する (0 なら省略しない)
+		/// </summary>
+		double surrogate_skip_confidence = 0;
+		/// <summary>
+		/// 実行中の直線探索で実測を省略した点を打ち切り標本として見せるデータベースの覆い (省略しない場合は nullptr)
+		/// </summary>
+		std::shared_ptr<SkippedSampleDatabase> skipped_database = nullptr;
+		/// <summary>
+		/// 先読みで構築中の探索機構に渡したデータベースの覆い (省略しない場合は nullptr)
+		/// </summary>
+		std::shared_ptr<SkippedSampleDatabase> precomputed_skipped_database = nullptr;
+		/// <summary>
+		/// 残りの実測予算 (予算を設定していない場合は std::numeric_limits&lt;std::size_t&gt;::max())
+		/// </summary>
+		std::size_t remaining_budget = std::numeric_limits<std::size_t>::max();
+		/// <summary>
+		/// 直線探索 1 本を完了させるのに見込む実測数 (残りの予算が実行中の直線の数のこの倍に満たなければ予算が足りないとみなす)
+		/// </summary>
+		static constexpr std::size_t LINE_COMPLETION_COST = 2;
+		/// <summary>
+		/// 探索機構の状態を更新し，探索機構が終了していれば次の段階へ移行
+		/// </summary>
+		void updateSearcherState(void);
+		/// <summary>
+		/// 代理モデル上で明らかに基準点より悪いかどうか
+		/// </summary>
+		/// <param name="target_coordinate">判定対象の座標</param>
+		/// <returns>予測値を標準偏差の指定倍だけ良い方にずらしても基準点より悪ければ true</returns>
+		bool isConfidentlyWorse(const coordinate& target_coordinate) const;
+		/// <summary>
+		/// 直線探索の実測候補のうち代理モデル上で明らかに基準点より悪いものを，実測せずに予測値の限界を打ち切り値として探索機構に渡す<br/>
+		/// (データベースには登録せず，実行中の直線探索のデータベースの覆いにのみ記録する)
+		/// </summary>
+		/// <returns>1 点でも登録した場合は true</returns>
+		bool skipConfidentlyWorse(void);
+		/// <summary>
+		/// 新たに開始する直線探索の探索機構に渡すデータベースを用意 (実測を省略する場合は空の覆いを作り直す)
+		/// </summary>
+		/// <returns>探索機構に渡すデータベース</returns>
+		std::shared_ptr<const DatabaseCore> prepareLineSearchDatabase(void);
+		/// <summary>
+		/// 性能パラメタの選別を開始 (全軸の実測候補が揃っていれば直ちに選別を終えて放射状探索を開始)
+		/// </summary>
+		void startScreening(void);
+		/// <summary>
+		/// 性能パラメタの選別結果から効果の小さい軸を固定し，選別中の最良点を基準点として放射状探索を開始
+		/// </summary>
+		void finishScreening(void);
+		/// <summary>
+		/// 現在の基準点で各軸のみを変化させる方向の直線探索を開始
+		/// </summary>
+		void startAxisSearch(void);
+		/// <summary>
+		/// 各軸の近似曲線の傾きから最急降下方向を求め，その方向の直線探索を開始 (斜め方向が得られなければ直ちに結果を判定)
+		/// </summary>
+		void finishAxisSearch(void);
+		/// <summary>
+		/// 最急降下方向の直線探索を終え，各軸の直線探索と合わせた結果を判定
+		/// </summary>
+		void finishGradientSearch(void);
+		/// <summary>
+		/// 各軸と最急降下方向の直線探索で見つかった最良点が基準点より良ければ移動し，良くなければ全周辺方向の探索を開始
+		/// </summary>
+		/// <param name="good_coordinate">見つかった最良点</param>
+		void concludeGradientStep(const coordinate& good_coordinate);
+		/// <summary>
+		/// 現在の基準点で全周辺方向の放射状探索を開始
+		/// </summary>
+		void startFullRadialSearch(void);
+		/// <summary>
+		/// 見つかった点が有意に良いと判定されなかった際の処理 (全周辺方向を探索済であれば探索を終了)
+		/// </summary>
+		void rejectBetterPoint(void);
+		/// <summary>
+		/// 残りの予算が実行中の直線をすべて完了させるのに足りない場合，放射状探索の途中で基準点より良い点が実測済であればその点を受け入れる
+		/// </summary>
+		/// <returns>良い点を受け入れた場合は true</returns>
+		bool acceptBetterPointEarly(void);
+		/// <summary>
+		/// 基準点より良い点が見つかった際の処理 (有意差検定を行う場合は検定を開始し，行わない場合は移動)
+		/// </summary>
+		/// <param name="good_coordinate">見つかった良い点</param>
+		void acceptBetterPoint(const coordinate& good_coordinate);
+		/// <summary>
+		/// 探索基準点を移動し，新しい基準点から放射状探索を開始
+		/// </summary>
+		/// <param name="new_base_coordinate">新しい基準点</param>
+		void moveBasePoint(const coordinate& new_base_coordinate);
+		/// <summary>
+		/// 現在の基準点で探索を終了
+		/// </summary>
+		void finishSearching(void);
+		/// <summary>
+		/// 放射状探索で改善が見られなかった際の処理．<br/>
+		/// 方向を間引いている場合は，未探索の方向が残っていれば選ぶ方向数を増やして同じ基準点で探索を続け，残っていなければ探索を終了
+		/// </summary>
+		void finishRadialSearch(void);
+		/// <summary>
+		/// 指定した基準点の放射状探索機構を構築
+		/// </summary>
+		/// <param name="new_base_coordinate">探索基準点</param>
+		/// <returns>構築した探索機構</returns>
+		std::shared_ptr<RadialDspSearcher> buildRadialSearcher(const coordinate& new_base_coordinate);
+		/// <summary>
+		/// 次の基準点になる見込みの点が見つかっていれば，その点を基準点とする探索機構の構築を別スレッドで開始
+		/// </summary>
+		void startPrecomputation(void);
+		/// <summary>
+		/// 先読みで構築中の探索機構の完了を待ち，データベースへの書き込みを可能にする
+		/// </summary>
+		void waitPrecomputation(void);
+		/// <summary>
+		/// 先読みした探索機構を，先読み開始後の実測結果を反映したうえで取り出す
+		/// </summary>
+		/// <param name="new_base_coordinate">新しい基準点</param>
+		/// <returns>先読みした探索機構 (想定と異なる基準点の場合や使えなくなった場合は nullptr)</returns>
+		std::shared_ptr<RadialDspSearcher> takePrecomputedSearcher(const coordinate& new_base_coordinate);
 	public:
 		/// <summary>
 		/// コンストラクタ
 		/// </summary>
 		/// <param name="parameters">各性能パラメタが取りうる値の数リスト</param>
-		/// <param name="low_value_is_better">性能評価値が低い値ほど良いのであれば true</param>
-		/// <param name="logging_on">ログを取る場合は true</param>
-		/// <param name="initialize_way">初期点の決定方法</param>
-		/// <param name="alpha">近似関数の滑らかさを決定する重み係数 (小さいほどデータ追随，値が大きいほど滑らか)</param>
-		/// <param name="metric_type">性能パラメタの同一設定値に複数の性能評価値が登録された際の挙動</param>
-		/// <param name="initial_coordinate">初期点の座標</param>
-		Operator_P_2024B(const space_size& parameters, bool low_value_is_better = true, bool logging_on = false, OperatorInitializeWay initialize_way = OperatorInitializeWay::CENTER, double alpha = 0.1, DatabaseMetricType metric_type = DatabaseMetricType::AverageDouble, coordinate initial_coordinate = {});
+		/// <param name="options">構築時設定</param>
+		Operator_P_2024B(const space_size& parameters, const ParallelOperatorOptions& options = ParallelOperatorOptions());
 		/// <summary>
 		/// コピーコンストラクタ
 		/// </summary>
 		/// <param name="original">コピー元</param>
 		Operator_P_2024B(const Operator_P_2024B& original);
 		/// <summary>
-		/// デストラクタ
+		/// デストラクタ (先読み中であれば完了を待つ)
 		/// </summary>
 		~Operator_P_2024B(void);
 		/// <summary>
@@ -93,12 +275,49 @@ namespace dsice {
 		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
 		const coordinate_list& getSuggestedList(void) override;
 		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを指定件数で取得．<br/>
+		/// 探索機構の提案が指定件数に満たない場合は投機的実測候補で補い，探索終了時や未実測点が尽きた場合のみ指定件数未満となる
+		/// </summary>
+		/// <param name="suggested_num">取得する候補数</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(std::size_t suggested_num);
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを，指定した座標を除いて指定件数で取得．<br/>
+		/// 実測中の点と重複しない候補を並列実測の空き枠に割り当てるために用いる
+		/// </summary>
+		/// <param name="suggested_num">取得する候補数</param>
+		/// <param name="excluded_coordinates">除外する座標 (実測中の点など)</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(std::size_t suggested_num, const std::unordered_set<coordinate>& excluded_coordinates) override;
+		/// <summary>
+		/// 残りの実測予算を設定 (予算が足りなければ，放射状探索のすべての直線の完了を待たずに良い点へ移動する)
+		/// </summary>
+		/// <param name="remaining_num">残りの実測数</param>
+		void setRemainingBudget(std::size_t remaining_num) override;
+		/// <summary>
 		/// 実測データを記録
 		/// </summary>
 		/// <param name="measured_coordinate">実測した座標</param>
 		/// <param name="metric_value">実測した値</param>
 		void setMetricValue(const coordinate& measured_coordinate, double metric_value) override;
 		/// <summary>
+		/// 実測データをデータベースにのみ記録 (探索機構には渡さない)
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void recordMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// データベースで集計済の性能評価値を探索機構に渡す
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		void commitMetricValue(const coordinate& measured_coordinate) override;
+		/// <summary>
+		/// 実測を途中で打ち切ったデータを記録 (性能評価値は打ち切り時点の限界値で，実際はこれより悪い)
+		/// </summary>
+		/// <param name="measured_coordinate">実測を打ち切った座標</param>
+		/// <param name="bound">打ち切り時点の限界値</param>
+		void setCensoredMetricValue(const coordinate& measured_coordinate, double bound) override;
+		/// <summary>
 		/// 状態を更新
 		/// </summary>
 		void updateState(void) override;
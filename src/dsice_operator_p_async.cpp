@@ -0,0 +1,455 @@
+﻿#include <memory>
+#include <limits>
+#include <string>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "direction_line.hpp"
+#include "dsice_database_metric_type.hpp"
+#include "dsice_standard_database.hpp"
+#include "dsice_logging_database.hpp"
+#include "simple_lhd_searcher.hpp"
+#include "radial_dsp_searcher.hpp"
+#include "around_points.hpp"
+#include "uni_measurer.hpp"
+#include "dsice_thread_pool.hpp"
+#include "initial_design.hpp"
+#include "direction_sampler.hpp"
+#include "dsice_operator_p_async.hpp"
+
+namespace dsice {
+
+	Operator_P_Async::Operator_P_Async(const space_size& parameters, const ParallelOperatorOptions& options) {
+
+		if (parameters.empty()) {
+			throw std::invalid_argument("need one parameter at least.");
+		}
+
+		this->lower_is_better = options.lower_is_better;
+		this->is_logging_mode_on = options.logging_on;
+		this->dsp_alpha = options.alpha;
+		this->worker_num = options.worker_num;
+		this->thread_pool = options.thread_pool;
+
+		if (options.sampled_max_changed_axis_num > 0) {
+			this->direction_sampler = std::make_shared<DirectionSampler>(parameters, options.sampled_max_changed_axis_num, options.sampled_direction_budget);
+		}
+
+		if (this->is_logging_mode_on) {
+			this->database = std::make_shared<LoggingDatabase>(parameters, options.metric_type);
+		}
+		else {
+			this->database = std::make_shared<StandardDatabase>(parameters, options.metric_type);
+		}
+
+		if (this->lower_is_better) {
+			this->base_value = std::numeric_limits<double>::max();
+		}
+		else {
+			this->base_value = std::numeric_limits<double>::lowest();
+		}
+
+		switch (options.initialize_way) {
+		case OperatorInitializeWay::SPECIFIED:
+			this->base_coordinate = options.initial_coordinate;
+			this->database->setBasePoint(this->base_coordinate);
+
+			this->searcher = this->buildRadialSearcher(this->base_coordinate);
+			this->searching_phase = 1;
+			if (this->is_logging_mode_on) {
+				std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+				ld->updateCandidateList(this->searcher->getSuggestedList());
+			}
+			break;
+		case OperatorInitializeWay::INITIAL_SEARCH:
+			if (options.initial_design != nullptr) {
+				this->searcher = std::make_shared<SimpleLhdSearcher>(this->database, options.initial_design->generate(*this->database, this->thread_pool), this->lower_is_better);
+			}
+			else {
+				this->searcher = std::make_shared<SimpleLhdSearcher>(this->database, this->lower_is_better);
+			}
+
+			this->base_coordinate = this->searcher->getSuggested();
+			this->database->setBasePoint(this->base_coordinate);
+
+			if (this->is_logging_mode_on) {
+				std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+				ld->updateCandidateList(this->searcher->getSuggestedList());
+			}
+			break;
+		default:
+			// 固定で中心点を初期点とする
+			coordinate center_point;
+			for (std::size_t param_length : parameters) {
+				if (param_length == 0) {
+					throw std::invalid_argument("All parameters must have configurable values.");
+				}
+				center_point.push_back(param_length / 2);
+			}
+
+			this->base_coordinate = center_point;
+			this->database->setBasePoint(this->base_coordinate);
+
+			this->searcher = this->buildRadialSearcher(this->base_coordinate);
+			this->searching_phase = 1;
+			if (this->is_logging_mode_on) {
+				std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+				ld->updateCandidateList(this->searcher->getSuggestedList());
+			}
+			break;
+		}
+	}
+
+	Operator_P_Async::Operator_P_Async(const Operator_P_Async& original) {
+
+		this->searching_phase = original.searching_phase;
+		this->lower_is_better = original.lower_is_better;
+		this->is_logging_mode_on = original.is_logging_mode_on;
+		this->dsp_alpha = original.dsp_alpha;
+		this->worker_num = original.worker_num;
+		this->thread_pool = original.thread_pool;
+		this->remaining_budget = original.remaining_budget;
+		if (original.direction_sampler != nullptr) {
+			this->direction_sampler = std::make_shared<DirectionSampler>(*original.direction_sampler);
+		}
+		this->base_coordinate = original.base_coordinate;
+		this->base_value = original.base_value;
+		this->loop_count = original.loop_count;
+		this->fixed_width_suggested_list = original.fixed_width_suggested_list;
+
+		if (std::shared_ptr<StandardDatabase> sd = std::dynamic_pointer_cast<StandardDatabase>(original.database)) {
+			this->database = std::make_shared<StandardDatabase>(*sd);
+		}
+		else {
+			this->database = std::make_shared<LoggingDatabase>(*(std::dynamic_pointer_cast<LoggingDatabase>(original.database)));
+		}
+
+		switch (this->searching_phase) {
+		case 0:
+			this->searcher = std::make_shared<SimpleLhdSearcher>(*(std::dynamic_pointer_cast<SimpleLhdSearcher>(original.searcher)));
+			break;
+		case 1:
+			this->searcher = std::make_shared<RadialDspSearcher>(*(std::dynamic_pointer_cast<RadialDspSearcher>(original.searcher)), this->database);
+			break;
+		case 2:
+			this->searcher = std::make_shared<UniMeasurer>(*(std::dynamic_pointer_cast<UniMeasurer>(original.searcher)));
+			break;
+		}
+	}
+
+	Operator_P_Async::~Operator_P_Async(void) {
+		// DO_NOTHING
+	}
+
+	const coordinate& Operator_P_Async::getBaseCoordinate(void) const {
+		return this->base_coordinate;
+	}
+
+	const coordinate& Operator_P_Async::getSuggested(void) {
+
+		this->updateState();
+
+		return this->searcher->getSuggested();
+	}
+
+	const coordinate_list& Operator_P_Async::getSuggestedList(void) {
+
+		this->updateState();
+
+		return this->searcher->getSuggestedList();
+	}
+
+	const coordinate_list& Operator_P_Async::getSuggestedList(std::size_t suggested_num) {
+		return this->getSuggestedList(suggested_num, std::unordered_set<coordinate>());
+	}
+
+	const coordinate_list& Operator_P_Async::getSuggestedList(std::size_t suggested_num, const std::unordered_set<coordinate>& excluded_coordinates) {
+
+		this->updateState();
+
+		this->fixed_width_suggested_list.clear();
+		std::unordered_set<coordinate> listed = excluded_coordinates;
+
+		std::shared_ptr<RadialDspSearcher> radial_searcher = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher);
+		if (radial_searcher != nullptr) {
+
+			// 放射状探索中は全体のリストを作らずにキューの先頭から必要数だけ取り出す (実測中の点は除く)
+			this->fixed_width_suggested_list = radial_searcher->getSuggestedList(suggested_num, excluded_coordinates);
+			listed.insert(this->fixed_width_suggested_list.begin(), this->fixed_width_suggested_list.end());
+		}
+		else {
+			for (const coordinate& c : this->searcher->getSuggestedList()) {
+				if (this->fixed_width_suggested_list.size() >= suggested_num) {
+					break;
+				}
+				if (listed.insert(c).second) {
+					this->fixed_width_suggested_list.push_back(c);
+				}
+			}
+		}
+
+		// 探索終了後は投機的に実測する意味がない
+		if (this->fixed_width_suggested_list.size() >= suggested_num || this->searching_phase == 2) {
+			return this->fixed_width_suggested_list;
+		}
+
+		if (this->searching_phase == 1) {
+
+			// 放射状探索中は直線上の点，次の基準点の隣接点，基準点の周辺点の順で補う
+			coordinate_list speculative = radial_searcher->getSpeculativeCandidates(listed, suggested_num - this->fixed_width_suggested_list.size());
+			this->fixed_width_suggested_list.insert(this->fixed_width_suggested_list.end(), speculative.begin(), speculative.end());
+		}
+		else {
+
+			// 初期探索中は基準点の周辺点で補う
+			std::size_t around_axis_num = this->direction_sampler != nullptr ? this->direction_sampler->getMaxChangedAxisNum() : this->database->getSpaceDimension();
+			AroundPoints base_around(this->database->getSpaceSize(), this->base_coordinate, around_axis_num);
+			for (const coordinate& c : base_around.getAroundPoints()) {
+				if (this->fixed_width_suggested_list.size() >= suggested_num) {
+					break;
+				}
+				if (!this->database->hasSample(c) && listed.insert(c).second) {
+					this->fixed_width_suggested_list.push_back(c);
+				}
+			}
+		}
+
+		return this->fixed_width_suggested_list;
+	}
+
+	void Operator_P_Async::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
+
+		// 基準点の移動前に提示した点の結果もデータベースには残す (現在の Searcher は担当外の点を無視する)
+		this->database->setSampleMetricValue(measured_coordinate, metric_value);
+		this->searcher->setMetricValue(measured_coordinate, metric_value);
+	}
+
+	void Operator_P_Async::recordMetricValue(const coordinate& measured_coordinate, double metric_value) {
+		this->database->setSampleMetricValue(measured_coordinate, metric_value);
+	}
+
+	void Operator_P_Async::commitMetricValue(const coordinate& measured_coordinate) {
+		this->searcher->setMetricValue(measured_coordinate, this->database->getSampleMetricValue(measured_coordinate));
+	}
+
+	void Operator_P_Async::setCensoredMetricValue(const coordinate& measured_coordinate, double bound) {
+		this->setMetricValue(measured_coordinate, bound);
+		this->database->setSampleCensored(measured_coordinate);
+	}
+
+	void Operator_P_Async::updateState(void) {
+
+		bool searcher_updated = this->searcher->updateState();
+
+		if (!searcher_updated) {
+			return;
+		}
+
+		this->loop_count++;
+
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+		this->database->setLoopEnd();
+
+		if (this->searcher->isSearchFinished()) {
+			switch (this->searching_phase) {
+			case 0:
+
+				this->base_coordinate = this->searcher->getBestMeasuredCoordinate();
+				this->database->setBasePoint(this->base_coordinate);
+				this->base_value = this->database->getSampleMetricValue(this->base_coordinate);
+
+				this->searcher = this->buildRadialSearcher(this->base_coordinate);
+				this->searching_phase = 1;
+				if (this->is_logging_mode_on) {
+					std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+					ld->updateCandidateList(this->searcher->getSuggestedList());
+				}
+
+				if (this->searcher->isSearchFinished()) {
+
+					const std::unordered_set<DirectionLine>& searched_directions = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher)->getFinishedDirections();
+					for (const DirectionLine& direction : searched_directions) {
+						this->database->recordSearchedDirection(this->base_coordinate, direction);
+					}
+
+					this->finishRadialSearch();
+				}
+
+				break;
+			case 1:
+
+				if (!this->moveBasePointEarly()) {
+
+					const std::unordered_set<DirectionLine>& searched_directions = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher)->getFinishedDirections();
+					for (const DirectionLine& direction : searched_directions) {
+						this->database->recordSearchedDirection(this->base_coordinate, direction);
+					}
+
+					if (this->direction_sampler != nullptr) {
+						this->direction_sampler->recordRound(this->base_coordinate, searched_directions, this->base_coordinate);
+					}
+
+					this->finishRadialSearch();
+				}
+
+				break;
+			}
+		}
+		else if (this->searching_phase == 1) {
+			this->moveBasePointEarly();
+		}
+	}
+
+	bool Operator_P_Async::moveBasePointEarly(void) {
+
+		std::shared_ptr<RadialDspSearcher> radial_searcher = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher);
+
+		// 基準点の値が確定するまでは比較できない
+		if (!radial_searcher->isFoundBetterPoint() || !this->database->hasSample(this->base_coordinate)) {
+			return false;
+		}
+
+		// Searcher の差し替え後も使うためコピー
+		coordinate tmp_good_coordinate = radial_searcher->getBestMeasuredCoordinate();
+		double tmp_good_value = this->database->getSampleMetricValue(tmp_good_coordinate);
+		this->base_value = this->database->getSampleMetricValue(this->base_coordinate);
+
+		bool is_improved;
+		if (this->lower_is_better) {
+			is_improved = tmp_good_value < this->base_value;
+		}
+		else {
+			is_improved = tmp_good_value > this->base_value;
+		}
+
+		if (!is_improved) {
+			return false;
+		}
+
+		// 完了した直線のみ探索済として記録 (途中の直線は移動後に再び探索対象となりうる)
+		const std::unordered_set<DirectionLine>& searched_directions = radial_searcher->getFinishedDirections();
+		for (const DirectionLine& direction : searched_directions) {
+			this->database->recordSearchedDirection(this->base_coordinate, direction);
+		}
+
+		if (this->direction_sampler != nullptr) {
+			this->direction_sampler->recordRound(this->base_coordinate, searched_directions, tmp_good_coordinate);
+		}
+
+		this->moveBasePoint(tmp_good_coordinate);
+
+		return true;
+	}
+
+	void Operator_P_Async::moveBasePoint(const coordinate& new_base_coordinate) {
+
+		DirectionLine trajectry_line = DirectionLine(this->base_coordinate, new_base_coordinate);
+		this->base_coordinate = new_base_coordinate;
+		this->database->setBasePoint(this->base_coordinate);
+		this->database->recordSearchedDirection(this->base_coordinate, trajectry_line);
+		this->base_value = this->database->getSampleMetricValue(this->base_coordinate);
+
+		this->searcher = this->buildRadialSearcher(this->base_coordinate);
+		this->searching_phase = 1;
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+
+		if (this->searcher->isSearchFinished()) {
+			this->finishRadialSearch();
+		}
+	}
+
+	void Operator_P_Async::finishSearching(void) {
+
+		this->searcher = std::make_shared<UniMeasurer>(this->base_coordinate);
+		this->searching_phase = 2;
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+	}
+
+	void Operator_P_Async::finishRadialSearch(void) {
+
+		// 方向を間引いている場合，同時変化軸数が上限以下の方向をすべて探索するまでは局所最適と判断しない
+		while (this->direction_sampler != nullptr && this->direction_sampler->hasUnsearchedDirection(this->database, this->base_coordinate)) {
+
+			this->searcher = this->buildRadialSearcher(this->base_coordinate);
+			this->searching_phase = 1;
+			if (this->is_logging_mode_on) {
+				std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+				ld->updateCandidateList(this->searcher->getSuggestedList());
+			}
+
+			if (!this->searcher->isSearchFinished()) {
+
+				// 予算内に新しい方向の直線を完了できる見込みがなければ，追加の方向を探索せずに終了
+				if (this->remaining_budget / Operator_P_Async::LINE_COMPLETION_COST < std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher)->getRunningSearchersNum()) {
+					break;
+				}
+
+				return;
+			}
+
+			const std::unordered_set<DirectionLine>& searched_directions = std::dynamic_pointer_cast<RadialDspSearcher>(this->searcher)->getFinishedDirections();
+			for (const DirectionLine& direction : searched_directions) {
+				this->database->recordSearchedDirection(this->base_coordinate, direction);
+			}
+		}
+
+		this->finishSearching();
+	}
+
+	std::shared_ptr<RadialDspSearcher> Operator_P_Async::buildRadialSearcher(const coordinate& new_base_coordinate) {
+
+		if (this->direction_sampler != nullptr) {
+			return std::make_shared<RadialDspSearcher>(this->database, new_base_coordinate, this->direction_sampler->sampleDirections(this->database, new_base_coordinate), this->lower_is_better, this->dsp_alpha, this->worker_num, this->thread_pool);
+		}
+
+		return std::make_shared<RadialDspSearcher>(this->database, new_base_coordinate, this->database->getSpaceDimension(), this->lower_is_better, this->dsp_alpha, std::unordered_set<DirectionLine>(), this->worker_num, this->thread_pool);
+	}
+
+	bool Operator_P_Async::isSearchFinished(void) {
+		return this->searching_phase == 2;
+	}
+
+	const coordinate& Operator_P_Async::getBestJudgedCoordinate(void) {
+		return this->base_coordinate;
+	}
+
+	const coordinate& Operator_P_Async::getBestMeasuredCoordinate(void) {
+		return this->base_coordinate;
+	}
+
+	void Operator_P_Async::setRemainingBudget(std::size_t remaining_num) {
+		this->remaining_budget = remaining_num;
+	}
+
+	std::string Operator_P_Async::getAlgorithmId(void) const {
+		return "P_ASYNC";
+	}
+
+	std::shared_ptr<DatabaseCore> Operator_P_Async::getDatabase(void) const {
+		return this->database;
+	}
+
+	std::size_t Operator_P_Async::getLoopCount(void) const {
+		return this->loop_count;
+	}
+
+	std::string Operator_P_Async::getSearchModeName(void) const {
+		switch (this->searching_phase) {
+		case 0:
+			return "Initial Search";
+		case 1:
+			return "Asynchronous Radial d-Spline Search";
+		default:
+			return "Finished";
+		}
+	}
+}
\ No newline at end of file
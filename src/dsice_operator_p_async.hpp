@@ -0,0 +1,236 @@
+﻿#ifndef DSICE_OPERATOR_P_ASYNC_HPP_
+#define DSICE_OPERATOR_P_ASYNC_HPP_
+
+#include <memory>
+#include <limits>
+#include <string>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_metric_type.hpp"
+#include "dsice_database_standard_functions.hpp"
+#include "dsice_searcher.hpp"
+#include "radial_dsp_searcher.hpp"
+#include "dsice_thread_pool.hpp"
+#include "initial_design.hpp"
+#include "direction_sampler.hpp"
+#include "dsice_operator.hpp"
+#include "parallel_operator_options.hpp"
+
+namespace dsice {
+
+	// ID : P_ASYNC
+	// P_2024B の反復放射型 d-Spline 並列探索法からループ単位の同期を取り除いたもの
+
+	/// <summary>
+	/// 反復放射型 d-Spline 探索法をループ単位の同期なしで実行する探索機構．<br/>
+	/// 実測結果は届いた時点で該当する直線の推定に反映し，いずれかの直線で基準点より良い点が見つかった時点で他の直線の完了を待たずに基準点を移動する．<br/>
+	/// 基準点の移動後に届いた古い実測結果もデータベースには記録される
+	/// </summary>
+	class Operator_P_Async final : public Operator {
+	private:
+		/// <summary>
+		/// データベース
+		/// </summary>
+		std::shared_ptr<DatabaseStandardFunctions> database;
+		/// <summary>
+		/// 実行中の探索アルゴリズム
+		/// </summary>
+		std::shared_ptr<Searcher> searcher;
+		/// <summary>
+		/// 探索フェーズ
+		/// </summary>
+		std::size_t searching_phase = 0;
+		/// <summary>
+		/// 低い値ほど良いかどうか
+		/// </summary>
+		bool lower_is_better;
+		/// <summary>
+		/// ログを記録するモードかどうか
+		/// </summary>
+		bool is_logging_mode_on;
+		/// <summary>
+		/// 近似関数の滑らかさを決定する重み係数
+		/// </summary>
+		double dsp_alpha;
+		/// <summary>
+		/// 並列に実測できる数 (直線探索の初期探索の分割数を決める，0 なら 3 分割)
+		/// </summary>
+		std::size_t worker_num = 0;
+		/// <summary>
+		/// 探索機構の構築や状態更新に用いるスレッドプール (nullptr の場合は逐次実行)
+		/// </summary>
+		std::shared_ptr<ThreadPool> thread_pool;
+		/// <summary>
+		/// 探索する方向を間引いて選ぶ機構 (nullptr の場合は全周辺方向を探索)
+		/// </summary>
+		std::shared_ptr<DirectionSampler> direction_sampler;
+		/// <summary>
+		/// 探索基準点
+		/// </summary>
+		coordinate base_coordinate;
+		/// <summary>
+		/// 基準点の値
+		/// </summary>
+		double base_value;
+		/// <summary>
+		/// 何ループ目か (setMetricValue() が呼ばれた回数)
+		/// </summary>
+		std::size_t loop_count = 0;
+		/// <summary>
+		/// 件数指定で取得された実測候補リスト (不足分を投機的実測候補で補ったもの)
+		/// </summary>
+		coordinate_list fixed_width_suggested_list;
+		/// <summary>
+		/// 残りの実測予算 (予算を設定していない場合は std::numeric_limits&lt;std::size_t&gt;::max())
+		/// </summary>
+		std::size_t remaining_budget = std::numeric_limits<std::size_t>::max();
+		/// <summary>
+		/// 直線探索 1 本を完了させるのに見込む実測数 (残りの予算が実行中の直線の数のこの倍に満たなければ予算が足りないとみなす)
+		/// </summary>
+		static constexpr std::size_t LINE_COMPLETION_COST = 2;
+		/// <summary>
+		/// 探索基準点を移動し，新しい基準点から放射状探索を開始
+		/// </summary>
+		/// <param name="new_base_coordinate">新しい基準点</param>
+		void moveBasePoint(const coordinate& new_base_coordinate);
+		/// <summary>
+		/// 現在の基準点で探索を終了
+		/// </summary>
+		void finishSearching(void);
+		/// <summary>
+		/// 放射状探索で改善が見られなかった際の処理．<br/>
+		/// 方向を間引いている場合は，未探索の方向が残っていれば選ぶ方向数を増やして同じ基準点で探索を続け，残っていなければ探索を終了．<br/>
+		/// ただし，残りの予算内に新しい方向の直線を完了できる見込みがなければ探索を終了
+		/// </summary>
+		void finishRadialSearch(void);
+		/// <summary>
+		/// 指定した基準点の放射状探索機構を構築
+		/// </summary>
+		/// <param name="new_base_coordinate">探索基準点</param>
+		/// <returns>構築した探索機構</returns>
+		std::shared_ptr<RadialDspSearcher> buildRadialSearcher(const coordinate& new_base_coordinate);
+		/// <summary>
+		/// 放射状探索の途中で基準点より良い点が実測済であれば，残りの直線の完了を待たずに基準点を移動
+		/// </summary>
+		/// <returns>基準点を移動した場合は true</returns>
+		bool moveBasePointEarly(void);
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="parameters">各性能パラメタが取りうる値の数リスト</param>
+		/// <param name="options">構築時設定</param>
+		Operator_P_Async(const space_size& parameters, const ParallelOperatorOptions& options = ParallelOperatorOptions());
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		Operator_P_Async(const Operator_P_Async& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~Operator_P_Async(void);
+		/// <summary>
+		/// 探索基準点を取得
+		/// </summary>
+		/// <returns>探索基準点</returns>
+		const coordinate& getBaseCoordinate(void) const override;
+		/// <summary>
+		/// 次に実測すべき性能パラメタ性能値 (座標) を取得
+		/// </summary>
+		/// <returns>次に実測すべき性能パラメタ性能値 (座標)</returns>
+		const coordinate& getSuggested(void) override;
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを取得
+		/// </summary>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(void) override;
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを指定件数で取得．<br/>
+		/// 実測中の点の数に 1 を加えた件数を指定することで，常に一定数の実測を途切れさせずに行える．<br/>
+		/// 探索機構の提案が指定件数に満たない場合は投機的実測候補で補い，探索終了時や未実測点が尽きた場合のみ指定件数未満となる
+		/// </summary>
+		/// <param name="suggested_num">取得する候補数</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(std::size_t suggested_num);
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを，指定した座標を除いて指定件数で取得．<br/>
+		/// 実測中の点と重複しない候補を並列実測の空き枠に割り当てるために用いる
+		/// </summary>
+		/// <param name="suggested_num">取得する候補数</param>
+		/// <param name="excluded_coordinates">除外する座標 (実測中の点など)</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(std::size_t suggested_num, const std::unordered_set<coordinate>& excluded_coordinates) override;
+		/// <summary>
+		/// 残りの実測予算を設定 (予算が足りなければ，間引いた方向の追加探索を行わずに現在の基準点で探索を終了する)
+		/// </summary>
+		/// <param name="remaining_num">残りの実測数</param>
+		void setRemainingBudget(std::size_t remaining_num) override;
+		/// <summary>
+		/// 実測データを記録
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void setMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// 実測データをデータベースにのみ記録 (探索機構には渡さない)
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void recordMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// データベースで集計済の性能評価値を探索機構に渡す
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		void commitMetricValue(const coordinate& measured_coordinate) override;
+		/// <summary>
+		/// 実測を途中で打ち切ったデータを記録 (性能評価値は打ち切り時点の限界値で，実際はこれより悪い)
+		/// </summary>
+		/// <param name="measured_coordinate">実測を打ち切った座標</param>
+		/// <param name="bound">打ち切り時点の限界値</param>
+		void setCensoredMetricValue(const coordinate& measured_coordinate, double bound) override;
+		/// <summary>
+		/// 状態を更新 (実測結果が 1 件でも届いていれば更新する)
+		/// </summary>
+		void updateState(void) override;
+		/// <summary>
+		/// 探索アルゴリズムが終了条件を満たしたかを取得．<br/>
+		/// 終了条件を持たない探索アルゴリズムの場合，この関数の挙動は各実装クラス依存です．
+		/// </summary>
+		/// <returns>終了条件を満たしていれば true</returns>
+		bool isSearchFinished(void) override;
+		/// <summary>
+		/// その時点で探索アルゴリズムが最良と判定している性能パラメタ設定値 (座標) を取得
+		/// </summary>
+		/// <returns>探索アルゴリズムが最良と判定している性能パラメタ設定値 (座標)</returns>
+		const coordinate& getBestJudgedCoordinate(void) override;
+		/// <summary>
+		/// 実測された中で性能評価値が最良だった性能パラメタ設定値 (座標) を取得
+		/// </summary>
+		/// <returns>実測された中で性能評価値が最良だった性能パラメタ設定値 (座標)</returns>
+		const coordinate& getBestMeasuredCoordinate(void) override;
+		/// <summary>
+		/// アルゴリズムセットの ID 文字列を取得
+		/// </summary>
+		/// <returns>アルゴリズムセットの ID 文字列</returns>
+		std::string getAlgorithmId(void) const override;
+		/// <summary>
+		/// 使用しているデータベースを取得
+		/// </summary>
+		/// <returns>使用しているデータベース</returns>
+		std::shared_ptr<DatabaseCore> getDatabase(void) const override;
+		/// <summary>
+		/// これまでのループ回数 (updateState() が呼ばれた回数) を取得
+		/// </summary>
+		/// <returns>これまでのループ回数</returns>
+		std::size_t getLoopCount(void) const override;
+		/// <summary>
+		/// 実行中の探索モード名を取得
+		/// </summary>
+		/// <returns>実行中の探索モード名</returns>
+		std::string getSearchModeName(void) const override;
+	};
+}
+
+#endif // !DSICE_OPERATOR_P_ASYNC_HPP_
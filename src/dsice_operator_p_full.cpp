@@ -0,0 +1,379 @@
+﻿#include <stdexcept>
+#include <memory>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <unordered_set>
+#include <unordered_map>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_metric_type.hpp"
+#include "dsice_standard_database.hpp"
+#include "dsice_logging_database.hpp"
+#include "equally_spaced_d_spline.hpp"
+#include "full_searcher.hpp"
+#include "uni_measurer.hpp"
+#include "dsice_operator_p_full.hpp"
+
+namespace dsice {
+
+	Operator_P_Full::Operator_P_Full(const space_size& parameters, bool low_value_is_better, bool logging_on, double alpha, DatabaseMetricType metric_type, double pruning_margin) {
+
+		if (parameters.empty()) {
+			throw std::invalid_argument("need one parameter at least.");
+		}
+		if (pruning_margin < 0) {
+			throw std::invalid_argument("pruning_margin must not be negative.");
+		}
+
+		this->lower_is_better = low_value_is_better;
+		this->is_logging_mode_on = logging_on;
+		this->dsp_alpha = alpha;
+		this->pruning_margin = pruning_margin;
+
+		if (this->is_logging_mode_on) {
+			this->database = std::make_shared<LoggingDatabase>(parameters, metric_type);
+		}
+		else {
+			this->database = std::make_shared<StandardDatabase>(parameters, metric_type);
+		}
+
+		// 全点を列挙
+		std::size_t points_num = 1;
+		for (std::size_t param_length : parameters) {
+			if (param_length == 0) {
+				throw std::invalid_argument("each parameter needs one value at least.");
+			}
+			if (points_num > std::numeric_limits<std::size_t>::max() / param_length) {
+				throw std::invalid_argument("search space is too large for full search.");
+			}
+			points_num *= param_length;
+		}
+
+		coordinate_list all_coordinates;
+		all_coordinates.reserve(points_num);
+		coordinate c(parameters.size(), 0);
+		for (std::size_t i = 0; i < points_num; i++) {
+
+			all_coordinates.push_back(c);
+
+			for (std::size_t j = 0; j < c.size(); j++) {
+				c[j]++;
+				if (c[j] < parameters[j]) {
+					break;
+				}
+				c[j] = 0;
+			}
+		}
+
+		// 同時に実測する点が空間上でまとまるよう Z 曲線の順に並べる
+		std::sort(all_coordinates.begin(), all_coordinates.end(), Operator_P_Full::isPrecedingOnCurve);
+
+		this->searcher = std::make_shared<FullSearcher>(all_coordinates, this->lower_is_better);
+		this->base_coordinate = all_coordinates[0];
+		this->database->setBasePoint(this->base_coordinate);
+
+		this->updateSuggestedList();
+
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->suggested_list);
+		}
+	}
+
+	Operator_P_Full::Operator_P_Full(const Operator_P_Full& original) {
+
+		this->searching_phase = original.searching_phase;
+		this->lower_is_better = original.lower_is_better;
+		this->is_logging_mode_on = original.is_logging_mode_on;
+		this->dsp_alpha = original.dsp_alpha;
+		this->pruning_margin = original.pruning_margin;
+		this->base_coordinate = original.base_coordinate;
+		this->pruned_coordinates = original.pruned_coordinates;
+		this->suggested_list = original.suggested_list;
+		this->fixed_width_suggested_list = original.fixed_width_suggested_list;
+		this->loop_count = original.loop_count;
+
+		if (std::shared_ptr<StandardDatabase> sd = std::dynamic_pointer_cast<StandardDatabase>(original.database)) {
+			this->database = std::make_shared<StandardDatabase>(*sd);
+		}
+		else {
+			this->database = std::make_shared<LoggingDatabase>(*(std::dynamic_pointer_cast<LoggingDatabase>(original.database)));
+		}
+
+		if (this->searching_phase == 0) {
+			this->searcher = std::make_shared<FullSearcher>(*(std::dynamic_pointer_cast<FullSearcher>(original.searcher)));
+		}
+		else {
+			this->searcher = std::make_shared<UniMeasurer>(*(std::dynamic_pointer_cast<UniMeasurer>(original.searcher)));
+		}
+	}
+
+	Operator_P_Full::~Operator_P_Full(void) {
+		// DO_NOTHING
+	}
+
+	bool Operator_P_Full::isBetter(double value, double compared_value) const {
+		if (this->lower_is_better) {
+			return value < compared_value;
+		}
+		else {
+			return value > compared_value;
+		}
+	}
+
+	bool Operator_P_Full::isPrecedingOnCurve(const coordinate& coordinate1, const coordinate& coordinate2) {
+
+		// 最上位の異なるビットが最も上位にある軸で比較する (ビットを交互に並べた値の比較と同じ)
+		std::size_t target_axis = 0;
+		std::size_t target_diff = 0;
+		for (std::size_t i = 0; i < coordinate1.size(); i++) {
+
+			std::size_t diff = coordinate1[i] ^ coordinate2[i];
+
+			if (target_diff < diff && target_diff < (target_diff ^ diff)) {
+				target_axis = i;
+				target_diff = diff;
+			}
+		}
+
+		return coordinate1[target_axis] < coordinate2[target_axis];
+	}
+
+	void Operator_P_Full::pruneHopelessCoordinates(void) {
+
+		if (this->pruning_margin == 0 || !this->database->hasSample(this->base_coordinate)) {
+			return;
+		}
+
+		double best_value = this->database->getSampleMetricValue(this->base_coordinate);
+		double tolerance = this->pruning_margin * std::abs(best_value);
+		const space_size& space = this->database->getSpaceSize();
+
+		// 未実測点ごとに，その点を通る各軸方向の直線上の d-Spline 推定値のうち最も良いもの
+		std::unordered_map<coordinate, double> optimistic_estimates;
+
+		for (std::size_t d = 0; d < space.size(); d++) {
+			for (const coordinate& line_origin : this->searcher->getTargetCoordinate()) {
+
+				// 軸 d の値が 0 の点で直線を代表させる
+				if (line_origin[d] != 0) {
+					continue;
+				}
+
+				coordinate c = line_origin;
+				std::vector<std::pair<std::size_t, double>> samples;
+				for (std::size_t i = 0; i < space[d]; i++) {
+					c[d] = i;
+					if (this->database->hasSample(c)) {
+						samples.emplace_back(i, this->database->getSampleMetricValue(c));
+					}
+				}
+
+				// 推定に足る実測がない直線や全点実測済の直線は使わない
+				if (samples.size() < 3 || samples.size() == space[d]) {
+					continue;
+				}
+
+				EquallySpacedDSpline d_spline(space[d], this->dsp_alpha);
+				d_spline.update(samples);
+
+				for (std::size_t i = 0; i < space[d]; i++) {
+					c[d] = i;
+					if (this->database->hasSample(c)) {
+						continue;
+					}
+
+					double estimated_value = d_spline.getSampleValue(i);
+					auto target = optimistic_estimates.find(c);
+					if (target == optimistic_estimates.end()) {
+						optimistic_estimates.emplace(c, estimated_value);
+					}
+					else if (this->isBetter(estimated_value, target->second)) {
+						target->second = estimated_value;
+					}
+				}
+			}
+		}
+
+		for (const std::pair<const coordinate, double>& estimate : optimistic_estimates) {
+			if (this->lower_is_better) {
+				if (estimate.second > best_value + tolerance) {
+					this->pruned_coordinates.insert(estimate.first);
+				}
+			}
+			else {
+				if (estimate.second < best_value - tolerance) {
+					this->pruned_coordinates.insert(estimate.first);
+				}
+			}
+		}
+	}
+
+	void Operator_P_Full::updateSuggestedList(void) {
+
+		this->suggested_list.clear();
+
+		for (const coordinate& c : this->searcher->getSuggestedList()) {
+			if (!this->pruned_coordinates.contains(c)) {
+				this->suggested_list.push_back(c);
+			}
+		}
+	}
+
+	void Operator_P_Full::finishSearching(void) {
+
+		this->searcher = std::make_shared<UniMeasurer>(this->base_coordinate);
+		this->searching_phase = 2;
+		this->suggested_list = this->searcher->getSuggestedList();
+
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+	}
+
+	const coordinate& Operator_P_Full::getBaseCoordinate(void) const {
+		return this->base_coordinate;
+	}
+
+	const coordinate& Operator_P_Full::getSuggested(void) {
+
+		this->updateState();
+
+		if (this->suggested_list.empty()) {
+			return this->base_coordinate;
+		}
+		else {
+			return this->suggested_list[0];
+		}
+	}
+
+	const coordinate_list& Operator_P_Full::getSuggestedList(void) {
+
+		this->updateState();
+
+		return this->suggested_list;
+	}
+
+	const coordinate_list& Operator_P_Full::getSuggestedList(std::size_t suggested_num) {
+		return this->getSuggestedList(suggested_num, std::unordered_set<coordinate>());
+	}
+
+	const coordinate_list& Operator_P_Full::getSuggestedList(std::size_t suggested_num, const std::unordered_set<coordinate>& excluded_coordinates) {
+
+		this->updateState();
+
+		this->fixed_width_suggested_list.clear();
+		for (const coordinate& c : this->suggested_list) {
+			if (this->fixed_width_suggested_list.size() >= suggested_num) {
+				break;
+			}
+			if (!excluded_coordinates.contains(c)) {
+				this->fixed_width_suggested_list.push_back(c);
+			}
+		}
+
+		return this->fixed_width_suggested_list;
+	}
+
+	void Operator_P_Full::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
+		this->database->setSampleMetricValue(measured_coordinate, metric_value);
+		this->searcher->setMetricValue(measured_coordinate, metric_value);
+	}
+
+	void Operator_P_Full::recordMetricValue(const coordinate& measured_coordinate, double metric_value) {
+		this->database->setSampleMetricValue(measured_coordinate, metric_value);
+	}
+
+	void Operator_P_Full::commitMetricValue(const coordinate& measured_coordinate) {
+		this->searcher->setMetricValue(measured_coordinate, this->database->getSampleMetricValue(measured_coordinate));
+	}
+
+	void Operator_P_Full::setCensoredMetricValue(const coordinate& measured_coordinate, double bound) {
+		this->setMetricValue(measured_coordinate, bound);
+		this->database->setSampleCensored(measured_coordinate);
+	}
+
+	void Operator_P_Full::updateState(void) {
+
+		bool searcher_updated = this->searcher->updateState();
+
+		if (!searcher_updated) {
+			return;
+		}
+
+		this->loop_count++;
+		this->database->setLoopEnd();
+
+		if (this->searching_phase != 0) {
+			if (this->is_logging_mode_on) {
+				std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+				ld->updateCandidateList(this->searcher->getSuggestedList());
+			}
+			return;
+		}
+
+		// 最良点を基準点として追跡
+		const coordinate& best_coordinate = this->searcher->getBestMeasuredCoordinate();
+		if (!best_coordinate.empty() && best_coordinate != this->base_coordinate) {
+			if (!this->database->hasSample(this->base_coordinate) || this->isBetter(this->database->getSampleMetricValue(best_coordinate), this->database->getSampleMetricValue(this->base_coordinate))) {
+				this->base_coordinate = best_coordinate;
+				this->database->setBasePoint(this->base_coordinate);
+			}
+		}
+
+		if (this->searcher->isSearchFinished()) {
+			this->finishSearching();
+			return;
+		}
+
+		this->pruneHopelessCoordinates();
+		this->updateSuggestedList();
+
+		if (this->suggested_list.empty()) {
+			this->finishSearching();
+			return;
+		}
+
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->suggested_list);
+		}
+	}
+
+	bool Operator_P_Full::isSearchFinished(void) {
+		return this->searching_phase == 2;
+	}
+
+	const coordinate& Operator_P_Full::getBestJudgedCoordinate(void) {
+		return this->base_coordinate;
+	}
+
+	const coordinate& Operator_P_Full::getBestMeasuredCoordinate(void) {
+		return this->base_coordinate;
+	}
+
+	std::string Operator_P_Full::getAlgorithmId(void) const {
+		return "P_FULL";
+	}
+
+	std::shared_ptr<DatabaseCore> Operator_P_Full::getDatabase(void) const {
+		return this->database;
+	}
+
+	std::size_t Operator_P_Full::getLoopCount(void) const {
+		return this->loop_count;
+	}
+
+	std::string Operator_P_Full::getSearchModeName(void) const {
+		switch (this->searching_phase) {
+		case 0:
+			return "Full Search";
+		default:
+			return "Finished";
+		}
+	}
+}
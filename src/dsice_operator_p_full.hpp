@@ -0,0 +1,215 @@
+﻿#ifndef DSICE_OPERATOR_P_FULL_HPP_
+#define DSICE_OPERATOR_P_FULL_HPP_
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_metric_type.hpp"
+#include "dsice_database_standard_functions.hpp"
+#include "dsice_searcher.hpp"
+#include "dsice_operator.hpp"
+
+namespace dsice {
+
+	// ID : P_FULL
+	// 小さな探索空間を多数の並列実測で全探索する
+
+	/// <summary>
+	/// 探索空間の全点を Z 曲線 (Morton 順序) の順に実測する並列全探索機構．<br/>
+	/// 並列実測数ずつ先頭から提案するため，同時に実測される点は空間上で近い位置にまとまる．<br/>
+	/// 枝刈りを有効にした場合，点を通る各軸方向の直線上の実測値から d-Spline で推定した値がいずれも最良値より明らかに悪い点は実測しない
+	/// </summary>
+	class Operator_P_Full final : public Operator {
+	private:
+		/// <summary>
+		/// データベース
+		/// </summary>
+		std::shared_ptr<DatabaseStandardFunctions> database;
+		/// <summary>
+		/// 実行中の探索アルゴリズム
+		/// </summary>
+		std::shared_ptr<Searcher> searcher;
+		/// <summary>
+		/// 探索フェーズ (0 : 全探索，2 : 終了)
+		/// </summary>
+		std::size_t searching_phase = 0;
+		/// <summary>
+		/// 低い値ほど良いかどうか
+		/// </summary>
+		bool lower_is_better;
+		/// <summary>
+		/// ログを記録するモードかどうか
+		/// </summary>
+		bool is_logging_mode_on;
+		/// <summary>
+		/// 近似関数の滑らかさを決定する重み係数
+		/// </summary>
+		double dsp_alpha;
+		/// <summary>
+		/// 枝刈りの余裕 (推定値と最良値の差が最良値の絶対値の何倍を超えたら枝刈りするか，0 なら枝刈りしない)
+		/// </summary>
+		double pruning_margin;
+		/// <summary>
+		/// 実測済の中で最良の点 (未実測の場合は曲線上の先頭点)
+		/// </summary>
+		coordinate base_coordinate;
+		/// <summary>
+		/// 枝刈りした点
+		/// </summary>
+		std::unordered_set<coordinate> pruned_coordinates;
+		/// <summary>
+		/// 全探索中の提案一覧 (枝刈りした点を除く)
+		/// </summary>
+		coordinate_list suggested_list;
+		/// <summary>
+		/// 件数を指定した提案一覧
+		/// </summary>
+		coordinate_list fixed_width_suggested_list;
+		/// <summary>
+		/// ループ回数
+		/// </summary>
+		std::size_t loop_count = 0;
+		/// <summary>
+		/// 値 1 が値 2 より良いか
+		/// </summary>
+		/// <param name="value">値 1</param>
+		/// <param name="compared_value">値 2</param>
+		/// <returns>値 1 の方が良ければ true</returns>
+		bool isBetter(double value, double compared_value) const;
+		/// <summary>
+		/// 座標 1 が Z 曲線上で座標 2 より前にあるか
+		/// </summary>
+		/// <param name="coordinate1">座標 1</param>
+		/// <param name="coordinate2">座標 2</param>
+		/// <returns>座標 1 が前にあれば true</returns>
+		static bool isPrecedingOnCurve(const coordinate& coordinate1, const coordinate& coordinate2);
+		/// <summary>
+		/// 各軸方向の直線ごとに d-Spline で未実測点の値を推定し，どの直線の推定値も見込みのない点を枝刈り
+		/// </summary>
+		void pruneHopelessCoordinates(void);
+		/// <summary>
+		/// 提案一覧を更新
+		/// </summary>
+		void updateSuggestedList(void);
+		/// <summary>
+		/// 全探索を終了し，最良点の実測に移る
+		/// </summary>
+		void finishSearching(void);
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="parameters">各性能パラメタが取りうる値の数リスト</param>
+		/// <param name="low_value_is_better">性能評価値が低い値ほど良いのであれば true</param>
+		/// <param name="logging_on">ログを取る場合は true</param>
+		/// <param name="alpha">枝刈りに用いる近似関数の滑らかさを決定する重み係数</param>
+		/// <param name="metric_type">性能パラメタの同一設定値に複数の性能評価値が登録された際の挙動</param>
+		/// <param name="pruning_margin">枝刈りの余裕 (0 なら枝刈りしない)</param>
+		Operator_P_Full(const space_size& parameters, bool low_value_is_better = true, bool logging_on = false, double alpha = 0.1, DatabaseMetricType metric_type = DatabaseMetricType::AverageDouble, double pruning_margin = 0);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		Operator_P_Full(const Operator_P_Full& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~Operator_P_Full(void);
+		/// <summary>
+		/// 探索基準点 (実測済の中で最良の点) を取得
+		/// </summary>
+		/// <returns>探索基準点</returns>
+		const coordinate& getBaseCoordinate(void) const override;
+		/// <summary>
+		/// 次に実測すべき性能パラメタ性能値 (座標) を取得
+		/// </summary>
+		/// <returns>次に実測すべき性能パラメタ性能値 (座標)</returns>
+		const coordinate& getSuggested(void) override;
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを Z 曲線の順に取得
+		/// </summary>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(void) override;
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを Z 曲線の順に指定件数まで取得
+		/// </summary>
+		/// <param name="suggested_num">取得する件数</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(std::size_t suggested_num);
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを，指定した座標を除いて指定件数で取得．<br/>
+		/// 実測中の点と重複しない候補を並列実測の空き枠に割り当てるために用いる
+		/// </summary>
+		/// <param name="suggested_num">取得する候補数</param>
+		/// <param name="excluded_coordinates">除外する座標 (実測中の点など)</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(std::size_t suggested_num, const std::unordered_set<coordinate>& excluded_coordinates) override;
+		/// <summary>
+		/// 実測データを記録
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void setMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// 実測データをデータベースにのみ記録 (探索機構には渡さない)
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void recordMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// データベースで集計済の性能評価値を探索機構に渡す
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		void commitMetricValue(const coordinate& measured_coordinate) override;
+		/// <summary>
+		/// 実測を途中で打ち切ったデータを記録 (性能評価値は打ち切り時点の限界値で，実際はこれより悪い)
+		/// </summary>
+		/// <param name="measured_coordinate">実測を打ち切った座標</param>
+		/// <param name="bound">打ち切り時点の限界値</param>
+		void setCensoredMetricValue(const coordinate& measured_coordinate, double bound) override;
+		/// <summary>
+		/// 状態を更新
+		/// </summary>
+		void updateState(void) override;
+		/// <summary>
+		/// 探索アルゴリズムが終了条件を満たしたかを取得．<br/>
+		/// 終了条件を持たない探索アルゴリズムの場合，この関数の挙動は各実装クラス依存です．
+		/// </summary>
+		/// <returns>終了条件を満たしていれば true</returns>
+		bool isSearchFinished(void) override;
+		/// <summary>
+		/// その時点で探索アルゴリズムが最良と判定している性能パラメタ設定値 (座標) を取得
+		/// </summary>
+		/// <returns>探索アルゴリズムが最良と判定している性能パラメタ設定値 (座標)</returns>
+		const coordinate& getBestJudgedCoordinate(void) override;
+		/// <summary>
+		/// 実測された中で性能評価値が最良だった性能パラメタ設定値 (座標) を取得
+		/// </summary>
+		/// <returns>実測された中で性能評価値が最良だった性能パラメタ設定値 (座標)</returns>
+		const coordinate& getBestMeasuredCoordinate(void) override;
+		/// <summary>
+		/// アルゴリズムセットの ID 文字列を取得
+		/// </summary>
+		/// <returns>アルゴリズムセットの ID 文字列</returns>
+		std::string getAlgorithmId(void) const override;
+		/// <summary>
+		/// 使用しているデータベースを取得
+		/// </summary>
+		/// <returns>使用しているデータベース</returns>
+		std::shared_ptr<DatabaseCore> getDatabase(void) const override;
+		/// <summary>
+		/// これまでのループ回数 (updateState() が呼ばれた回数) を取得
+		/// </summary>
+		/// <returns>これまでのループ回数</returns>
+		std::size_t getLoopCount(void) const override;
+		/// <summary>
+		/// 実行中の探索モード名を取得
+		/// </summary>
+		/// <returns>実行中の探索モード名</returns>
+		std::string getSearchModeName(void) const override;
+	};
+}
+
+#endif // !DSICE_OPERATOR_P_FULL_HPP_
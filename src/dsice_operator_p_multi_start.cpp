@@ -0,0 +1,695 @@
+﻿#include <stdexcept>
+#include <memory>
+#include <limits>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "direction_line.hpp"
+#include "dsice_database_metric_type.hpp"
+#include "dsice_standard_database.hpp"
+#include "dsice_logging_database.hpp"
+#include "simple_lhd_searcher.hpp"
+#include "radial_dsp_searcher.hpp"
+#include "around_points.hpp"
+#include "uni_measurer.hpp"
+#include "dsice_thread_pool.hpp"
+#include "initial_design.hpp"
+#include "direction_sampler.hpp"
+#include "dsice_operator_p_multi_start.hpp"
+
+namespace dsice {
+
+	Operator_P_MultiStart::Operator_P_MultiStart(const space_size& parameters, const ParallelOperatorOptions& options) {
+
+		if (parameters.empty()) {
+			throw std::invalid_argument("need one parameter at least.");
+		}
+		if (options.start_num == 0) {
+			throw std::invalid_argument("start_num must be greater than 0.");
+		}
+
+		this->lower_is_better = options.lower_is_better;
+		this->is_logging_mode_on = options.logging_on;
+		this->dsp_alpha = options.alpha;
+		this->worker_num = options.worker_num;
+		this->thread_pool = options.thread_pool;
+		this->start_num = options.start_num;
+
+		if (options.sampled_max_changed_axis_num > 0) {
+			this->direction_sampler = std::make_shared<DirectionSampler>(parameters, options.sampled_max_changed_axis_num, options.sampled_direction_budget);
+		}
+
+		if (this->is_logging_mode_on) {
+			this->database = std::make_shared<LoggingDatabase>(parameters, options.metric_type);
+		}
+		else {
+			this->database = std::make_shared<StandardDatabase>(parameters, options.metric_type);
+		}
+
+		// 複数の開始点を選ぶため，初期点は常に LHD 初期探索で決める
+		if (options.initial_design != nullptr) {
+			this->searcher = std::make_shared<SimpleLhdSearcher>(this->database, options.initial_design->generate(*this->database, this->thread_pool), this->lower_is_better);
+		}
+		else {
+			this->searcher = std::make_shared<SimpleLhdSearcher>(this->database, this->lower_is_better);
+		}
+
+		this->base_coordinate = this->searcher->getSuggested();
+		this->database->setBasePoint(this->base_coordinate);
+
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+	}
+
+	Operator_P_MultiStart::Operator_P_MultiStart(const Operator_P_MultiStart& original) {
+
+		this->searching_phase = original.searching_phase;
+		this->lower_is_better = original.lower_is_better;
+		this->is_logging_mode_on = original.is_logging_mode_on;
+		this->dsp_alpha = original.dsp_alpha;
+		this->worker_num = original.worker_num;
+		this->thread_pool = original.thread_pool;
+		this->remaining_budget = original.remaining_budget;
+		if (original.direction_sampler != nullptr) {
+			this->direction_sampler = std::make_shared<DirectionSampler>(*original.direction_sampler);
+		}
+		this->start_num = original.start_num;
+		this->base_coordinate = original.base_coordinate;
+		this->start_base_coordinates = original.start_base_coordinates;
+		this->start_base_values = original.start_base_values;
+		this->finished_base_coordinates = original.finished_base_coordinates;
+		this->loop_count = original.loop_count;
+		this->merged_suggested_list = original.merged_suggested_list;
+		this->fixed_width_suggested_list = original.fixed_width_suggested_list;
+
+		if (std::shared_ptr<StandardDatabase> sd = std::dynamic_pointer_cast<StandardDatabase>(original.database)) {
+			this->database = std::make_shared<StandardDatabase>(*sd);
+		}
+		else {
+			this->database = std::make_shared<LoggingDatabase>(*(std::dynamic_pointer_cast<LoggingDatabase>(original.database)));
+		}
+
+		for (const std::shared_ptr<RadialDspSearcher>& s : original.start_searchers) {
+			this->start_searchers.push_back(std::make_shared<RadialDspSearcher>(*s, this->database));
+		}
+
+		switch (this->searching_phase) {
+		case 0:
+			this->searcher = std::make_shared<SimpleLhdSearcher>(*(std::dynamic_pointer_cast<SimpleLhdSearcher>(original.searcher)));
+			break;
+		case 2:
+			this->searcher = std::make_shared<UniMeasurer>(*(std::dynamic_pointer_cast<UniMeasurer>(original.searcher)));
+			break;
+		}
+	}
+
+	Operator_P_MultiStart::~Operator_P_MultiStart(void) {
+		// DO_NOTHING
+	}
+
+	bool Operator_P_MultiStart::isBetter(double value, double compared_value) const {
+		if (this->lower_is_better) {
+			return value < compared_value;
+		}
+		else {
+			return value > compared_value;
+		}
+	}
+
+	bool Operator_P_MultiStart::isNeighbor(const coordinate& coordinate1, const coordinate& coordinate2) {
+
+		for (std::size_t i = 0; i < coordinate1.size(); i++) {
+			std::size_t distance = coordinate1[i] > coordinate2[i] ? coordinate1[i] - coordinate2[i] : coordinate2[i] - coordinate1[i];
+			if (distance > 1) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void Operator_P_MultiStart::startRadialSearches(void) {
+
+		// 初期探索で実測した点を良い順に並べる
+		std::vector<std::pair<double, coordinate>> ranked;
+		for (const coordinate& c : this->searcher->getTargetCoordinate()) {
+			if (this->database->hasSample(c)) {
+				ranked.emplace_back(this->database->getSampleMetricValue(c), c);
+			}
+		}
+		std::stable_sort(ranked.begin(), ranked.end(), [this](const std::pair<double, coordinate>& a, const std::pair<double, coordinate>& b) {
+			return this->isBetter(a.first, b.first);
+		});
+
+		// 隣接する点は同じ谷とみなし，上位から開始点を選ぶ
+		for (const std::pair<double, coordinate>& r : ranked) {
+
+			if (this->start_base_coordinates.size() >= this->start_num) {
+				break;
+			}
+
+			bool is_duplicated = false;
+			for (const coordinate& c : this->start_base_coordinates) {
+				if (Operator_P_MultiStart::isNeighbor(r.second, c)) {
+					is_duplicated = true;
+					break;
+				}
+			}
+			if (is_duplicated) {
+				continue;
+			}
+
+			this->start_base_coordinates.push_back(r.second);
+			this->start_base_values.push_back(r.first);
+
+			this->start_searchers.push_back(this->buildRadialSearcher(r.second));
+		}
+
+		this->searcher = nullptr;
+		this->searching_phase = 1;
+
+		// RadialDspSearcher は基準点の最良推定を実測するまで終了しないため，ここで終了していればその開始点の探索は不要
+		for (std::size_t i = 0; i < this->start_searchers.size();) {
+			if (this->start_searchers[i]->isSearchFinished() && !this->restartStart(i)) {
+				this->finishStart(i);
+			}
+			else {
+				i++;
+			}
+		}
+
+		this->updateBaseCoordinate();
+
+		if (this->start_searchers.empty()) {
+			this->finishSearching();
+			return;
+		}
+
+		this->merged_suggested_list.clear();
+		std::vector<coordinate_list> candidate_lists;
+		for (std::size_t i : this->getRankedStarts()) {
+			candidate_lists.push_back(this->start_searchers[i]->getSuggestedList());
+		}
+		this->merged_suggested_list = Operator_P_MultiStart::mergeByRank(candidate_lists, std::numeric_limits<std::size_t>::max());
+
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->merged_suggested_list);
+		}
+	}
+
+	void Operator_P_MultiStart::moveBasePoint(std::size_t start_idx, const coordinate& new_base_coordinate) {
+
+		DirectionLine trajectry_line = DirectionLine(this->start_base_coordinates[start_idx], new_base_coordinate);
+		this->start_base_coordinates[start_idx] = new_base_coordinate;
+		this->database->recordSearchedDirection(new_base_coordinate, trajectry_line);
+		this->start_base_values[start_idx] = this->database->getSampleMetricValue(new_base_coordinate);
+
+		this->start_searchers[start_idx] = this->buildRadialSearcher(new_base_coordinate);
+	}
+
+	void Operator_P_MultiStart::finishStart(std::size_t start_idx) {
+
+		const std::unordered_set<DirectionLine>& searched_directions = this->start_searchers[start_idx]->getFinishedDirections();
+		for (const DirectionLine& direction : searched_directions) {
+			this->database->recordSearchedDirection(this->start_base_coordinates[start_idx], direction);
+		}
+
+		this->finished_base_coordinates.push_back(this->start_base_coordinates[start_idx]);
+
+		this->start_searchers.erase(this->start_searchers.begin() + start_idx);
+		this->start_base_coordinates.erase(this->start_base_coordinates.begin() + start_idx);
+		this->start_base_values.erase(this->start_base_values.begin() + start_idx);
+	}
+
+	bool Operator_P_MultiStart::restartStart(std::size_t start_idx) {
+
+		if (this->direction_sampler == nullptr) {
+			return false;
+		}
+
+		// 方向を間引いている場合，同時変化軸数が上限以下の方向をすべて探索するまでは局所最適と判断しない
+		const coordinate& start_base_coordinate = this->start_base_coordinates[start_idx];
+
+		do {
+
+			const std::unordered_set<DirectionLine>& searched_directions = this->start_searchers[start_idx]->getFinishedDirections();
+			for (const DirectionLine& direction : searched_directions) {
+				this->database->recordSearchedDirection(start_base_coordinate, direction);
+			}
+
+			if (!this->direction_sampler->hasUnsearchedDirection(this->database, start_base_coordinate)) {
+				return false;
+			}
+
+			this->start_searchers[start_idx] = this->buildRadialSearcher(start_base_coordinate);
+
+		} while (this->start_searchers[start_idx]->isSearchFinished());
+
+		return true;
+	}
+
+	std::shared_ptr<RadialDspSearcher> Operator_P_MultiStart::buildRadialSearcher(const coordinate& new_base_coordinate) {
+
+		// 並列実測数は開始点間で分け合う
+		if (this->direction_sampler != nullptr) {
+			return std::make_shared<RadialDspSearcher>(this->database, new_base_coordinate, this->direction_sampler->sampleDirections(this->database, new_base_coordinate), this->lower_is_better, this->dsp_alpha, this->worker_num / this->start_num, this->thread_pool);
+		}
+
+		return std::make_shared<RadialDspSearcher>(this->database, new_base_coordinate, this->database->getSpaceDimension(), this->lower_is_better, this->dsp_alpha, std::unordered_set<DirectionLine>(), this->worker_num / this->start_num, this->thread_pool);
+	}
+
+	void Operator_P_MultiStart::mergeConvergedStarts(void) {
+
+		bool is_merged = true;
+
+		while (is_merged) {
+
+			is_merged = false;
+
+			for (std::size_t i = 0; i < this->start_searchers.size() && !is_merged; i++) {
+
+				// 実行中の探索同士は値の悪い方を打ち切る
+				for (std::size_t j = i + 1; j < this->start_searchers.size(); j++) {
+					if (Operator_P_MultiStart::isNeighbor(this->start_base_coordinates[i], this->start_base_coordinates[j])) {
+						this->finishStart(this->isBetter(this->start_base_values[j], this->start_base_values[i]) ? i : j);
+						is_merged = true;
+						break;
+					}
+				}
+
+				if (is_merged) {
+					break;
+				}
+
+				// 終了済の探索の谷に入り，その基準点より良くない場合も打ち切る
+				for (const coordinate& c : this->finished_base_coordinates) {
+					if (Operator_P_MultiStart::isNeighbor(this->start_base_coordinates[i], c) && !this->isBetter(this->start_base_values[i], this->database->getSampleMetricValue(c))) {
+						this->finishStart(i);
+						is_merged = true;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	void Operator_P_MultiStart::concentrateOnBestStart(void) {
+
+		if (this->start_searchers.size() <= 1) {
+			return;
+		}
+
+		std::size_t running_num = 0;
+		for (const std::shared_ptr<RadialDspSearcher>& s : this->start_searchers) {
+			running_num += s->getRunningSearchersNum();
+		}
+
+		if (this->remaining_budget / Operator_P_MultiStart::LINE_COMPLETION_COST >= running_num) {
+			return;
+		}
+
+		// 後ろから打ち切ることで，最良の探索のインデックスを打ち切りの影響を受けないようにする
+		std::size_t best_idx = this->getRankedStarts()[0];
+		for (std::size_t i = this->start_searchers.size(); i > 0; i--) {
+			if (i - 1 != best_idx) {
+				this->finishStart(i - 1);
+			}
+		}
+	}
+
+	void Operator_P_MultiStart::updateBaseCoordinate(void) {
+
+		coordinate best_coordinate = this->base_coordinate;
+		bool has_best = this->database->hasSample(best_coordinate);
+		double best_value = has_best ? this->database->getSampleMetricValue(best_coordinate) : 0;
+
+		for (const coordinate_list* list : { &this->start_base_coordinates, &this->finished_base_coordinates }) {
+			for (const coordinate& c : *list) {
+
+				double v = this->database->getSampleMetricValue(c);
+
+				if (!has_best || this->isBetter(v, best_value)) {
+					best_coordinate = c;
+					best_value = v;
+					has_best = true;
+				}
+			}
+		}
+
+		if (best_coordinate != this->base_coordinate) {
+			this->base_coordinate = best_coordinate;
+			this->database->setBasePoint(this->base_coordinate);
+		}
+	}
+
+	std::vector<std::size_t> Operator_P_MultiStart::getRankedStarts(void) const {
+
+		std::vector<std::size_t> ranked;
+		for (std::size_t i = 0; i < this->start_searchers.size(); i++) {
+			ranked.push_back(i);
+		}
+
+		std::stable_sort(ranked.begin(), ranked.end(), [this](std::size_t a, std::size_t b) {
+			return this->isBetter(this->start_base_values[a], this->start_base_values[b]);
+		});
+
+		return ranked;
+	}
+
+	coordinate_list Operator_P_MultiStart::mergeByRank(const std::vector<coordinate_list>& candidate_lists, std::size_t max_num) {
+
+		coordinate_list merged;
+		std::unordered_set<coordinate> listed;
+		std::vector<std::size_t> positions(candidate_lists.size(), 0);
+
+		bool has_remaining = true;
+		while (has_remaining && merged.size() < max_num) {
+
+			has_remaining = false;
+
+			// 順位 r の探索には 1 巡あたり (探索数 - r) 件の枠を割り当てる
+			for (std::size_t i = 0; i < candidate_lists.size() && merged.size() < max_num; i++) {
+
+				std::size_t quota = candidate_lists.size() - i;
+
+				while (quota > 0 && positions[i] < candidate_lists[i].size() && merged.size() < max_num) {
+
+					const coordinate& c = candidate_lists[i][positions[i]];
+					positions[i]++;
+
+					if (listed.insert(c).second) {
+						merged.push_back(c);
+						quota--;
+					}
+				}
+
+				if (positions[i] < candidate_lists[i].size()) {
+					has_remaining = true;
+				}
+			}
+		}
+
+		return merged;
+	}
+
+	void Operator_P_MultiStart::finishSearching(void) {
+
+		this->updateBaseCoordinate();
+
+		this->searcher = std::make_shared<UniMeasurer>(this->base_coordinate);
+		this->searching_phase = 2;
+		if (this->is_logging_mode_on) {
+			std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+			ld->updateCandidateList(this->searcher->getSuggestedList());
+		}
+	}
+
+	const coordinate& Operator_P_MultiStart::getBaseCoordinate(void) const {
+		return this->base_coordinate;
+	}
+
+	const coordinate& Operator_P_MultiStart::getSuggested(void) {
+
+		this->updateState();
+
+		if (this->searching_phase != 1) {
+			return this->searcher->getSuggested();
+		}
+		else if (this->merged_suggested_list.empty()) {
+			return this->base_coordinate;
+		}
+		else {
+			return this->merged_suggested_list[0];
+		}
+	}
+
+	const coordinate_list& Operator_P_MultiStart::getSuggestedList(void) {
+
+		this->updateState();
+
+		if (this->searching_phase != 1) {
+			return this->searcher->getSuggestedList();
+		}
+		else {
+			return this->merged_suggested_list;
+		}
+	}
+
+	const coordinate_list& Operator_P_MultiStart::getSuggestedList(std::size_t suggested_num) {
+		return this->getSuggestedList(suggested_num, std::unordered_set<coordinate>());
+	}
+
+	const coordinate_list& Operator_P_MultiStart::getSuggestedList(std::size_t suggested_num, const std::unordered_set<coordinate>& excluded_coordinates) {
+
+		this->updateState();
+
+		this->fixed_width_suggested_list.clear();
+
+		switch (this->searching_phase) {
+		case 0: {
+
+			std::unordered_set<coordinate> listed = excluded_coordinates;
+			for (const coordinate& c : this->searcher->getSuggestedList()) {
+				if (this->fixed_width_suggested_list.size() >= suggested_num) {
+					break;
+				}
+				if (listed.insert(c).second) {
+					this->fixed_width_suggested_list.push_back(c);
+				}
+			}
+
+			// 初期探索中は基準点の周辺点で補う
+			std::size_t around_axis_num = this->direction_sampler != nullptr ? this->direction_sampler->getMaxChangedAxisNum() : this->database->getSpaceDimension();
+			AroundPoints base_around(this->database->getSpaceSize(), this->base_coordinate, around_axis_num);
+			for (const coordinate& c : base_around.getAroundPoints()) {
+				if (this->fixed_width_suggested_list.size() >= suggested_num) {
+					break;
+				}
+				if (!this->database->hasSample(c) && listed.insert(c).second) {
+					this->fixed_width_suggested_list.push_back(c);
+				}
+			}
+
+			break;
+		}
+		case 1: {
+
+			// 各探索の提案の後に投機的実測候補を続け，基準点の値が良い探索ほど多くの枠を割り当てる
+			std::vector<coordinate_list> candidate_lists;
+			for (std::size_t i : this->getRankedStarts()) {
+				candidate_lists.push_back(this->start_searchers[i]->getSuggestedList(suggested_num, excluded_coordinates));
+				coordinate_list speculative = this->start_searchers[i]->getSpeculativeCandidates(excluded_coordinates, suggested_num);
+				candidate_lists.back().insert(candidate_lists.back().end(), speculative.begin(), speculative.end());
+			}
+			this->fixed_width_suggested_list = Operator_P_MultiStart::mergeByRank(candidate_lists, suggested_num);
+
+			break;
+		}
+		default:
+
+			// 探索終了後は投機的に実測する意味がない
+			for (const coordinate& c : this->searcher->getSuggestedList()) {
+				if (this->fixed_width_suggested_list.size() >= suggested_num) {
+					break;
+				}
+				if (!excluded_coordinates.contains(c)) {
+					this->fixed_width_suggested_list.push_back(c);
+				}
+			}
+
+			break;
+		}
+
+		return this->fixed_width_suggested_list;
+	}
+
+	void Operator_P_MultiStart::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
+		this->recordMetricValue(measured_coordinate, metric_value);
+		this->passMetricValue(measured_coordinate, metric_value);
+	}
+
+	void Operator_P_MultiStart::recordMetricValue(const coordinate& measured_coordinate, double metric_value) {
+		this->database->setSampleMetricValue(measured_coordinate, metric_value);
+	}
+
+	void Operator_P_MultiStart::commitMetricValue(const coordinate& measured_coordinate) {
+		this->passMetricValue(measured_coordinate, this->database->getSampleMetricValue(measured_coordinate));
+	}
+
+	void Operator_P_MultiStart::passMetricValue(const coordinate& measured_coordinate, double metric_value) {
+
+		// データベースを共有しているため，どの探索の提案かによらず全探索に渡す (担当外の点は無視される)
+		if (this->searching_phase == 1) {
+			for (const std::shared_ptr<RadialDspSearcher>& s : this->start_searchers) {
+				s->setMetricValue(measured_coordinate, metric_value);
+			}
+		}
+		else {
+			this->searcher->setMetricValue(measured_coordinate, metric_value);
+		}
+	}
+
+	void Operator_P_MultiStart::setCensoredMetricValue(const coordinate& measured_coordinate, double bound) {
+		this->setMetricValue(measured_coordinate, bound);
+		this->database->setSampleCensored(measured_coordinate);
+	}
+
+	void Operator_P_MultiStart::updateState(void) {
+
+		bool searcher_updated = false;
+		if (this->searching_phase == 1) {
+			for (const std::shared_ptr<RadialDspSearcher>& s : this->start_searchers) {
+				if (s->updateState()) {
+					searcher_updated = true;
+				}
+			}
+		}
+		else {
+			searcher_updated = this->searcher->updateState();
+		}
+
+		if (!searcher_updated) {
+			return;
+		}
+
+		this->loop_count++;
+		this->database->setLoopEnd();
+
+		switch (this->searching_phase) {
+		case 0:
+
+			if (this->is_logging_mode_on) {
+				std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+				ld->updateCandidateList(this->searcher->getSuggestedList());
+			}
+
+			if (this->searcher->isSearchFinished()) {
+				this->startRadialSearches();
+			}
+
+			break;
+		case 1: {
+
+			for (std::size_t i = 0; i < this->start_searchers.size();) {
+
+				if (!this->start_searchers[i]->isSearchFinished()) {
+					i++;
+					continue;
+				}
+
+				// Searcher の差し替え後も使うためコピー
+				coordinate tmp_good_coordinate = this->start_searchers[i]->getBestMeasuredCoordinate();
+
+				const std::unordered_set<DirectionLine>& searched_directions = this->start_searchers[i]->getFinishedDirections();
+
+				if (tmp_good_coordinate.empty() || !this->database->hasSample(tmp_good_coordinate) || !this->isBetter(this->database->getSampleMetricValue(tmp_good_coordinate), this->start_base_values[i])) {
+
+					if (this->direction_sampler != nullptr) {
+						this->direction_sampler->recordRound(this->start_base_coordinates[i], searched_directions, this->start_base_coordinates[i]);
+					}
+
+					if (this->restartStart(i)) {
+						i++;
+					}
+					else {
+						this->finishStart(i);
+					}
+					continue;
+				}
+
+				for (const DirectionLine& direction : searched_directions) {
+					this->database->recordSearchedDirection(this->start_base_coordinates[i], direction);
+				}
+
+				if (this->direction_sampler != nullptr) {
+					this->direction_sampler->recordRound(this->start_base_coordinates[i], searched_directions, tmp_good_coordinate);
+				}
+
+				this->moveBasePoint(i, tmp_good_coordinate);
+
+				if (this->start_searchers[i]->isSearchFinished() && !this->restartStart(i)) {
+					this->finishStart(i);
+				}
+				else {
+					i++;
+				}
+			}
+
+			this->mergeConvergedStarts();
+			this->concentrateOnBestStart();
+			this->updateBaseCoordinate();
+
+			if (this->start_searchers.empty()) {
+				this->finishSearching();
+				break;
+			}
+
+			std::vector<coordinate_list> candidate_lists;
+			for (std::size_t i : this->getRankedStarts()) {
+				candidate_lists.push_back(this->start_searchers[i]->getSuggestedList());
+			}
+			this->merged_suggested_list = Operator_P_MultiStart::mergeByRank(candidate_lists, std::numeric_limits<std::size_t>::max());
+
+			if (this->is_logging_mode_on) {
+				std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+				ld->updateCandidateList(this->merged_suggested_list);
+			}
+
+			break;
+		}
+		default:
+
+			if (this->is_logging_mode_on) {
+				std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+				ld->updateCandidateList(this->searcher->getSuggestedList());
+			}
+
+			break;
+		}
+	}
+
+	bool Operator_P_MultiStart::isSearchFinished(void) {
+		return this->searching_phase == 2;
+	}
+
+	const coordinate& Operator_P_MultiStart::getBestJudgedCoordinate(void) {
+		return this->base_coordinate;
+	}
+
+	const coordinate& Operator_P_MultiStart::getBestMeasuredCoordinate(void) {
+		return this->base_coordinate;
+	}
+
+	void Operator_P_MultiStart::setRemainingBudget(std::size_t remaining_num) {
+		this->remaining_budget = remaining_num;
+	}
+
+	std::string Operator_P_MultiStart::getAlgorithmId(void) const {
+		return "P_MULTI_START";
+	}
+
+	std::shared_ptr<DatabaseCore> Operator_P_MultiStart::getDatabase(void) const {
+		return this->database;
+	}
+
+	std::size_t Operator_P_MultiStart::getLoopCount(void) const {
+		return this->loop_count;
+	}
+
+	std::string Operator_P_MultiStart::getSearchModeName(void) const {
+		switch (this->searching_phase) {
+		case 0:
+			return "Initial Search";
+		case 1:
+			return "Multi-Start Radial d-Spline Search";
+		default:
+			return "Finished";
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,306 @@
+﻿#ifndef DSICE_OPERATOR_P_MULTI_START_HPP_
+#define DSICE_OPERATOR_P_MULTI_START_HPP_
+
+#include <memory>
+#include <limits>
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_metric_type.hpp"
+#include "dsice_database_standard_functions.hpp"
+#include "dsice_searcher.hpp"
+#include "radial_dsp_searcher.hpp"
+#include "dsice_thread_pool.hpp"
+#include "initial_design.hpp"
+#include "direction_sampler.hpp"
+#include "dsice_operator.hpp"
+#include "parallel_operator_options.hpp"
+
+namespace dsice {
+
+	// ID : P_MULTI_START
+	// P_2024B の反復放射型 d-Spline 並列探索法を，LHD 初期探索の上位点から複数同時に開始するもの
+
+	/// <summary>
+	/// LHD 初期探索の上位点それぞれを探索基準点とし，反復放射型 d-Spline 探索を複数同時に実行する探索機構．<br/>
+	/// 各探索はデータベースを共有し，実測候補の枠は基準点の値が良い探索ほど多く割り当てる．<br/>
+	/// 基準点同士が隣接した (同じ谷に収束した) 場合は，値の悪い方の探索を打ち切って統合する
+	/// </summary>
+	class Operator_P_MultiStart final : public Operator {
+	private:
+		/// <summary>
+		/// データベース
+		/// </summary>
+		std::shared_ptr<DatabaseStandardFunctions> database;
+		/// <summary>
+		/// 初期探索中および探索終了後の探索アルゴリズム (放射状探索中は使用しない)
+		/// </summary>
+		std::shared_ptr<Searcher> searcher;
+		/// <summary>
+		/// 探索フェーズ
+		/// </summary>
+		std::size_t searching_phase = 0;
+		/// <summary>
+		/// 低い値ほど良いかどうか
+		/// </summary>
+		bool lower_is_better;
+		/// <summary>
+		/// ログを記録するモードかどうか
+		/// </summary>
+		bool is_logging_mode_on;
+		/// <summary>
+		/// 近似関数の滑らかさを決定する重み係数
+		/// </summary>
+		double dsp_alpha;
+		/// <summary>
+		/// 並列に実測できる数 (直線探索の初期探索の分割数を決める，0 なら 3 分割)
+		/// </summary>
+		std::size_t worker_num = 0;
+		/// <summary>
+		/// 探索機構の構築や状態更新に用いるスレッドプール (nullptr の場合は逐次実行)
+		/// </summary>
+		std::shared_ptr<ThreadPool> thread_pool;
+		/// <summary>
+		/// 探索する方向を間引いて選ぶ機構 (nullptr の場合は全周辺方向を探索，全開始点で共有)
+		/// </summary>
+		std::shared_ptr<DirectionSampler> direction_sampler;
+		/// <summary>
+		/// 同時に実行する放射状探索の最大数
+		/// </summary>
+		std::size_t start_num;
+		/// <summary>
+		/// 全探索の基準点のうち最良のもの
+		/// </summary>
+		coordinate base_coordinate;
+		/// <summary>
+		/// 実行中の放射状探索
+		/// </summary>
+		std::vector<std::shared_ptr<RadialDspSearcher>> start_searchers;
+		/// <summary>
+		/// 実行中の放射状探索それぞれの基準点
+		/// </summary>
+		coordinate_list start_base_coordinates;
+		/// <summary>
+		/// 実行中の放射状探索それぞれの基準点の値
+		/// </summary>
+		std::vector<double> start_base_values;
+		/// <summary>
+		/// 終了した放射状探索の最終的な基準点 (以降に同じ谷へ至った探索の統合に使用)
+		/// </summary>
+		coordinate_list finished_base_coordinates;
+		/// <summary>
+		/// 何ループ目か (setMetricValue() が呼ばれた回数)
+		/// </summary>
+		std::size_t loop_count = 0;
+		/// <summary>
+		/// 各探索の実測候補を統合したリスト
+		/// </summary>
+		coordinate_list merged_suggested_list;
+		/// <summary>
+		/// 件数指定で取得された実測候補リスト (不足分を投機的実測候補で補ったもの)
+		/// </summary>
+		coordinate_list fixed_width_suggested_list;
+		/// <summary>
+		/// 残りの実測予算 (予算を設定していない場合は std::numeric_limits&lt;std::size_t&gt;::max())
+		/// </summary>
+		std::size_t remaining_budget = std::numeric_limits<std::size_t>::max();
+		/// <summary>
+		/// 直線探索 1 本を完了させるのに見込む実測数 (残りの予算が実行中の直線の数のこの倍に満たなければ予算が足りないとみなす)
+		/// </summary>
+		static constexpr std::size_t LINE_COMPLETION_COST = 2;
+		/// <summary>
+		/// 一方の値がもう一方より良いか
+		/// </summary>
+		/// <param name="value">比較する値</param>
+		/// <param name="compared_value">比較対象の値</param>
+		/// <returns>value の方が良ければ true</returns>
+		bool isBetter(double value, double compared_value) const;
+		/// <summary>
+		/// 2 点が同じ谷にあるとみなせるほど近いか (全軸で隣接以内か)
+		/// </summary>
+		/// <param name="coordinate1">1 点目</param>
+		/// <param name="coordinate2">2 点目</param>
+		/// <returns>近ければ true</returns>
+		static bool isNeighbor(const coordinate& coordinate1, const coordinate& coordinate2);
+		/// <summary>
+		/// 初期探索の上位点から放射状探索を開始
+		/// </summary>
+		void startRadialSearches(void);
+		/// <summary>
+		/// 指定した放射状探索の基準点を移動
+		/// </summary>
+		/// <param name="start_idx">放射状探索のインデックス</param>
+		/// <param name="new_base_coordinate">新しい基準点</param>
+		void moveBasePoint(std::size_t start_idx, const coordinate& new_base_coordinate);
+		/// <summary>
+		/// 指定した放射状探索を終了し，実行中の一覧から除く
+		/// </summary>
+		/// <param name="start_idx">放射状探索のインデックス</param>
+		void finishStart(std::size_t start_idx);
+		/// <summary>
+		/// 改善が見られなかった放射状探索を，方向を間引いている場合に選ぶ方向数を増やして同じ基準点で再開
+		/// </summary>
+		/// <param name="start_idx">放射状探索のインデックス</param>
+		/// <returns>再開した場合は true (未探索の方向が残っていない場合や方向を間引いていない場合は false)</returns>
+		bool restartStart(std::size_t start_idx);
+		/// <summary>
+		/// 指定した基準点の放射状探索機構を構築
+		/// </summary>
+		/// <param name="new_base_coordinate">探索基準点</param>
+		/// <returns>構築した探索機構</returns>
+		std::shared_ptr<RadialDspSearcher> buildRadialSearcher(const coordinate& new_base_coordinate);
+		/// <summary>
+		/// 基準点が他の探索の基準点と同じ谷に至った放射状探索を打ち切る
+		/// </summary>
+		void mergeConvergedStarts(void);
+		/// <summary>
+		/// 実行中のすべての直線を残りの予算内に完了できる見込みがなければ，基準点の値が最良の放射状探索以外を打ち切り，最良点の周辺に予算を集中
+		/// </summary>
+		void concentrateOnBestStart(void);
+		/// <summary>
+		/// 実測データを実行中の探索機構に渡す
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void passMetricValue(const coordinate& measured_coordinate, double metric_value);
+		/// <summary>
+		/// 全探索の基準点のうち最良のものを探索基準点として更新
+		/// </summary>
+		void updateBaseCoordinate(void);
+		/// <summary>
+		/// 実行中の放射状探索のインデックスを基準点の値が良い順に取得
+		/// </summary>
+		/// <returns>放射状探索のインデックス</returns>
+		std::vector<std::size_t> getRankedStarts(void) const;
+		/// <summary>
+		/// 各探索の候補リストを，基準点の値が良い探索ほど多くの枠を割り当てて交互に統合
+		/// </summary>
+		/// <param name="candidate_lists">各探索の候補リスト (getRankedStarts() の順)</param>
+		/// <param name="max_num">統合後の最大件数</param>
+		/// <returns>統合した候補リスト</returns>
+		static coordinate_list mergeByRank(const std::vector<coordinate_list>& candidate_lists, std::size_t max_num);
+		/// <summary>
+		/// 全探索を終了
+		/// </summary>
+		void finishSearching(void);
+	public:
+		/// <summary>
+		/// コンストラクタ．<br/>
+		/// 初期点は常に LHD 初期探索で決定する
+		/// </summary>
+		/// <param name="parameters">各性能パラメタが取りうる値の数リスト</param>
+		/// <param name="options">構築時設定</param>
+		Operator_P_MultiStart(const space_size& parameters, const ParallelOperatorOptions& options = ParallelOperatorOptions());
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		Operator_P_MultiStart(const Operator_P_MultiStart& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~Operator_P_MultiStart(void);
+		/// <summary>
+		/// 探索基準点 (全探索の基準点のうち最良のもの) を取得
+		/// </summary>
+		/// <returns>探索基準点</returns>
+		const coordinate& getBaseCoordinate(void) const override;
+		/// <summary>
+		/// 次に実測すべき性能パラメタ性能値 (座標) を取得
+		/// </summary>
+		/// <returns>次に実測すべき性能パラメタ性能値 (座標)</returns>
+		const coordinate& getSuggested(void) override;
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを取得
+		/// </summary>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(void) override;
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを指定件数で取得．<br/>
+		/// 基準点の値が良い探索ほど多くの枠を割り当て，各探索の提案が枠に満たない場合は投機的実測候補で補う
+		/// </summary>
+		/// <param name="suggested_num">取得する候補数</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(std::size_t suggested_num);
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを，指定した座標を除いて指定件数で取得．<br/>
+		/// 実測中の点と重複しない候補を並列実測の空き枠に割り当てるために用いる
+		/// </summary>
+		/// <param name="suggested_num">取得する候補数</param>
+		/// <param name="excluded_coordinates">除外する座標 (実測中の点など)</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(std::size_t suggested_num, const std::unordered_set<coordinate>& excluded_coordinates) override;
+		/// <summary>
+		/// 残りの実測予算を設定 (予算が足りなければ，基準点の値が最良の放射状探索以外を打ち切る)
+		/// </summary>
+		/// <param name="remaining_num">残りの実測数</param>
+		void setRemainingBudget(std::size_t remaining_num) override;
+		/// <summary>
+		/// 実測データを記録
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void setMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// 実測データをデータベースにのみ記録 (探索機構には渡さない)
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void recordMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// データベースで集計済の性能評価値を探索機構に渡す
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		void commitMetricValue(const coordinate& measured_coordinate) override;
+		/// <summary>
+		/// 実測を途中で打ち切ったデータを記録 (性能評価値は打ち切り時点の限界値で，実際はこれより悪い)
+		/// </summary>
+		/// <param name="measured_coordinate">実測を打ち切った座標</param>
+		/// <param name="bound">打ち切り時点の限界値</param>
+		void setCensoredMetricValue(const coordinate& measured_coordinate, double bound) override;
+		/// <summary>
+		/// 状態を更新
+		/// </summary>
+		void updateState(void) override;
+		/// <summary>
+		/// 探索アルゴリズムが終了条件を満たしたかを取得．<br/>
+		/// 終了条件を持たない探索アルゴリズムの場合，この関数の挙動は各実装クラス依存です．
+		/// </summary>
+		/// <returns>終了条件を満たしていれば true</returns>
+		bool isSearchFinished(void) override;
+		/// <summary>
+		/// その時点で探索アルゴリズムが最良と判定している性能パラメタ設定値 (座標) を取得
+		/// </summary>
+		/// <returns>探索アルゴリズムが最良と判定している性能パラメタ設定値 (座標)</returns>
+		const coordinate& getBestJudgedCoordinate(void) override;
+		/// <summary>
+		/// 実測された中で性能評価値が最良だった性能パラメタ設定値 (座標) を取得
+		/// </summary>
+		/// <returns>実測された中で性能評価値が最良だった性能パラメタ設定値 (座標)</returns>
+		const coordinate& getBestMeasuredCoordinate(void) override;
+		/// <summary>
+		/// アルゴリズムセットの ID 文字列を取得
+		/// </summary>
+		/// <returns>アルゴリズムセットの ID 文字列</returns>
+		std::string getAlgorithmId(void) const override;
+		/// <summary>
+		/// 使用しているデータベースを取得
+		/// </summary>
+		/// <returns>使用しているデータベース</returns>
+		std::shared_ptr<DatabaseCore> getDatabase(void) const override;
+		/// <summary>
+		/// これまでのループ回数 (updateState() が呼ばれた回数) を取得
+		/// </summary>
+		/// <returns>これまでのループ回数</returns>
+		std::size_t getLoopCount(void) const override;
+		/// <summary>
+		/// 実行中の探索モード名を取得
+		/// </summary>
+		/// <returns>実行中の探索モード名</returns>
+		std::string getSearchModeName(void) const override;
+	};
+}
+
+#endif // !DSICE_OPERATOR_P_MULTI_START_HPP_
\ No newline at end of file
@@ -1,6 +1,7 @@
 ﻿#include <stdexcept>
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 #include "dsice_search_space.hpp"
 #include "dsice_database_metric_type.hpp"
@@ -11,11 +12,12 @@
 #include "simple_direction_searcher.hpp"
 #include "line_single_tri_searcher.hpp"
 #include "one_dim_dsp_searcher.hpp"
+#include "dsice_thread_pool.hpp"
 #include "dsice_operator_s_2017.hpp"
 
 namespace dsice {
 
-	Operator_S_2017::Operator_S_2017(const space_size& parameters, bool low_value_is_better, bool logging_on, double alpha, DatabaseMetricType metric_type) {
+	Operator_S_2017::Operator_S_2017(const space_size& parameters, bool low_value_is_better, bool logging_on, double alpha, DatabaseMetricType metric_type, std::shared_ptr<ThreadPool> pool) {
 
 		if (parameters.empty()) {
 			throw std::invalid_argument("need one parameter at least.");
@@ -24,6 +26,7 @@ namespace dsice {
 		this->lower_is_better = low_value_is_better;
 		this->is_logging_mode_on = logging_on;
 		this->dsp_alpha = alpha;
+		this->thread_pool = pool;
 
 		if (this->is_logging_mode_on) {
 			this->database = std::make_shared<LoggingDatabase>(parameters, metric_type);
@@ -60,6 +63,7 @@ namespace dsice {
 		this->searching_line = original.searching_line;
 		this->loop_count = original.loop_count;
 		this->dsp_alpha = original.dsp_alpha;
+		this->thread_pool = original.thread_pool;
 
 		if (std::shared_ptr<StandardDatabase> sd = std::dynamic_pointer_cast<StandardDatabase>(original.database)) {
 			this->database = std::make_shared<StandardDatabase>(*sd);
@@ -79,7 +83,7 @@ namespace dsice {
 			this->searcher = std::make_shared<LineSingleTriSearcher>(*(std::dynamic_pointer_cast<LineSingleTriSearcher>(original.searcher)));
 			break;
 		case 3:
-			this->searcher = std::make_shared<OneDimDspSearcher>(*(std::dynamic_pointer_cast<OneDimDspSearcher>(original.searcher)));
+			this->searcher = std::make_shared<OneDimDspSearcher>(*(std::dynamic_pointer_cast<OneDimDspSearcher>(original.searcher)), this->database);
 			break;
 		default:
 			this->searcher = std::make_shared<UniMeasurer>(*(std::dynamic_pointer_cast<UniMeasurer>(original.searcher)));
@@ -109,11 +113,28 @@ namespace dsice {
 		return this->searcher->getSuggestedList();
 	}
 
+	const coordinate_list& Operator_S_2017::getSuggestedList(std::size_t, const std::unordered_set<coordinate>&) {
+		return this->getSuggestedList();
+	}
+
 	void Operator_S_2017::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
 		this->database->setSampleMetricValue(measured_coordinate, metric_value);
 		this->searcher->setMetricValue(measured_coordinate, metric_value);
 	}
 
+	void Operator_S_2017::recordMetricValue(const coordinate& measured_coordinate, double metric_value) {
+		this->database->setSampleMetricValue(measured_coordinate, metric_value);
+	}
+
+	void Operator_S_2017::commitMetricValue(const coordinate& measured_coordinate) {
+		this->searcher->setMetricValue(measured_coordinate, this->database->getSampleMetricValue(measured_coordinate));
+	}
+
+	void Operator_S_2017::setCensoredMetricValue(const coordinate& measured_coordinate, double bound) {
+		this->setMetricValue(measured_coordinate, bound);
+		this->database->setSampleCensored(measured_coordinate);
+	}
+
 	bool Operator_S_2017::isSearchFinished(void) {
 
 		this->updateState();
@@ -210,7 +231,7 @@ namespace dsice {
 				switch (this->searching_phase) {
 				case 0:
 
-					this->searcher = std::make_shared<SimpleDirectionSearcher>(this->database, this->base_coordinate, this->database->getSpaceDimension(), this->lower_is_better);
+					this->searcher = std::make_shared<SimpleDirectionSearcher>(this->database, this->base_coordinate, this->database->getSpaceDimension(), this->lower_is_better, this->thread_pool);
 					this->searching_phase = 1;
 
 					if (this->is_logging_mode_on) {
@@ -288,7 +309,7 @@ namespace dsice {
 						this->database->recordSearchedDirection(this->base_coordinate, this->searching_line->getLineDirection());
 
 						this->searching_line = nullptr;
-						this->searcher = std::make_shared<SimpleDirectionSearcher>(this->database, this->base_coordinate, this->database->getSpaceDimension(), this->lower_is_better);
+						this->searcher = std::make_shared<SimpleDirectionSearcher>(this->database, this->base_coordinate, this->database->getSpaceDimension(), this->lower_is_better, this->thread_pool);
 						this->searching_phase = 1;
 						if (this->is_logging_mode_on) {
 							std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
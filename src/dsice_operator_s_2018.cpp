@@ -1,6 +1,7 @@
 ﻿#include <stdexcept>
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 #include "dsice_search_space.hpp"
 #include "direction_line.hpp"
@@ -9,15 +10,18 @@
 #include "dsice_logging_database.hpp"
 #include "coordinate_line.hpp"
 #include "uni_measurer.hpp"
+#include "welch_test_measurer.hpp"
 #include "simple_lhd_searcher.hpp"
 #include "simple_direction_searcher.hpp"
 #include "line_single_tri_searcher.hpp"
 #include "one_dim_dsp_searcher.hpp"
+#include "dsice_thread_pool.hpp"
+#include "initial_design.hpp"
 #include "dsice_operator_s_2018.hpp"
 
 namespace dsice {
 
-	Operator_S_2018::Operator_S_2018(const space_size& parameters, bool low_value_is_better, bool logging_on, OperatorInitializeWay initialize_way, double alpha, DatabaseMetricType metric_type, coordinate initial_coordinate) {
+	Operator_S_2018::Operator_S_2018(const space_size& parameters, bool low_value_is_better, bool logging_on, OperatorInitializeWay initialize_way, double alpha, DatabaseMetricType metric_type, coordinate initial_coordinate, std::size_t significance_test_repetitions, double significance_level, std::shared_ptr<ThreadPool> pool, std::shared_ptr<const InitialDesign> initial_design) {
 
 		if (parameters.empty()) {
 			throw std::invalid_argument("need one parameter at least.");
@@ -26,6 +30,9 @@ namespace dsice {
 		this->lower_is_better = low_value_is_better;
 		this->is_logging_mode_on = logging_on;
 		this->dsp_alpha = alpha;
+		this->thread_pool = pool;
+		this->significance_test_repetitions = significance_test_repetitions;
+		this->significance_level = significance_level;
 
 		if (logging_on) {
 			this->database = std::make_shared<LoggingDatabase>(parameters, metric_type);
@@ -46,7 +53,12 @@ namespace dsice {
 			}
 			break;
 		case OperatorInitializeWay::INITIAL_SEARCH:
-			this->searcher = std::make_shared<SimpleLhdSearcher>(this->database, this->lower_is_better);
+			if (initial_design != nullptr) {
+				this->searcher = std::make_shared<SimpleLhdSearcher>(this->database, initial_design->generate(*this->database, this->thread_pool), this->lower_is_better);
+			}
+			else {
+				this->searcher = std::make_shared<SimpleLhdSearcher>(this->database, this->lower_is_better);
+			}
 
 			this->base_coordinate = this->searcher->getSuggested();
 			this->database->setBasePoint(this->base_coordinate);
@@ -89,6 +101,9 @@ namespace dsice {
 		this->searching_line = original.searching_line;
 		this->loop_count = original.loop_count;
 		this->dsp_alpha = original.dsp_alpha;
+		this->thread_pool = original.thread_pool;
+		this->significance_test_repetitions = original.significance_test_repetitions;
+		this->significance_level = original.significance_level;
 
 		if (std::shared_ptr<StandardDatabase> sd = std::dynamic_pointer_cast<StandardDatabase>(original.database)) {
 			this->database = std::make_shared<StandardDatabase>(*sd);
@@ -116,7 +131,10 @@ namespace dsice {
 			this->searcher = std::make_shared<LineSingleTriSearcher>(*(std::dynamic_pointer_cast<LineSingleTriSearcher>(original.searcher)));
 			break;
 		case 3:
-			this->searcher = std::make_shared<OneDimDspSearcher>(*(std::dynamic_pointer_cast<OneDimDspSearcher>(original.searcher)));
+			this->searcher = std::make_shared<OneDimDspSearcher>(*(std::dynamic_pointer_cast<OneDimDspSearcher>(original.searcher)), this->database);
+			break;
+		case 5:
+			this->searcher = std::make_shared<WelchTestMeasurer>(*(std::dynamic_pointer_cast<WelchTestMeasurer>(original.searcher)));
 			break;
 		default:
 			this->searcher = std::make_shared<UniMeasurer>(*(std::dynamic_pointer_cast<UniMeasurer>(original.searcher)));
@@ -146,11 +164,28 @@ namespace dsice {
 		return this->searcher->getSuggestedList();
 	}
 
+	const coordinate_list& Operator_S_2018::getSuggestedList(std::size_t, const std::unordered_set<coordinate>&) {
+		return this->getSuggestedList();
+	}
+
 	void Operator_S_2018::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
 		this->database->setSampleMetricValue(measured_coordinate, metric_value);
 		this->searcher->setMetricValue(measured_coordinate, metric_value);
 	}
 
+	void Operator_S_2018::recordMetricValue(const coordinate& measured_coordinate, double metric_value) {
+		this->database->setSampleMetricValue(measured_coordinate, metric_value);
+	}
+
+	void Operator_S_2018::commitMetricValue(const coordinate& measured_coordinate) {
+		this->searcher->setMetricValue(measured_coordinate, this->database->getSampleMetricValue(measured_coordinate));
+	}
+
+	void Operator_S_2018::setCensoredMetricValue(const coordinate& measured_coordinate, double bound) {
+		this->setMetricValue(measured_coordinate, bound);
+		this->database->setSampleCensored(measured_coordinate);
+	}
+
 	void Operator_S_2018::updateState(void) {
 
 		bool searcher_updated = this->searcher->updateState();
@@ -179,7 +214,7 @@ namespace dsice {
 						this->base_coordinate = s->getBestJudgedCoordinate();
 					}
 
-					this->searcher = std::make_shared<SimpleDirectionSearcher>(this->database, this->base_coordinate, this->axis_dimension_level, this->lower_is_better);
+					this->searcher = std::make_shared<SimpleDirectionSearcher>(this->database, this->base_coordinate, this->axis_dimension_level, this->lower_is_better, this->thread_pool);
 					this->searching_phase = 1;
 					if (this->is_logging_mode_on) {
 						std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
@@ -239,6 +274,25 @@ namespace dsice {
 					phase_changing = false;
 					break;
 				case 3:
+				case 5:
+
+					// 基準点を移動する前に，雑音による見かけの改善でないことを検定 (検定結果は WelchTestMeasurer の最良判定点に反映される)
+					if (this->searching_phase == 3 && this->significance_test_repetitions > 0 && this->base_coordinate != this->searcher->getBestJudgedCoordinate()) {
+						if (this->database->hasSample(this->base_coordinate) && this->database->hasSample(this->searcher->getBestJudgedCoordinate())) {
+
+							this->searcher = std::make_shared<WelchTestMeasurer>(this->database, this->base_coordinate, this->searcher->getBestJudgedCoordinate(), this->lower_is_better, this->significance_test_repetitions, this->significance_level);
+							this->searching_phase = 5;
+							if (this->is_logging_mode_on) {
+								std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
+								ld->updateCandidateList(this->searcher->getSuggestedList());
+							}
+
+							if (!this->searcher->isSearchFinished()) {
+								phase_changing = false;
+							}
+							break;
+						}
+					}
 
 					if (this->base_coordinate == this->searcher->getBestJudgedCoordinate()) {
 						if (this->axis_dimension_level == this->database->getSpaceDimension()) {
@@ -254,7 +308,7 @@ namespace dsice {
 
 							this->axis_dimension_level++;
 							this->searching_line = nullptr;
-							this->searcher = std::make_shared<SimpleDirectionSearcher>(this->database, this->base_coordinate, this->axis_dimension_level, this->lower_is_better);
+							this->searcher = std::make_shared<SimpleDirectionSearcher>(this->database, this->base_coordinate, this->axis_dimension_level, this->lower_is_better, this->thread_pool);
 							this->searching_phase = 1;
 							if (this->is_logging_mode_on) {
 								std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
@@ -273,7 +327,7 @@ namespace dsice {
 						this->database->recordSearchedDirection(this->base_coordinate, this->searching_line->getLineDirection());
 
 						this->searching_line = nullptr;
-						this->searcher = std::make_shared<SimpleDirectionSearcher>(this->database, this->base_coordinate, this->axis_dimension_level, this->lower_is_better);
+						this->searcher = std::make_shared<SimpleDirectionSearcher>(this->database, this->base_coordinate, this->axis_dimension_level, this->lower_is_better, this->thread_pool);
 						this->searching_phase = 1;
 						if (this->is_logging_mode_on) {
 							std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->database);
@@ -396,6 +450,8 @@ namespace dsice {
 			return "One Dimensional d-Spline Search (Preparing Approxymation)";
 		case 3:
 			return "One Dimensional d-Spline Search";
+		case 5:
+			return "Significance Test";
 		default:
 			return "Finished";
 		}
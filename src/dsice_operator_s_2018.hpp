@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 #include "dsice_search_space.hpp"
 #include "dsice_database_metric_type.hpp"
@@ -10,6 +11,8 @@
 #include "coordinate_line.hpp"
 #include "observed_d_spline.hpp"
 #include "dsice_searcher.hpp"
+#include "dsice_thread_pool.hpp"
+#include "initial_design.hpp"
 #include "dsice_operator.hpp"
 
 namespace dsice {
@@ -62,6 +65,18 @@ namespace dsice {
 		/// d-Spline 関数の滑らかさを決定する重み係数
 		/// </summary>
 		double dsp_alpha = 0.1;
+		/// <summary>
+		/// 探索機構の構築や状態更新に用いるスレッドプール (nullptr の場合は逐次実行)
+		/// </summary>
+		std::shared_ptr<ThreadPool> thread_pool;
+		/// <summary>
+		/// 基準点移動前の有意差検定で 1 点あたりに許す最大実測回数 (0 なら検定しない)
+		/// </summary>
+		std::size_t significance_test_repetitions = 0;
+		/// <summary>
+		/// 基準点移動前の有意差検定の有意水準
+		/// </summary>
+		double significance_level = 0.05;
 	public:
 		/// <summary>
 		/// コンストラクタ
@@ -73,7 +88,11 @@ namespace dsice {
 		/// <param name="alpha">近似関数の滑らかさを決定する重み係数 (小さいほどデータ追随，値が大きいほど滑らか)</param>
 		/// <param name="metric_type">性能パラメタの同一設定値に複数の性能評価値が登録された際の挙動</param>
 		/// <param name="initial_coordinate">初期点の座標</param>
-		Operator_S_2018(const space_size& parameters, bool low_value_is_better = true, bool logging_on = false, OperatorInitializeWay initialize_way = OperatorInitializeWay::CENTER, double alpha = 0.1, DatabaseMetricType metric_type = DatabaseMetricType::AverageDouble, coordinate initial_coordinate = {});
+		/// <param name="significance_test_repetitions">基準点移動前の有意差検定で 1 点あたりに許す最大実測回数 (0 なら検定しない)</param>
+		/// <param name="significance_level">基準点移動前の有意差検定の有意水準</param>
+		/// <param name="pool">探索機構の構築や状態更新に用いるスレッドプール (nullptr の場合は逐次実行)</param>
+		/// <param name="initial_design">初期探索で実測する点の配置 (nullptr なら性能パラメタの値の数が最も多い軸に合わせたランダムな LHD)</param>
+		Operator_S_2018(const space_size& parameters, bool low_value_is_better = true, bool logging_on = false, OperatorInitializeWay initialize_way = OperatorInitializeWay::CENTER, double alpha = 0.1, DatabaseMetricType metric_type = DatabaseMetricType::AverageDouble, coordinate initial_coordinate = {}, std::size_t significance_test_repetitions = 0, double significance_level = 0.05, std::shared_ptr<ThreadPool> pool = nullptr, std::shared_ptr<const InitialDesign> initial_design = nullptr);
 		/// <summary>
 		/// コピーコンストラクタ
 		/// </summary>
@@ -99,12 +118,36 @@ namespace dsice {
 		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
 		const coordinate_list& getSuggestedList(void) override;
 		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを取得 (並列実測には対応しないため引数は無視する)
+		/// </summary>
+		/// <param name="suggested_num">取得する候補数 (無視される)</param>
+		/// <param name="excluded_coordinates">除外する座標 (無視される)</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(std::size_t suggested_num, const std::unordered_set<coordinate>& excluded_coordinates) override;
+		/// <summary>
 		/// 実測データを記録
 		/// </summary>
 		/// <param name="measured_coordinate">実測した座標</param>
 		/// <param name="metric_value">実測した値</param>
 		void setMetricValue(const coordinate& measured_coordinate, double metric_value) override;
 		/// <summary>
+		/// 実測データをデータベースにのみ記録 (探索機構には渡さない)
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void recordMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// データベースで集計済の性能評価値を探索機構に渡す
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		void commitMetricValue(const coordinate& measured_coordinate) override;
+		/// <summary>
+		/// 実測を途中で打ち切ったデータを記録 (性能評価値は打ち切り時点の限界値で，実際はこれより悪い)
+		/// </summary>
+		/// <param name="measured_coordinate">実測を打ち切った座標</param>
+		/// <param name="bound">打ち切り時点の限界値</param>
+		void setCensoredMetricValue(const coordinate& measured_coordinate, double bound) override;
+		/// <summary>
 		/// 状態を更新
 		/// </summary>
 		void updateState(void) override;
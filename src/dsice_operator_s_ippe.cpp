@@ -1,6 +1,7 @@
 ﻿#include <stdexcept>
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 #include "dsice_search_space.hpp"
 #include "dsice_database_metric_type.hpp"
@@ -8,12 +9,13 @@
 #include "dsice_logging_database.hpp"
 #include "uni_measurer.hpp"
 #include "line_single_tri_searcher.hpp"
+#include "line_multi_section_searcher.hpp"
 #include "one_dim_dsp_searcher.hpp"
 #include "dsice_operator_s_ippe.hpp"
 
 namespace dsice {
 
-	Operator_S_IPPE::Operator_S_IPPE(const space_size& parameters, bool low_value_is_better, bool logging_on, double alpha, DatabaseMetricType metric_type) {
+	Operator_S_IPPE::Operator_S_IPPE(const space_size& parameters, bool low_value_is_better, bool logging_on, double alpha, DatabaseMetricType metric_type, std::size_t worker_num) {
 
 		if (parameters.empty()) {
 			throw std::invalid_argument("Need one parameter at least.");
@@ -30,6 +32,7 @@ namespace dsice {
 		this->lower_is_better = low_value_is_better;
 		this->is_logging_mode_on = logging_on;
 		this->dsp_alpha = alpha;
+		this->worker_num = worker_num;
 
 		if (this->is_logging_mode_on) {
 			this->database = std::make_shared<LoggingDatabase>(parameters, metric_type);
@@ -56,7 +59,12 @@ namespace dsice {
 		}
 
 		CoordinateLine line(parameters, this->base_coordinate, { 1 });
-		this->searcher = std::make_shared<LineSingleTriSearcher>(this->database, line, this->lower_is_better);
+		if (this->worker_num > 2) {
+			this->searcher = std::make_shared<LineMultiSectionSearcher>(this->database, line, this->lower_is_better, this->worker_num);
+		}
+		else {
+			this->searcher = std::make_shared<LineSingleTriSearcher>(this->database, line, this->lower_is_better);
+		}
 
 		this->searching_phase = 0;
 
@@ -74,6 +82,7 @@ namespace dsice {
 		this->base_coordinate = original.base_coordinate;
 		this->loop_count = original.loop_count;
 		this->dsp_alpha = original.dsp_alpha;
+		this->worker_num = original.worker_num;
 
 		if (std::shared_ptr<StandardDatabase> sd = std::dynamic_pointer_cast<StandardDatabase>(original.database)) {
 			this->database = std::make_shared<StandardDatabase>(*sd);
@@ -84,10 +93,15 @@ namespace dsice {
 
 		switch (this->searching_phase) {
 		case 0:
-			this->searcher = std::make_shared<LineSingleTriSearcher>(*(std::dynamic_pointer_cast<LineSingleTriSearcher>(original.searcher)));
+			if (std::shared_ptr<LineMultiSectionSearcher> s = std::dynamic_pointer_cast<LineMultiSectionSearcher>(original.searcher)) {
+				this->searcher = std::make_shared<LineMultiSectionSearcher>(*s, this->database);
+			}
+			else {
+				this->searcher = std::make_shared<LineSingleTriSearcher>(*(std::dynamic_pointer_cast<LineSingleTriSearcher>(original.searcher)));
+			}
 			break;
 		case 1:
-			this->searcher = std::make_shared<OneDimDspSearcher>(*(std::dynamic_pointer_cast<OneDimDspSearcher>(original.searcher)));
+			this->searcher = std::make_shared<OneDimDspSearcher>(*(std::dynamic_pointer_cast<OneDimDspSearcher>(original.searcher)), this->database);
 			break;
 		default:
 			this->searcher = std::make_shared<UniMeasurer>(*(std::dynamic_pointer_cast<UniMeasurer>(original.searcher)));
@@ -117,11 +131,30 @@ namespace dsice {
 		return this->searcher->getSuggestedList();
 	}
 
+	const coordinate_list& Operator_S_IPPE::getSuggestedList(std::size_t, const std::unordered_set<coordinate>&) {
+		return this->getSuggestedList();
+	}
+
 	void Operator_S_IPPE::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
 		this->database->setSampleMetricValue(measured_coordinate, metric_value);
 		this->searcher->setMetricValue(measured_coordinate, metric_value);
 	}
 
+	void Operator_S_IPPE::recordMetricValue(const coordinate& measured_coordinate, double metric_value) {
+		this->database->setSampleMetricValue(measured_coordinate, metric_value);
+	}
+
+	void Operator_S_IPPE::commitMetricValue(const coordinate& measured_coordinate) {
+		this->searcher->setMetricValue(measured_coordinate, this->database->getSampleMetricValue(measured_coordinate));
+	}
+
+	void Operator_S_IPPE::setCensoredMetricValue(const coordinate& measured_coordinate, double bound) {
+
+		// 通常の値の登録時に打ち切りの印は外れるため，印は登録後に付ける
+		this->setMetricValue(measured_coordinate, bound);
+		this->database->setSampleCensored(measured_coordinate);
+	}
+
 	bool Operator_S_IPPE::isSearchFinished(void) {
 
 		this->updateState();
@@ -1,6 +1,8 @@
 ﻿#ifndef DSICE_OPERATOR_S_IPPE_HPP_
 #define DSICE_OPERATOR_S_IPPE_HPP_
 
+#include <unordered_set>
+
 #include "dsice_search_space.hpp"
 #include "dsice_database_metric_type.hpp"
 #include "dsice_database_standard_functions.hpp"
@@ -44,6 +46,10 @@ namespace dsice {
 		/// d-Spline 関数の滑らかさを決定する重み係数
 		/// </summary>
 		double dsp_alpha = 0.1;
+		/// <summary>
+		/// 並列に実測できる数 (直線探索の初期探索の分割数を決める，0 なら 3 分割)
+		/// </summary>
+		std::size_t worker_num = 0;
 	public:
 		/// <summary>
 		/// コンストラクタ
@@ -53,7 +59,8 @@ namespace dsice {
 		/// <param name="logging_on">ログを取る場合は true</param>
 		/// <param name="alpha">近似関数の滑らかさを決定する重み係数 (小さいほどデータ追随，値が大きいほど滑らか)</param>
 		/// <param name="metric_type">性能パラメタの同一設定値に複数の性能評価値が登録された際の挙動</param>
-		Operator_S_IPPE(const space_size& parameters, bool low_value_is_better = true, bool logging_on = false, double alpha = 0.1, DatabaseMetricType metric_type = DatabaseMetricType::AverageDouble);
+		/// <param name="worker_num">並列に実測できる数 (0 なら直線探索の初期探索を 3 分割で行う)</param>
+		Operator_S_IPPE(const space_size& parameters, bool low_value_is_better = true, bool logging_on = false, double alpha = 0.1, DatabaseMetricType metric_type = DatabaseMetricType::AverageDouble, std::size_t worker_num = 0);
 		/// <summary>
 		/// コピーコンストラクタ
 		/// </summary>
@@ -79,12 +86,36 @@ namespace dsice {
 		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
 		const coordinate_list& getSuggestedList(void) override;
 		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを取得 (並列実測には対応しないため引数は無視する)
+		/// </summary>
+		/// <param name="suggested_num">取得する候補数 (無視される)</param>
+		/// <param name="excluded_coordinates">除外する座標 (無視される)</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(std::size_t suggested_num, const std::unordered_set<coordinate>& excluded_coordinates) override;
+		/// <summary>
 		/// 実測データを記録
 		/// </summary>
 		/// <param name="measured_coordinate">実測した座標</param>
 		/// <param name="metric_value">実測した値</param>
 		void setMetricValue(const coordinate& measured_coordinate, double metric_value) override;
 		/// <summary>
+		/// 実測データをデータベースにのみ記録 (探索機構には渡さない)
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void recordMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// データベースで集計済の性能評価値を探索機構に渡す
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		void commitMetricValue(const coordinate& measured_coordinate) override;
+		/// <summary>
+		/// 実測を途中で打ち切ったデータを記録 (性能評価値は打ち切り時点の限界値で，実際はこれより悪い)
+		/// </summary>
+		/// <param name="measured_coordinate">実測を打ち切った座標</param>
+		/// <param name="bound">打ち切り時点の限界値</param>
+		void setCensoredMetricValue(const coordinate& measured_coordinate, double bound) override;
+		/// <summary>
 		/// 探索アルゴリズムが終了条件を満たしたかを取得．<br/>
 		/// 終了条件を持たない探索アルゴリズムの場合，この関数の挙動は各実装クラス依存です．
 		/// </summary>
@@ -1,6 +1,7 @@
 ﻿#include <stdexcept>
 #include <vector>
 #include <string>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 
@@ -77,6 +78,12 @@ namespace dsice {
 			this->parameter.push_back(tmp);
 		}
 
+		// 忠実度はパラメタ設定値の後ろに記録されている場合のみ取得
+		double tmp_fidelity;
+		if (ifs >> tmp_fidelity) {
+			this->fidelity = tmp_fidelity;
+		}
+
 		recordStartProcess(this->process_id);
 	}
 
@@ -99,6 +106,12 @@ namespace dsice {
 			this->parameter.push_back(this->stoT(argv[argc - i - 3]));
 		}
 
+		// 忠実度はコマンドライン引数の並びを変えないよう環境変数で受け取る
+		const char* fidelity_env = std::getenv(FIDELITY_ENV_NAME.c_str());
+		if (fidelity_env != nullptr) {
+			this->fidelity = std::stod(fidelity_env);
+		}
+
 		recordStartProcess(this->process_id);
 	}
 
@@ -112,6 +125,11 @@ namespace dsice {
 		return this->parameter;
 	}
 
+	template <typename T>
+	double ProcessAgent<T>::getFidelity(void) const {
+		return this->fidelity;
+	}
+
 	template <typename T>
 	void ProcessAgent<T>::recordPerformanceValue(double performance_value) const {
 
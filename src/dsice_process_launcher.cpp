@@ -2,6 +2,9 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
 #include <future>
 
 #include "dsice_symbols.hpp"
@@ -10,9 +13,17 @@
 namespace dsice {
 
 	template <typename T>
-	void launchProcess(std::string command, const std::vector<T>& parameters, std::size_t process_id) {
+	void launchProcess(std::string command, const std::vector<T>& parameters, std::size_t process_id, double fidelity) {
 
 		std::string run_command = command;
+
+		// 忠実度は既存のコマンドライン引数の並びを崩さないよう環境変数で渡す
+		if (fidelity > 0) {
+			std::ostringstream env_command;
+			env_command << FIDELITY_ENV_NAME << "=" << std::setprecision(std::numeric_limits<double>::max_digits10) << fidelity << " " << run_command;
+			run_command = env_command.str();
+		}
+
 		for (T p : parameters) {
 			run_command += " " + std::to_string(p);
 		}
@@ -28,7 +39,7 @@ namespace dsice {
 	}
 
 	template <typename T>
-	void launchProcessWithFile(std::string command, const std::vector<T>& parameters, std::size_t process_id) {
+	void launchProcessWithFile(std::string command, const std::vector<T>& parameters, std::size_t process_id, double fidelity) {
 
 		std::ofstream ofs(TMP_PARAM_SPECIFY_FILE, std::ios::out);
 		if (!ofs) {
@@ -40,6 +51,9 @@ namespace dsice {
 		for (T p : parameters) {
 			ofs << " " << p;
 		}
+		if (fidelity > 0) {
+			ofs << " " << std::setprecision(std::numeric_limits<double>::max_digits10) << fidelity;
+		}
 
 		ofs.close();
 
@@ -53,15 +67,15 @@ namespace dsice {
 	// テンプレート関数の実態を定義
 	//
 
-	template void launchProcess(std::string, const std::vector<int>&, std::size_t);
-	template void launchProcess(std::string, const std::vector<long long>&, std::size_t);
-	template void launchProcess(std::string, const std::vector<std::size_t>&, std::size_t);
-	template void launchProcess(std::string, const std::vector<float>&, std::size_t);
-	template void launchProcess(std::string, const std::vector<double>&, std::size_t);
+	template void launchProcess(std::string, const std::vector<int>&, std::size_t, double);
+	template void launchProcess(std::string, const std::vector<long long>&, std::size_t, double);
+	template void launchProcess(std::string, const std::vector<std::size_t>&, std::size_t, double);
+	template void launchProcess(std::string, const std::vector<float>&, std::size_t, double);
+	template void launchProcess(std::string, const std::vector<double>&, std::size_t, double);
 
-	template void launchProcessWithFile(std::string, const std::vector<int>&, std::size_t);
-	template void launchProcessWithFile(std::string, const std::vector<long long>&, std::size_t);
-	template void launchProcessWithFile(std::string, const std::vector<std::size_t>&, std::size_t);
-	template void launchProcessWithFile(std::string, const std::vector<float>&, std::size_t);
-	template void launchProcessWithFile(std::string, const std::vector<double>&, std::size_t);
+	template void launchProcessWithFile(std::string, const std::vector<int>&, std::size_t, double);
+	template void launchProcessWithFile(std::string, const std::vector<long long>&, std::size_t, double);
+	template void launchProcessWithFile(std::string, const std::vector<std::size_t>&, std::size_t, double);
+	template void launchProcessWithFile(std::string, const std::vector<float>&, std::size_t, double);
+	template void launchProcessWithFile(std::string, const std::vector<double>&, std::size_t, double);
 }
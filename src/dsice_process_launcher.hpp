@@ -14,8 +14,9 @@ namespace dsice {
 	/// <param name="command">プロセスを起動するコマンド (コマンドそのものに引数を渡す場合はここで設定してください)</param>
 	/// <param name="parameters">コマンドライン引数で渡すパラメタ設定値</param>
 	/// <param name="process_id">管理用 ID (DSICE 用．通常は 0．パラメタ設定値がない場合は無視されます)</param>
+	/// <param name="fidelity">実測すべき忠実度 (正の場合のみ環境変数 DSICE_FIDELITY で渡します)</param>
 	template <typename T = double>
-	void launchProcess(std::string command, const std::vector<T>& parameters, std::size_t process_id = 0);
+	void launchProcess(std::string command, const std::vector<T>& parameters, std::size_t process_id = 0, double fidelity = 0);
 
 	/// <summary>
 	/// ファイル経由でパラメタ設定値を指定し，プロセスを起動
@@ -23,8 +24,9 @@ namespace dsice {
 	/// <param name="command">プロセスを起動するコマンド (コマンドそのものに引数を渡す場合はここで設定してください)</param>
 	/// <param name="parameters">ファイル経由で渡すパラメタ設定値</param>
 	/// <param name="process_id">管理用 ID (DSICE 用．通常は 0)</param>
+	/// <param name="fidelity">実測すべき忠実度 (正の場合のみパラメタ設定値の後ろに記録します)</param>
 	template <typename T = double>
-	void launchProcessWithFile(std::string command, const std::vector<T>& parameters, std::size_t process_id = 0);
+	void launchProcessWithFile(std::string command, const std::vector<T>& parameters, std::size_t process_id = 0, double fidelity = 0);
 }
 
 #endif // !DSICE_PROCESS_LAUNCHER_HPP_
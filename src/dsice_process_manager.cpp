@@ -234,12 +234,23 @@ namespace dsice {
 	}
 
 	template <typename T>
-	bool ProcessManager<T>::launchProcess(std::vector<T> parameter, bool with_file) {
+	void ProcessManager<T>::setDeadlineOfRunning(double seconds) {
+
+		if (seconds < 0) {
+			throw std::invalid_argument("seconds must not be negative.");
+		}
+
+		this->deadline_of_running = std::chrono::duration<double>(seconds);
+	}
+
+	template <typename T>
+	bool ProcessManager<T>::launchProcess(std::vector<T> parameter, bool with_file, double fidelity) {
 
 		if (this->reserved_update) {
 			this->running_processes.clear();
 			this->running_pid.clear();
 			this->running_dir.clear();
+			this->running_start_time.clear();
 			this->reserved_update = false;
 		}
 
@@ -268,10 +279,10 @@ namespace dsice {
 				}
 
 				if (with_file) {
-					dsice::launchProcessWithFile(comm, parameter, this->dsice_process_id);
+					dsice::launchProcessWithFile(comm, parameter, this->dsice_process_id, fidelity);
 				}
 				else {
-					dsice::launchProcess(comm, parameter, this->dsice_process_id);
+					dsice::launchProcess(comm, parameter, this->dsice_process_id, fidelity);
 				}
 
 				process_state_file_dir = std::filesystem::current_path();
@@ -292,10 +303,10 @@ namespace dsice {
 				}
 
 				if (with_file) {
-					dsice::launchProcessWithFile(comm, parameter, this->dsice_process_id);
+					dsice::launchProcessWithFile(comm, parameter, this->dsice_process_id, fidelity);
 				}
 				else {
-					dsice::launchProcess(comm, parameter, this->dsice_process_id);
+					dsice::launchProcess(comm, parameter, this->dsice_process_id, fidelity);
 				}
 
 				std::filesystem::current_path(this->current_path);
@@ -322,10 +333,10 @@ namespace dsice {
 			}
 
 			if (with_file) {
-				dsice::launchProcessWithFile(comm, parameter, this->dsice_process_id);
+				dsice::launchProcessWithFile(comm, parameter, this->dsice_process_id, fidelity);
 			}
 			else {
-				dsice::launchProcess(comm, parameter, this->dsice_process_id);
+				dsice::launchProcess(comm, parameter, this->dsice_process_id, fidelity);
 			}
 
 			process_state_file_dir = std::filesystem::current_path();
@@ -348,6 +359,7 @@ namespace dsice {
 				if (file_str.find(start_notice_str) != std::string::npos) {
 					this->running_processes.push_back(this->dsice_process_id);
 					this->running_dir.push_back(process_state_file_dir);
+					this->running_start_time.push_back(std::chrono::system_clock::now());
 					break;
 				}
 			}
@@ -387,6 +399,9 @@ namespace dsice {
 			std::string end_notice_str = std::to_string(id) + ", END";
 			std::chrono::system_clock::time_point wait_limit = std::chrono::system_clock::now() + this->wait_duration_of_running_h + this->wait_duration_of_running_m + this->wait_duration_of_running_s;
 
+			bool has_deadline = this->deadline_of_running.count() > 0;
+			std::chrono::system_clock::time_point deadline = this->running_start_time[i] + std::chrono::duration_cast<std::chrono::system_clock::duration>(this->deadline_of_running);
+
 			while (true) {
 
 				if (std::filesystem::is_regular_file(state_file)) {
@@ -399,12 +414,30 @@ namespace dsice {
 					}
 				}
 
+				// 実行期限を超えたプロセスは結果を待たずに打ち切る
+				if (has_deadline && std::chrono::system_clock::now() > deadline) {
+
+					if (this->running_pid.contains(id)) {
+
+						int kill_result = std::system((this->kill_process_command + " " + std::to_string(this->running_pid.at(id))).c_str());
+
+						if (kill_result != 0) {
+							std::cerr << "Failed to cancel process execution.\n" << std::endl;
+						}
+					}
+
+					break;
+				}
+
 				// 待機制限時間で終了
 				if (std::chrono::system_clock::now() > wait_limit) {
 					return false;
 				}
 
 				std::chrono::system_clock::time_point wait_next = std::chrono::system_clock::now() + this->watch_duration_of_running_h + this->watch_duration_of_running_m + this->watch_duration_of_running_s;
+				if (has_deadline && wait_next > deadline) {
+					wait_next = deadline + std::chrono::milliseconds(1);
+				}
 				std::this_thread::sleep_until(wait_next);
 			}
 		}
@@ -416,6 +449,7 @@ namespace dsice {
 	std::vector<double> ProcessManager<T>::aggregateResults(void) {
 
 		std::vector<double> performance_values;
+		this->censored_flags.clear();
 
 		for (std::size_t i = 0; i < this->running_processes.size(); i++) {
 
@@ -426,10 +460,18 @@ namespace dsice {
 				double tmp;
 				ifs >> tmp;
 				performance_values.push_back(tmp);
+				this->censored_flags.push_back(false);
+			}
+			else if (this->deadline_of_running.count() > 0 && std::chrono::system_clock::now() - this->running_start_time[i] > this->deadline_of_running) {
+
+				// 実行期限で打ち切ったプロセスは，実行時間が少なくとも期限以上であることのみ分かる
+				performance_values.push_back(this->deadline_of_running.count());
+				this->censored_flags.push_back(true);
 			}
 			else {
 				
 				performance_values.push_back(std::numeric_limits<double>::quiet_NaN());
+				this->censored_flags.push_back(false);
 
 				// プロセスキル
 				if (this->process_kill_reservation_on && this->running_pid.contains(this->running_processes[i])) {
@@ -448,6 +490,11 @@ namespace dsice {
 		return performance_values;
 	}
 
+	template <typename T>
+	const std::vector<bool>& ProcessManager<T>::getCensoredFlags(void) const {
+		return this->censored_flags;
+	}
+
 	template <typename T>
 	void ProcessManager<T>::resetEnvironment(void) const {
 
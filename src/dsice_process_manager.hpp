@@ -139,6 +139,18 @@ namespace dsice {
 		/// </summary>
 		std::chrono::hours wait_duration_of_running_h = std::chrono::hours(0);
 		/// <summary>
+		/// プロセス 1 つあたりの実行期限 (0 なら期限なし)
+		/// </summary>
+		std::chrono::duration<double> deadline_of_running = std::chrono::duration<double>(0);
+		/// <summary>
+		/// 監視中プロセスの実行開始を確認した時刻
+		/// </summary>
+		std::vector<std::chrono::system_clock::time_point> running_start_time;
+		/// <summary>
+		/// 直近に集計した結果のうち，実行期限を超えて打ち切られたものか
+		/// </summary>
+		std::vector<bool> censored_flags;
+		/// <summary>
 		/// 一時ファイルから PID を取得
 		/// </summary>
 		/// <param name="pid_recorded_path">一時ファイルの位置</param>
@@ -234,14 +246,22 @@ namespace dsice {
 		/// <param name="seconds">秒</param>
 		void setWaitDurationOfRunning(std::size_t hours, std::size_t minutes, std::size_t seconds);
 		/// <summary>
+		/// プロセス 1 つあたりの実行期限を設定．<br/>
+		/// 期限を超えたプロセスは waitAll() 内で強制終了され，aggregateResults() では期限の秒数が打ち切り時点の限界値として返されます
+		/// </summary>
+		/// <param name="seconds">実行期限の秒数 (Tuner::getDeadline() の値など，0 なら期限なし)</param>
+		void setDeadlineOfRunning(double seconds);
+		/// <summary>
 		/// パラメタ設定値を変化させながらユーザプログラムを起動
 		/// </summary>
 		/// <param name="parameter">パラメタ設定値</param>
 		/// <param name="with_file">パラメタ設定値をファイルで受け渡すかどうか</param>
+		/// <param name="fidelity">実測すべき忠実度 (Tuner::getSuggestedFidelity() の値など，0 なら渡さない)．ユーザプログラムでは ProcessAgent::getFidelity() で取得できます</param>
 		/// <returns>時間制限などでプログラムが起動しなかった場合に false</returns>
-		bool launchProcess(std::vector<T> parameter, bool with_file = true);
+		bool launchProcess(std::vector<T> parameter, bool with_file = true, double fidelity = 0);
 		/// <summary>
-		/// 実行中の全プロセスが終了するか，事前に設定された制限時間が経過するまで待機
+		/// 実行中の全プロセスが終了するか，事前に設定された制限時間が経過するまで待機．<br/>
+		/// 実行期限が設定されている場合，期限を超えたプロセスは強制終了して次のプロセスの待機に移る
 		/// </summary>
 		/// <returns>全プロセス終了で true，制限時間到達で false</returns>
 		bool waitAll(void) const;
@@ -251,6 +271,11 @@ namespace dsice {
 		/// <returns>結果の性能値一覧 (終了できていない場合は NaN)</returns>
 		std::vector<double> aggregateResults(void);
 		/// <summary>
+		/// 直近の aggregateResults() の結果のうち，実行期限を超えて打ち切られたものかを取得
+		/// </summary>
+		/// <returns>結果ごとの打ち切りの有無 (Tuner::setMetricValuesList() にそのまま渡せる)</returns>
+		const std::vector<bool>& getCensoredFlags(void) const;
+		/// <summary>
 		/// DSICE の一時ファイルとコピーされたディレクトリをすべて削除し，実行前の状態に戻す
 		/// </summary>
 		void resetEnvironment(void) const;
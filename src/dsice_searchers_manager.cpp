@@ -1,5 +1,6 @@
 ﻿#include <memory>
 
+#include "copy_on_write.hpp"
 #include "dsice_searchers_manager.hpp"
 
 namespace dsice {
@@ -30,6 +31,10 @@ namespace dsice {
 		return this->searcher;
 	}
 
+	bool ManagedSearcher::isSearcherShared(void) const {
+		return isShared(this->searcher);
+	}
+
 	bool ManagedSearcher::isRunning(void) const {
 		return this->is_running;
 	}
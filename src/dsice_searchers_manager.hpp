@@ -48,6 +48,11 @@ namespace dsice {
 		/// <returns>探索機構</returns>
 		std::shared_ptr<Searcher> getSearcher(void) const;
 		/// <summary>
+		/// 探索機構を他の ManagedSearcher と共有しているかどうか (更新前に複製が必要か)
+		/// </summary>
+		/// <returns>共有していれば true</returns>
+		bool isSearcherShared(void) const;
+		/// <summary>
 		/// 探索機構が稼働しているかどうか
 		/// </summary>
 		/// <returns>探索機構が稼働していれば true</returns>
@@ -1,10 +1,19 @@
 ﻿#include <memory>
 #include <limits>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
 
 #include "dsice_metric.hpp"
 #include "overwritten_double.hpp"
 #include "average_double.hpp"
+#include "median_double.hpp"
+#include "trimmed_average_double.hpp"
+#include "minimum_double.hpp"
+#include "ewma_double.hpp"
 #include "dsice_search_space.hpp"
+#include "additive_surrogate.hpp"
+#include "copy_on_write.hpp"
 #include "dsice_standard_database.hpp"
 
 namespace dsice {
@@ -12,17 +21,38 @@ namespace dsice {
 	StandardDatabase::StandardDatabase(const space_size& search_space, DatabaseMetricType database_metric_type) {
 		this->search_space_size = search_space;
 		this->metric_type = database_metric_type;
+		this->base_points = std::make_shared<std::unordered_map<coordinate, std::unordered_set<DirectionLine>>>();
+		this->censored_samples = std::make_shared<std::unordered_set<coordinate>>();
 	}
 
 	StandardDatabase::StandardDatabase(const StandardDatabase& original) {
 		
 		this->search_space_size = original.search_space_size;
 
-		for (const std::pair<const coordinate, std::shared_ptr<Metric>>& original_sample : original.samples) {
-			this->samples.emplace(original_sample.first, original_sample.second->makeCopy());
-		}
-
+		// 標本や基準点はコピー元と共有し，どちらかが更新する時点で更新する部分のみ複製する (コピーオンライト)
+		this->samples = original.samples;
 		this->base_points = original.base_points;
+		this->censored_samples = original.censored_samples;
+
+		// 代理モデルは推定済であれば共有する (共有中に遅延再推定が走らないよう，未推定のものは複製する)
+		if (original.surrogate != nullptr) {
+			if (original.surrogate->isOutdated()) {
+				this->surrogate = std::make_shared<AdditiveSurrogate>(*original.surrogate);
+			}
+			else {
+				this->surrogate = original.surrogate;
+			}
+		}
+		this->surrogate_pair_num = original.surrogate_pair_num;
+		this->measure_durations = original.measure_durations;
+		if (original.duration_model != nullptr) {
+			if (original.duration_model->isOutdated()) {
+				this->duration_model = std::make_shared<AdditiveSurrogate>(*original.duration_model);
+			}
+			else {
+				this->duration_model = original.duration_model;
+			}
+		}
 		this->latest_base_coordinate = original.latest_base_coordinate;
 		this->has_base_coordinate_changed = original.has_base_coordinate_changed;
 		this->latest_sample_coordinates = original.latest_sample_coordinates;
@@ -34,6 +64,42 @@ namespace dsice {
 		// DO_NOTHING
 	}
 
+	std::unordered_map<coordinate, std::unordered_set<DirectionLine>>& StandardDatabase::getWritableBasePoints(void) {
+
+		if (isShared(this->base_points)) {
+			this->base_points = std::make_shared<std::unordered_map<coordinate, std::unordered_set<DirectionLine>>>(*this->base_points);
+		}
+
+		return *this->base_points;
+	}
+
+	std::unordered_set<coordinate>& StandardDatabase::getWritableCensoredSamples(void) {
+
+		if (isShared(this->censored_samples)) {
+			this->censored_samples = std::make_shared<std::unordered_set<coordinate>>(*this->censored_samples);
+		}
+
+		return *this->censored_samples;
+	}
+
+	AdditiveSurrogate& StandardDatabase::getWritableSurrogate(void) {
+
+		if (isShared(this->surrogate)) {
+			this->surrogate = std::make_shared<AdditiveSurrogate>(*this->surrogate);
+		}
+
+		return *this->surrogate;
+	}
+
+	AdditiveSurrogate& StandardDatabase::getWritableDurationModel(void) {
+
+		if (isShared(this->duration_model)) {
+			this->duration_model = std::make_shared<AdditiveSurrogate>(*this->duration_model);
+		}
+
+		return *this->duration_model;
+	}
+
 	dimension_size StandardDatabase::getSpaceDimension(void) const {
 		return this->search_space_size.size();
 	}
@@ -46,9 +112,16 @@ namespace dsice {
 
 		this->latest_sample_coordinates.push_back(target_coordinate);
 		this->latest_measured_values.push_back(metric_value);
+		if (this->censored_samples->contains(target_coordinate)) {
+			this->getWritableCensoredSamples().erase(target_coordinate);
+		}
 
 		if (this->samples.contains(target_coordinate)) {
-			this->samples.at(target_coordinate)->setValue(metric_value);
+			std::shared_ptr<Metric>& target_metric = this->samples.getWritable(target_coordinate);
+			if (isShared(target_metric)) {
+				target_metric = target_metric->makeCopy();
+			}
+			target_metric->setValue(metric_value);
 		}
 		else {
 			switch (this->metric_type) {
@@ -58,8 +131,24 @@ namespace dsice {
 			case DatabaseMetricType::AverageDouble:
 				this->samples.emplace(target_coordinate, std::make_shared<AverageDouble>(metric_value));
 				break;
+			case DatabaseMetricType::MedianDouble:
+				this->samples.emplace(target_coordinate, std::make_shared<MedianDouble>(metric_value));
+				break;
+			case DatabaseMetricType::TrimmedAverageDouble:
+				this->samples.emplace(target_coordinate, std::make_shared<TrimmedAverageDouble>(metric_value));
+				break;
+			case DatabaseMetricType::MinimumDouble:
+				this->samples.emplace(target_coordinate, std::make_shared<MinimumDouble>(metric_value));
+				break;
+			case DatabaseMetricType::EwmaDouble:
+				this->samples.emplace(target_coordinate, std::make_shared<EwmaDouble>(metric_value));
+				break;
 			}
 		}
+
+		if (this->surrogate != nullptr) {
+			this->getWritableSurrogate().setSample(target_coordinate, this->samples.at(target_coordinate)->getValue());
+		}
 	}
 
 	bool StandardDatabase::hasSample(const coordinate& target_coordinate) const {
@@ -70,6 +159,17 @@ namespace dsice {
 		return this->samples.size();
 	}
 
+	coordinate_list StandardDatabase::getExistSampleCoordinates(void) const {
+
+		coordinate_list sample_coordinates;
+		sample_coordinates.reserve(this->samples.size());
+		for (const std::pair<const coordinate, std::shared_ptr<Metric>>& sample : this->samples) {
+			sample_coordinates.push_back(sample.first);
+		}
+
+		return sample_coordinates;
+	}
+
 	double StandardDatabase::getSampleMetricValue(const coordinate& target_coordinate) const {
 		
 		if (this->samples.contains(target_coordinate)) {
@@ -87,8 +187,8 @@ namespace dsice {
 			this->has_base_coordinate_changed = true;
 			this->latest_base_coordinate = target_coordinate;
 
-			if (!this->base_points.contains(target_coordinate)) {
-				this->base_points.emplace(target_coordinate, std::unordered_set<DirectionLine>());
+			if (!this->base_points->contains(target_coordinate)) {
+				this->getWritableBasePoints().emplace(target_coordinate, std::unordered_set<DirectionLine>());
 			}
 		}
 		else {
@@ -97,26 +197,22 @@ namespace dsice {
 	}
 
 	const std::unordered_map<coordinate, std::unordered_set<DirectionLine>>& StandardDatabase::getBasePoints(void) const {
-		return this->base_points;
+		return *this->base_points;
 	}
 
 	bool StandardDatabase::hasBeenBasePoint(const coordinate& target_coordinate) const {
-		return this->base_points.contains(target_coordinate);
+		return this->base_points->contains(target_coordinate);
 	}
 
 	void StandardDatabase::recordSearchedDirection(const coordinate& base_coordinate, const DirectionLine& line_info) {
 
-		if (!this->base_points.contains(base_coordinate)) {
-			this->base_points.emplace(base_coordinate, std::unordered_set<DirectionLine>());
-		}
-
-		this->base_points.at(base_coordinate).insert(line_info);
+		this->getWritableBasePoints()[base_coordinate].insert(line_info);
 	}
 
 	bool StandardDatabase::isSearchedDirection(const coordinate& base_coordinate, const DirectionLine& line_info) const {
 		
-		if (this->base_points.contains(base_coordinate)) {
-			if (this->base_points.at(base_coordinate).contains(line_info)) {
+		if (this->base_points->contains(base_coordinate)) {
+			if (this->base_points->at(base_coordinate).contains(line_info)) {
 				return true;
 			}
 		}
@@ -144,4 +240,107 @@ namespace dsice {
 	bool StandardDatabase::hasBaseCoordinateChanged(void) const {
 		return this->has_base_coordinate_changed;
 	}
+
+	void StandardDatabase::setSampleCensored(const coordinate& target_coordinate) {
+
+		this->getWritableCensoredSamples().insert(target_coordinate);
+
+		// 限界値は代理モデルの当てはめに使わない
+		if (this->surrogate != nullptr) {
+			this->getWritableSurrogate().removeSample(target_coordinate);
+		}
+	}
+
+	bool StandardDatabase::isSampleCensored(const coordinate& target_coordinate) const {
+		return this->censored_samples->contains(target_coordinate);
+	}
+
+	const AdditiveSurrogate& StandardDatabase::getSurrogate(void) const {
+
+		if (this->surrogate == nullptr) {
+			this->surrogate = std::make_shared<AdditiveSurrogate>(this->search_space_size, this->surrogate_pair_num);
+			for (const std::pair<const coordinate, std::shared_ptr<Metric>>& sample : this->samples) {
+				if (!this->censored_samples->contains(sample.first)) {
+					this->surrogate->setSample(sample.first, sample.second->getValue());
+				}
+			}
+		}
+
+		return *this->surrogate;
+	}
+
+	void StandardDatabase::setSurrogatePairNum(std::size_t max_pair_num) {
+		this->surrogate_pair_num = max_pair_num;
+		this->surrogate = nullptr;
+	}
+
+	void StandardDatabase::setSampleMeasureDuration(const coordinate& target_coordinate, double duration_sec) {
+
+		if (!(duration_sec >= 0)) {
+			throw std::invalid_argument("duration_sec must be zero or more.");
+		}
+
+		AverageDouble& durations = this->measure_durations[target_coordinate];
+		durations.setValue(duration_sec);
+
+		// 実測時間はパラメタ間で乗法的に効くことが多いため，対数をとって加法モデルに当てはめる
+		if (this->duration_model != nullptr) {
+			this->getWritableDurationModel().setSample(target_coordinate, std::log(std::max(durations.getValue(), MIN_MODELED_DURATION_SEC)));
+		}
+	}
+
+	std::size_t StandardDatabase::getMeasureDurationSamplesNum(void) const {
+		return this->measure_durations.size();
+	}
+
+	double StandardDatabase::predictMeasureDuration(const coordinate& target_coordinate) const {
+
+		if (this->measure_durations.empty()) {
+			return 0;
+		}
+
+		if (this->measure_durations.contains(target_coordinate)) {
+			return this->measure_durations.at(target_coordinate).getValue();
+		}
+
+		if (this->duration_model == nullptr) {
+			this->duration_model = std::make_shared<AdditiveSurrogate>(this->search_space_size);
+			for (const std::pair<const coordinate, AverageDouble>& duration : this->measure_durations) {
+				this->duration_model->setSample(duration.first, std::log(std::max(duration.second.getValue(), MIN_MODELED_DURATION_SEC)));
+			}
+		}
+
+		return std::exp(this->duration_model->predict(target_coordinate));
+	}
+
+	std::size_t StandardDatabase::getSampleRecordedCount(const coordinate& target_coordinate) const {
+
+		if (this->samples.contains(target_coordinate)) {
+			return this->samples.at(target_coordinate)->getRecordedCount();
+		}
+		else {
+			return 0;
+		}
+	}
+
+	double StandardDatabase::getSampleVariance(const coordinate& target_coordinate) const {
+
+		// 分散を保持するのは平均，中央値，両端を除いた平均をとる型のみ
+		if (this->samples.contains(target_coordinate) && this->samples.at(target_coordinate)->getRecordedCount() >= 2) {
+
+			std::shared_ptr<const Metric> sample = this->samples.at(target_coordinate);
+
+			if (std::shared_ptr<const AverageDouble> average = std::dynamic_pointer_cast<const AverageDouble>(sample)) {
+				return average->getVariance();
+			}
+			if (std::shared_ptr<const MedianDouble> median = std::dynamic_pointer_cast<const MedianDouble>(sample)) {
+				return median->getVariance();
+			}
+			if (std::shared_ptr<const TrimmedAverageDouble> trimmed = std::dynamic_pointer_cast<const TrimmedAverageDouble>(sample)) {
+				return trimmed->getVariance();
+			}
+		}
+
+		return std::numeric_limits<double>::quiet_NaN();
+	}
 }
\ No newline at end of file
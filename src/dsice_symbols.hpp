@@ -12,6 +12,8 @@ namespace dsice {
 	const std::string TMP_PROCESS_STATE_FILE = std::string(".dsice_process_state");
 
 	const std::string TMP_PERFORMANCE_FILE_PREFIX = std::string(".dsice_performance_");
+
+	const std::string FIDELITY_ENV_NAME = std::string("DSICE_FIDELITY");
 }
 
 #endif // !DSICE_SYMBOLS_HPP_
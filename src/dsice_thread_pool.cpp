@@ -0,0 +1,184 @@
+﻿#include <memory>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+
+#include "dsice_thread_pool.hpp"
+
+namespace dsice {
+
+	ThreadPool::ThreadPool(std::size_t thread_num) {
+
+		if (thread_num == 0) {
+			throw std::invalid_argument("thread pool needs one thread at least.");
+		}
+
+		for (std::size_t i = 0; i < thread_num; i++) {
+			this->queues.push_back(std::make_unique<TaskQueue>());
+		}
+
+		for (std::size_t i = 0; i < thread_num; i++) {
+			this->threads.emplace_back(&ThreadPool::workerLoop, this, i);
+		}
+	}
+
+	ThreadPool::~ThreadPool(void) {
+
+		{
+			std::lock_guard<std::mutex> lock(this->wait_mutex);
+			this->is_stopping = true;
+		}
+		this->wait_condition.notify_all();
+
+		for (std::thread& t : this->threads) {
+			t.join();
+		}
+	}
+
+	bool ThreadPool::tryRunTask(std::size_t own_queue_idx) {
+
+		for (std::size_t k = 0; k < this->queues.size(); k++) {
+
+			std::size_t idx = (own_queue_idx + k) % this->queues.size();
+			std::function<void(void)> task;
+
+			{
+				std::lock_guard<std::mutex> lock(this->queues[idx]->mutex);
+
+				if (this->queues[idx]->tasks.empty()) {
+					continue;
+				}
+
+				// 自分のキューは末尾 (直近に積んだ仕事) から，他のキューは先頭から奪う
+				if (k == 0) {
+					task = std::move(this->queues[idx]->tasks.back());
+					this->queues[idx]->tasks.pop_back();
+				}
+				else {
+					task = std::move(this->queues[idx]->tasks.front());
+					this->queues[idx]->tasks.pop_front();
+				}
+				this->queued_task_num--;
+			}
+
+			task();
+			return true;
+		}
+
+		return false;
+	}
+
+	void ThreadPool::workerLoop(std::size_t own_queue_idx) {
+
+		while (true) {
+
+			if (this->tryRunTask(own_queue_idx)) {
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(this->wait_mutex);
+			this->wait_condition.wait(lock, [this]() { return this->is_stopping || this->queued_task_num > 0; });
+
+			if (this->is_stopping && this->queued_task_num == 0) {
+				return;
+			}
+		}
+	}
+
+	std::size_t ThreadPool::getThreadNum(void) const {
+		return this->threads.size();
+	}
+
+	void ThreadPool::parallelFor(std::size_t task_num, const std::function<void(std::size_t)>& task) {
+
+		if (task_num == 0) {
+			return;
+		}
+
+		if (task_num == 1) {
+			task(0);
+			return;
+		}
+
+		// 奪い合いで負荷が均せる程度に細かく，仕事の受け渡しが重くならない程度に粗く分割する
+		std::size_t chunk_num = std::min(task_num, this->threads.size() * 4);
+		std::size_t chunk_size = (task_num + chunk_num - 1) / chunk_num;
+		chunk_num = (task_num + chunk_size - 1) / chunk_size;
+
+		std::atomic<std::size_t> remaining_chunk_num = chunk_num;
+		std::exception_ptr first_error = nullptr;
+		std::mutex error_mutex;
+
+		for (std::size_t c = 0; c < chunk_num; c++) {
+
+			std::size_t begin = c * chunk_size;
+			std::size_t end = std::min(task_num, begin + chunk_size);
+
+			std::function<void(void)> chunk = [this, begin, end, &task, &remaining_chunk_num, &first_error, &error_mutex]() {
+
+				try {
+					for (std::size_t i = begin; i < end; i++) {
+						task(i);
+					}
+				}
+				catch (...) {
+					std::lock_guard<std::mutex> lock(error_mutex);
+					if (first_error == nullptr) {
+						first_error = std::current_exception();
+					}
+				}
+
+				if (--remaining_chunk_num == 0) {
+					std::lock_guard<std::mutex> lock(this->wait_mutex);
+					this->wait_condition.notify_all();
+				}
+			};
+
+			std::size_t idx = this->next_queue_idx++ % this->queues.size();
+			{
+				std::lock_guard<std::mutex> lock(this->queues[idx]->mutex);
+				this->queues[idx]->tasks.push_back(std::move(chunk));
+				this->queued_task_num++;
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(this->wait_mutex);
+			this->wait_condition.notify_all();
+		}
+
+		// 待つ間も仕事を実行する (仕事の中から呼ばれた場合に全スレッドが待ちで止まらないように)
+		while (remaining_chunk_num > 0) {
+
+			if (this->tryRunTask(0)) {
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(this->wait_mutex);
+			this->wait_condition.wait(lock, [this, &remaining_chunk_num]() { return remaining_chunk_num == 0 || this->queued_task_num > 0; });
+		}
+
+		if (first_error != nullptr) {
+			std::rethrow_exception(first_error);
+		}
+	}
+
+	void ThreadPool::run(const std::shared_ptr<ThreadPool>& pool, std::size_t task_num, const std::function<void(std::size_t)>& task) {
+
+		if (pool != nullptr) {
+			pool->parallelFor(task_num, task);
+		}
+		else {
+			for (std::size_t i = 0; i < task_num; i++) {
+				task(i);
+			}
+		}
+	}
+}
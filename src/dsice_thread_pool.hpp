@@ -0,0 +1,116 @@
+﻿#ifndef DSICE_THREAD_POOL_HPP_
+#define DSICE_THREAD_POOL_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace dsice {
+
+	/// <summary>
+	/// 探索機構の構築や再計算を並列に実行するワークスティーリング型スレッドプール．<br/>
+	/// 各スレッドは自分のキューの末尾から仕事を取り出し，空であれば他のスレッドのキューの先頭から奪う
+	/// </summary>
+	class ThreadPool final {
+	private:
+		/// <summary>
+		/// スレッドごとの仕事キュー
+		/// </summary>
+		struct TaskQueue {
+			/// <summary>
+			/// キューの排他制御
+			/// </summary>
+			std::mutex mutex;
+			/// <summary>
+			/// 未実行の仕事
+			/// </summary>
+			std::deque<std::function<void(void)>> tasks;
+		};
+		/// <summary>
+		/// スレッドごとの仕事キュー
+		/// </summary>
+		std::vector<std::unique_ptr<TaskQueue>> queues;
+		/// <summary>
+		/// 作業スレッド
+		/// </summary>
+		std::vector<std::thread> threads;
+		/// <summary>
+		/// 待機用の排他制御
+		/// </summary>
+		std::mutex wait_mutex;
+		/// <summary>
+		/// 仕事の追加や完了を通知する条件変数
+		/// </summary>
+		std::condition_variable wait_condition;
+		/// <summary>
+		/// 全キュー中の未実行の仕事の数
+		/// </summary>
+		std::atomic<std::size_t> queued_task_num = 0;
+		/// <summary>
+		/// 次に仕事を積むキューの番号
+		/// </summary>
+		std::atomic<std::size_t> next_queue_idx = 0;
+		/// <summary>
+		/// 終了処理中かどうか (wait_mutex で保護)
+		/// </summary>
+		bool is_stopping = false;
+		/// <summary>
+		/// 仕事を 1 つ取り出して実行する
+		/// </summary>
+		/// <param name="own_queue_idx">優先して取り出すキューの番号</param>
+		/// <returns>実行した場合 true</returns>
+		bool tryRunTask(std::size_t own_queue_idx);
+		/// <summary>
+		/// 作業スレッドの処理
+		/// </summary>
+		/// <param name="own_queue_idx">担当キューの番号</param>
+		void workerLoop(std::size_t own_queue_idx);
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="thread_num">作業スレッド数 (1 以上)</param>
+		ThreadPool(std::size_t thread_num);
+		/// <summary>
+		/// スレッドを所有するためコピー不可
+		/// </summary>
+		ThreadPool(const ThreadPool&) = delete;
+		/// <summary>
+		/// スレッドを所有するためコピー不可
+		/// </summary>
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		/// <summary>
+		/// デストラクタ．作業スレッドを終了させて待つ
+		/// </summary>
+		/// <param name=""></param>
+		~ThreadPool(void);
+		/// <summary>
+		/// 作業スレッド数を取得
+		/// </summary>
+		/// <returns>作業スレッド数</returns>
+		std::size_t getThreadNum(void) const;
+		/// <summary>
+		/// 0 から task_num - 1 までの番号それぞれについて仕事を並列実行し，すべての完了を待つ．<br/>
+		/// 呼び出し元スレッドも完了待ちの間に仕事を実行するため，仕事の中から呼び出しても停止しない．
+		/// 仕事が例外を送出した場合は，すべての完了後に最初の例外を再送出する
+		/// </summary>
+		/// <param name="task_num">仕事の数</param>
+		/// <param name="task">番号を受け取る仕事 (同時に複数スレッドから呼ばれる)</param>
+		void parallelFor(std::size_t task_num, const std::function<void(std::size_t)>& task);
+		/// <summary>
+		/// スレッドプールが指定されていれば並列に，nullptr であれば呼び出し元スレッドで番号順に仕事を実行する
+		/// </summary>
+		/// <param name="pool">スレッドプール (nullptr 可)</param>
+		/// <param name="task_num">仕事の数</param>
+		/// <param name="task">番号を受け取る仕事</param>
+		static void run(const std::shared_ptr<ThreadPool>& pool, std::size_t task_num, const std::function<void(std::size_t)>& task);
+	};
+}
+
+#endif // !DSICE_THREAD_POOL_HPP_
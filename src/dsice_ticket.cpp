@@ -0,0 +1,47 @@
+﻿#include <vector>
+
+#include "dsice_ticket.hpp"
+
+namespace dsice {
+
+	template <typename T>
+	Ticket<T>::Ticket(std::size_t ticket_id, const std::vector<T>& parameter, double fidelity) {
+		this->ticket_id = ticket_id;
+		this->parameter = parameter;
+		this->fidelity = fidelity;
+	}
+
+	template <typename T>
+	Ticket<T>::Ticket(const Ticket& original) {
+		this->ticket_id = original.ticket_id;
+		this->parameter = original.parameter;
+		this->fidelity = original.fidelity;
+	}
+
+	template <typename T>
+	Ticket<T>::~Ticket(void) {
+		// DO_NOTHING
+	}
+
+	template <typename T>
+	std::size_t Ticket<T>::getId(void) const {
+		return this->ticket_id;
+	}
+
+	template <typename T>
+	const std::vector<T>& Ticket<T>::getParameter(void) const {
+		return this->parameter;
+	}
+
+	template <typename T>
+	double Ticket<T>::getFidelity(void) const {
+		return this->fidelity;
+	}
+
+	// コンパイルさせるための実態を記述
+	template class Ticket<int>;
+	template class Ticket<long long>;
+	template class Ticket<std::size_t>;
+	template class Ticket<float>;
+	template class Ticket<double>;
+}
\ No newline at end of file
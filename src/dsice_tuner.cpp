@@ -1,24 +1,79 @@
 ﻿#include <memory>
 #include <vector>
 #include <string>
+#include <mutex>
 
+#include "dsice_ticket.hpp"
 #include "operation_integrator.hpp"
+#include "copy_on_write.hpp"
 #include "dsice_tuner.hpp"
 
 namespace dsice {
 
 	/// <summary>
 	/// private メンバを隠蔽するための Pimpl イディオム用クラス．<br/>
-	/// これを Integrator にできなくはないが，ヘッダと実装の分離を徹底するためにポインタ所持の役割に徹する
+	/// これを Integrator にできなくはないが，ヘッダと実装の分離を徹底するためにポインタ所持の役割に徹する．<br/>
+	/// コピー時は統合層をコピー元と共有し，どちらかが更新する時点で初めて複製する (コピーオンライト)．<br/>
+	/// 統合層の呼び出しは常に排他制御を保持したまま行い，複製と他スレッドからの呼び出しが競合しないようにする
 	/// </summary>
 	/// <typeparam name="T">性能パラメタの値型</typeparam>
 	template <typename T>
 	class Tuner<T>::TunerPrivateMembers {
+	public:
+		/// <summary>
+		/// 排他制御を保持したまま統合層を呼び出すためのアクセサ．<br/>
+		/// 呼び出し式の一時オブジェクトとして使い，式の評価が終わるまでロックを保持する
+		/// </summary>
+		/// <typeparam name="I">統合層の型 (const 修飾を含む)</typeparam>
+		template <typename I>
+		class IntegratorAccess {
+		private:
+			/// <summary>
+			/// 統合層のポインタのロック
+			/// </summary>
+			std::unique_lock<std::mutex> pointer_lock;
+			/// <summary>
+			/// 統合層を共有するチューナ間で共通のロック
+			/// </summary>
+			std::unique_lock<std::mutex> integrator_lock;
+			/// <summary>
+			/// 呼び出す統合層
+			/// </summary>
+			I* integrator;
+		public:
+			/// <summary>
+			/// コンストラクタ
+			/// </summary>
+			/// <param name="locked_pointer">取得済の統合層のポインタのロック</param>
+			/// <param name="locked_integrator">取得済の統合層のロック</param>
+			/// <param name="target_integrator">呼び出す統合層</param>
+			IntegratorAccess(std::unique_lock<std::mutex>&& locked_pointer, std::unique_lock<std::mutex>&& locked_integrator, I* target_integrator) :
+				pointer_lock(std::move(locked_pointer)), integrator_lock(std::move(locked_integrator)), integrator(target_integrator)
+			{
+				// DO_NOTHING
+			}
+			/// <summary>
+			/// 統合層の呼び出し
+			/// </summary>
+			/// <returns>統合層のポインタ</returns>
+			I* operator->(void) const {
+				return this->integrator;
+			}
+		};
 	private:
 		/// <summary>
 		/// 隠蔽された統合層
 		/// </summary>
 		std::shared_ptr<OperationIntegrator<T>> integrator = nullptr;
+		/// <summary>
+		/// 統合層の呼び出しの排他制御 (統合層を共有するチューナ間で共通，統合層の複製時に作り直す)
+		/// </summary>
+		std::shared_ptr<std::mutex> integrator_mutex = nullptr;
+		/// <summary>
+		/// 統合層のポインタの排他制御．<br/>
+		/// 統合層の呼び出し中も保持し，呼び出し中の統合層が他スレッドの複製で差し替わらないようにする
+		/// </summary>
+		mutable std::mutex pointer_mutex;
 	public:
 		/// <summary>
 		/// コンストラクタ
@@ -39,25 +94,36 @@ namespace dsice {
 		/// </summary>
 		~TunerPrivateMembers(void);
 		/// <summary>
-		/// 統合層へのアクセス
+		/// 統合層への更新を伴うアクセス．他のチューナと共有している場合は複製してから返す．<br/>
+		/// 共有判定を参照数で行うため，呼び出し側で参照数を増やさないようロックと生ポインタの組で返す
+		/// </summary>
+		/// <returns>統合層へのアクセサ</returns>
+		IntegratorAccess<OperationIntegrator<T>> Integrator(void);
+		/// <summary>
+		/// 統合層への参照のみのアクセス (共有したまま返す)
 		/// </summary>
-		/// <returns>統合層のポインタ</returns>
-		std::shared_ptr<OperationIntegrator<T>> Integrator(void);
+		/// <returns>統合層へのアクセサ</returns>
+		IntegratorAccess<const OperationIntegrator<T>> ConstIntegrator(void) const;
 	};
 
 	template <typename T>
 	Tuner<T>::TunerPrivateMembers::TunerPrivateMembers(void) {
 		this->integrator = std::make_shared<OperationIntegrator<T>>();
+		this->integrator_mutex = std::make_shared<std::mutex>();
 	}
 
 	template <typename T>
 	Tuner<T>::TunerPrivateMembers::TunerPrivateMembers(const std::vector<std::vector<T>>& parameters) {
 		this->integrator = std::make_shared<OperationIntegrator<T>>(parameters);
+		this->integrator_mutex = std::make_shared<std::mutex>();
 	}
 
 	template <typename T>
 	Tuner<T>::TunerPrivateMembers::TunerPrivateMembers(const TunerPrivateMembers& original) {
-		this->integrator = std::make_shared<OperationIntegrator<T>>(*(original.integrator));
+		// 複製は更新時まで遅延する
+		std::lock_guard<std::mutex> lock(original.pointer_mutex);
+		this->integrator = original.integrator;
+		this->integrator_mutex = original.integrator_mutex;
 	}
 
 	template <typename T>
@@ -66,8 +132,33 @@ namespace dsice {
 	}
 
 	template <typename T>
-	std::shared_ptr<OperationIntegrator<T>> Tuner<T>::TunerPrivateMembers::Integrator(void){
-		return this->integrator;
+	typename Tuner<T>::TunerPrivateMembers::template IntegratorAccess<OperationIntegrator<T>> Tuner<T>::TunerPrivateMembers::Integrator(void){
+
+		std::unique_lock<std::mutex> pointer_lock(this->pointer_mutex);
+
+		if (isShared(this->integrator)) {
+			// 共有先が複製元を呼び出し中でないことを保証してから複製する
+			std::unique_lock<std::mutex> shared_lock(*(this->integrator_mutex));
+			std::shared_ptr<OperationIntegrator<T>> detached_integrator = std::make_shared<OperationIntegrator<T>>(*(this->integrator));
+			shared_lock.unlock();
+
+			this->integrator = detached_integrator;
+			this->integrator_mutex = std::make_shared<std::mutex>();
+		}
+
+		std::unique_lock<std::mutex> integrator_lock(*(this->integrator_mutex));
+
+		return IntegratorAccess<OperationIntegrator<T>>(std::move(pointer_lock), std::move(integrator_lock), this->integrator.get());
+	}
+
+	template <typename T>
+	typename Tuner<T>::TunerPrivateMembers::template IntegratorAccess<const OperationIntegrator<T>> Tuner<T>::TunerPrivateMembers::ConstIntegrator(void) const {
+
+		// 共有中の統合層でも参照時に内部状態の遅延更新が起こりうるため，共有先と共通のロックを取る
+		std::unique_lock<std::mutex> pointer_lock(this->pointer_mutex);
+		std::unique_lock<std::mutex> integrator_lock(*(this->integrator_mutex));
+
+		return IntegratorAccess<const OperationIntegrator<T>>(std::move(pointer_lock), std::move(integrator_lock), this->integrator.get());
 	}
 
 	//
@@ -149,6 +240,96 @@ namespace dsice {
 		this->private_members->Integrator()->config_setDatabaseMetricType(metric_type);
 	}
 
+	template <typename T>
+	void Tuner<T>::config_setAdaptiveRemeasurement(std::size_t max_measurement_num, double z_value) {
+		this->private_members->Integrator()->config_setAdaptiveRemeasurement(max_measurement_num, z_value);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setSignificanceTest(std::size_t max_repetitions, double significance_level) {
+		this->private_members->Integrator()->config_setSignificanceTest(max_repetitions, significance_level);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setLogMemoryLimit(std::size_t max_in_memory_base_point_num, const std::string& spill_file_path) {
+		this->private_members->Integrator()->config_setLogMemoryLimit(max_in_memory_base_point_num, spill_file_path);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setPrecomputation(bool precomputation_on) {
+		this->private_members->Integrator()->config_setPrecomputation(precomputation_on);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setDeadlineFactor(double deadline_factor) {
+		this->private_members->Integrator()->config_setDeadlineFactor(deadline_factor);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setMultiStartNum(std::size_t start_num) {
+		this->private_members->Integrator()->config_setMultiStartNum(start_num);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setWorkerNum(std::size_t worker_num) {
+		this->private_members->Integrator()->config_setWorkerNum(worker_num);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setFullSearchFactor(std::size_t factor) {
+		this->private_members->Integrator()->config_setFullSearchFactor(factor);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setFullSearchPruning(double margin) {
+		this->private_members->Integrator()->config_setFullSearchPruning(margin);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setThreadPoolSize(std::size_t thread_num) {
+		this->private_members->Integrator()->config_setThreadPoolSize(thread_num);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setDirectionSampling(std::size_t max_changed_axis_num, std::size_t direction_budget) {
+		this->private_members->Integrator()->config_setDirectionSampling(max_changed_axis_num, direction_budget);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setParameterScreening(double threshold) {
+		this->private_members->Integrator()->config_setParameterScreening(threshold);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setGradientStep(bool gradient_step_on) {
+		this->private_members->Integrator()->config_setGradientStep(gradient_step_on);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setSurrogate(std::size_t max_pair_num, double skip_confidence) {
+		this->private_members->Integrator()->config_setSurrogate(max_pair_num, skip_confidence);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setInitialDesign(InitialDesignType design_type, std::size_t point_num, std::uint64_t seed) {
+		this->private_members->Integrator()->config_setInitialDesign(design_type, point_num, seed);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setMultiFidelity(const std::vector<double>& fidelities, std::size_t eta, std::size_t initial_num) {
+		this->private_members->Integrator()->config_setMultiFidelity(fidelities, eta, initial_num);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setCostAwareOrdering(std::size_t window) {
+		this->private_members->Integrator()->config_setCostAwareOrdering(window);
+	}
+
+	template <typename T>
+	void Tuner<T>::config_setBudget(std::size_t max_measurement_num, double max_time_sec) {
+		this->private_members->Integrator()->config_setBudget(max_measurement_num, max_time_sec);
+	}
+
 	template <typename T>
 	const std::vector<T>& Tuner<T>::getSuggestedNext(void) {
 		return this->private_members->Integrator()->getSuggestedNext();
@@ -159,6 +340,16 @@ namespace dsice {
 		return this->private_members->Integrator()->getSuggestedList();
 	}
 
+	template <typename T>
+	const std::vector<std::vector<T>>& Tuner<T>::getSuggestedList(std::size_t suggested_num) {
+		return this->private_members->Integrator()->getSuggestedList(suggested_num);
+	}
+
+	template <typename T>
+	double Tuner<T>::getSuggestedFidelity(void) const {
+		return this->private_members->ConstIntegrator()->getSuggestedFidelity();
+	}
+
 	template <typename T>
 	void Tuner<T>::setMetricValue(double metric_value) {
 		this->private_members->Integrator()->setMetricValue(metric_value);
@@ -166,27 +357,62 @@ namespace dsice {
 
 	template <typename T>
 	std::size_t Tuner<T>::getParametersNum(void) const {
-		return this->private_members->Integrator()->getParametersNum();
+		return this->private_members->ConstIntegrator()->getParametersNum();
 	}
 
 	template <typename T>
 	std::size_t Tuner<T>::getParameterLength(std::size_t parameter_idx) const {
-		return this->private_members->Integrator()->getParameterLength(parameter_idx);
+		return this->private_members->ConstIntegrator()->getParameterLength(parameter_idx);
 	}
 
 	template <typename T>
 	const std::vector<std::vector<T>>& Tuner<T>::getTargetParameters(void) const {
-		return this->private_members->Integrator()->getTargetParameters();
+		return this->private_members->ConstIntegrator()->getTargetParameters();
 	}
 
 	template <typename T>
 	std::vector<T> Tuner<T>::getTentativeBestParameter(void) const {
-		return this->private_members->Integrator()->getTentativeBestParameter();
+		return this->private_members->ConstIntegrator()->getTentativeBestParameter();
+	}
+
+	template <typename T>
+	double Tuner<T>::predict(const std::vector<T>& parameter) const {
+		return this->private_members->ConstIntegrator()->predict(parameter);
+	}
+
+	template <typename T>
+	std::vector<double> Tuner<T>::predictBatch(const std::vector<std::vector<T>>& parameters) const {
+		return this->private_members->ConstIntegrator()->predictBatch(parameters);
 	}
 
 	template <typename T>
 	bool Tuner<T>::isSearchFinished(void) const {
-		return this->private_members->Integrator()->isSearchFinished();
+		return this->private_members->ConstIntegrator()->isSearchFinished();
+	}
+
+	template <typename T>
+	std::size_t Tuner<T>::getMeasuredNum(void) const {
+		return this->private_members->ConstIntegrator()->getMeasuredNum();
+	}
+
+	template <typename T>
+	std::size_t Tuner<T>::getRemainingMeasurementNum(void) const {
+		return this->private_members->ConstIntegrator()->getRemainingMeasurementNum();
+	}
+
+	template <typename T>
+	double Tuner<T>::getElapsedTime(void) const {
+		return this->private_members->ConstIntegrator()->getElapsedTime();
+	}
+
+	template <typename T>
+	double Tuner<T>::getEstimatedRemainingTime(void) const {
+		return this->private_members->ConstIntegrator()->getEstimatedRemainingTime();
+	}
+
+	template <typename T>
+	double Tuner<T>::getExpectedImprovement(void) const {
+		return this->private_members->ConstIntegrator()->getExpectedImprovement();
 	}
 
 	template <typename T>
@@ -199,24 +425,74 @@ namespace dsice {
 		this->private_members->Integrator()->setMetricValuesList(metric_values_list);
 	}
 
+	template <typename T>
+	void Tuner<T>::setMetricValuesList(const std::vector<double>& metric_values_list, const std::vector<bool>& censored_flags) {
+		this->private_members->Integrator()->setMetricValuesList(metric_values_list, censored_flags);
+	}
+
+	template <typename T>
+	void Tuner<T>::setMeasureDurationsList(const std::vector<double>& durations_sec) {
+		this->private_members->Integrator()->setMeasureDurationsList(durations_sec);
+	}
+
+	template <typename T>
+	double Tuner<T>::getDeadline(void) {
+		return this->private_members->Integrator()->getDeadline();
+	}
+
+	template <typename T>
+	bool Tuner<T>::reportPartial(double partial_value) {
+		return this->private_members->Integrator()->reportPartial(partial_value);
+	}
+
+	template <typename T>
+	void Tuner<T>::setCensoredMetricValue(double bound) {
+		this->private_members->Integrator()->setCensoredMetricValue(bound);
+	}
+
+	template <typename T>
+	Ticket<T> Tuner<T>::acquire(void) {
+		return this->private_members->Integrator()->acquire();
+	}
+
+	template <typename T>
+	void Tuner<T>::complete(const Ticket<T>& ticket, double metric_value) {
+		this->private_members->Integrator()->complete(ticket.getId(), metric_value);
+	}
+
+	template <typename T>
+	void Tuner<T>::complete(std::size_t ticket_id, double metric_value) {
+		this->private_members->Integrator()->complete(ticket_id, metric_value);
+	}
+
+	template <typename T>
+	void Tuner<T>::abort(const Ticket<T>& ticket, double bound) {
+		this->private_members->Integrator()->abort(ticket.getId(), bound);
+	}
+
+	template <typename T>
+	void Tuner<T>::abort(std::size_t ticket_id, double bound) {
+		this->private_members->Integrator()->abort(ticket_id, bound);
+	}
+
 	template <typename T>
 	void Tuner<T>::printTuningResult(std::string file_path) const {
-		this->private_members->Integrator()->printTuningResult(file_path);
+		this->private_members->ConstIntegrator()->printTuningResult(file_path);
 	}
 
 	template <typename T>
 	void Tuner<T>::printSimpleLoopLog(std::string file_path) const {
-		this->private_members->Integrator()->printSimpleLoopLog(file_path);
+		this->private_members->ConstIntegrator()->printSimpleLoopLog(file_path);
 	}
 
 	template <typename T>
 	void Tuner<T>::outputSearchSpaceForViewer(std::string file_path, double default_value) const {
-		this->private_members->Integrator()->outputSearchSpaceForViewer(file_path, default_value);
+		this->private_members->ConstIntegrator()->outputSearchSpaceForViewer(file_path, default_value);
 	}
 
 	template <typename T>
 	void Tuner<T>::outputLogForViewer(std::string file_path) const {
-		this->private_members->Integrator()->outputLogForViewer(file_path);
+		this->private_members->ConstIntegrator()->outputLogForViewer(file_path);
 	}
 
 	// コンパイルさせるための実態を記述
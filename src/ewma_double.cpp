@@ -0,0 +1,52 @@
+﻿#include <cstddef>
+#include "ewma_double.hpp"
+
+namespace dsice {
+
+	EwmaDouble::EwmaDouble(void) {
+		// DO_NOTHING
+	}
+
+	EwmaDouble::EwmaDouble(double init_value) {
+		this->count = 1;
+		this->value = init_value;
+	}
+
+	EwmaDouble::EwmaDouble(const EwmaDouble& original) {
+		this->value = original.value;
+		this->count = original.count;
+	}
+
+	EwmaDouble::~EwmaDouble(void) {
+		// DO_NOTHING
+	}
+
+	EwmaDouble::operator double() const {
+		return this->value;
+	}
+
+	double EwmaDouble::getValue(void) const {
+		return this->value;
+	}
+
+	void EwmaDouble::setValue(double metric_value) {
+
+		// 初回の値はそのまま採用
+		if (this->count == 0) {
+			this->value = metric_value;
+		}
+		else {
+			this->value += EwmaDouble::SMOOTHING_FACTOR * (metric_value - this->value);
+		}
+
+		this->count++;
+	}
+
+	std::size_t EwmaDouble::getRecordedCount(void) const {
+		return this->count;
+	}
+
+	std::shared_ptr<Metric> EwmaDouble::makeCopy(void) const {
+		return std::make_shared<EwmaDouble>(*this);
+	}
+}
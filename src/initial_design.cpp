@@ -0,0 +1,415 @@
+﻿#include <cstdint>
+#include <cmath>
+#include <memory>
+#include <limits>
+#include <random>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_core.hpp"
+#include "dsice_initial_design_type.hpp"
+#include "dsice_thread_pool.hpp"
+#include "initial_design.hpp"
+
+namespace dsice {
+
+	InitialDesign::InitialDesign(InitialDesignType design_type, std::size_t point_num, std::uint64_t seed, std::size_t slice_size) {
+		this->design_type = design_type;
+		this->point_num = point_num;
+		this->seed = seed;
+		this->slice_size = slice_size > 0 ? slice_size : 1;
+	}
+
+	InitialDesign::InitialDesign(const coordinate_list& design_coordinates) {
+		this->fixed_coordinates = design_coordinates;
+		this->point_num = design_coordinates.size();
+	}
+
+	InitialDesign::InitialDesign(const InitialDesign& original) {
+		this->design_type = original.design_type;
+		this->point_num = original.point_num;
+		this->seed = original.seed;
+		this->slice_size = original.slice_size;
+		this->fixed_coordinates = original.fixed_coordinates;
+	}
+
+	InitialDesign::~InitialDesign(void) {
+		// DO_NOTHING
+	}
+
+	std::size_t InitialDesign::stratumToLevel(std::size_t stratum, std::size_t stratum_num, std::size_t level_num) {
+		return (2 * stratum + 1) * level_num / (2 * stratum_num);
+	}
+
+	std::vector<double> InitialDesign::normalize(const space_size& space, const coordinate& target_coordinate) {
+
+		std::vector<double> position;
+		for (std::size_t i = 0; i < space.size(); i++) {
+			position.push_back(space[i] > 1 ? static_cast<double>(target_coordinate[i]) / static_cast<double>(space[i] - 1) : 0);
+		}
+
+		return position;
+	}
+
+	std::vector<std::vector<std::size_t>> InitialDesign::buildLhdColumns(std::size_t dimension, std::size_t stratum_num, std::mt19937_64& engine) {
+
+		std::vector<std::vector<std::size_t>> columns(dimension, std::vector<std::size_t>(stratum_num));
+		for (std::vector<std::size_t>& column : columns) {
+			std::iota(column.begin(), column.end(), 0);
+			std::shuffle(column.begin(), column.end(), engine);
+		}
+
+		return columns;
+	}
+
+	std::vector<std::vector<std::size_t>> InitialDesign::buildSlicedLhdColumns(std::size_t dimension, std::size_t slices_num, std::size_t slice_size, std::mt19937_64& engine) {
+
+		std::vector<std::vector<std::size_t>> columns(dimension, std::vector<std::size_t>(slices_num * slice_size));
+		for (std::vector<std::size_t>& column : columns) {
+
+			// 各組は slice_size 個の粗い層に 1 点ずつ配置し，同じ粗い層に入った slices_num 点に細かい層を割り振る
+			std::vector<std::vector<std::size_t>> fine_strata(slice_size, std::vector<std::size_t>(slices_num));
+			for (std::size_t c = 0; c < slice_size; c++) {
+				std::iota(fine_strata[c].begin(), fine_strata[c].end(), c * slices_num);
+				std::shuffle(fine_strata[c].begin(), fine_strata[c].end(), engine);
+			}
+
+			std::vector<std::size_t> coarse_strata(slice_size);
+			for (std::size_t s = 0; s < slices_num; s++) {
+				std::iota(coarse_strata.begin(), coarse_strata.end(), 0);
+				std::shuffle(coarse_strata.begin(), coarse_strata.end(), engine);
+				for (std::size_t r = 0; r < slice_size; r++) {
+					column[s * slice_size + r] = fine_strata[coarse_strata[r]][s];
+				}
+			}
+		}
+
+		return columns;
+	}
+
+	double InitialDesign::optimizeMaximin(const space_size& space, std::vector<std::vector<std::size_t>>& columns, const std::vector<std::vector<double>>& fixed_points, std::mt19937_64& engine) {
+
+		std::size_t dimension = columns.size();
+		if (dimension == 0 || columns[0].size() < 2) {
+			return 0;
+		}
+
+		std::size_t num = columns[0].size();
+		std::size_t all_num = num + fixed_points.size();
+
+		// 各列の層番号に対応する正規化座標
+		std::vector<std::vector<double>> stratum_positions(dimension, std::vector<double>(num));
+		for (std::size_t i = 0; i < dimension; i++) {
+			for (std::size_t s = 0; s < num; s++) {
+				std::size_t level = InitialDesign::stratumToLevel(s, num, space[i]);
+				stratum_positions[i][s] = space[i] > 1 ? static_cast<double>(level) / static_cast<double>(space[i] - 1) : 0;
+			}
+		}
+
+		auto position = [&](std::size_t p, std::size_t i) {
+			return p < num ? stratum_positions[i][columns[i][p]] : fixed_points[p - num][i];
+		};
+
+		// phi_p 基準 (p = 16) の各点対の寄与
+		auto pair_term = [](double squared_distance) {
+			double v = 1.0 / std::max(squared_distance, 1e-12);
+			v *= v;
+			v *= v;
+			v *= v;
+			return v;
+		};
+
+		std::vector<std::vector<double>> squared_distances(num, std::vector<double>(all_num, 0));
+		double phi = 0;
+		for (std::size_t p = 0; p < num; p++) {
+			for (std::size_t q = 0; q < all_num; q++) {
+				if (p == q) {
+					continue;
+				}
+				double d2 = 0;
+				for (std::size_t i = 0; i < dimension; i++) {
+					double diff = position(p, i) - position(q, i);
+					d2 += diff * diff;
+				}
+				squared_distances[p][q] = d2;
+				if (q > p) {
+					phi += pair_term(d2);
+				}
+			}
+		}
+
+		std::uniform_int_distribution<std::size_t> column_dist(0, dimension - 1);
+		std::uniform_int_distribution<std::size_t> point_dist(0, num - 1);
+		std::size_t iteration_num = std::min<std::size_t>(50000, 50 * num * dimension);
+		std::vector<double> new_a(all_num);
+		std::vector<double> new_b(all_num);
+
+		for (std::size_t iteration = 0; iteration < iteration_num; iteration++) {
+
+			std::size_t k = column_dist(engine);
+			std::size_t a = point_dist(engine);
+			std::size_t b = point_dist(engine);
+			if (a == b || columns[k][a] == columns[k][b]) {
+				continue;
+			}
+
+			// 入れ替えで変わるのは a, b と他の点との距離のみ (a と b の間の距離は変わらない)
+			double xa = position(a, k);
+			double xb = position(b, k);
+			double delta = 0;
+			for (std::size_t q = 0; q < all_num; q++) {
+				if (q == a || q == b) {
+					continue;
+				}
+				double xq = position(q, k);
+				new_a[q] = squared_distances[a][q] - (xa - xq) * (xa - xq) + (xb - xq) * (xb - xq);
+				new_b[q] = squared_distances[b][q] - (xb - xq) * (xb - xq) + (xa - xq) * (xa - xq);
+				delta += pair_term(new_a[q]) - pair_term(squared_distances[a][q]) + pair_term(new_b[q]) - pair_term(squared_distances[b][q]);
+			}
+
+			if (delta >= 0) {
+				continue;
+			}
+
+			std::swap(columns[k][a], columns[k][b]);
+			phi += delta;
+			for (std::size_t q = 0; q < all_num; q++) {
+				if (q == a || q == b) {
+					continue;
+				}
+				squared_distances[a][q] = new_a[q];
+				squared_distances[b][q] = new_b[q];
+				if (q < num) {
+					squared_distances[q][a] = new_a[q];
+					squared_distances[q][b] = new_b[q];
+				}
+			}
+		}
+
+		return phi;
+	}
+
+	coordinate_list InitialDesign::columnsToCoordinates(const space_size& space, const std::vector<std::vector<std::size_t>>& columns) {
+
+		coordinate_list design;
+		if (columns.empty()) {
+			return design;
+		}
+
+		for (std::size_t p = 0; p < columns[0].size(); p++) {
+			coordinate tmp_c;
+			for (std::size_t i = 0; i < space.size(); i++) {
+				tmp_c.push_back(InitialDesign::stratumToLevel(columns[i][p], columns[i].size(), space[i]));
+			}
+			design.push_back(tmp_c);
+		}
+
+		return design;
+	}
+
+	std::vector<std::vector<double>> InitialDesign::buildLowDiscrepancyPoints(std::size_t dimension, std::size_t num, bool use_sobol, std::mt19937_64& engine) {
+
+		std::vector<std::vector<double>> points(num, std::vector<double>(dimension));
+
+		if (use_sobol && dimension <= InitialDesign::SOBOL_MAX_DIMENSION) {
+
+			// 原始多項式の次数 s，係数 a と初期方向数 m (Joe and Kuo)
+			static const std::uint32_t sobol_s[] = { 0, 1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 7, 7 };
+			static const std::uint32_t sobol_a[] = { 0, 0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1, 13, 16, 19, 22, 25, 1, 4 };
+			static const std::uint32_t sobol_m[][7] = {
+				{ 0 }, { 1 }, { 1, 3 }, { 1, 3, 1 }, { 1, 1, 1 }, { 1, 1, 3, 3 }, { 1, 3, 5, 13 },
+				{ 1, 1, 5, 5, 17 }, { 1, 1, 5, 5, 5 }, { 1, 1, 7, 11, 19 }, { 1, 1, 5, 1, 1 }, { 1, 1, 1, 3, 11 }, { 1, 3, 5, 5, 31 },
+				{ 1, 3, 3, 9, 7, 49 }, { 1, 1, 1, 15, 21, 21 }, { 1, 3, 1, 13, 27, 49 }, { 1, 1, 1, 15, 7, 5 }, { 1, 3, 1, 15, 13, 25 }, { 1, 1, 5, 5, 19, 61 },
+				{ 1, 3, 7, 11, 23, 15, 103 }, { 1, 3, 7, 13, 13, 15, 69 }
+			};
+
+			for (std::size_t i = 0; i < dimension; i++) {
+
+				std::uint32_t directions[32];
+				if (i == 0) {
+					for (std::uint32_t j = 0; j < 32; j++) {
+						directions[j] = 1u << (31 - j);
+					}
+				}
+				else {
+					std::uint32_t s = sobol_s[i];
+					for (std::uint32_t j = 0; j < 32; j++) {
+						if (j < s) {
+							directions[j] = sobol_m[i][j] << (31 - j);
+						}
+						else {
+							directions[j] = directions[j - s] ^ (directions[j - s] >> s);
+							for (std::uint32_t k = 1; k < s; k++) {
+								if ((sobol_a[i] >> (s - 1 - k)) & 1) {
+									directions[j] ^= directions[j - k];
+								}
+							}
+						}
+					}
+				}
+
+				std::uint32_t shift = static_cast<std::uint32_t>(engine());
+				for (std::size_t p = 0; p < num; p++) {
+					std::uint32_t x = 0;
+					std::size_t idx = p;
+					for (std::uint32_t j = 0; idx > 0 && j < 32; j++, idx >>= 1) {
+						if (idx & 1) {
+							x ^= directions[j];
+						}
+					}
+					points[p][i] = static_cast<double>(x ^ shift) / 4294967296.0;
+				}
+			}
+		}
+		else {
+
+			std::uniform_real_distribution<double> shift_dist(0, 1);
+			std::size_t base = 1;
+			for (std::size_t i = 0; i < dimension; i++) {
+
+				// 次の素数を底とする
+				bool is_prime = false;
+				while (!is_prime) {
+					base++;
+					is_prime = true;
+					for (std::size_t d = 2; d * d <= base; d++) {
+						if (base % d == 0) {
+							is_prime = false;
+							break;
+						}
+					}
+				}
+
+				double shift = shift_dist(engine);
+				for (std::size_t p = 0; p < num; p++) {
+					double x = 0;
+					double f = 1.0 / static_cast<double>(base);
+					for (std::size_t idx = p + 1; idx > 0; idx /= base) {
+						x += f * static_cast<double>(idx % base);
+						f /= static_cast<double>(base);
+					}
+					x += shift;
+					points[p][i] = x - std::floor(x);
+				}
+			}
+		}
+
+		return points;
+	}
+
+	std::size_t InitialDesign::getDesignSize(const space_size& space) const {
+
+		if (!this->fixed_coordinates.empty()) {
+			return this->fixed_coordinates.size();
+		}
+
+		std::size_t num = this->point_num;
+		if (num == 0) {
+			for (std::size_t param_length : space) {
+				num = std::max(num, param_length);
+			}
+		}
+
+		return (num + this->slice_size - 1) / this->slice_size * this->slice_size;
+	}
+
+	coordinate_list InitialDesign::generate(const DatabaseCore& database, std::shared_ptr<ThreadPool> pool) const {
+
+		if (!this->fixed_coordinates.empty()) {
+			return this->fixed_coordinates;
+		}
+
+		const space_size& space = database.getSpaceSize();
+		std::size_t dimension = space.size();
+		std::size_t num = this->getDesignSize(space);
+
+		// 実測済の点は順序によらず同じ配置となるよう整列しておく
+		coordinate_list existing_coordinates = database.getExistSampleCoordinates();
+		std::sort(existing_coordinates.begin(), existing_coordinates.end());
+		std::vector<std::vector<double>> existing_positions;
+		for (const coordinate& c : existing_coordinates) {
+			existing_positions.push_back(InitialDesign::normalize(space, c));
+		}
+
+		std::mt19937_64 engine(this->seed);
+		coordinate_list design;
+
+		switch (this->design_type) {
+		case InitialDesignType::SimpleLhd:
+			design = InitialDesign::columnsToCoordinates(space, InitialDesign::buildLhdColumns(dimension, num, engine));
+			break;
+		case InitialDesignType::MaximinLhd:
+		{
+			// 独立な初期 LHD からの局所探索を並列に行い，最良のものを採用
+			std::vector<std::vector<std::vector<std::size_t>>> candidates(InitialDesign::MAXIMIN_RESTART_NUM);
+			std::vector<double> phis(InitialDesign::MAXIMIN_RESTART_NUM);
+			ThreadPool::run(pool, InitialDesign::MAXIMIN_RESTART_NUM, [&](std::size_t r) {
+				std::seed_seq seq{ static_cast<std::uint32_t>(this->seed), static_cast<std::uint32_t>(this->seed >> 32), static_cast<std::uint32_t>(r) };
+				std::mt19937_64 restart_engine(seq);
+				candidates[r] = InitialDesign::buildLhdColumns(dimension, num, restart_engine);
+				phis[r] = InitialDesign::optimizeMaximin(space, candidates[r], existing_positions, restart_engine);
+			});
+
+			std::size_t best_idx = std::distance(phis.begin(), std::min_element(phis.begin(), phis.end()));
+			design = InitialDesign::columnsToCoordinates(space, candidates[best_idx]);
+			break;
+		}
+		case InitialDesignType::Sobol:
+		case InitialDesignType::Halton:
+			for (const std::vector<double>& point : InitialDesign::buildLowDiscrepancyPoints(dimension, num, this->design_type == InitialDesignType::Sobol, engine)) {
+				coordinate tmp_c;
+				for (std::size_t i = 0; i < dimension; i++) {
+					tmp_c.push_back(std::min(static_cast<std::size_t>(point[i] * static_cast<double>(space[i])), space[i] - 1));
+				}
+				design.push_back(tmp_c);
+			}
+			break;
+		case InitialDesignType::Stratified:
+			design = InitialDesign::columnsToCoordinates(space, InitialDesign::buildSlicedLhdColumns(dimension, num / this->slice_size, this->slice_size, engine));
+			break;
+		}
+
+		// 実測済の点ごとに最も近い配置点を置き換える
+		std::vector<bool> is_replaced(design.size(), false);
+		std::size_t replaced_num = 0;
+		for (const std::vector<double>& e : existing_positions) {
+
+			if (replaced_num >= design.size()) {
+				break;
+			}
+
+			std::size_t nearest_idx = 0;
+			double nearest_distance = std::numeric_limits<double>::max();
+			for (std::size_t p = 0; p < design.size(); p++) {
+				if (is_replaced[p]) {
+					continue;
+				}
+				std::vector<double> position = InitialDesign::normalize(space, design[p]);
+				double d2 = 0;
+				for (std::size_t i = 0; i < dimension; i++) {
+					d2 += (position[i] - e[i]) * (position[i] - e[i]);
+				}
+				if (d2 < nearest_distance) {
+					nearest_distance = d2;
+					nearest_idx = p;
+				}
+			}
+
+			is_replaced[nearest_idx] = true;
+			replaced_num++;
+		}
+
+		coordinate_list result = existing_coordinates;
+		std::unordered_set<coordinate> listed(result.begin(), result.end());
+		for (std::size_t p = 0; p < design.size(); p++) {
+			if (!is_replaced[p] && listed.insert(design[p]).second) {
+				result.push_back(design[p]);
+			}
+		}
+
+		return result;
+	}
+}
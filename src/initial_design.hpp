@@ -0,0 +1,147 @@
+﻿#ifndef INITIAL_DESIGN_HPP_
+#define INITIAL_DESIGN_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_core.hpp"
+#include "dsice_initial_design_type.hpp"
+#include "dsice_thread_pool.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 初期探索で実測する点の配置 (実験計画) を生成する機構．<br/>
+	/// 同じシード値からは常に同じ配置を生成し，データベースに実測済の点があれば最も近い配置点をその点で置き換えて配置を補完する
+	/// </summary>
+	class InitialDesign final {
+	private:
+		/// <summary>
+		/// 配置方法
+		/// </summary>
+		InitialDesignType design_type = InitialDesignType::SimpleLhd;
+		/// <summary>
+		/// 配置する点の数 (0 なら最も長い性能パラメタの値の数)
+		/// </summary>
+		std::size_t point_num = 0;
+		/// <summary>
+		/// 乱数のシード値
+		/// </summary>
+		std::uint64_t seed = 0;
+		/// <summary>
+		/// 並列に実測できる数 (点の数はこの倍数に切り上げる)
+		/// </summary>
+		std::size_t slice_size = 1;
+		/// <summary>
+		/// そのまま配置とする座標リスト (空なら design_type に従って生成)
+		/// </summary>
+		coordinate_list fixed_coordinates;
+		/// <summary>
+		/// Sobol 列の方向数を定義済の最大次元数
+		/// </summary>
+		static constexpr std::size_t SOBOL_MAX_DIMENSION = 21;
+		/// <summary>
+		/// maximin 基準の最適化で試す初期 LHD の数 (並列数によらず一定とし，同じシード値から同じ配置を得る)
+		/// </summary>
+		static constexpr std::size_t MAXIMIN_RESTART_NUM = 8;
+		/// <summary>
+		/// 0 から point_num - 1 までの細かい層番号を，値の数が level_num の性能パラメタの値に対応付ける (各層の中央に最も近い値)
+		/// </summary>
+		/// <param name="stratum">層番号</param>
+		/// <param name="stratum_num">層の数</param>
+		/// <param name="level_num">性能パラメタの値の数</param>
+		/// <returns>性能パラメタの値のインデックス</returns>
+		static std::size_t stratumToLevel(std::size_t stratum, std::size_t stratum_num, std::size_t level_num);
+		/// <summary>
+		/// 各軸の長さを 1 に正規化した座標を取得
+		/// </summary>
+		/// <param name="space">探索空間の大きさ</param>
+		/// <param name="target_coordinate">座標</param>
+		/// <returns>正規化した座標</returns>
+		static std::vector<double> normalize(const space_size& space, const coordinate& target_coordinate);
+		/// <summary>
+		/// ランダムな LHD の各列 (各性能パラメタの層番号の並び) を生成
+		/// </summary>
+		/// <param name="dimension">次元数</param>
+		/// <param name="stratum_num">層の数 (点の数)</param>
+		/// <param name="engine">乱数生成器</param>
+		/// <returns>各列の層番号の並び</returns>
+		static std::vector<std::vector<std::size_t>> buildLhdColumns(std::size_t dimension, std::size_t stratum_num, std::mt19937_64& engine);
+		/// <summary>
+		/// 連続する slice_size 点ずつの各組もそれ自体が粗い LHD となる sliced LHD の各列を生成
+		/// </summary>
+		/// <param name="dimension">次元数</param>
+		/// <param name="slices_num">組の数</param>
+		/// <param name="slice_size">1 組の点の数</param>
+		/// <param name="engine">乱数生成器</param>
+		/// <returns>各列の層番号の並び</returns>
+		static std::vector<std::vector<std::size_t>> buildSlicedLhdColumns(std::size_t dimension, std::size_t slices_num, std::size_t slice_size, std::mt19937_64& engine);
+		/// <summary>
+		/// LHD の同じ列内で 2 点の層番号を入れ替える局所探索により，点間距離の maximin 基準 (Morris-Mitchell の phi_p 基準) を改善
+		/// </summary>
+		/// <param name="space">探索空間の大きさ</param>
+		/// <param name="columns">各列の層番号の並び (改善後の並びに更新される)</param>
+		/// <param name="fixed_points">距離の計算に含める実測済の点 (正規化座標)</param>
+		/// <param name="engine">乱数生成器</param>
+		/// <returns>改善後の phi_p 基準値 (小さいほど良い)</returns>
+		static double optimizeMaximin(const space_size& space, std::vector<std::vector<std::size_t>>& columns, const std::vector<std::vector<double>>& fixed_points, std::mt19937_64& engine);
+		/// <summary>
+		/// 層番号の並びから座標リストを生成
+		/// </summary>
+		/// <param name="space">探索空間の大きさ</param>
+		/// <param name="columns">各列の層番号の並び</param>
+		/// <returns>座標リスト</returns>
+		static coordinate_list columnsToCoordinates(const space_size& space, const std::vector<std::vector<std::size_t>>& columns);
+		/// <summary>
+		/// 単位超立方体上の低食い違い量列を生成 (Sobol 列は乱数によるディジタルシフト，Halton 列は乱数による平行移動を施す)
+		/// </summary>
+		/// <param name="dimension">次元数</param>
+		/// <param name="num">点の数</param>
+		/// <param name="use_sobol">Sobol 列を用いる場合は true (次元数が多すぎる場合は Halton 列になる)</param>
+		/// <param name="engine">乱数生成器</param>
+		/// <returns>各点の座標 (各成分は 0 以上 1 未満)</returns>
+		static std::vector<std::vector<double>> buildLowDiscrepancyPoints(std::size_t dimension, std::size_t num, bool use_sobol, std::mt19937_64& engine);
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="design_type">配置方法</param>
+		/// <param name="point_num">配置する点の数 (0 なら最も長い性能パラメタの値の数)</param>
+		/// <param name="seed">乱数のシード値</param>
+		/// <param name="slice_size">並列に実測できる数 (点の数はこの倍数に切り上げる，0 なら切り上げない)</param>
+		InitialDesign(InitialDesignType design_type, std::size_t point_num = 0, std::uint64_t seed = 0, std::size_t slice_size = 0);
+		/// <summary>
+		/// 配置済の座標リストをそのまま用いるコンストラクタ (多忠実度探索で生き残った設定値など)
+		/// </summary>
+		/// <param name="design_coordinates">配置点の座標リスト</param>
+		InitialDesign(const coordinate_list& design_coordinates);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		InitialDesign(const InitialDesign& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~InitialDesign(void);
+		/// <summary>
+		/// 配置する点の数を取得
+		/// </summary>
+		/// <param name="space">探索空間の大きさ</param>
+		/// <returns>配置する点の数 (並列に実測できる数の倍数に切り上げ済)</returns>
+		std::size_t getDesignSize(const space_size& space) const;
+		/// <summary>
+		/// 配置を生成．データベースに実測済の点があれば，最も近い配置点をその点で置き換える
+		/// </summary>
+		/// <param name="database">データベース</param>
+		/// <param name="pool">配置の最適化を並列に行うスレッドプール (nullptr の場合は逐次実行)</param>
+		/// <returns>配置点の座標リスト (重複なし，置き換えた実測済の点を含む)</returns>
+		coordinate_list generate(const DatabaseCore& database, std::shared_ptr<ThreadPool> pool = nullptr) const;
+	};
+}
+
+#endif // !INITIAL_DESIGN_HPP_
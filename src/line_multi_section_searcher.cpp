@@ -0,0 +1,272 @@
+﻿#include <stdexcept>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "dsice_search_space.hpp"
+#include "coordinate_line.hpp"
+#include "direction_line.hpp"
+#include "dsice_database_core.hpp"
+#include "line_multi_section_searcher.hpp"
+
+namespace dsice {
+
+	std::vector<std::size_t> LineMultiSectionSearcher::getSectionIndexes(std::size_t left, std::size_t right, std::size_t section_num) {
+
+		std::vector<std::size_t> indexes;
+		indexes.push_back(left);
+		if (right != left) {
+			indexes.push_back(right);
+		}
+
+		std::size_t segment_length = right - left;
+
+		for (std::size_t i = 1; i <= section_num; i++) {
+
+			std::size_t idx = left + (segment_length * i) / (section_num + 1);
+
+			// 区間が短い場合は分割点が重なるため除外
+			if (idx != left && idx != right && std::find(indexes.begin(), indexes.end(), idx) == indexes.end()) {
+				indexes.push_back(idx);
+			}
+		}
+
+		return indexes;
+	}
+
+	void LineMultiSectionSearcher::checkBestPoint(const coordinate& measured_coordinate, double metric_value) {
+
+		if (this->low_is_better) {
+			if (metric_value < this->best_point_value) {
+				this->best_judged_point_coordinate = measured_coordinate;
+				this->best_measured_point_coordinate = measured_coordinate;
+				this->best_point_value = metric_value;
+			}
+		}
+		else {
+			if (metric_value > this->best_point_value) {
+				this->best_judged_point_coordinate = measured_coordinate;
+				this->best_measured_point_coordinate = measured_coordinate;
+				this->best_point_value = metric_value;
+			}
+		}
+	}
+
+	void LineMultiSectionSearcher::listupSectionPoints(void) {
+
+		while (true) {
+
+			for (std::size_t i : LineMultiSectionSearcher::getSectionIndexes(this->left_index, this->right_index, this->section_num)) {
+
+				const coordinate& c = this->line.getPointCoordinate(i);
+
+				if (this->database->hasSample(c)) {
+					this->measured_coordinates.insert(c);
+					this->checkBestPoint(c, this->database->getSampleMetricValue(c));
+				}
+				else {
+					this->suggested_coordinates.push_back(c);
+				}
+			}
+
+			if (!this->suggested_coordinates.empty()) {
+				return;
+			}
+
+			if (!this->narrowSection()) {
+				this->is_finish_searching = true;
+				return;
+			}
+		}
+	}
+
+	bool LineMultiSectionSearcher::narrowSection(void) {
+
+		// 区間内の実測済の点のインデックスと値を集める
+		std::vector<std::size_t> measured_indexes;
+		std::size_t best_index = this->left_index;
+		double best_value = 0;
+		for (std::size_t i = this->left_index; i <= this->right_index; i++) {
+
+			const coordinate& c = this->line.getPointCoordinate(i);
+
+			if (!this->database->hasSample(c)) {
+				continue;
+			}
+
+			double v = this->database->getSampleMetricValue(c);
+			if (measured_indexes.empty() || (this->low_is_better ? v < best_value : v > best_value)) {
+				best_index = i;
+				best_value = v;
+			}
+
+			measured_indexes.push_back(i);
+		}
+
+		std::size_t new_left = best_index;
+		std::size_t new_right = best_index;
+		for (std::size_t i : measured_indexes) {
+			if (i < best_index) {
+				new_left = i;
+			}
+			else if (i > best_index) {
+				new_right = i;
+				break;
+			}
+		}
+
+		if (new_left == this->left_index && new_right == this->right_index) {
+			return false;
+		}
+
+		this->left_index = new_left;
+		this->right_index = new_right;
+
+		return true;
+	}
+
+	LineMultiSectionSearcher::LineMultiSectionSearcher(std::shared_ptr<const DatabaseCore> database, const coordinate& example_coordinate, const DirectionLine& direction_info, bool low_value_is_better, std::size_t section_num) :
+		database(database), line(database->getSpaceSize(), example_coordinate, direction_info)
+	{
+		if (section_num == 0) {
+			throw std::invalid_argument("section_num must be greater than 0.");
+		}
+
+		this->low_is_better = low_value_is_better;
+		this->section_num = section_num;
+		this->left_index = 0;
+		this->right_index = this->line.getPointsNum() - 1;
+		this->best_judged_point_coordinate = this->line.getPointCoordinate(0);
+		if (this->low_is_better) {
+			this->best_point_value = std::numeric_limits<double>::max();
+		}
+		else {
+			this->best_point_value = std::numeric_limits<double>::lowest();
+		}
+
+		this->listupSectionPoints();
+	}
+
+	LineMultiSectionSearcher::LineMultiSectionSearcher(std::shared_ptr<const DatabaseCore> database, const CoordinateLine& line_info, bool low_value_is_better, std::size_t section_num) :
+		database(database), line(line_info)
+	{
+		if (section_num == 0) {
+			throw std::invalid_argument("section_num must be greater than 0.");
+		}
+
+		this->low_is_better = low_value_is_better;
+		this->section_num = section_num;
+		this->left_index = 0;
+		this->right_index = this->line.getPointsNum() - 1;
+		this->best_judged_point_coordinate = this->line.getPointCoordinate(0);
+		if (this->low_is_better) {
+			this->best_point_value = std::numeric_limits<double>::max();
+		}
+		else {
+			this->best_point_value = std::numeric_limits<double>::lowest();
+		}
+
+		this->listupSectionPoints();
+	}
+
+	LineMultiSectionSearcher::LineMultiSectionSearcher(const LineMultiSectionSearcher& original) :
+		database(original.database), line(original.line)
+	{
+		this->section_num = original.section_num;
+		this->left_index = original.left_index;
+		this->right_index = original.right_index;
+		this->suggested_coordinates = original.suggested_coordinates;
+		this->measured_coordinates = original.measured_coordinates;
+		this->low_is_better = original.low_is_better;
+		this->measured_coordinate_buffer = original.measured_coordinate_buffer;
+		this->measured_metric_value_buffer = original.measured_metric_value_buffer;
+		this->best_judged_point_coordinate = original.best_judged_point_coordinate;
+		this->best_measured_point_coordinate = original.best_measured_point_coordinate;
+		this->best_point_value = original.best_point_value;
+		this->is_finish_searching = original.is_finish_searching;
+	}
+
+	LineMultiSectionSearcher::LineMultiSectionSearcher(const LineMultiSectionSearcher& original, std::shared_ptr<const DatabaseCore> search_database) :
+		LineMultiSectionSearcher(original)
+	{
+		this->database = search_database;
+	}
+
+	LineMultiSectionSearcher::~LineMultiSectionSearcher(void) {
+		// DO_NOTHING
+	}
+
+	const CoordinateLine& LineMultiSectionSearcher::getLineInfomation(void) const {
+		return this->line;
+	}
+
+	const coordinate& LineMultiSectionSearcher::getSuggested(void) const {
+
+		if (this->suggested_coordinates.empty()) {
+			return this->best_judged_point_coordinate;
+		}
+		else {
+			return this->suggested_coordinates[0];
+		}
+	}
+
+	const coordinate_list& LineMultiSectionSearcher::getSuggestedList(void) const {
+		return this->suggested_coordinates;
+	}
+
+	void LineMultiSectionSearcher::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
+		this->measured_coordinate_buffer.push_back(measured_coordinate);
+		this->measured_metric_value_buffer.push_back(metric_value);
+	}
+
+	bool LineMultiSectionSearcher::updateState(void) {
+
+		if (this->measured_coordinate_buffer.empty()) {
+			return false;
+		}
+
+		for (std::size_t i = 0; i < this->measured_coordinate_buffer.size(); i++) {
+
+			const coordinate& measured_coordinate = this->measured_coordinate_buffer[i];
+			this->measured_coordinates.insert(measured_coordinate);
+			this->checkBestPoint(measured_coordinate, this->measured_metric_value_buffer[i]);
+
+			auto target = std::find(this->suggested_coordinates.begin(), this->suggested_coordinates.end(), measured_coordinate);
+			if (target != this->suggested_coordinates.end()) {
+				this->suggested_coordinates.erase(target);
+			}
+		}
+
+		this->measured_coordinate_buffer.clear();
+		this->measured_metric_value_buffer.clear();
+
+		// 1 回分の分割点がすべて実測されてから区間を狭める
+		if (this->suggested_coordinates.empty() && !this->is_finish_searching) {
+			this->narrowSection();
+			this->listupSectionPoints();
+		}
+
+		return true;
+	}
+
+	bool LineMultiSectionSearcher::isSearchFinished(void) const {
+		return this->is_finish_searching;
+	}
+
+	const coordinate_list& LineMultiSectionSearcher::getTargetCoordinate(void) const {
+		return this->line.getPoints();
+	}
+
+	const std::unordered_set<coordinate>& LineMultiSectionSearcher::getMeasuredCoordinates(void) const {
+		return this->measured_coordinates;
+	}
+
+	const coordinate& LineMultiSectionSearcher::getBestJudgedCoordinate(void) const {
+		return this->best_judged_point_coordinate;
+	}
+
+	const coordinate& LineMultiSectionSearcher::getBestMeasuredCoordinate(void) const {
+		return this->best_measured_point_coordinate;
+	}
+}
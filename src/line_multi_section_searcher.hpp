@@ -0,0 +1,188 @@
+﻿#ifndef LINE_MULTI_SECTION_SEARCHER_HPP_
+#define LINE_MULTI_SECTION_SEARCHER_HPP_
+
+#include <memory>
+#include <vector>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "coordinate_line.hpp"
+#include "direction_line.hpp"
+#include "dsice_database_core.hpp"
+#include "dsice_search_engine.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 探索空間における直線上の区間を (分割点数 + 1) 等分する分割点を 1 回分まとめて提案し，最良点の前後の分割点間へ区間を狭めていく機構．<br/>
+	/// 並列実行時に LineSingleTriSearcher の代わりに用いる d-Spline 近似の準備機構で，分割点数を並列実測数に合わせることで 1 回で多くの点を実測できる
+	/// </summary>
+	class LineMultiSectionSearcher final : public SearchEngine {
+	private:
+		/// <summary>
+		/// データベース
+		/// </summary>
+		std::shared_ptr<const DatabaseCore> database;
+		/// <summary>
+		/// 探索対象直線
+		/// </summary>
+		CoordinateLine line;
+		/// <summary>
+		/// 1 回に提案する区間内部の分割点の数
+		/// </summary>
+		std::size_t section_num;
+		/// <summary>
+		/// 現在の区間の左端のインデックス
+		/// </summary>
+		std::size_t left_index;
+		/// <summary>
+		/// 現在の区間の右端のインデックス
+		/// </summary>
+		std::size_t right_index;
+		/// <summary>
+		/// この機構が探索すべきと判断した座標リスト
+		/// </summary>
+		coordinate_list suggested_coordinates;
+		/// <summary>
+		/// 探索済点
+		/// </summary>
+		std::unordered_set<coordinate> measured_coordinates;
+		/// <summary>
+		/// 低い値ほど良いかどうか
+		/// </summary>
+		bool low_is_better;
+		/// <summary>
+		/// 実測データの更新用バッファ (座標)
+		/// </summary>
+		std::vector<coordinate> measured_coordinate_buffer;
+		/// <summary>
+		/// 実測データの更新用バッファ (性能評価値)
+		/// </summary>
+		std::vector<double> measured_metric_value_buffer;
+		/// <summary>
+		/// 基準点を含む全点の中で最良点の座標
+		/// </summary>
+		coordinate best_judged_point_coordinate;
+		/// <summary>
+		/// この機構による実測済の中で最良点の座標 (完全未探索状態の場合のみ空)
+		/// </summary>
+		coordinate best_measured_point_coordinate;
+		/// <summary>
+		/// 最良点の値
+		/// </summary>
+		double best_point_value;
+		/// <summary>
+		/// 探索が終わったか
+		/// </summary>
+		bool is_finish_searching = false;
+		/// <summary>
+		/// 実測済の点を最良点の候補として調べる
+		/// </summary>
+		/// <param name="measured_coordinate">実測済の点</param>
+		/// <param name="metric_value">その点の性能評価値</param>
+		void checkBestPoint(const coordinate& measured_coordinate, double metric_value);
+		/// <summary>
+		/// 現在の区間の分割点のうち未実測のものを提案し，すべて実測済であれば区間を狭めることを繰り返す
+		/// </summary>
+		void listupSectionPoints(void);
+		/// <summary>
+		/// 区間内の最良点を挟む実測済の点の間に区間を狭める
+		/// </summary>
+		/// <returns>区間が変化したら true</returns>
+		bool narrowSection(void);
+		/// <summary>
+		/// 区間を (分割点数 + 1) 等分する点のインデックスを両端を含めて取得
+		/// </summary>
+		/// <param name="left">区間の左端</param>
+		/// <param name="right">区間の右端</param>
+		/// <param name="section_num">区間内部の分割点の数</param>
+		/// <returns>分割点のインデックス一覧 (重複なし)</returns>
+		static std::vector<std::size_t> getSectionIndexes(std::size_t left, std::size_t right, std::size_t section_num);
+	public:
+		/// <summary>
+		/// 直線上の 1 点と方向情報から探索対象を決めるコンストラクタ
+		/// </summary>
+		/// <param name="database">データベース</param>
+		/// <param name="example_coordinate">直線上のどれか 1 点</param>
+		/// <param name="direction_info">方向情報</param>
+		/// <param name="low_value_is_better">性能評価値が低い値ほど良いのであれば true</param>
+		/// <param name="section_num">1 回に提案する区間内部の分割点の数 (1 以上)</param>
+		LineMultiSectionSearcher(std::shared_ptr<const DatabaseCore> database, const coordinate& example_coordinate, const DirectionLine& direction_info, bool low_value_is_better, std::size_t section_num);
+		/// <summary>
+		/// 探索対象情報を直接指定するコンストラクタ
+		/// </summary>
+		/// <param name="database">データベース</param>
+		/// <param name="line_info">探索対象直線</param>
+		/// <param name="low_value_is_better">性能評価値が低い値ほど良いのであれば true</param>
+		/// <param name="section_num">1 回に提案する区間内部の分割点の数 (1 以上)</param>
+		LineMultiSectionSearcher(std::shared_ptr<const DatabaseCore> database, const CoordinateLine& line_info, bool low_value_is_better, std::size_t section_num);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		LineMultiSectionSearcher(const LineMultiSectionSearcher& original);
+		/// <summary>
+		/// 参照するデータベースを差し替えるコピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		/// <param name="search_database">参照するデータベース (コピー元のデータベースを複製したもの)</param>
+		LineMultiSectionSearcher(const LineMultiSectionSearcher& original, std::shared_ptr<const DatabaseCore> search_database);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~LineMultiSectionSearcher(void);
+		/// <summary>
+		/// 直線の構成情報にアクセス
+		/// </summary>
+		/// <returns>直線の構成情報</returns>
+		const CoordinateLine& getLineInfomation(void) const;
+		/// <summary>
+		/// 次に実測すべき性能パラメタ性能値 (座標) を取得
+		/// </summary>
+		/// <returns>次に実測すべき性能パラメタ性能値 (座標)</returns>
+		const coordinate& getSuggested(void) const override;
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを取得
+		/// </summary>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(void) const override;
+		/// <summary>
+		/// 実測データを次回更新用バッファに記録
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void setMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// 記録されている実測データを用いて状態を更新
+		/// </summary>
+		/// <returns>更新用バッファにデータがあり，更新されたら true</returns>
+		bool updateState(void) override;
+		/// <summary>
+		/// 区間をこれ以上狭められなくなったかを取得
+		/// </summary>
+		/// <returns>終了条件を満たしていれば true</returns>
+		bool isSearchFinished(void) const override;
+		/// <summary>
+		/// 探索機構が探索対象とする座標リストを取得
+		/// </summary>
+		/// <returns>探索機構が探索対象とする座標リスト</returns>
+		const coordinate_list& getTargetCoordinate(void) const override;
+		/// <summary>
+		/// 対象座標内で探索済の座標リストを取得
+		/// </summary>
+		/// <returns>対象座標内で探索済の座標リスト</returns>
+		const std::unordered_set<coordinate>& getMeasuredCoordinates(void) const override;
+		/// <summary>
+		/// 探索アルゴリズムが最良と判定した性能パラメタ設定値 (座標) を取得
+		/// </summary>
+		/// <returns>探索アルゴリズムが最良と判定した性能パラメタ設定値 (座標)</returns>
+		const coordinate& getBestJudgedCoordinate(void) const override;
+		/// <summary>
+		/// 探索アルゴリズムによって実測されたうち，性能評価値が最良だった性能パラメタ設定値 (座標) を取得
+		/// </summary>
+		/// <returns>実測されたうち，性能評価値が最良だった性能パラメタ設定値 (座標)</returns>
+		const coordinate& getBestMeasuredCoordinate(void) const override;
+	};
+}
+
+#endif // !LINE_MULTI_SECTION_SEARCHER_HPP_
@@ -18,17 +18,12 @@ namespace dsice {
 		std::size_t right = line.getPointsNum() - 1;
 		std::pair<std::size_t, std::size_t> tmp_mids = TriEquallyIndexer::getTriPoints(left, right);
 
-		if (!database->hasSample(line.getPointCoordinate(left))) {
-			this->tri_points.push_back(line.getPointCoordinate(left));
-		}
-		if (!database->hasSample(line.getPointCoordinate(right))) {
-			this->tri_points.push_back(line.getPointCoordinate(right));
-		}
-		if (!database->hasSample(line.getPointCoordinate(tmp_mids.first))) {
-			this->tri_points.push_back(line.getPointCoordinate(tmp_mids.first));
-		}
-		if (!database->hasSample(line.getPointCoordinate(tmp_mids.second))) {
-			this->tri_points.push_back(line.getPointCoordinate(tmp_mids.second));
+		// 短い直線では 3 分割点が端点と重なるため，同じ点は 1 度だけ並べる (1 回の実測で終了できるように)
+		for (std::size_t i : { left, right, tmp_mids.first, tmp_mids.second }) {
+			const coordinate& c = line.getPointCoordinate(i);
+			if (!database->hasSample(c) && std::find(this->tri_points.begin(), this->tri_points.end(), c) == this->tri_points.end()) {
+				this->tri_points.push_back(c);
+			}
 		}
 	}
 
@@ -182,9 +182,10 @@ namespace dsice {
 
 			std::size_t loop_cnt = 1;
 
-			const std::vector<BasePointLog>& log = database->getAllMeasuringLog();
-			for (const BasePointLog& each_base : log) {
+			// ファイルへ書き出されたログもあるため，全件をメモリに載せず逐次読み出す
+			for (MeasuringLogIterator itr = database->beginMeasuringLog(); itr != database->endMeasuringLog(); ++itr) {
 
+				const BasePointLog& each_base = *itr;
 				const coordinate& base_point = each_base.getBasePoint();
 				const std::vector<SuggestGroupLog>& each_base_log = each_base.getSuggestLogList();
 				for (const SuggestGroupLog& each_suggest : each_base_log) {
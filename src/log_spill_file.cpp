@@ -0,0 +1,255 @@
+﻿#include <cstring>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include <istream>
+#include <ostream>
+#include <fstream>
+#include <stdexcept>
+
+#include "dsice_search_space.hpp"
+#include "sampling_log.hpp"
+#include "suggest_group_log.hpp"
+#include "base_point_log.hpp"
+#include "log_spill_file.hpp"
+
+namespace dsice {
+
+	// static 変数の実体定義
+	std::atomic<std::size_t> LogSpillFile::tail_file_count = 0;
+
+	LogSpillFile::LogSpillFile(const std::string& file_path) {
+
+		this->root_file_path = file_path;
+		this->file_path = file_path;
+		this->output = std::make_shared<std::ofstream>(file_path, std::ios::binary | std::ios::trunc);
+
+		if (!this->output->is_open()) {
+			throw std::runtime_error("failed to open log spill file: " + file_path);
+		}
+	}
+
+	LogSpillFile::LogSpillFile(std::shared_ptr<const LogSpillFile> original) {
+
+		this->root_file_path = original->root_file_path;
+		this->is_tail_file = true;
+		this->last_coordinate = original->last_coordinate;
+		this->last_time_count = original->last_time_count;
+
+		// 複製元が自身で書き出していなければ，その複製元を直接参照する (参照の連鎖を伸ばさない)
+		if (original->spilled_num > 0) {
+			this->prefix_file = original;
+			this->prefix_num = original->getSpilledNum();
+		}
+		else {
+			this->prefix_file = original->prefix_file;
+			this->prefix_num = original->prefix_num;
+		}
+	}
+
+	LogSpillFile::~LogSpillFile(void) {
+
+		if (this->is_tail_file && this->output != nullptr) {
+			this->output->close();
+			std::remove(this->file_path.c_str());
+		}
+	}
+
+	void LogSpillFile::writeVarint(std::ostream& output, std::uint64_t value) {
+
+		while (value >= 0x80) {
+			output.put(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+
+		output.put(static_cast<char>(value));
+	}
+
+	void LogSpillFile::writeSignedVarint(std::ostream& output, long long value) {
+		LogSpillFile::writeVarint(output, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+	}
+
+	std::uint64_t LogSpillFile::readVarint(std::istream& input) {
+
+		std::uint64_t value = 0;
+
+		for (int shift = 0; shift < 64; shift += 7) {
+
+			int c = input.get();
+			if (c == std::char_traits<char>::eof()) {
+				throw std::runtime_error("log spill file is truncated");
+			}
+
+			value |= static_cast<std::uint64_t>(c & 0x7F) << shift;
+			if ((c & 0x80) == 0) {
+				break;
+			}
+		}
+
+		return value;
+	}
+
+	long long LogSpillFile::readSignedVarint(std::istream& input) {
+		std::uint64_t value = LogSpillFile::readVarint(input);
+		return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+	}
+
+	void LogSpillFile::writeCoordinate(std::ostream& output, const coordinate& target_coordinate, coordinate& last_coordinate) {
+
+		// 次元数が変わる場合 (ダミー基準点など) は原点との差分とする
+		if (last_coordinate.size() != target_coordinate.size()) {
+			last_coordinate.assign(target_coordinate.size(), 0);
+		}
+
+		LogSpillFile::writeVarint(output, target_coordinate.size());
+		for (std::size_t i = 0; i < target_coordinate.size(); i++) {
+			LogSpillFile::writeSignedVarint(output, static_cast<long long>(target_coordinate[i]) - static_cast<long long>(last_coordinate[i]));
+		}
+
+		last_coordinate = target_coordinate;
+	}
+
+	coordinate LogSpillFile::readCoordinate(std::istream& input, coordinate& last_coordinate) {
+
+		std::size_t dimension = static_cast<std::size_t>(LogSpillFile::readVarint(input));
+
+		if (last_coordinate.size() != dimension) {
+			last_coordinate.assign(dimension, 0);
+		}
+
+		coordinate tmp_c(dimension);
+		for (std::size_t i = 0; i < dimension; i++) {
+			tmp_c[i] = static_cast<std::size_t>(static_cast<long long>(last_coordinate[i]) + LogSpillFile::readSignedVarint(input));
+		}
+
+		last_coordinate = tmp_c;
+
+		return tmp_c;
+	}
+
+	void LogSpillFile::append(const BasePointLog& base_point_log) {
+
+		// 末尾ファイルは最初の書き出し時に，既存のファイルと重ならない名前で作る
+		if (this->output == nullptr) {
+			do {
+				this->file_path = this->root_file_path + "." + std::to_string(++LogSpillFile::tail_file_count);
+			} while (std::filesystem::exists(this->file_path));
+
+			this->output = std::make_shared<std::ofstream>(this->file_path, std::ios::binary | std::ios::trunc);
+			if (!this->output->is_open()) {
+				throw std::runtime_error("failed to open log spill file: " + this->file_path);
+			}
+		}
+
+		std::ostream& out = *this->output;
+
+		LogSpillFile::writeCoordinate(out, base_point_log.getBasePoint(), this->last_coordinate);
+
+		const std::vector<SuggestGroupLog>& suggest_log_list = base_point_log.getSuggestLogList();
+		LogSpillFile::writeVarint(out, suggest_log_list.size());
+
+		for (const SuggestGroupLog& sg_log : suggest_log_list) {
+
+			const coordinate_list& candidate_list = sg_log.getCandidateList();
+			LogSpillFile::writeVarint(out, candidate_list.size());
+			for (const coordinate& c : candidate_list) {
+				LogSpillFile::writeCoordinate(out, c, this->last_coordinate);
+			}
+
+			const std::vector<SamplingLog>& measured_data_list = sg_log.getMeasuredDataList();
+			LogSpillFile::writeVarint(out, measured_data_list.size());
+			for (const SamplingLog& sl_log : measured_data_list) {
+
+				LogSpillFile::writeCoordinate(out, sl_log.getSampleCoordinate(), this->last_coordinate);
+
+				double metric_value = sl_log.getMetricValue();
+				char raw[sizeof(double)];
+				std::memcpy(raw, &metric_value, sizeof(double));
+				out.write(raw, sizeof(double));
+
+				long long start_count = sl_log.getMeasureStartTime().time_since_epoch().count();
+				LogSpillFile::writeSignedVarint(out, start_count - this->last_time_count);
+				LogSpillFile::writeSignedVarint(out, sl_log.getMeasureDuration().count());
+				this->last_time_count = start_count;
+			}
+		}
+
+		out.flush();
+		if (!out.good()) {
+			throw std::runtime_error("failed to write log spill file: " + this->file_path);
+		}
+
+		this->spilled_num++;
+	}
+
+	std::size_t LogSpillFile::getSpilledNum(void) const {
+		return this->prefix_num + this->spilled_num;
+	}
+
+	std::vector<std::pair<std::string, std::size_t>> LogSpillFile::getSpilledSegments(void) const {
+
+		std::vector<std::pair<std::string, std::size_t>> segments;
+		this->collectSegments(this->getSpilledNum(), segments);
+
+		return segments;
+	}
+
+	void LogSpillFile::collectSegments(std::size_t log_num, std::vector<std::pair<std::string, std::size_t>>& segments) const {
+
+		// 複製元は複製後も追記しているため，自身の spilled_num ではなく要求された件数で区切る
+		std::size_t prefix_used_num = std::min(log_num, this->prefix_num);
+		if (this->prefix_file != nullptr && prefix_used_num > 0) {
+			this->prefix_file->collectSegments(prefix_used_num, segments);
+		}
+
+		if (log_num > prefix_used_num) {
+			segments.emplace_back(this->file_path, log_num - prefix_used_num);
+		}
+	}
+
+	std::shared_ptr<BasePointLog> LogSpillFile::readBasePointLog(std::istream& input, coordinate& last_coordinate, long long& last_time_count) {
+
+		std::shared_ptr<BasePointLog> b_log = std::make_shared<BasePointLog>(LogSpillFile::readCoordinate(input, last_coordinate));
+
+		std::size_t suggest_num = static_cast<std::size_t>(LogSpillFile::readVarint(input));
+		for (std::size_t i = 0; i < suggest_num; i++) {
+
+			std::size_t candidate_num = static_cast<std::size_t>(LogSpillFile::readVarint(input));
+			coordinate_list candidate_list;
+			candidate_list.reserve(candidate_num);
+			for (std::size_t j = 0; j < candidate_num; j++) {
+				candidate_list.push_back(LogSpillFile::readCoordinate(input, last_coordinate));
+			}
+			b_log->updateCandidateList(candidate_list);
+
+			std::size_t measured_num = static_cast<std::size_t>(LogSpillFile::readVarint(input));
+			for (std::size_t j = 0; j < measured_num; j++) {
+
+				coordinate sample_coordinate = LogSpillFile::readCoordinate(input, last_coordinate);
+
+				char raw[sizeof(double)];
+				double metric_value;
+				if (!input.read(raw, sizeof(double))) {
+					throw std::runtime_error("log spill file is truncated");
+				}
+				std::memcpy(&metric_value, raw, sizeof(double));
+
+				long long start_count = last_time_count + LogSpillFile::readSignedVarint(input);
+				long long duration_count = LogSpillFile::readSignedVarint(input);
+				last_time_count = start_count;
+
+				std::chrono::system_clock::time_point start_time{ std::chrono::system_clock::duration(start_count) };
+				std::chrono::system_clock::time_point end_time = start_time + std::chrono::system_clock::duration(duration_count);
+				b_log->appendMeasuredData(sample_coordinate, metric_value, start_time, end_time);
+			}
+		}
+
+		return b_log;
+	}
+}
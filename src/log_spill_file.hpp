@@ -0,0 +1,162 @@
+﻿#ifndef LOG_SPILL_FILE_HPP_
+#define LOG_SPILL_FILE_HPP_
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <fstream>
+
+#include "dsice_search_space.hpp"
+#include "base_point_log.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 実測ログのうちメモリ上から追い出された探索基準点ログを書き出す追記専用のバイナリファイル．<br/>
+	/// 座標は直前に書き出した座標との差分，時刻は直前の時刻との差分を可変長整数で記録して圧縮する．<br/>
+	/// 複製時は書き出し済の部分を複製元と共有し，複製後に書き出すログのみを別ファイル (末尾ファイル) に書き出す
+	/// </summary>
+	class LogSpillFile final {
+	private:
+		/// <summary>
+		/// 末尾ファイルの通し番号 (ファイル名の重複を避けるためプロセス内で共有)
+		/// </summary>
+		static std::atomic<std::size_t> tail_file_count;
+		/// <summary>
+		/// 利用者が指定した書き出し先ファイルのパス (末尾ファイル名の基準)
+		/// </summary>
+		std::string root_file_path;
+		/// <summary>
+		/// このインスタンスが書き出すファイルのパス (末尾ファイルは最初の書き出しまで空文字列)
+		/// </summary>
+		std::string file_path;
+		/// <summary>
+		/// このインスタンスが書き出すファイルが末尾ファイル (破棄時に削除するファイル) かどうか
+		/// </summary>
+		bool is_tail_file = false;
+		/// <summary>
+		/// 書き出し用ストリーム (末尾ファイルは最初の書き出しまで nullptr)
+		/// </summary>
+		std::shared_ptr<std::ofstream> output;
+		/// <summary>
+		/// 複製時点までに書き出されたログを保持する複製元 (複製元が無い場合は nullptr)．<br/>
+		/// 複製元はその後も追記するが，先頭 prefix_num 件のみを参照するため内容は変わらない
+		/// </summary>
+		std::shared_ptr<const LogSpillFile> prefix_file;
+		/// <summary>
+		/// 複製元から引き継いだ書き出し済ログの数
+		/// </summary>
+		std::size_t prefix_num = 0;
+		/// <summary>
+		/// 直前に書き出した座標 (差分符号化の基準)
+		/// </summary>
+		coordinate last_coordinate;
+		/// <summary>
+		/// 直前に書き出した時刻 (差分符号化の基準，system_clock の tick 数)
+		/// </summary>
+		long long last_time_count = 0;
+		/// <summary>
+		/// このインスタンスが書き出した探索基準点ログの数 (複製元から引き継いだ分を除く)
+		/// </summary>
+		std::size_t spilled_num = 0;
+		/// <summary>
+		/// 先頭から指定件数までのログを保持するファイルとその件数を古い順に追加
+		/// </summary>
+		/// <param name="log_num">対象とするログの数</param>
+		/// <param name="segments">追加先 (ファイルのパスとそのファイルから読み出すログの数の組)</param>
+		void collectSegments(std::size_t log_num, std::vector<std::pair<std::string, std::size_t>>& segments) const;
+		/// <summary>
+		/// 符号なし整数を可変長整数として書き出す
+		/// </summary>
+		/// <param name="output">書き出し先</param>
+		/// <param name="value">値</param>
+		static void writeVarint(std::ostream& output, std::uint64_t value);
+		/// <summary>
+		/// 符号付き整数を zigzag 変換したうえで可変長整数として書き出す
+		/// </summary>
+		/// <param name="output">書き出し先</param>
+		/// <param name="value">値</param>
+		static void writeSignedVarint(std::ostream& output, long long value);
+		/// <summary>
+		/// 可変長整数を読み出す
+		/// </summary>
+		/// <param name="input">読み出し元</param>
+		/// <returns>値</returns>
+		static std::uint64_t readVarint(std::istream& input);
+		/// <summary>
+		/// zigzag 変換された可変長整数を符号付き整数として読み出す
+		/// </summary>
+		/// <param name="input">読み出し元</param>
+		/// <returns>値</returns>
+		static long long readSignedVarint(std::istream& input);
+		/// <summary>
+		/// 座標を直前の座標との差分として書き出す
+		/// </summary>
+		/// <param name="output">書き出し先</param>
+		/// <param name="target_coordinate">書き出す座標</param>
+		/// <param name="last_coordinate">直前の座標 (書き出し後に更新される)</param>
+		static void writeCoordinate(std::ostream& output, const coordinate& target_coordinate, coordinate& last_coordinate);
+		/// <summary>
+		/// 直前の座標との差分として書き出された座標を読み出す
+		/// </summary>
+		/// <param name="input">読み出し元</param>
+		/// <param name="last_coordinate">直前の座標 (読み出し後に更新される)</param>
+		/// <returns>座標</returns>
+		static coordinate readCoordinate(std::istream& input, coordinate& last_coordinate);
+	public:
+		/// <summary>
+		/// コンストラクタ．指定ファイルを空にして書き出しを開始
+		/// </summary>
+		/// <param name="file_path">書き出し先ファイルのパス</param>
+		LogSpillFile(const std::string& file_path);
+		/// <summary>
+		/// 複製元の書き出し済ログを共有して引き継ぐコンストラクタ．<br/>
+		/// 以降のログは指定ファイルの末尾に通し番号を付けた末尾ファイルに書き出す (最初の書き出しまでファイルは作らない)
+		/// </summary>
+		/// <param name="original">複製元</param>
+		LogSpillFile(std::shared_ptr<const LogSpillFile> original);
+		/// <summary>
+		/// デストラクタ．末尾ファイルを削除 (利用者が指定したファイルは残す)
+		/// </summary>
+		/// <param name=""></param>
+		~LogSpillFile(void);
+		/// <summary>
+		/// コピーコンストラクタ (末尾ファイルの所有が重複するため禁止)
+		/// </summary>
+		LogSpillFile(const LogSpillFile&) = delete;
+		/// <summary>
+		/// コピー代入 (末尾ファイルの所有が重複するため禁止)
+		/// </summary>
+		LogSpillFile& operator=(const LogSpillFile&) = delete;
+		/// <summary>
+		/// 探索基準点ログ 1 件を末尾に書き出す
+		/// </summary>
+		/// <param name="base_point_log">書き出すログ</param>
+		void append(const BasePointLog& base_point_log);
+		/// <summary>
+		/// 書き出し済の探索基準点ログの数 (複製元から引き継いだ分を含む) を取得
+		/// </summary>
+		/// <returns>書き出し済の探索基準点ログの数</returns>
+		std::size_t getSpilledNum(void) const;
+		/// <summary>
+		/// 書き出し済のログを保持するファイルとその件数の一覧を取得
+		/// </summary>
+		/// <returns>ファイルのパスとそのファイルから読み出すログの数の組 (古い順)</returns>
+		std::vector<std::pair<std::string, std::size_t>> getSpilledSegments(void) const;
+		/// <summary>
+		/// 書き出されたファイルから探索基準点ログ 1 件を読み出す
+		/// </summary>
+		/// <param name="input">読み出し元 (ファイル先頭から順に読む)</param>
+		/// <param name="last_coordinate">直前に読み出した座標 (読み出し開始時は空，読み出し後に更新される．ファイルをまたいでも引き継ぐ)</param>
+		/// <param name="last_time_count">直前に読み出した時刻 (読み出し開始時は 0，読み出し後に更新される)</param>
+		/// <returns>読み出したログ</returns>
+		static std::shared_ptr<BasePointLog> readBasePointLog(std::istream& input, coordinate& last_coordinate, long long& last_time_count);
+	};
+}
+
+#endif // !LOG_SPILL_FILE_HPP_
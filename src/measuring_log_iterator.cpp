@@ -0,0 +1,107 @@
+﻿#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <deque>
+#include <fstream>
+#include <stdexcept>
+
+#include "dsice_search_space.hpp"
+#include "base_point_log.hpp"
+#include "log_spill_file.hpp"
+#include "measuring_log_iterator.hpp"
+
+namespace dsice {
+
+	MeasuringLogIterator::MeasuringLogIterator(const std::vector<std::pair<std::string, std::size_t>>& spilled_segments, const std::deque<std::shared_ptr<BasePointLog>>& memory_log) {
+
+		this->spilled_segments = spilled_segments;
+		this->spilled_num = 0;
+		for (const std::pair<std::string, std::size_t>& segment : spilled_segments) {
+			this->spilled_num += segment.second;
+		}
+		this->memory_log = &memory_log;
+		this->position = 0;
+
+		this->readCurrent();
+	}
+
+	MeasuringLogIterator::MeasuringLogIterator(std::size_t spilled_num, const std::deque<std::shared_ptr<BasePointLog>>& memory_log) {
+		this->spilled_num = spilled_num;
+		this->memory_log = &memory_log;
+		this->position = spilled_num + memory_log.size();
+	}
+
+	MeasuringLogIterator::MeasuringLogIterator(const MeasuringLogIterator& original) {
+		this->spilled_segments = original.spilled_segments;
+		this->segment_idx = original.segment_idx;
+		this->segment_end = original.segment_end;
+		this->input = original.input;
+		this->spilled_num = original.spilled_num;
+		this->memory_log = original.memory_log;
+		this->position = original.position;
+		this->decoded_log = original.decoded_log;
+		this->last_coordinate = original.last_coordinate;
+		this->last_time_count = original.last_time_count;
+	}
+
+	MeasuringLogIterator::~MeasuringLogIterator(void) {
+		// DO_NOTHING
+	}
+
+	void MeasuringLogIterator::readCurrent(void) {
+
+		if (this->position < this->spilled_num) {
+
+			// 差分復号の基準はファイルをまたいで引き継ぐ (末尾ファイルは複製元の続きとして書き出されている)
+			if (this->input == nullptr || this->position == this->segment_end) {
+
+				if (this->input != nullptr) {
+					this->segment_idx++;
+				}
+
+				const std::string& segment_path = this->spilled_segments[this->segment_idx].first;
+				this->input = std::make_shared<std::ifstream>(segment_path, std::ios::binary);
+				if (!this->input->is_open()) {
+					throw std::runtime_error("failed to open log spill file: " + segment_path);
+				}
+				this->segment_end += this->spilled_segments[this->segment_idx].second;
+			}
+
+			this->decoded_log = LogSpillFile::readBasePointLog(*this->input, this->last_coordinate, this->last_time_count);
+		}
+		else {
+			// メモリ上のログに移ったら読み出し元は不要
+			this->decoded_log = nullptr;
+			this->input = nullptr;
+		}
+	}
+
+	const BasePointLog& MeasuringLogIterator::operator*(void) const {
+
+		if (this->position < this->spilled_num) {
+			return *this->decoded_log;
+		}
+		else {
+			return *(*this->memory_log)[this->position - this->spilled_num];
+		}
+	}
+
+	const BasePointLog* MeasuringLogIterator::operator->(void) const {
+		return &(**this);
+	}
+
+	MeasuringLogIterator& MeasuringLogIterator::operator++(void) {
+		this->position++;
+		this->readCurrent();
+		return *this;
+	}
+
+	bool MeasuringLogIterator::operator==(const MeasuringLogIterator& other) const {
+		return this->memory_log == other.memory_log && this->position == other.position;
+	}
+
+	bool MeasuringLogIterator::operator!=(const MeasuringLogIterator& other) const {
+		return !(*this == other);
+	}
+}
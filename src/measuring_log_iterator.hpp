@@ -0,0 +1,127 @@
+﻿#ifndef MEASURING_LOG_ITERATOR_HPP_
+#define MEASURING_LOG_ITERATOR_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <deque>
+#include <fstream>
+
+#include "dsice_search_space.hpp"
+#include "base_point_log.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 探索基準点ログを古い順に 1 件ずつ読み出す入力イテレータ．<br/>
+	/// ファイルへ書き出されたログはファイルから逐次読み出し (複製元と共有するファイルから順に)，その後メモリ上に残るログを順に返す
+	/// </summary>
+	class MeasuringLogIterator final {
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = BasePointLog;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const BasePointLog*;
+		using reference = const BasePointLog&;
+	private:
+		/// <summary>
+		/// 書き出し済ログを保持するファイルとそのファイルから読み出すログの数 (古い順)
+		/// </summary>
+		std::vector<std::pair<std::string, std::size_t>> spilled_segments;
+		/// <summary>
+		/// 現在読み出し中のファイルの番号
+		/// </summary>
+		std::size_t segment_idx = 0;
+		/// <summary>
+		/// 現在読み出し中のファイルの最後のログの次の位置 (全ログ中)
+		/// </summary>
+		std::size_t segment_end = 0;
+		/// <summary>
+		/// 書き出し済ログの読み出し元 (書き出しがない場合は nullptr)
+		/// </summary>
+		std::shared_ptr<std::ifstream> input;
+		/// <summary>
+		/// 書き出し済ログの数
+		/// </summary>
+		std::size_t spilled_num = 0;
+		/// <summary>
+		/// メモリ上に残るログ
+		/// </summary>
+		const std::deque<std::shared_ptr<BasePointLog>>* memory_log = nullptr;
+		/// <summary>
+		/// 全ログ中の現在位置
+		/// </summary>
+		std::size_t position = 0;
+		/// <summary>
+		/// ファイルから読み出した現在のログ
+		/// </summary>
+		std::shared_ptr<BasePointLog> decoded_log;
+		/// <summary>
+		/// 直前に読み出した座標 (差分復号の基準)
+		/// </summary>
+		coordinate last_coordinate;
+		/// <summary>
+		/// 直前に読み出した時刻 (差分復号の基準)
+		/// </summary>
+		long long last_time_count = 0;
+		/// <summary>
+		/// 現在位置がファイル内であれば 1 件読み出す (ファイルの終わりに達していれば次のファイルを開く)
+		/// </summary>
+		void readCurrent(void);
+	public:
+		/// <summary>
+		/// 先頭を指すイテレータを作るコンストラクタ
+		/// </summary>
+		/// <param name="spilled_segments">書き出し済ログを保持するファイルとそのファイルから読み出すログの数 (古い順，書き出しがない場合は空)</param>
+		/// <param name="memory_log">メモリ上に残るログ</param>
+		MeasuringLogIterator(const std::vector<std::pair<std::string, std::size_t>>& spilled_segments, const std::deque<std::shared_ptr<BasePointLog>>& memory_log);
+		/// <summary>
+		/// 終端を指すイテレータを作るコンストラクタ
+		/// </summary>
+		/// <param name="spilled_num">書き出し済ログの数</param>
+		/// <param name="memory_log">メモリ上に残るログ</param>
+		MeasuringLogIterator(std::size_t spilled_num, const std::deque<std::shared_ptr<BasePointLog>>& memory_log);
+		/// <summary>
+		/// コピーコンストラクタ (ファイル読み出し位置は共有される)
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		MeasuringLogIterator(const MeasuringLogIterator& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		/// <param name=""></param>
+		~MeasuringLogIterator(void);
+		/// <summary>
+		/// 現在位置のログを取得
+		/// </summary>
+		/// <returns>現在位置のログ</returns>
+		const BasePointLog& operator*(void) const;
+		/// <summary>
+		/// 現在位置のログのメンバにアクセス
+		/// </summary>
+		/// <returns>現在位置のログ</returns>
+		const BasePointLog* operator->(void) const;
+		/// <summary>
+		/// 次のログへ進む
+		/// </summary>
+		/// <returns>進めた後のイテレータ</returns>
+		MeasuringLogIterator& operator++(void);
+		/// <summary>
+		/// 同じ位置を指しているか
+		/// </summary>
+		/// <param name="other">比較対象</param>
+		/// <returns>同じ位置なら true</returns>
+		bool operator==(const MeasuringLogIterator& other) const;
+		/// <summary>
+		/// 異なる位置を指しているか
+		/// </summary>
+		/// <param name="other">比較対象</param>
+		/// <returns>異なる位置なら true</returns>
+		bool operator!=(const MeasuringLogIterator& other) const;
+	};
+}
+
+#endif // !MEASURING_LOG_ITERATOR_HPP_
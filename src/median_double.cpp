@@ -0,0 +1,172 @@
+﻿#include <cstddef>
+#include <array>
+#include <algorithm>
+#include "median_double.hpp"
+
+namespace dsice {
+
+	MedianDouble::MedianDouble(void) {
+		// DO_NOTHING
+	}
+
+	MedianDouble::MedianDouble(double init_value) {
+		this->setValue(init_value);
+	}
+
+	MedianDouble::MedianDouble(const MedianDouble& original) {
+		this->heights = original.heights;
+		this->positions = original.positions;
+		this->desired_positions = original.desired_positions;
+		this->count = original.count;
+		this->mean = original.mean;
+		this->squared_deviation_sum = original.squared_deviation_sum;
+	}
+
+	MedianDouble::~MedianDouble(void) {
+		// DO_NOTHING
+	}
+
+	MedianDouble::operator double() const {
+		return this->getValue();
+	}
+
+	double MedianDouble::getValue(void) const {
+
+		if (this->count == 0) {
+			return 0;
+		}
+
+		// マーカ初期化後は中央のマーカが中央値の推定値
+		if (this->count >= MedianDouble::MARKERS_NUM) {
+			return this->heights[MedianDouble::MARKERS_NUM / 2];
+		}
+
+		// 登録数が少ない間は保持している値から厳密に計算
+		std::array<double, MedianDouble::MARKERS_NUM> sorted = this->heights;
+		std::sort(sorted.begin(), sorted.begin() + this->count);
+
+		if (this->count % 2 == 1) {
+			return sorted[this->count / 2];
+		}
+		else {
+			return (sorted[this->count / 2 - 1] + sorted[this->count / 2]) / 2;
+		}
+	}
+
+	void MedianDouble::setValue(double metric_value) {
+
+		// 信頼区間の推定用に分散を更新 (Welford のアルゴリズム)
+		double diff = metric_value - this->mean;
+		this->mean += diff / (this->count + 1);
+		this->squared_deviation_sum += diff * (metric_value - this->mean);
+
+		// マーカが揃うまでは値をそのまま保持
+		if (this->count < MedianDouble::MARKERS_NUM) {
+
+			this->heights[this->count] = metric_value;
+			this->count++;
+
+			if (this->count == MedianDouble::MARKERS_NUM) {
+				this->initializeMarkers();
+			}
+
+			return;
+		}
+
+		// 値が入る区間 [heights[k], heights[k + 1]) を特定 (両端の外側なら端のマーカを更新)
+		std::size_t k;
+		if (metric_value < this->heights[0]) {
+			this->heights[0] = metric_value;
+			k = 0;
+		}
+		else if (metric_value >= this->heights[MedianDouble::MARKERS_NUM - 1]) {
+			this->heights[MedianDouble::MARKERS_NUM - 1] = metric_value;
+			k = MedianDouble::MARKERS_NUM - 2;
+		}
+		else {
+			k = 0;
+			while (metric_value >= this->heights[k + 1]) {
+				k++;
+			}
+		}
+
+		for (std::size_t i = k + 1; i < MedianDouble::MARKERS_NUM; i++) {
+			this->positions[i] += 1;
+		}
+
+		// 理想位置は中央値 (p = 0.5) に対する増分 {0, p/2, p, (1+p)/2, 1} で移動
+		this->desired_positions[1] += 0.25;
+		this->desired_positions[2] += 0.5;
+		this->desired_positions[3] += 0.75;
+		this->desired_positions[4] += 1;
+
+		// 両端以外のマーカについて，理想位置から 1 以上ずれていれば調整
+		for (std::size_t i = 1; i < MedianDouble::MARKERS_NUM - 1; i++) {
+
+			double diff = this->desired_positions[i] - this->positions[i];
+
+			if (diff >= 1 && this->positions[i + 1] - this->positions[i] > 1) {
+				this->adjustMarker(i, 1);
+			}
+			else if (diff <= -1 && this->positions[i - 1] - this->positions[i] < -1) {
+				this->adjustMarker(i, -1);
+			}
+		}
+
+		this->count++;
+	}
+
+	std::size_t MedianDouble::getRecordedCount(void) const {
+		return this->count;
+	}
+
+	double MedianDouble::getVariance(void) const {
+
+		if (this->count < 2) {
+			return 0;
+		}
+
+		return this->squared_deviation_sum / (this->count - 1);
+	}
+
+	std::shared_ptr<Metric> MedianDouble::makeCopy(void) const {
+		return std::make_shared<MedianDouble>(*this);
+	}
+
+	void MedianDouble::initializeMarkers(void) {
+
+		std::sort(this->heights.begin(), this->heights.end());
+
+		for (std::size_t i = 0; i < MedianDouble::MARKERS_NUM; i++) {
+			this->positions[i] = static_cast<double>(i);
+		}
+
+		this->desired_positions = { 0, 1, 2, 3, 4 };
+	}
+
+	void MedianDouble::adjustMarker(std::size_t marker_idx, int direction) {
+
+		double d = static_cast<double>(direction);
+		double q_prev = this->heights[marker_idx - 1];
+		double q = this->heights[marker_idx];
+		double q_next = this->heights[marker_idx + 1];
+		double n_prev = this->positions[marker_idx - 1];
+		double n = this->positions[marker_idx];
+		double n_next = this->positions[marker_idx + 1];
+
+		// 放物線補間
+		double parabolic = q + d / (n_next - n_prev) * ((n - n_prev + d) * (q_next - q) / (n_next - n) + (n_next - n - d) * (q - q_prev) / (n - n_prev));
+
+		if (q_prev < parabolic && parabolic < q_next) {
+			this->heights[marker_idx] = parabolic;
+		}
+		else {
+
+			// 単調性が崩れる場合は線形補間
+			std::size_t neighbor_idx = (direction > 0) ? marker_idx + 1 : marker_idx - 1;
+			this->heights[marker_idx] = q + d * (this->heights[neighbor_idx] - q) / (this->positions[neighbor_idx] - n);
+		}
+
+		this->positions[marker_idx] += d;
+	}
+}
@@ -0,0 +1,109 @@
+﻿#ifndef MEDIAN_DOUBLE_HPP_
+#define MEDIAN_DOUBLE_HPP_
+
+#include <cstddef>
+#include <array>
+#include "dsice_metric.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 倍精度浮動小数について過去に登録された値の中央値をとり続ける蓄積数値型．<br/>
+	/// P² アルゴリズム (Jain and Chlamtac, 1985) による推定値であり，過去の生データは保持しない．<br/>
+	/// 登録数が 5 以下の場合は厳密な中央値となる．信頼区間の推定用に分散も Welford のアルゴリズムで更新する
+	/// </summary>
+	class MedianDouble final : public Metric {
+	private:
+		/// <summary>
+		/// P² アルゴリズムで用いるマーカの数
+		/// </summary>
+		static constexpr std::size_t MARKERS_NUM = 5;
+		/// <summary>
+		/// 各マーカの高さ (最小値，1/4 分位，中央値，3/4 分位，最大値の推定値)．<br/>
+		/// 登録数が MARKERS_NUM 未満の間は登録された値そのものを保持
+		/// </summary>
+		std::array<double, MARKERS_NUM> heights = {};
+		/// <summary>
+		/// 各マーカの実際の位置 (何番目の値に相当するか)
+		/// </summary>
+		std::array<double, MARKERS_NUM> positions = {};
+		/// <summary>
+		/// 各マーカの理想的な位置
+		/// </summary>
+		std::array<double, MARKERS_NUM> desired_positions = {};
+		/// <summary>
+		/// 性能評価値を登録した回数
+		/// </summary>
+		std::size_t count = 0;
+		/// <summary>
+		/// 過去に登録された性能評価値の平均値 (分散の計算用)
+		/// </summary>
+		double mean = 0;
+		/// <summary>
+		/// 平均値からの偏差の 2 乗和 (Welford のアルゴリズムで逐次更新)
+		/// </summary>
+		double squared_deviation_sum = 0;
+		/// <summary>
+		/// 登録数が MARKERS_NUM に達した時点でマーカを初期化
+		/// </summary>
+		void initializeMarkers(void);
+		/// <summary>
+		/// 指定マーカの高さを放物線補間 (不適切な場合は線形補間) で調整
+		/// </summary>
+		/// <param name="marker_idx">調整するマーカの番号</param>
+		/// <param name="direction">マーカの移動方向 (1 または -1)</param>
+		void adjustMarker(std::size_t marker_idx, int direction);
+	public:
+		/// <summary>
+		/// 値無しの場合のコンストラクタ．<br/>
+		/// 初期値は 0 ですが，値は以降の計算に用いられません．
+		/// </summary>
+		MedianDouble(void);
+		/// <summary>
+		/// 初期値を指定するコンストラクタ
+		/// </summary>
+		/// <param name="init_value">初期値</param>
+		MedianDouble(double init_value);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		MedianDouble(const MedianDouble& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~MedianDouble(void);
+		/// <summary>
+		/// double 型への型変換 (getValue() の省略) を許可
+		/// </summary>
+		operator double() const override;
+		/// <summary>
+		/// 倍精度浮動小数点数表現を取得
+		/// </summary>
+		/// <returns>倍精度浮動小数点数で表現した場合の値</returns>
+		double getValue(void) const override;
+		/// <summary>
+		/// 性能評価値を登録
+		/// </summary>
+		/// <param name="value">性能評価値</param>
+		void setValue(double metric_value) override;
+		/// <summary>
+		/// 過去に保存されたデータの数を取得
+		/// </summary>
+		/// <returns>過去に保存されたデータの数</returns>
+		std::size_t getRecordedCount(void) const override;
+		/// <summary>
+		/// 過去に登録された性能評価値の不偏分散を取得 (信頼区間の推定用)．<br/>
+		/// 登録数が 2 未満の場合は 0
+		/// </summary>
+		/// <returns>過去に登録された性能評価値の不偏分散</returns>
+		double getVariance(void) const;
+		/// <summary>
+		/// コピーされた新しいインスタンスを Metric 型として作成．コピーコンストラクタ用．
+		/// </summary>
+		/// <returns>コピーされたインスタンス</returns>
+		std::shared_ptr<Metric> makeCopy(void) const override;
+	};
+}
+
+#endif // !MEDIAN_DOUBLE_HPP_
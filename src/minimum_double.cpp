@@ -0,0 +1,48 @@
+﻿#include <cstddef>
+#include "minimum_double.hpp"
+
+namespace dsice {
+
+	MinimumDouble::MinimumDouble(void) {
+		// DO_NOTHING
+	}
+
+	MinimumDouble::MinimumDouble(double init_value) {
+		this->count = 1;
+		this->value = init_value;
+	}
+
+	MinimumDouble::MinimumDouble(const MinimumDouble& original) {
+		this->value = original.value;
+		this->count = original.count;
+	}
+
+	MinimumDouble::~MinimumDouble(void) {
+		// DO_NOTHING
+	}
+
+	MinimumDouble::operator double() const {
+		return this->value;
+	}
+
+	double MinimumDouble::getValue(void) const {
+		return this->value;
+	}
+
+	void MinimumDouble::setValue(double metric_value) {
+
+		if (this->count == 0 || metric_value < this->value) {
+			this->value = metric_value;
+		}
+
+		this->count++;
+	}
+
+	std::size_t MinimumDouble::getRecordedCount(void) const {
+		return this->count;
+	}
+
+	std::shared_ptr<Metric> MinimumDouble::makeCopy(void) const {
+		return std::make_shared<MinimumDouble>(*this);
+	}
+}
@@ -0,0 +1,70 @@
+﻿#ifndef MINIMUM_DOUBLE_HPP_
+#define MINIMUM_DOUBLE_HPP_
+
+#include <cstddef>
+#include "dsice_metric.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 倍精度浮動小数について過去に登録された値の最小値をとり続ける蓄積数値型．<br/>
+	/// 実行時間のように外乱で悪化する方向にのみ値が揺らぐ性能評価値を想定
+	/// </summary>
+	class MinimumDouble final : public Metric {
+	private:
+		/// <summary>
+		/// 性能評価値 (の過去の最小値)
+		/// </summary>
+		double value = 0;
+		/// <summary>
+		/// 性能評価値を登録した回数
+		/// </summary>
+		std::size_t count = 0;
+	public:
+		/// <summary>
+		/// 値無しの場合のコンストラクタ．<br/>
+		/// 初期値は 0 ですが，値は以降の計算に用いられません．
+		/// </summary>
+		MinimumDouble(void);
+		/// <summary>
+		/// 初期値を指定するコンストラクタ
+		/// </summary>
+		/// <param name="init_value">初期値</param>
+		MinimumDouble(double init_value);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		MinimumDouble(const MinimumDouble& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~MinimumDouble(void);
+		/// <summary>
+		/// double 型への型変換 (getValue() の省略) を許可
+		/// </summary>
+		operator double() const override;
+		/// <summary>
+		/// 倍精度浮動小数点数表現を取得
+		/// </summary>
+		/// <returns>倍精度浮動小数点数で表現した場合の値</returns>
+		double getValue(void) const override;
+		/// <summary>
+		/// 性能評価値を登録
+		/// </summary>
+		/// <param name="value">性能評価値</param>
+		void setValue(double metric_value) override;
+		/// <summary>
+		/// 過去に保存されたデータの数を取得
+		/// </summary>
+		/// <returns>過去に保存されたデータの数</returns>
+		std::size_t getRecordedCount(void) const override;
+		/// <summary>
+		/// コピーされた新しいインスタンスを Metric 型として作成．コピーコンストラクタ用．
+		/// </summary>
+		/// <returns>コピーされたインスタンス</returns>
+		std::shared_ptr<Metric> makeCopy(void) const override;
+	};
+}
+
+#endif // !MINIMUM_DOUBLE_HPP_
@@ -4,6 +4,7 @@
 #include <limits>
 
 #include "d_spline.hpp"
+#include "equally_spaced_d_spline.hpp"
 #include "observed_d_spline.hpp"
 
 namespace dsice {
@@ -144,11 +145,17 @@ namespace dsice {
 	ObservedDSpline::ObservedDSpline(const ObservedDSpline& original):
 		mode(original.mode)
 	{
-		this->d_spline = original.d_spline;
+		// 近似曲線は更新されるため，コピー元と共有せず複製する
+		if (std::shared_ptr<EquallySpacedDSpline> e = std::dynamic_pointer_cast<EquallySpacedDSpline>(original.d_spline)) {
+			this->d_spline = std::make_shared<EquallySpacedDSpline>(*e);
+		}
+		else {
+			this->d_spline = original.d_spline;
+		}
 		this->all_curvatures = original.all_curvatures;
 		this->sample_curvatures = original.sample_curvatures;
 		this->measured_max = original.measured_max;
-		this->measured_min = original.measured_max;
+		this->measured_min = original.measured_min;
 		this->lowest_estimated_index = original.lowest_estimated_index;
 		this->highest_estimated_index = original.highest_estimated_index;
 		this->consecutive_highest_count = original.consecutive_highest_count;
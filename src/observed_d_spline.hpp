@@ -114,7 +114,7 @@ namespace dsice {
 		/// <param name="observation_mode">監視モード</param>
 		ObservedDSpline(std::shared_ptr<DSpline> target_d_spline, DSplineObservationMode observation_mode = DSplineObservationMode::STANDARD);
 		/// <summary>
-		/// コピーコンストラクタ
+		/// コピーコンストラクタ (観測対象の d-Spline も複製する)
 		/// </summary>
 		/// <param name="original">コピー元</param>
 		ObservedDSpline(const ObservedDSpline& original);
@@ -7,6 +7,7 @@
 #include "dsice_search_space.hpp"
 #include "observed_d_spline.hpp"
 #include "dsice_database_core.hpp"
+#include "dsice_database_censored_sample_extension.hpp"
 #include "equally_spaced_d_spline.hpp"
 #include "one_dim_dsp_searcher.hpp"
 
@@ -82,11 +83,42 @@ namespace dsice {
 		}
 	}
 
+	double OneDimDspSearcher::imputeCensoredValue(std::size_t sample_index, double bound) const {
+
+		// 近似曲線が定まらない間は限界値をそのまま使う
+		if (this->uncensored_num < 2) {
+			return bound;
+		}
+
+		double estimated_value = this->d_spline->getSampleValue(sample_index);
+
+		if (this->lower_is_better) {
+			return std::max(bound, estimated_value);
+		}
+		else {
+			return std::min(bound, estimated_value);
+		}
+	}
+
+	void OneDimDspSearcher::updateDSpline(const std::vector<std::pair<std::size_t, double>>& data, const std::vector<std::pair<std::size_t, double>>& censored_data) {
+
+		// 限界値をそのまま当てはめると打ち切り点付近が実際より良く近似されるため，登録前の近似値で底上げする
+		// (最良推定点の連続回数が 1 回の登録で数えられるよう，通常の標本とまとめて登録)
+		std::vector<std::pair<std::size_t, double>> delivered_data = data;
+		for (const std::pair<std::size_t, double>& one_data : censored_data) {
+			delivered_data.emplace_back(one_data.first, this->imputeCensoredValue(one_data.first, one_data.second));
+		}
+
+		this->d_spline->update(delivered_data);
+		this->uncensored_num += data.size();
+	}
+
 	OneDimDspSearcher::OneDimDspSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& example_coordinate, const DirectionLine& direction_info, bool low_value_is_better, double alpha) :
 		line(search_database->getSpaceSize(), example_coordinate, direction_info)
 	{
 		this->d_spline = std::make_shared<ObservedDSpline>(std::make_shared<EquallySpacedDSpline>(this->line.getPointsNum(), alpha), DSplineObservationMode::MEASURED_ZONE);
 		this->lower_is_better = low_value_is_better;
+		this->censored_database = std::dynamic_pointer_cast<const DatabaseCensoredSampleExtension>(search_database);
 		this->best_judged_point_coordinate = example_coordinate;
 		if (this->lower_is_better) {
 			this->best_point_value = std::numeric_limits<double>::max();
@@ -97,13 +129,19 @@ namespace dsice {
 
 		// データベースから初期データ登録
 		std::vector<std::pair<std::size_t, double>> initial_data;
+		std::vector<std::pair<std::size_t, double>> initial_censored_data;
 		for (const coordinate& c : this->line.getPoints()) {
 			if (search_database->hasSample(c)) {
 
 				this->measured_coordinates.insert(c);
 				double v = search_database->getSampleMetricValue(c);
 
-				initial_data.emplace_back(this->line.getPointIndex(c), v);
+				if (this->censored_database != nullptr && this->censored_database->isSampleCensored(c)) {
+					initial_censored_data.emplace_back(this->line.getPointIndex(c), v);
+				}
+				else {
+					initial_data.emplace_back(this->line.getPointIndex(c), v);
+				}
 
 				if (this->lower_is_better) {
 					if (this->best_point_value > v) {
@@ -121,9 +159,9 @@ namespace dsice {
 				}
 			}
 		}
-		this->d_spline->update(initial_data);
+		this->updateDSpline(initial_data, initial_censored_data);
 
-		if (initial_data.empty()) {
+		if (initial_data.empty() && initial_censored_data.empty()) {
 			this->suggest_target = this->line.getPoints();
 		}
 		else {
@@ -136,6 +174,7 @@ namespace dsice {
 	{
 		this->d_spline = std::make_shared<ObservedDSpline>(std::make_shared<EquallySpacedDSpline>(this->line.getPointsNum(), alpha), DSplineObservationMode::MEASURED_ZONE);
 		this->lower_is_better = low_value_is_better;
+		this->censored_database = std::dynamic_pointer_cast<const DatabaseCensoredSampleExtension>(search_database);
 		this->best_judged_point_coordinate = coordinate1;
 		if (this->lower_is_better) {
 			this->best_point_value = std::numeric_limits<double>::max();
@@ -146,13 +185,19 @@ namespace dsice {
 
 		// データベースから初期データ登録
 		std::vector<std::pair<std::size_t, double>> initial_data;
+		std::vector<std::pair<std::size_t, double>> initial_censored_data;
 		for (const coordinate& c : this->line.getPoints()) {
 			if (search_database->hasSample(c)) {
 
 				this->measured_coordinates.insert(c);
 				double v = search_database->getSampleMetricValue(c);
 
-				initial_data.emplace_back(this->line.getPointIndex(c), v);
+				if (this->censored_database != nullptr && this->censored_database->isSampleCensored(c)) {
+					initial_censored_data.emplace_back(this->line.getPointIndex(c), v);
+				}
+				else {
+					initial_data.emplace_back(this->line.getPointIndex(c), v);
+				}
 
 				if (this->lower_is_better) {
 					if (this->best_point_value > v) {
@@ -170,9 +215,9 @@ namespace dsice {
 				}
 			}
 		}
-		this->d_spline->update(initial_data);
+		this->updateDSpline(initial_data, initial_censored_data);
 
-		if (initial_data.empty()) {
+		if (initial_data.empty() && initial_censored_data.empty()) {
 			this->suggest_target = this->line.getPoints();
 		}
 		else {
@@ -185,6 +230,7 @@ namespace dsice {
 	{
 		this->d_spline = std::make_shared<ObservedDSpline>(std::make_shared<EquallySpacedDSpline>(this->line.getPointsNum(), alpha), DSplineObservationMode::MEASURED_ZONE);
 		this->lower_is_better = low_value_is_better;
+		this->censored_database = std::dynamic_pointer_cast<const DatabaseCensoredSampleExtension>(search_database);
 		this->best_judged_point_coordinate = this->line.getPointCoordinate(0);
 		if (this->lower_is_better) {
 			this->best_point_value = std::numeric_limits<double>::max();
@@ -195,13 +241,19 @@ namespace dsice {
 
 		// データベースから初期データ登録
 		std::vector<std::pair<std::size_t, double>> initial_data;
+		std::vector<std::pair<std::size_t, double>> initial_censored_data;
 		for (const coordinate& c : this->line.getPoints()) {
 			if (search_database->hasSample(c)) {
 
 				this->measured_coordinates.insert(c);
 				double v = search_database->getSampleMetricValue(c);
 
-				initial_data.emplace_back(this->line.getPointIndex(c), v);
+				if (this->censored_database != nullptr && this->censored_database->isSampleCensored(c)) {
+					initial_censored_data.emplace_back(this->line.getPointIndex(c), v);
+				}
+				else {
+					initial_data.emplace_back(this->line.getPointIndex(c), v);
+				}
 
 				if (this->lower_is_better) {
 					if (v < this->best_point_value) {
@@ -219,9 +271,9 @@ namespace dsice {
 				}
 			}
 		}
-		this->d_spline->update(initial_data);
+		this->updateDSpline(initial_data, initial_censored_data);
 
-		if (initial_data.empty()) {
+		if (initial_data.empty() && initial_censored_data.empty()) {
 			this->suggest_target = this->line.getPoints();
 		}
 		else {
@@ -231,7 +283,7 @@ namespace dsice {
 
 	OneDimDspSearcher::OneDimDspSearcher(const OneDimDspSearcher& original) :
 		line(original.line),
-		d_spline(original.d_spline)
+		d_spline(std::make_shared<ObservedDSpline>(*original.d_spline))
 	{
 		this->suggest_target = original.suggest_target;
 		this->lower_is_better = original.lower_is_better;
@@ -241,6 +293,14 @@ namespace dsice {
 		this->best_measured_point_coordinate = original.best_measured_point_coordinate;
 		this->best_point_value = original.best_point_value;
 		this->measured_coordinates = original.measured_coordinates;
+		this->censored_database = original.censored_database;
+		this->uncensored_num = original.uncensored_num;
+	}
+
+	OneDimDspSearcher::OneDimDspSearcher(const OneDimDspSearcher& original, std::shared_ptr<const DatabaseCore> search_database) :
+		OneDimDspSearcher(original)
+	{
+		this->censored_database = std::dynamic_pointer_cast<const DatabaseCensoredSampleExtension>(search_database);
 	}
 
 	OneDimDspSearcher::~OneDimDspSearcher(void) {
@@ -255,6 +315,21 @@ namespace dsice {
 		return std::shared_ptr<ObservedDSpline>(this->d_spline);
 	}
 
+	double OneDimDspSearcher::getFittedSlope(const coordinate& target_coordinate) const {
+
+		std::size_t points_num = this->line.getPointsNum();
+		if (points_num < 2) {
+			return 0;
+		}
+
+		std::size_t idx = this->line.getPointIndex(target_coordinate);
+		std::size_t lower_idx = idx > 0 ? idx - 1 : idx;
+		std::size_t upper_idx = idx + 1 < points_num ? idx + 1 : idx;
+
+		// 直線上の点は方向情報の向きに並んでいる
+		return (this->d_spline->getSampleValue(upper_idx) - this->d_spline->getSampleValue(lower_idx)) / static_cast<double>(upper_idx - lower_idx);
+	}
+
 	const coordinate& OneDimDspSearcher::getSuggested(void) const {
 		if (this->suggest_target.empty()) {
 			return this->best_judged_point_coordinate;
@@ -280,6 +355,7 @@ namespace dsice {
 		}
 
 		std::vector<std::pair<std::size_t, double>> delivered_data;
+		std::vector<std::pair<std::size_t, double>> delivered_censored_data;
 		for (std::size_t i = 0; i < this->measured_coordinate_buffer.size(); i++) {
 
 			const coordinate& measured_coordinate = this->measured_coordinate_buffer[i];
@@ -287,7 +363,12 @@ namespace dsice {
 
 			this->measured_coordinates.insert(measured_coordinate);
 
-			delivered_data.emplace_back(this->line.getPointIndex(measured_coordinate), metric_value);
+			if (this->censored_database != nullptr && this->censored_database->isSampleCensored(measured_coordinate)) {
+				delivered_censored_data.emplace_back(this->line.getPointIndex(measured_coordinate), metric_value);
+			}
+			else {
+				delivered_data.emplace_back(this->line.getPointIndex(measured_coordinate), metric_value);
+			}
 
 			if (this->lower_is_better) {
 				if (metric_value < this->best_point_value) {
@@ -305,7 +386,7 @@ namespace dsice {
 			}
 		}
 
-		this->d_spline->update(delivered_data);
+		this->updateDSpline(delivered_data, delivered_censored_data);
 		this->suggestBasedOnApproximation();
 
 		this->measured_coordinate_buffer.clear();
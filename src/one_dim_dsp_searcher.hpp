@@ -9,6 +9,7 @@
 #include "coordinate_line.hpp"
 #include "observed_d_spline.hpp"
 #include "dsice_database_core.hpp"
+#include "dsice_database_censored_sample_extension.hpp"
 #include "dsice_search_engine.hpp"
 
 namespace dsice {
@@ -62,9 +63,32 @@ namespace dsice {
 		/// </summary>
 		double best_point_value;
 		/// <summary>
+		/// 打ち切り標本の判定に使用するデータベース (打ち切り標本に対応しないデータベースの場合は nullptr)
+		/// </summary>
+		std::shared_ptr<const DatabaseCensoredSampleExtension> censored_database;
+		/// <summary>
+		/// d-Spline に登録した打ち切りでない標本の数
+		/// </summary>
+		std::size_t uncensored_num = 0;
+		/// <summary>
 		/// d-Spline 近似結果にしたがって探索対象をリストに追加する
 		/// </summary>
 		void suggestBasedOnApproximation(void);
+		/// <summary>
+		/// 打ち切り標本の値を補完する．<br/>
+		/// 打ち切り時点の限界値と現在の近似値のうち悪い方を用いる (近似に十分な標本がない場合は限界値)
+		/// </summary>
+		/// <param name="sample_index">d-Spline 上の標本インデックス</param>
+		/// <param name="bound">打ち切り時点の限界値</param>
+		/// <returns>補完した値</returns>
+		double imputeCensoredValue(std::size_t sample_index, double bound) const;
+		/// <summary>
+		/// 実測データを d-Spline に登録する．<br/>
+		/// 打ち切り標本は登録前の近似値で補完して登録する
+		/// </summary>
+		/// <param name="data">通常の標本 (インデックスと値)</param>
+		/// <param name="censored_data">打ち切り標本 (インデックスと限界値)</param>
+		void updateDSpline(const std::vector<std::pair<std::size_t, double>>& data, const std::vector<std::pair<std::size_t, double>>& censored_data);
 	public:
 		/// <summary>
 		/// 直線上の 1 点と方向を指定するコンストラクタ
@@ -98,6 +122,12 @@ namespace dsice {
 		/// <param name="original">コピー元</param>
 		OneDimDspSearcher(const OneDimDspSearcher& original);
 		/// <summary>
+		/// 参照するデータベースを差し替えるコピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		/// <param name="search_database">参照するデータベース (コピー元のデータベースを複製したもの)</param>
+		OneDimDspSearcher(const OneDimDspSearcher& original, std::shared_ptr<const DatabaseCore> search_database);
+		/// <summary>
 		/// デストラクタ
 		/// </summary>
 		~OneDimDspSearcher(void);
@@ -112,6 +142,13 @@ namespace dsice {
 		/// <returns>d-Spline</returns>
 		std::shared_ptr<const ObservedDSpline> getUsedDSpline(void) const;
 		/// <summary>
+		/// 近似曲線の指定点における傾き (直線の方向へ 1 点進むあたりの性能評価値の変化量) を取得．<br/>
+		/// 前後の点の近似値の中心差分で求め，直線の端では片側差分とする
+		/// </summary>
+		/// <param name="target_coordinate">直線上の座標</param>
+		/// <returns>近似曲線の傾き</returns>
+		double getFittedSlope(const coordinate& target_coordinate) const;
+		/// <summary>
 		/// 次に実測すべき性能パラメタ性能値 (座標) を取得
 		/// </summary>
 		/// <returns>次に実測すべき性能パラメタ性能値 (座標)</returns>
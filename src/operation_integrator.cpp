@@ -6,34 +6,63 @@
 #include <chrono>
 #include <algorithm>
 #include <iterator>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "dsice_search_space.hpp"
+#include "dsice_database_core.hpp"
+#include "dsice_database_surrogate_extension.hpp"
+#include "dsice_database_measure_duration_extension.hpp"
+#include "dsice_database_sample_statistics_extension.hpp"
 #include "dsice_operator_s_ippe.hpp"
 #include "dsice_operator_s_2017.hpp"
 #include "dsice_operator_s_2018.hpp"
 #include "dsice_operator_p_2024b.hpp"
+#include "dsice_operator_p_async.hpp"
+#include "dsice_operator_p_multi_start.hpp"
+#include "dsice_operator_p_full.hpp"
+#include "parallel_operator_options.hpp"
+#include "dsice_logging_database.hpp"
 #include "log_printer.hpp"
+#include "dsice_ticket.hpp"
+#include "dsice_thread_pool.hpp"
+#include "initial_design.hpp"
 #include "operation_integrator.hpp"
 
 // MEMO:
 //  新しい Operator は buildOperator() とコピーコンストラクタに登録
 //  並列用の場合は forSequentialMode() にも登録
-//  推奨アルゴリズムの場合は buildOperator() を編集
+//  推奨アルゴリズムの場合は resolveRecommendedMode() を編集
+//  初期探索の配置 (InitialDesign) に対応する場合は prepareFidelityScreening() にも登録
 //  C ラッパーにも入れる場合は dsice_c_wrapper.hpp (および dsice.h) 内の DSICE_EXECUTION_MODE 列挙体と dsice_c_wrapper.cpp 内の DSICE_SELECT_MODE() を編集
 
 namespace dsice {
 
 	template <typename T>
-	void OperationIntegrator<T>::buildOperator(void) {
-
-		if (this->target_parameters.empty()) {
-			throw std::runtime_error("Tuner needs one parameter at least.");
-		}
+	void OperationIntegrator<T>::resolveRecommendedMode(void) {
 
 		// 推奨モードでは設定内容に応じて適切な探索機構を自動選択
 		if (this->mode == ExecutionMode::RECOMMENDED) {
 			if (this->for_parallel) {
-				this->mode = ExecutionMode::P_2024B;
+
+				// 並列実測数に比べて探索空間が十分小さければ全探索の方が早く終わる
+				std::size_t full_search_limit = this->full_search_factor * this->worker_num;
+				std::size_t points_num = 1;
+				for (const std::vector<T>& one_parameter : this->target_parameters) {
+					if (points_num > full_search_limit) {
+						break;
+					}
+					points_num *= one_parameter.size();
+				}
+
+				if (points_num <= full_search_limit) {
+					this->mode = ExecutionMode::P_FULL;
+				}
+				else {
+					this->mode = ExecutionMode::P_2024B;
+				}
 			}
 			else if (this->target_parameters.size() == 1) {
 				this->mode = ExecutionMode::S_IPPE;
@@ -42,29 +71,317 @@ namespace dsice {
 				this->mode = ExecutionMode::S_2018;
 			}
 		}
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::buildOperator(void) {
+
+		if (this->target_parameters.empty()) {
+			throw std::runtime_error("Tuner needs one parameter at least.");
+		}
+
+		this->resolveRecommendedMode();
 
 		space_size space;
 		for (const std::vector<T>& one_parameter : this->target_parameters) {
 			space.push_back(one_parameter.size());
 		}
 
+		std::shared_ptr<ThreadPool> thread_pool = nullptr;
+		if (this->thread_pool_size > 0) {
+			thread_pool = std::make_shared<ThreadPool>(this->thread_pool_size);
+		}
+
+		// 初期配置の点数は並列実測数の倍数に揃え，各実測ラウンドが埋まるようにする
+		std::shared_ptr<const InitialDesign> initial_design = nullptr;
+		if (this->fidelity_scheduler != nullptr && this->fidelity_scheduler->isFinished()) {
+
+			// 多忠実度探索で生き残った設定値を最高忠実度で初期探索する
+			this->operator_initialize_way = OperatorInitializeWay::INITIAL_SEARCH;
+			initial_design = std::make_shared<InitialDesign>(this->fidelity_scheduler->getSurvivors());
+		}
+		else if (this->is_initial_design_set) {
+			initial_design = std::make_shared<InitialDesign>(this->initial_design_type, this->initial_design_point_num, this->initial_design_seed, this->for_parallel ? this->worker_num : 1);
+		}
+
+		// 並列探索用の探索機構に渡す構築時設定 (探索機構ごとに必要な項目のみ参照される)
+		ParallelOperatorOptions parallel_options;
+		parallel_options.lower_is_better = this->lower_is_better;
+		parallel_options.logging_on = this->is_logging_mode_on;
+		parallel_options.initialize_way = this->operator_initialize_way;
+		parallel_options.alpha = this->dsp_alpha;
+		parallel_options.metric_type = this->database_metric_type;
+		parallel_options.initial_coordinate = this->initial_coordinate;
+		parallel_options.significance_test_repetitions = this->significance_test_repetitions;
+		parallel_options.significance_level = this->significance_level;
+		parallel_options.precomputation_on = this->is_precomputation_on;
+		parallel_options.worker_num = this->worker_num;
+		parallel_options.thread_pool = thread_pool;
+		parallel_options.sampled_max_changed_axis_num = this->sampled_max_changed_axis_num;
+		parallel_options.sampled_direction_budget = this->sampled_direction_budget;
+		parallel_options.screening_threshold = this->screening_threshold;
+		parallel_options.gradient_step_on = this->is_gradient_step_on;
+		parallel_options.surrogate_skip_confidence = this->surrogate_skip_confidence;
+		parallel_options.start_num = this->multi_start_num;
+		parallel_options.initial_design = initial_design;
+
 		// 新しい Operator はここに登録
 		switch (this->mode) {
 		case ExecutionMode::S_IPPE:
-			this->search_operator = std::make_shared<Operator_S_IPPE>(space, this->lower_is_better, this->is_logging_mode_on, this->dsp_alpha, this->database_metric_type);
+			this->search_operator = std::make_shared<Operator_S_IPPE>(space, this->lower_is_better, this->is_logging_mode_on, this->dsp_alpha, this->database_metric_type, this->worker_num);
 			break;
 		case ExecutionMode::S_2017:
-			this->search_operator = std::make_shared<Operator_S_2017>(space, this->lower_is_better, this->is_logging_mode_on, this->dsp_alpha, this->database_metric_type);
+			this->search_operator = std::make_shared<Operator_S_2017>(space, this->lower_is_better, this->is_logging_mode_on, this->dsp_alpha, this->database_metric_type, thread_pool);
 			break;
 		case ExecutionMode::S_2018:
-			this->search_operator = std::make_shared<Operator_S_2018>(space, this->lower_is_better, this->is_logging_mode_on, this->operator_initialize_way, this->dsp_alpha, this->database_metric_type, this->initial_coordinate);
+			this->search_operator = std::make_shared<Operator_S_2018>(space, this->lower_is_better, this->is_logging_mode_on, this->operator_initialize_way, this->dsp_alpha, this->database_metric_type, this->initial_coordinate, this->significance_test_repetitions, this->significance_level, thread_pool, initial_design);
 			break;
 		case ExecutionMode::P_2024B:
-			this->search_operator = std::make_shared<Operator_P_2024B>(space, this->lower_is_better, this->is_logging_mode_on, this->operator_initialize_way, this->dsp_alpha, this->database_metric_type, this->initial_coordinate);
+			this->search_operator = std::make_shared<Operator_P_2024B>(space, parallel_options);
+			break;
+		case ExecutionMode::P_ASYNC:
+			this->search_operator = std::make_shared<Operator_P_Async>(space, parallel_options);
+			break;
+		case ExecutionMode::P_MULTI_START:
+			this->search_operator = std::make_shared<Operator_P_MultiStart>(space, parallel_options);
+			break;
+		case ExecutionMode::P_FULL:
+			this->search_operator = std::make_shared<Operator_P_Full>(space, this->lower_is_better, this->is_logging_mode_on, this->dsp_alpha, this->database_metric_type, this->full_search_pruning_margin);
 			break;
 		default:
 			throw std::runtime_error("Failed to build the Search Operator : the specified mode is not found.\n");
 		}
+
+		if (this->is_logging_mode_on && this->max_in_memory_log_num > 0) {
+			if (std::shared_ptr<LoggingDatabase> ld = std::dynamic_pointer_cast<LoggingDatabase>(this->search_operator->getDatabase())) {
+				ld->setLogSpill(this->max_in_memory_log_num, this->log_spill_file_path);
+			}
+		}
+
+		if (this->surrogate_pair_num > 0) {
+			if (std::shared_ptr<DatabaseSurrogateExtension> sd = std::dynamic_pointer_cast<DatabaseSurrogateExtension>(this->search_operator->getDatabase())) {
+				sd->setSurrogatePairNum(this->surrogate_pair_num);
+			}
+		}
+	}
+
+	template <typename T>
+	bool OperationIntegrator<T>::prepareFidelityScreening(void) {
+
+		if (this->search_operator != nullptr) {
+			return false;
+		}
+
+		if (this->fidelity_scheduler == nullptr) {
+
+			if (this->fidelities.size() < 2 || this->target_parameters.empty()) {
+				this->buildOperator();
+				return false;
+			}
+
+			// 生き残った設定値を初期探索の配置として受け取れる探索アルゴリズムのみ対応
+			this->resolveRecommendedMode();
+			switch (this->mode) {
+			case ExecutionMode::S_2018:
+			case ExecutionMode::P_2024B:
+			case ExecutionMode::P_ASYNC:
+			case ExecutionMode::P_MULTI_START:
+				break;
+			default:
+				this->buildOperator();
+				return false;
+			}
+
+			space_size space;
+			std::size_t max_axis_length = 0;
+			for (const std::vector<T>& one_parameter : this->target_parameters) {
+				space.push_back(one_parameter.size());
+				max_axis_length = std::max(max_axis_length, one_parameter.size());
+			}
+
+			std::size_t slice_size = this->for_parallel ? std::max<std::size_t>(this->worker_num, 1) : 1;
+			std::size_t initial_num = this->fidelity_initial_num;
+			if (initial_num == 0) {
+
+				// 最高忠実度で少なくとも最も長い性能パラメタの値の数 (並列実測数) だけ残るようにする
+				initial_num = std::max(max_axis_length, slice_size);
+				for (std::size_t r = 1; r < this->fidelities.size(); r++) {
+					initial_num *= this->fidelity_eta;
+				}
+			}
+
+			std::shared_ptr<ThreadPool> thread_pool = nullptr;
+			if (this->thread_pool_size > 0) {
+				thread_pool = std::make_shared<ThreadPool>(this->thread_pool_size);
+			}
+
+			InitialDesignType design_type = this->is_initial_design_set ? this->initial_design_type : InitialDesignType::MaximinLhd;
+			InitialDesign first_rung_design(design_type, initial_num, this->initial_design_seed, slice_size);
+			this->fidelity_scheduler = std::make_shared<SuccessiveHalvingScheduler>(space, this->fidelities, this->fidelity_eta, first_rung_design, this->lower_is_better, thread_pool);
+		}
+
+		this->fidelity_scheduler->updateState();
+		if (!this->fidelity_scheduler->isFinished()) {
+			return true;
+		}
+
+		this->buildOperator();
+		return false;
+	}
+
+	template <typename T>
+	bool OperationIntegrator<T>::inFidelityScreening(void) const {
+		return this->search_operator == nullptr && this->fidelity_scheduler != nullptr && !this->fidelity_scheduler->isFinished();
+	}
+
+	template <typename T>
+	coordinate OperationIntegrator<T>::getCurrentCoordinate(void) const {
+
+		if (!this->remeasure_coordinates.empty()) {
+			return this->remeasure_coordinates.front();
+		}
+
+		if (this->inFidelityScreening()) {
+			return this->fidelity_scheduler->getSuggested();
+		}
+
+		return this->search_operator->getSuggested();
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::registerMetricValue(const coordinate& measured_coordinate, double metric_value) {
+
+		// 低忠実度の実測値は探索機構のデータベースには入れない
+		if (this->inFidelityScreening()) {
+			this->fidelity_scheduler->setMetricValue(measured_coordinate, metric_value);
+			return;
+		}
+
+		if (this->max_measurement_num <= 1) {
+			this->search_operator->setMetricValue(measured_coordinate, metric_value);
+			return;
+		}
+
+		// 再計測の結果は 1 回ずつデータベースの性能評価値の型で集計し，探索機構には再計測を終えた時点の集計値を 1 度だけ渡す
+		this->search_operator->recordMetricValue(measured_coordinate, metric_value);
+
+		coordinate_list::iterator remeasure_target = std::find(this->remeasure_coordinates.begin(), this->remeasure_coordinates.end(), measured_coordinate);
+
+		if (this->needsRemeasurement(measured_coordinate)) {
+			if (remeasure_target == this->remeasure_coordinates.end()) {
+				this->remeasure_coordinates.push_back(measured_coordinate);
+			}
+			return;
+		}
+
+		if (remeasure_target != this->remeasure_coordinates.end()) {
+
+			this->remeasure_coordinates.erase(remeasure_target);
+
+			// 再計測を終えた点の分散は，計測 1 回のみの点の信頼区間の推定に用いる
+			if (std::shared_ptr<const DatabaseSampleStatisticsExtension> statistics_database = std::dynamic_pointer_cast<const DatabaseSampleStatisticsExtension>(this->search_operator->getDatabase())) {
+				double variance = statistics_database->getSampleVariance(measured_coordinate);
+				if (!std::isnan(variance)) {
+					this->pooled_variance_sum += variance;
+					this->pooled_variance_count++;
+				}
+			}
+		}
+
+		this->search_operator->commitMetricValue(measured_coordinate);
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::registerCensoredMetricValue(const coordinate& measured_coordinate, double bound) {
+
+		// 打ち切った設定値は限界値で順位付けする
+		if (this->inFidelityScreening()) {
+			this->fidelity_scheduler->setMetricValue(measured_coordinate, bound);
+			return;
+		}
+
+		coordinate_list::iterator erase_target = std::find(this->remeasure_coordinates.begin(), this->remeasure_coordinates.end(), measured_coordinate);
+		if (erase_target != this->remeasure_coordinates.end()) {
+			this->remeasure_coordinates.erase(erase_target);
+		}
+
+		this->search_operator->setCensoredMetricValue(measured_coordinate, bound);
+	}
+
+	template <typename T>
+	double OperationIntegrator<T>::calculateDeadline(void) {
+
+		// 高い値ほど良い場合は「値が悪い = 途中で判明する」とならないため打ち切らない
+		if (this->deadline_factor == 0 || !this->lower_is_better || this->search_operator == nullptr) {
+			return std::numeric_limits<double>::infinity();
+		}
+
+		const coordinate& best_coordinate = this->search_operator->getBestMeasuredCoordinate();
+		std::shared_ptr<DatabaseCore> database = this->search_operator->getDatabase();
+		if (best_coordinate.empty() || !database->hasSample(best_coordinate)) {
+			return std::numeric_limits<double>::infinity();
+		}
+
+		return this->deadline_factor * database->getSampleMetricValue(best_coordinate);
+	}
+
+	template <typename T>
+	bool OperationIntegrator<T>::needsRemeasurement(const coordinate& measured_coordinate) const {
+
+		std::shared_ptr<DatabaseCore> database = this->search_operator->getDatabase();
+
+		// 登録回数を得られないデータベースでは再計測しない
+		std::shared_ptr<const DatabaseSampleStatisticsExtension> statistics_database = std::dynamic_pointer_cast<const DatabaseSampleStatisticsExtension>(database);
+		if (statistics_database == nullptr) {
+			return false;
+		}
+
+		std::size_t recorded_num = statistics_database->getSampleRecordedCount(measured_coordinate);
+		if (recorded_num >= this->max_measurement_num) {
+			return false;
+		}
+
+		// 基準点は以降の比較の基準となるため，最大回数まで計測
+		const coordinate& base_coordinate = this->search_operator->getBaseCoordinate();
+		if (measured_coordinate == base_coordinate) {
+			return true;
+		}
+
+		// 比較対象は基準点とそれまでの最良点 (比較対象が無ければ再計測の必要なし)
+		std::vector<double> compared_values;
+		for (const coordinate* compared_coordinate : { &base_coordinate, &this->best_measured_coordinate }) {
+			if (!compared_coordinate->empty() && *compared_coordinate != measured_coordinate && database->hasSample(*compared_coordinate)) {
+				compared_values.push_back(database->getSampleMetricValue(*compared_coordinate));
+			}
+		}
+		if (compared_values.empty()) {
+			return false;
+		}
+
+		// 分散が未知の場合 (計測 1 回の点や，分散を保持しない性能評価値の型) は過去の再計測結果から誤差を見積もる
+		double variance = statistics_database->getSampleVariance(measured_coordinate);
+		if (std::isnan(variance)) {
+			if (this->pooled_variance_count > 0) {
+				variance = this->pooled_variance_sum / this->pooled_variance_count;
+			}
+			else {
+				// 分散を保持する型では，もう 1 回計測すれば分散を見積もれる (保持しない型では何回計測しても見積もれないため再計測しない)
+				switch (this->database_metric_type) {
+				case DatabaseMetricType::AverageDouble:
+				case DatabaseMetricType::MedianDouble:
+				case DatabaseMetricType::TrimmedAverageDouble:
+					return recorded_num < 2;
+				default:
+					return false;
+				}
+			}
+		}
+
+		double half_width = this->remeasure_z_value * std::sqrt(variance / recorded_num);
+		double measured_value = database->getSampleMetricValue(measured_coordinate);
+
+		// 信頼区間がいずれかの比較対象の値と重なる場合のみ再計測 (明らかに優劣がつく点は再計測しない)
+		return std::any_of(compared_values.begin(), compared_values.end(), [measured_value, half_width](double v) { return std::abs(measured_value - v) <= half_width; });
 	}
 
 	template <typename T>
@@ -73,12 +390,200 @@ namespace dsice {
 		// 並列アルゴリズムはここにも登録
 		switch (this->mode) {
 		case ExecutionMode::P_2024B:
+		case ExecutionMode::P_ASYNC:
+		case ExecutionMode::P_MULTI_START:
+		case ExecutionMode::P_FULL:
 			return false;
 		default:
 			return true;
 		}
 	}
 
+	template <typename T>
+	coordinate OperationIntegrator<T>::selectTicketCoordinate(void) {
+
+		// 再計測中の点があれば優先
+		for (const coordinate& c : this->remeasure_coordinates) {
+			if (!this->in_flight_counts.contains(c)) {
+				return c;
+			}
+		}
+
+		// 実測中の点を除いて 1 点余るだけの候補を要求し，実測中でない候補の先頭を割り当てる
+		std::unordered_set<coordinate> in_flight_coordinates;
+		for (const std::pair<const coordinate, std::size_t>& f : this->in_flight_counts) {
+			in_flight_coordinates.insert(f.first);
+		}
+
+		coordinate_list candidates = this->search_operator->getSuggestedList(1, in_flight_coordinates);
+		if (candidates.empty() && !in_flight_coordinates.empty()) {
+			candidates = this->search_operator->getSuggestedList(1, std::unordered_set<coordinate>());
+		}
+
+		for (const coordinate& c : candidates) {
+			if (!this->in_flight_counts.contains(c)) {
+				return c;
+			}
+		}
+
+		// 候補がすべて実測中の場合は最優先点を重複して実測する
+		if (!candidates.empty()) {
+			return candidates.front();
+		}
+		else if (!this->remeasure_coordinates.empty()) {
+			return this->remeasure_coordinates.front();
+		}
+		else {
+			return this->search_operator->getSuggested();
+		}
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::recordMeasureDuration(const coordinate& measured_coordinate, double duration_sec) {
+
+		if (this->search_operator == nullptr || this->inFidelityScreening()) {
+			return;
+		}
+
+		if (std::shared_ptr<DatabaseMeasureDurationExtension> d = std::dynamic_pointer_cast<DatabaseMeasureDurationExtension>(this->search_operator->getDatabase())) {
+			d->setSampleMeasureDuration(measured_coordinate, duration_sec);
+		}
+	}
+
+	template <typename T>
+	std::shared_ptr<DatabaseMeasureDurationExtension> OperationIntegrator<T>::getDurationModel(void) const {
+
+		// 逐次アルゴリズムは提示順に値を受け付けるため並べ替えない
+		if (this->cost_aware_window <= 1 || this->search_operator == nullptr || this->forSequentialMode()) {
+			return nullptr;
+		}
+
+		std::shared_ptr<DatabaseMeasureDurationExtension> d = std::dynamic_pointer_cast<DatabaseMeasureDurationExtension>(this->search_operator->getDatabase());
+
+		// 各性能パラメタの効果を推定できるだけの実測時間が揃うまでは並べ替えない
+		if (d == nullptr || d->getMeasureDurationSamplesNum() <= this->target_parameters.size()) {
+			return nullptr;
+		}
+
+		return d;
+	}
+
+	template <typename T>
+	coordinate_list OperationIntegrator<T>::orderByMeasureDuration(const coordinate_list& candidates, const DatabaseMeasureDurationExtension& duration_model) const {
+
+		// 実測時間を許容差の幅で対数的に区切り，同じ区間内では元の優先度順を保つ
+		double bucket_width = std::log1p(OperationIntegrator<T>::DURATION_TOLERANCE);
+		std::vector<std::pair<std::size_t, double>> keys;
+		for (std::size_t i = 0; i < candidates.size(); i++) {
+			double duration = std::max(duration_model.predictMeasureDuration(candidates[i]), DatabaseMeasureDurationExtension::MIN_MODELED_DURATION_SEC);
+			keys.emplace_back(i / this->cost_aware_window, std::floor(std::log(duration) / bucket_width));
+		}
+
+		std::vector<std::size_t> order(candidates.size());
+		for (std::size_t i = 0; i < order.size(); i++) {
+			order[i] = i;
+		}
+		std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) { return keys[a] < keys[b]; });
+
+		coordinate_list ordered;
+		ordered.reserve(candidates.size());
+		for (std::size_t i : order) {
+			ordered.push_back(candidates[i]);
+		}
+
+		return ordered;
+	}
+
+	template <typename T>
+	coordinate_list OperationIntegrator<T>::packByMeasureDuration(const coordinate_list& candidates, std::size_t suggested_num, const DatabaseMeasureDurationExtension& duration_model) const {
+
+		if (candidates.size() <= suggested_num || suggested_num == 0) {
+			return candidates;
+		}
+
+		// 最優先の候補との実測時間の比が許容差を超える分を不利とし，許容差内の候補は優先度順に選ぶ
+		double anchor_log_duration = std::log(std::max(duration_model.predictMeasureDuration(candidates.front()), DatabaseMeasureDurationExtension::MIN_MODELED_DURATION_SEC));
+		double tolerance = std::log1p(OperationIntegrator<T>::DURATION_TOLERANCE);
+		std::vector<std::pair<double, std::size_t>> excesses;
+		for (std::size_t i = 1; i < candidates.size(); i++) {
+			double log_duration = std::log(std::max(duration_model.predictMeasureDuration(candidates[i]), DatabaseMeasureDurationExtension::MIN_MODELED_DURATION_SEC));
+			excesses.emplace_back(std::max(0.0, std::abs(log_duration - anchor_log_duration) - tolerance), i);
+		}
+		std::stable_sort(excesses.begin(), excesses.end(), [](const std::pair<double, std::size_t>& a, const std::pair<double, std::size_t>& b) { return a.first < b.first; });
+
+		std::vector<std::size_t> picked = { 0 };
+		for (std::size_t i = 0; i + 1 < suggested_num; i++) {
+			picked.push_back(excesses[i].second);
+		}
+		std::sort(picked.begin(), picked.end());
+
+		coordinate_list packed;
+		packed.reserve(picked.size());
+		for (std::size_t i : picked) {
+			packed.push_back(candidates[i]);
+		}
+
+		return packed;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::startSearchClock(void) {
+
+		if (!this->is_search_started) {
+			this->search_start_point = std::chrono::system_clock::now();
+			this->is_search_started = true;
+		}
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::countMeasurement(const coordinate& measured_coordinate, bool is_comparable) {
+
+		this->measured_num++;
+
+		if (this->search_operator == nullptr) {
+			this->best_value_history.push_back(std::numeric_limits<double>::quiet_NaN());
+			return;
+		}
+
+		// 再計測で平均値が変わりうるため，比較のたびにデータベースから読み直す
+		std::shared_ptr<DatabaseCore> database = this->search_operator->getDatabase();
+		if (is_comparable && database->hasSample(measured_coordinate)) {
+			if (this->best_measured_coordinate.empty() || !database->hasSample(this->best_measured_coordinate)) {
+				this->best_measured_coordinate = measured_coordinate;
+			}
+			else {
+				double measured_value = database->getSampleMetricValue(measured_coordinate);
+				double best_value = database->getSampleMetricValue(this->best_measured_coordinate);
+				if (this->lower_is_better ? measured_value < best_value : measured_value > best_value) {
+					this->best_measured_coordinate = measured_coordinate;
+				}
+			}
+		}
+
+		if (!this->best_measured_coordinate.empty() && database->hasSample(this->best_measured_coordinate)) {
+			this->best_value_history.push_back(database->getSampleMetricValue(this->best_measured_coordinate));
+		}
+		else {
+			this->best_value_history.push_back(std::numeric_limits<double>::quiet_NaN());
+		}
+
+		this->search_operator->setRemainingBudget(this->getRemainingMeasurementNum());
+	}
+
+	template <typename T>
+	bool OperationIntegrator<T>::isBudgetExhausted(void) const {
+
+		if (this->budget_measurement_num > 0 && this->measured_num + this->issued_tickets.size() >= this->budget_measurement_num) {
+			return true;
+		}
+
+		if (this->budget_time_sec > 0 && this->getElapsedTime() >= this->budget_time_sec) {
+			return true;
+		}
+
+		return false;
+	}
+
 	template <typename T>
 	OperationIntegrator<T>::OperationIntegrator(void) {
 		// DO_NOTHING
@@ -101,6 +606,7 @@ namespace dsice {
 
 		this->target_parameters = original.target_parameters;
 		this->suggest_parameters = original.suggest_parameters;
+		this->suggested_coordinates = original.suggested_coordinates;
 		this->mode = original.mode;
 		this->timer_start_point = original.timer_start_point;
 		this->lower_is_better = original.lower_is_better;
@@ -109,6 +615,52 @@ namespace dsice {
 		this->for_parallel = original.for_parallel;
 		this->dsp_alpha = original.dsp_alpha;
 		this->database_metric_type = original.database_metric_type;
+		this->max_measurement_num = original.max_measurement_num;
+		this->remeasure_z_value = original.remeasure_z_value;
+		this->remeasure_coordinates = original.remeasure_coordinates;
+		this->pooled_variance_sum = original.pooled_variance_sum;
+		this->pooled_variance_count = original.pooled_variance_count;
+		this->significance_test_repetitions = original.significance_test_repetitions;
+		this->significance_level = original.significance_level;
+		this->max_in_memory_log_num = original.max_in_memory_log_num;
+		this->log_spill_file_path = original.log_spill_file_path;
+		this->is_precomputation_on = original.is_precomputation_on;
+		this->deadline_factor = original.deadline_factor;
+		this->multi_start_num = original.multi_start_num;
+		this->worker_num = original.worker_num;
+		this->full_search_factor = original.full_search_factor;
+		this->full_search_pruning_margin = original.full_search_pruning_margin;
+		this->thread_pool_size = original.thread_pool_size;
+		this->sampled_max_changed_axis_num = original.sampled_max_changed_axis_num;
+		this->sampled_direction_budget = original.sampled_direction_budget;
+		this->screening_threshold = original.screening_threshold;
+		this->is_gradient_step_on = original.is_gradient_step_on;
+		this->surrogate_pair_num = original.surrogate_pair_num;
+		this->surrogate_skip_confidence = original.surrogate_skip_confidence;
+		this->is_initial_design_set = original.is_initial_design_set;
+		this->initial_design_type = original.initial_design_type;
+		this->initial_design_point_num = original.initial_design_point_num;
+		this->initial_design_seed = original.initial_design_seed;
+		this->fidelities = original.fidelities;
+		this->fidelity_eta = original.fidelity_eta;
+		this->fidelity_initial_num = original.fidelity_initial_num;
+		if (original.fidelity_scheduler != nullptr) {
+			this->fidelity_scheduler = std::make_shared<SuccessiveHalvingScheduler>(*original.fidelity_scheduler);
+		}
+		this->screening_ticket_rungs = original.screening_ticket_rungs;
+		this->cost_aware_window = original.cost_aware_window;
+		this->is_timer_running = original.is_timer_running;
+		this->budget_measurement_num = original.budget_measurement_num;
+		this->budget_time_sec = original.budget_time_sec;
+		this->measured_num = original.measured_num;
+		this->is_search_started = original.is_search_started;
+		this->search_start_point = original.search_start_point;
+		this->best_measured_coordinate = original.best_measured_coordinate;
+		this->best_value_history = original.best_value_history;
+		this->ticket_issue_times = original.ticket_issue_times;
+		this->next_ticket_id = original.next_ticket_id;
+		this->issued_tickets = original.issued_tickets;
+		this->in_flight_counts = original.in_flight_counts;
 
 		if (original.search_operator == nullptr) {
 			this->search_operator = nullptr;
@@ -136,6 +688,21 @@ namespace dsice {
 					this->search_operator = std::make_shared<Operator_P_2024B>(*s);
 				}
 				break;
+			case ExecutionMode::P_ASYNC:
+				if (std::shared_ptr<Operator_P_Async> s = std::dynamic_pointer_cast<Operator_P_Async>(original.search_operator)) {
+					this->search_operator = std::make_shared<Operator_P_Async>(*s);
+				}
+				break;
+			case ExecutionMode::P_MULTI_START:
+				if (std::shared_ptr<Operator_P_MultiStart> s = std::dynamic_pointer_cast<Operator_P_MultiStart>(original.search_operator)) {
+					this->search_operator = std::make_shared<Operator_P_MultiStart>(*s);
+				}
+				break;
+			case ExecutionMode::P_FULL:
+				if (std::shared_ptr<Operator_P_Full> s = std::dynamic_pointer_cast<Operator_P_Full>(original.search_operator)) {
+					this->search_operator = std::make_shared<Operator_P_Full>(*s);
+				}
+				break;
 			default:
 				throw std::runtime_error("Failed to copy Tuner instance : the specified mode is not found.\n");
 			}
@@ -290,36 +857,332 @@ namespace dsice {
 	}
 
 	template <typename T>
-	const std::vector<T>& OperationIntegrator<T>::getSuggestedNext(void) {
+	void OperationIntegrator<T>::config_setAdaptiveRemeasurement(std::size_t max_measurement_num, double z_value) {
 
-		if (this->search_operator == nullptr) {
-			this->buildOperator();
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
 		}
 
-		this->suggest_parameters.clear();
-
-		const coordinate& next_coordinate = this->search_operator->getSuggested();
-		this->suggest_parameters.emplace_back();
-		for (std::size_t i = 0; i < next_coordinate.size(); i++) {
-			this->suggest_parameters.back().push_back(this->target_parameters[i][next_coordinate[i]]);
+		if (z_value <= 0) {
+			throw std::invalid_argument("z_value must be greater than zero.");
 		}
 
-		this->timer_start_point = std::chrono::system_clock::now();
-
-		return this->suggest_parameters.back();
+		this->max_measurement_num = max_measurement_num;
+		this->remeasure_z_value = z_value;
 	}
 
 	template <typename T>
-	const std::vector<std::vector<T>>& OperationIntegrator<T>::getSuggestedList(void) {
+	void OperationIntegrator<T>::config_setSignificanceTest(std::size_t max_repetitions, double significance_level) {
 
-		if (this->search_operator == nullptr) {
-			this->buildOperator();
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		// 分散を求めるには 2 回以上の実測が必要
+		if (max_repetitions == 1) {
+			throw std::invalid_argument("max_repetitions must be 0 (disabled) or greater than one.");
+		}
+
+		if (significance_level <= 0 || significance_level >= 1) {
+			throw std::invalid_argument("significance_level must be between 0 and 1.");
+		}
+
+		this->significance_test_repetitions = max_repetitions;
+		this->significance_level = significance_level;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setLogMemoryLimit(std::size_t max_in_memory_base_point_num, const std::string& spill_file_path) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		if (max_in_memory_base_point_num > 0 && spill_file_path.empty()) {
+			throw std::invalid_argument("spill_file_path must not be empty.");
+		}
+
+		this->max_in_memory_log_num = max_in_memory_base_point_num;
+		this->log_spill_file_path = spill_file_path;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setPrecomputation(bool precomputation_on) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		this->is_precomputation_on = precomputation_on;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setDeadlineFactor(double deadline_factor) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		if (deadline_factor != 0 && !(deadline_factor > 1)) {
+			throw std::invalid_argument("deadline_factor must be 0 or greater than 1.");
+		}
+
+		this->deadline_factor = deadline_factor;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setMultiStartNum(std::size_t start_num) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		if (start_num == 0) {
+			throw std::invalid_argument("start_num must be greater than 0.");
+		}
+
+		this->multi_start_num = start_num;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setWorkerNum(std::size_t worker_num) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		this->worker_num = worker_num;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setFullSearchFactor(std::size_t factor) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		this->full_search_factor = factor;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setFullSearchPruning(double margin) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		if (margin < 0) {
+			throw std::invalid_argument("margin must not be negative.");
+		}
+
+		this->full_search_pruning_margin = margin;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setThreadPoolSize(std::size_t thread_num) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		this->thread_pool_size = thread_num;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setDirectionSampling(std::size_t max_changed_axis_num, std::size_t direction_budget) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		if (max_changed_axis_num > 0 && direction_budget == 0) {
+			throw std::invalid_argument("direction_budget must be greater than zero.");
+		}
+
+		this->sampled_max_changed_axis_num = max_changed_axis_num;
+		this->sampled_direction_budget = direction_budget;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setParameterScreening(double threshold) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		if (threshold < 0 || threshold >= 1) {
+			throw std::invalid_argument("threshold must be in [0, 1).");
+		}
+
+		this->screening_threshold = threshold;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setGradientStep(bool gradient_step_on) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		this->is_gradient_step_on = gradient_step_on;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setSurrogate(std::size_t max_pair_num, double skip_confidence) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		if (skip_confidence < 0) {
+			throw std::invalid_argument("skip_confidence must not be negative.");
+		}
+
+		this->surrogate_pair_num = max_pair_num;
+		this->surrogate_skip_confidence = skip_confidence;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setInitialDesign(InitialDesignType design_type, std::size_t point_num, std::uint64_t seed) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		this->operator_initialize_way = OperatorInitializeWay::INITIAL_SEARCH;
+		this->is_initial_design_set = true;
+		this->initial_design_type = design_type;
+		this->initial_design_point_num = point_num;
+		this->initial_design_seed = seed;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setMultiFidelity(const std::vector<double>& fidelities, std::size_t eta, std::size_t initial_num) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr || this->fidelity_scheduler != nullptr) {
+			return;
+		}
+
+		if (fidelities.size() < 2) {
+			throw std::invalid_argument("need two fidelities at least.");
+		}
+		for (std::size_t i = 1; i < fidelities.size(); i++) {
+			if (fidelities[i] <= fidelities[i - 1]) {
+				throw std::invalid_argument("fidelities must be in ascending order.");
+			}
+		}
+		if (eta < 2) {
+			throw std::invalid_argument("eta must be 2 or more.");
+		}
+
+		this->fidelities = fidelities;
+		this->fidelity_eta = eta;
+		this->fidelity_initial_num = initial_num;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setCostAwareOrdering(std::size_t window) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		if (window == 0) {
+			throw std::invalid_argument("window must be 1 or more.");
+		}
+
+		this->cost_aware_window = window;
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::config_setBudget(std::size_t max_measurement_num, double max_time_sec) {
+
+		// すでに探索が開始している場合は何もしない
+		if (this->search_operator != nullptr) {
+			return;
+		}
+
+		if (!(max_time_sec >= 0)) {
+			throw std::invalid_argument("max_time_sec must be 0 or more.");
 		}
 
+		this->budget_measurement_num = max_measurement_num;
+		this->budget_time_sec = max_time_sec;
+	}
+
+	template <typename T>
+	const std::vector<T>& OperationIntegrator<T>::getSuggestedNext(void) {
+
+		this->startSearchClock();
+		this->prepareFidelityScreening();
+
 		this->suggest_parameters.clear();
 
-		const coordinate_list& suggested_coordinates = this->search_operator->getSuggestedList();
-		for (const coordinate& one_coordinate : suggested_coordinates) {
+		// 再計測中の点があれば優先
+		coordinate next_coordinate = this->getCurrentCoordinate();
+		this->suggest_parameters.emplace_back();
+		for (std::size_t i = 0; i < next_coordinate.size(); i++) {
+			this->suggest_parameters.back().push_back(this->target_parameters[i][next_coordinate[i]]);
+		}
+
+		this->timer_start_point = std::chrono::system_clock::now();
+		this->is_timer_running = true;
+
+		return this->suggest_parameters.back();
+	}
+
+	template <typename T>
+	const std::vector<std::vector<T>>& OperationIntegrator<T>::getSuggestedList(void) {
+
+		this->startSearchClock();
+		this->suggest_parameters.clear();
+
+		// 再計測中の点があれば，それらの計測を終えるまで Operator の候補は返さない
+		if (this->prepareFidelityScreening()) {
+			this->suggested_coordinates = this->fidelity_scheduler->getSuggestedList();
+		}
+		else if (!this->remeasure_coordinates.empty()) {
+			this->suggested_coordinates = this->remeasure_coordinates;
+		}
+		else {
+			this->suggested_coordinates = this->search_operator->getSuggestedList();
+
+			// チケットで実測中の点は重ねて実測しない
+			std::erase_if(this->suggested_coordinates, [this](const coordinate& c) { return this->in_flight_counts.contains(c); });
+
+			// 同程度に有望な候補の中では短く済むものを先に提示
+			if (std::shared_ptr<DatabaseMeasureDurationExtension> duration_model = this->getDurationModel()) {
+				this->suggested_coordinates = this->orderByMeasureDuration(this->suggested_coordinates, *duration_model);
+			}
+		}
+
+		// 予算を超えて実測しないよう，残りの実測数までに切り詰める
+		if (this->budget_measurement_num > 0) {
+			std::size_t consumed_num = this->measured_num + this->issued_tickets.size();
+			std::size_t remaining_num = consumed_num < this->budget_measurement_num ? this->budget_measurement_num - consumed_num : 0;
+			if (this->suggested_coordinates.size() > remaining_num) {
+				this->suggested_coordinates.resize(remaining_num);
+			}
+		}
+
+		for (const coordinate& one_coordinate : this->suggested_coordinates) {
 			this->suggest_parameters.emplace_back();
 			for (std::size_t i = 0; i < one_coordinate.size(); i++) {
 				this->suggest_parameters.back().push_back(this->target_parameters[i][one_coordinate[i]]);
@@ -329,9 +1192,97 @@ namespace dsice {
 		return this->suggest_parameters;
 	}
 
+	template <typename T>
+	const std::vector<std::vector<T>>& OperationIntegrator<T>::getSuggestedList(std::size_t suggested_num) {
+
+		this->startSearchClock();
+
+		// 予算を超えて実測しないよう，残りの実測数までに切り詰める
+		if (this->budget_measurement_num > 0) {
+			std::size_t consumed_num = this->measured_num + this->issued_tickets.size();
+			suggested_num = std::min(suggested_num, consumed_num < this->budget_measurement_num ? this->budget_measurement_num - consumed_num : 0);
+		}
+
+		bool in_screening = this->prepareFidelityScreening();
+
+		this->suggest_parameters.clear();
+
+		// 再計測中の点があれば，それらの計測を終えるまで Operator の候補は返さない
+		if (in_screening) {
+			this->suggested_coordinates = this->fidelity_scheduler->getSuggestedList();
+		}
+		else if (!this->remeasure_coordinates.empty()) {
+			this->suggested_coordinates = this->remeasure_coordinates;
+		}
+		else {
+
+			std::unordered_set<coordinate> in_flight_coordinates;
+			for (const std::pair<const coordinate, std::size_t>& f : this->in_flight_counts) {
+				in_flight_coordinates.insert(f.first);
+			}
+
+			// チケットで実測中の点は重ねて実測しない
+			std::shared_ptr<DatabaseMeasureDurationExtension> duration_model = this->getDurationModel();
+			coordinate_list candidates;
+			if (duration_model != nullptr) {
+				candidates = this->search_operator->getSuggestedList();
+				std::erase_if(candidates, [&in_flight_coordinates](const coordinate& c) { return in_flight_coordinates.contains(c); });
+			}
+
+			if (candidates.size() > suggested_num) {
+
+				// 探索機構本来の候補が件数より多い場合は，その先頭 (件数 × cost_aware_window) 点から同時に終わる組を選ぶ (投機的な候補は比べない)
+				if (candidates.size() > suggested_num * this->cost_aware_window) {
+					candidates.resize(suggested_num * this->cost_aware_window);
+				}
+				this->suggested_coordinates = this->packByMeasureDuration(candidates, suggested_num, *duration_model);
+			}
+			else {
+				this->suggested_coordinates = this->search_operator->getSuggestedList(suggested_num, in_flight_coordinates);
+			}
+		}
+
+		if (this->suggested_coordinates.size() > suggested_num) {
+			this->suggested_coordinates.resize(suggested_num);
+		}
+
+		for (const coordinate& one_coordinate : this->suggested_coordinates) {
+			this->suggest_parameters.emplace_back();
+			for (std::size_t i = 0; i < one_coordinate.size(); i++) {
+				this->suggest_parameters.back().push_back(this->target_parameters[i][one_coordinate[i]]);
+			}
+		}
+
+		return this->suggest_parameters;
+	}
+
+	template <typename T>
+	double OperationIntegrator<T>::getSuggestedFidelity(void) const {
+
+		if (this->fidelities.empty()) {
+			return 0;
+		}
+
+		if (this->inFidelityScreening()) {
+			return this->fidelity_scheduler->getFidelity();
+		}
+
+		return this->fidelities.back();
+	}
+
 	template <typename T>
 	void OperationIntegrator<T>::setMetricValue(double metric_value) {
-		this->search_operator->setMetricValue(this->search_operator->getSuggested(), metric_value);
+
+		coordinate measured_coordinate = this->getCurrentCoordinate();
+
+		if (this->is_timer_running) {
+			this->recordMeasureDuration(measured_coordinate, std::chrono::duration<double>(std::chrono::system_clock::now() - this->timer_start_point).count());
+			this->is_timer_running = false;
+		}
+
+		bool is_comparable = !this->inFidelityScreening();
+		this->registerMetricValue(measured_coordinate, metric_value);
+		this->countMeasurement(measured_coordinate, is_comparable);
 	}
 
 	template <typename T>
@@ -352,7 +1303,16 @@ namespace dsice {
 	template <typename T>
 	std::vector<T> OperationIntegrator<T>::getTentativeBestParameter(void) const {
 
-		const coordinate& base_coordinate = this->search_operator->getBaseCoordinate();
+		const coordinate& base_coordinate = this->search_operator == nullptr && this->fidelity_scheduler != nullptr ? this->fidelity_scheduler->getBestCoordinate() : this->search_operator->getBaseCoordinate();
+
+		// 予算を使い切った場合や基準点が未実測の場合 (初期探索中など) は，探索機構の判定を待たずにそれまでに実測した最良の点を返す
+		if (!this->best_measured_coordinate.empty() && (this->isBudgetExhausted() || base_coordinate.empty() || !this->search_operator->getDatabase()->hasSample(base_coordinate))) {
+			std::vector<T> best;
+			for (std::size_t i = 0; i < this->best_measured_coordinate.size(); i++) {
+				best.push_back(this->target_parameters[i][this->best_measured_coordinate[i]]);
+			}
+			return best;
+		}
 
 		std::vector<T> tmp;
 		for (std::size_t i = 0; i < base_coordinate.size(); i++) {
@@ -362,11 +1322,177 @@ namespace dsice {
 		return tmp;
 	}
 
+	template <typename T>
+	double OperationIntegrator<T>::predict(const std::vector<T>& parameter) const {
+		return this->predictBatch({ parameter }).front();
+	}
+
+	template <typename T>
+	std::vector<double> OperationIntegrator<T>::predictBatch(const std::vector<std::vector<T>>& parameters) const {
+
+		// 代理モデルは予測時に再推定されるため，実測券の登録と同時に行わない
+		std::lock_guard<std::mutex> lock(this->ticket_mutex);
+
+		if (this->search_operator == nullptr) {
+			throw std::runtime_error("The search has not started yet.");
+		}
+
+		std::shared_ptr<DatabaseSurrogateExtension> sd = std::dynamic_pointer_cast<DatabaseSurrogateExtension>(this->search_operator->getDatabase());
+		if (sd == nullptr) {
+			throw std::runtime_error("The current mode does not support the surrogate model.");
+		}
+
+		coordinate_list target_coordinates;
+		target_coordinates.reserve(parameters.size());
+		for (const std::vector<T>& parameter : parameters) {
+
+			if (parameter.size() != this->target_parameters.size()) {
+				throw std::invalid_argument("The dimension of the specified parameter is not the same as the target parameter's.");
+			}
+
+			coordinate tmp_c;
+			for (std::size_t i = 0; i < this->target_parameters.size(); i++) {
+
+				auto it = std::find(this->target_parameters[i].begin(), this->target_parameters[i].end(), parameter[i]);
+				if (it == this->target_parameters[i].end()) {
+					throw std::invalid_argument("One of the elements in the specified parameter is not found in the parameter.");
+				}
+
+				tmp_c.push_back(std::distance(this->target_parameters[i].begin(), it));
+			}
+			target_coordinates.push_back(tmp_c);
+		}
+
+		return sd->getSurrogate().predict(target_coordinates);
+	}
+
 	template <typename T>
 	bool OperationIntegrator<T>::isSearchFinished(void) const {
+
+		if (this->isBudgetExhausted()) {
+			return true;
+		}
+
+		// 探索機構の構築前 (最初の実測候補の提示前や低忠実度段) は終了していない
+		if (this->search_operator == nullptr) {
+			return false;
+		}
+
 		return this->search_operator->isSearchFinished();
 	}
 
+	template <typename T>
+	std::size_t OperationIntegrator<T>::getMeasuredNum(void) const {
+		return this->measured_num;
+	}
+
+	template <typename T>
+	std::size_t OperationIntegrator<T>::getRemainingMeasurementNum(void) const {
+
+		std::size_t remaining_num = std::numeric_limits<std::size_t>::max();
+
+		// 実測中の実測券は予算を消費済とみなす
+		if (this->budget_measurement_num > 0) {
+			std::size_t consumed_num = this->measured_num + this->issued_tickets.size();
+			remaining_num = consumed_num < this->budget_measurement_num ? this->budget_measurement_num - consumed_num : 0;
+		}
+
+		if (this->budget_time_sec > 0) {
+
+			double elapsed_time = this->getElapsedTime();
+			if (elapsed_time >= this->budget_time_sec) {
+				return 0;
+			}
+
+			// これまでのペース (並列実測や探索機構の処理時間を含む) で実測が進むとみなす
+			if (this->measured_num > 0 && elapsed_time > 0) {
+				double paced_num = (this->budget_time_sec - elapsed_time) * this->measured_num / elapsed_time - this->issued_tickets.size();
+				if (paced_num <= 0) {
+					return 0;
+				}
+				if (paced_num < static_cast<double>(remaining_num)) {
+					remaining_num = static_cast<std::size_t>(paced_num);
+				}
+			}
+		}
+
+		return remaining_num;
+	}
+
+	template <typename T>
+	double OperationIntegrator<T>::getElapsedTime(void) const {
+
+		if (!this->is_search_started) {
+			return 0;
+		}
+
+		return std::chrono::duration<double>(std::chrono::system_clock::now() - this->search_start_point).count();
+	}
+
+	template <typename T>
+	double OperationIntegrator<T>::getEstimatedRemainingTime(void) const {
+
+		if (this->isBudgetExhausted()) {
+			return 0;
+		}
+
+		double elapsed_time = this->getElapsedTime();
+		double remaining_time = std::numeric_limits<double>::infinity();
+
+		if (this->budget_time_sec > 0) {
+			remaining_time = this->budget_time_sec - elapsed_time;
+		}
+
+		// 実測中の実測券も結果が返るまでは残りに含める
+		if (this->budget_measurement_num > 0 && this->measured_num > 0 && elapsed_time > 0) {
+			std::size_t remaining_num = this->measured_num < this->budget_measurement_num ? this->budget_measurement_num - this->measured_num : 0;
+			remaining_time = std::min(remaining_time, remaining_num * elapsed_time / this->measured_num);
+		}
+
+		return remaining_time;
+	}
+
+	template <typename T>
+	double OperationIntegrator<T>::getExpectedImprovement(void) const {
+
+		if (this->isBudgetExhausted()) {
+			return 0;
+		}
+
+		// 並列実測数と性能パラメタの数の大きい方の 2 倍の実測を 1 区間とし，直近の 2 区間の改善量を比べる
+		std::size_t window = 2 * std::max<std::size_t>({ this->worker_num, this->target_parameters.size(), 1 });
+		std::size_t history_num = this->best_value_history.size();
+		if (history_num < 2 * window + 1) {
+			return std::numeric_limits<double>::infinity();
+		}
+
+		double oldest_value = this->best_value_history[history_num - 1 - 2 * window];
+		double middle_value = this->best_value_history[history_num - 1 - window];
+		double latest_value = this->best_value_history[history_num - 1];
+		if (!std::isfinite(oldest_value) || !std::isfinite(middle_value) || !std::isfinite(latest_value)) {
+			return std::numeric_limits<double>::infinity();
+		}
+
+		double earlier_gain = std::max(0.0, this->lower_is_better ? oldest_value - middle_value : middle_value - oldest_value);
+		double recent_gain = std::max(0.0, this->lower_is_better ? middle_value - latest_value : latest_value - middle_value);
+		if (recent_gain == 0) {
+			return 0;
+		}
+
+		std::size_t remaining_num = this->getRemainingMeasurementNum();
+		bool is_unlimited = remaining_num == std::numeric_limits<std::size_t>::max();
+		double remaining_windows = static_cast<double>(remaining_num) / window;
+
+		// 改善が減っていれば等比級数で，減っていなければ直近のペースが続くとみなして足し合わせる
+		if (recent_gain < earlier_gain) {
+			double ratio = recent_gain / earlier_gain;
+			double truncation = is_unlimited ? 1 : 1 - std::pow(ratio, remaining_windows);
+			return recent_gain * ratio * truncation / (1 - ratio);
+		}
+
+		return is_unlimited ? std::numeric_limits<double>::infinity() : recent_gain * remaining_windows;
+	}
+
 	template <typename T>
 	void OperationIntegrator<T>::setTimePerformance(void) {
 
@@ -374,21 +1500,206 @@ namespace dsice {
 		std::chrono::nanoseconds elapsed_time = std::chrono::system_clock::now() - this->timer_start_point;
 		double nano_sec_double = static_cast<double>(elapsed_time.count());
 
-		this->search_operator->setMetricValue(this->search_operator->getSuggested(), nano_sec_double);
+		coordinate measured_coordinate = this->getCurrentCoordinate();
+		this->recordMeasureDuration(measured_coordinate, std::chrono::duration<double>(elapsed_time).count());
+		this->is_timer_running = false;
+
+		bool is_comparable = !this->inFidelityScreening();
+		this->registerMetricValue(measured_coordinate, nano_sec_double);
+		this->countMeasurement(measured_coordinate, is_comparable);
 	}
 
 	template <typename T>
 	void OperationIntegrator<T>::setMetricValuesList(const std::vector<double>& metric_values_list) {
 
-		const coordinate_list& suggested_list = this->search_operator->getSuggestedList();
+		// 直近に提示した一覧と対応付ける (登録中に再計測リストが変化するためコピーをとる)
+		coordinate_list suggested_list = this->suggested_coordinates;
 
 		if (suggested_list.size() < metric_values_list.size()) {
 			throw std::invalid_argument("There are too many metric values.");
 		}
 
 		for (std::size_t i = 0; i < metric_values_list.size(); i++) {
-			this->search_operator->setMetricValue(suggested_list[i], metric_values_list[i]);
+			bool is_comparable = !this->inFidelityScreening();
+			this->registerMetricValue(suggested_list[i], metric_values_list[i]);
+			this->countMeasurement(suggested_list[i], is_comparable);
+		}
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::setMetricValuesList(const std::vector<double>& metric_values_list, const std::vector<bool>& censored_flags) {
+
+		// 直近に提示した一覧と対応付ける (登録中に再計測リストが変化するためコピーをとる)
+		coordinate_list suggested_list = this->suggested_coordinates;
+
+		if (suggested_list.size() < metric_values_list.size()) {
+			throw std::invalid_argument("There are too many metric values.");
+		}
+		if (censored_flags.size() != metric_values_list.size()) {
+			throw std::invalid_argument("censored_flags must have the same length as metric_values_list.");
 		}
+
+		for (std::size_t i = 0; i < metric_values_list.size(); i++) {
+			bool is_comparable = !censored_flags[i] && !this->inFidelityScreening();
+			if (censored_flags[i]) {
+				this->registerCensoredMetricValue(suggested_list[i], metric_values_list[i]);
+			}
+			else {
+				this->registerMetricValue(suggested_list[i], metric_values_list[i]);
+			}
+			this->countMeasurement(suggested_list[i], is_comparable);
+		}
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::setMeasureDurationsList(const std::vector<double>& durations_sec) {
+
+		if (this->suggested_coordinates.size() < durations_sec.size()) {
+			throw std::invalid_argument("There are too many durations.");
+		}
+
+		for (std::size_t i = 0; i < durations_sec.size(); i++) {
+			this->recordMeasureDuration(this->suggested_coordinates[i], durations_sec[i]);
+		}
+	}
+
+	template <typename T>
+	double OperationIntegrator<T>::getDeadline(void) {
+
+		std::lock_guard<std::mutex> lock(this->ticket_mutex);
+
+		return this->calculateDeadline();
+	}
+
+	template <typename T>
+	bool OperationIntegrator<T>::reportPartial(double partial_value) {
+		return partial_value >= this->getDeadline();
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::setCensoredMetricValue(double bound) {
+
+		coordinate measured_coordinate = this->getCurrentCoordinate();
+
+		if (this->is_timer_running) {
+			this->recordMeasureDuration(measured_coordinate, std::chrono::duration<double>(std::chrono::system_clock::now() - this->timer_start_point).count());
+			this->is_timer_running = false;
+		}
+
+		this->registerCensoredMetricValue(measured_coordinate, bound);
+		this->countMeasurement(measured_coordinate, false);
+	}
+
+	template <typename T>
+	Ticket<T> OperationIntegrator<T>::acquire(void) {
+
+		std::lock_guard<std::mutex> lock(this->ticket_mutex);
+
+		this->startSearchClock();
+		bool in_screening = this->prepareFidelityScreening();
+
+		coordinate target_coordinate;
+		if (in_screening) {
+
+			// 低忠実度段では実測中でない未評価の設定値を優先し，すべて実測中なら先頭を重複して実測する
+			const coordinate_list& candidates = this->fidelity_scheduler->getSuggestedList();
+			auto target = std::find_if(candidates.begin(), candidates.end(), [this](const coordinate& c) { return !this->in_flight_counts.contains(c); });
+			target_coordinate = target != candidates.end() ? *target : this->fidelity_scheduler->getSuggested();
+		}
+		else {
+			target_coordinate = this->selectTicketCoordinate();
+		}
+
+		std::size_t ticket_id = this->next_ticket_id;
+		this->next_ticket_id++;
+		this->issued_tickets.emplace(ticket_id, target_coordinate);
+		this->ticket_issue_times.emplace(ticket_id, std::chrono::system_clock::now());
+		this->in_flight_counts[target_coordinate]++;
+		if (in_screening) {
+			this->screening_ticket_rungs.emplace(ticket_id, this->fidelity_scheduler->getRung());
+		}
+
+		std::vector<T> parameter;
+		for (std::size_t i = 0; i < target_coordinate.size(); i++) {
+			parameter.push_back(this->target_parameters[i][target_coordinate[i]]);
+		}
+
+		return Ticket<T>(ticket_id, parameter, this->getSuggestedFidelity());
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::complete(std::size_t ticket_id, double metric_value) {
+
+		std::lock_guard<std::mutex> lock(this->ticket_mutex);
+
+		this->finishTicket(ticket_id, metric_value, false);
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::abort(std::size_t ticket_id, double bound) {
+
+		std::lock_guard<std::mutex> lock(this->ticket_mutex);
+
+		this->finishTicket(ticket_id, bound, true);
+	}
+
+	template <typename T>
+	void OperationIntegrator<T>::finishTicket(std::size_t ticket_id, double metric_value, bool is_censored) {
+
+		if (!this->issued_tickets.contains(ticket_id)) {
+			throw std::invalid_argument("The ticket is not issued or already completed.");
+		}
+
+		coordinate measured_coordinate = this->issued_tickets.at(ticket_id);
+		this->issued_tickets.erase(ticket_id);
+
+		std::chrono::system_clock::duration measure_duration = std::chrono::system_clock::now() - this->ticket_issue_times.at(ticket_id);
+		this->ticket_issue_times.erase(ticket_id);
+
+		std::size_t& in_flight = this->in_flight_counts.at(measured_coordinate);
+		in_flight--;
+		if (in_flight == 0) {
+			this->in_flight_counts.erase(measured_coordinate);
+		}
+
+		// 低忠実度段の実測券は発行時と同じ段の間だけ受け付ける (最高忠実度の探索には渡さない)
+		if (this->screening_ticket_rungs.contains(ticket_id)) {
+
+			std::size_t issued_rung = this->screening_ticket_rungs.at(ticket_id);
+			this->screening_ticket_rungs.erase(ticket_id);
+
+			if (this->inFidelityScreening() && issued_rung == this->fidelity_scheduler->getRung()) {
+				this->fidelity_scheduler->setMetricValue(measured_coordinate, metric_value);
+				this->fidelity_scheduler->updateState();
+			}
+
+			this->countMeasurement(measured_coordinate, false);
+			return;
+		}
+
+		// 逐次アルゴリズムは提示中の点以外の値を受け付けないため，探索が先へ進んだ後に返ってきた値は捨てる
+		if (this->forSequentialMode()) {
+			const coordinate_list& current_list = this->search_operator->getSuggestedList();
+			bool is_current = std::find(current_list.begin(), current_list.end(), measured_coordinate) != current_list.end();
+			bool is_remeasuring = std::find(this->remeasure_coordinates.begin(), this->remeasure_coordinates.end(), measured_coordinate) != this->remeasure_coordinates.end();
+			if (!is_current && !is_remeasuring) {
+				this->countMeasurement(measured_coordinate, false);
+				return;
+			}
+		}
+
+		this->recordMeasureDuration(measured_coordinate, std::chrono::duration<double>(measure_duration).count());
+
+		if (is_censored) {
+			this->registerCensoredMetricValue(measured_coordinate, metric_value);
+		}
+		else {
+			this->registerMetricValue(measured_coordinate, metric_value);
+		}
+		this->countMeasurement(measured_coordinate, !is_censored);
+
+		// 次の発行を待たずに結果を反映
+		this->search_operator->updateState();
 	}
 
 	template <typename T>
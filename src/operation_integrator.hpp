@@ -2,14 +2,21 @@
 #define OPERATION_INTEGRATOR_HPP_
 
 #include <memory>
+#include <cstdint>
 #include <vector>
 #include <chrono>
 #include <string>
+#include <mutex>
+#include <unordered_map>
 
 #include "dsice_search_space.hpp"
 #include "dsice_operator.hpp"
 #include "dsice_execution_mode.hpp"
 #include "dsice_database_metric_type.hpp"
+#include "dsice_database_measure_duration_extension.hpp"
+#include "dsice_initial_design_type.hpp"
+#include "dsice_ticket.hpp"
+#include "successive_halving_scheduler.hpp"
 
 namespace dsice {
 
@@ -28,6 +35,10 @@ namespace dsice {
 		/// </summary>
 		std::vector<std::vector<T>> suggest_parameters;
 		/// <summary>
+		/// 直近に一覧で提示した実測候補の座標 (setMetricValuesList() での対応付けに使用)
+		/// </summary>
+		coordinate_list suggested_coordinates;
+		/// <summary>
 		/// 探索機構の本体
 		/// </summary>
 		std::shared_ptr<Operator> search_operator = nullptr;
@@ -68,14 +79,298 @@ namespace dsice {
 		/// </summary>
 		DatabaseMetricType database_metric_type = DatabaseMetricType::AverageDouble;
 		/// <summary>
+		/// 適応的再計測において 1 点あたりに許す最大計測回数 (1 以下なら再計測しない)
+		/// </summary>
+		std::size_t max_measurement_num = 1;
+		/// <summary>
+		/// 適応的再計測において信頼区間の幅を決める係数 (標準誤差の何倍か)
+		/// </summary>
+		double remeasure_z_value = 1.96;
+		/// <summary>
+		/// 再計測中の点の座標 (再計測を要求する順)
+		/// </summary>
+		coordinate_list remeasure_coordinates;
+		/// <summary>
+		/// 再計測を終えた点の分散の総和 (計測 1 回のみの点の信頼区間の推定に使用)
+		/// </summary>
+		double pooled_variance_sum = 0;
+		/// <summary>
+		/// pooled_variance_sum に加算された点の数
+		/// </summary>
+		std::size_t pooled_variance_count = 0;
+		/// <summary>
+		/// 基準点移動前の有意差検定で 1 点あたりに許す最大実測回数 (0 なら検定しない)
+		/// </summary>
+		std::size_t significance_test_repetitions = 0;
+		/// <summary>
+		/// 基準点移動前の有意差検定の有意水準
+		/// </summary>
+		double significance_level = 0.05;
+		/// <summary>
+		/// ログ記録時にメモリ上に保持する探索基準点ログの最大数 (0 なら無制限)
+		/// </summary>
+		std::size_t max_in_memory_log_num = 0;
+		/// <summary>
+		/// メモリ上に保持しきれないログの書き出し先ファイルのパス
+		/// </summary>
+		std::string log_spill_file_path;
+		/// <summary>
+		/// 実測待ちの間に次の探索機構を先読みで構築するかどうか
+		/// </summary>
+		bool is_precomputation_on = false;
+		/// <summary>
+		/// 実測の打ち切り期限を決める係数 (現在の最良値の何倍か，0 なら打ち切らない)
+		/// </summary>
+		double deadline_factor = 0;
+		/// <summary>
+		/// 多点開始型の並列探索で同時に探索する開始点の数
+		/// </summary>
+		std::size_t multi_start_num = 4;
+		/// <summary>
+		/// 並列に実測できる数 (直線探索の初期探索の分割数を決める，0 なら 3 分割)
+		/// </summary>
+		std::size_t worker_num = 0;
+		/// <summary>
+		/// 推奨モードで全探索を選ぶ探索空間の大きさ (並列実測数の何倍以下か，0 なら選ばない)
+		/// </summary>
+		std::size_t full_search_factor = 4;
+		/// <summary>
+		/// 全探索の枝刈りの余裕 (0 なら枝刈りしない)
+		/// </summary>
+		double full_search_pruning_margin = 0;
+		/// <summary>
+		/// 探索機構の構築や状態更新に用いるスレッドプールのスレッド数 (0 なら逐次実行)
+		/// </summary>
+		std::size_t thread_pool_size = 0;
+		/// <summary>
+		/// 放射状探索で方向を間引く場合に同時変化させる軸数の最大値 (0 なら間引かない)
+		/// </summary>
+		std::size_t sampled_max_changed_axis_num = 0;
+		/// <summary>
+		/// 放射状探索で方向を間引く場合の 1 巡あたりの方向数の上限
+		/// </summary>
+		std::size_t sampled_direction_budget = 64;
+		/// <summary>
+		/// 放射状探索前の性能パラメタの選別で固定する効果の大きさの閾値 (最大の効果に対する比，0 なら選別しない)
+		/// </summary>
+		double screening_threshold = 0;
+		/// <summary>
+		/// 全周辺方向の探索の前に各軸と最急降下方向の直線探索を行うかどうか
+		/// </summary>
+		bool is_gradient_step_on = false;
+		/// <summary>
+		/// 代理モデルで交互作用項として採用する性能パラメタ組の最大数
+		/// </summary>
+		std::size_t surrogate_pair_num = 0;
+		/// <summary>
+		/// 代理モデルの予測値がこの標準偏差倍だけずれても暫定最良値より悪い点の実測を省略する (0 なら省略しない)
+		/// </summary>
+		double surrogate_skip_confidence = 0;
+		/// <summary>
+		/// 初期探索の配置方法が設定されているか
+		/// </summary>
+		bool is_initial_design_set = false;
+		/// <summary>
+		/// 初期探索の配置方法
+		/// </summary>
+		InitialDesignType initial_design_type = InitialDesignType::SimpleLhd;
+		/// <summary>
+		/// 初期探索で配置する点の数 (0 なら最も長い性能パラメタの値の数)
+		/// </summary>
+		std::size_t initial_design_point_num = 0;
+		/// <summary>
+		/// 初期探索の配置の生成に用いる乱数のシード値
+		/// </summary>
+		std::uint64_t initial_design_seed = 0;
+		/// <summary>
+		/// 多忠実度探索の各段の忠実度 (昇順，末尾が最高忠実度，空なら多忠実度探索を行わない)
+		/// </summary>
+		std::vector<double> fidelities;
+		/// <summary>
+		/// 多忠実度探索の各段で次の段に昇格させる割合の逆数
+		/// </summary>
+		std::size_t fidelity_eta = 3;
+		/// <summary>
+		/// 多忠実度探索で最も低い忠実度で評価する設定値の数 (0 なら自動)
+		/// </summary>
+		std::size_t fidelity_initial_num = 0;
+		/// <summary>
+		/// 探索機構の構築前に低い忠実度で設定値を絞り込む逐次半減法の管理機構
+		/// </summary>
+		std::shared_ptr<SuccessiveHalvingScheduler> fidelity_scheduler = nullptr;
+		/// <summary>
+		/// 実測時間の予測に応じて候補を並べ替える際に同程度に有望とみなす範囲 (件数指定なしの一覧では先頭からこの件数ごと，件数指定の一覧では件数のこの倍数．1 なら並べ替えない)
+		/// </summary>
+		std::size_t cost_aware_window = 1;
+		/// <summary>
+		/// 実測時間がこの割合までしか違わない候補は同程度の実測時間とみなす (予測誤差による不要な並べ替えを避ける)
+		/// </summary>
+		static constexpr double DURATION_TOLERANCE = 0.1;
+		/// <summary>
+		/// getSuggestedNext() で提示した点の実測時間を計測中か
+		/// </summary>
+		bool is_timer_running = false;
+		/// <summary>
+		/// 実測数の予算 (0 なら制限なし)
+		/// </summary>
+		std::size_t budget_measurement_num = 0;
+		/// <summary>
+		/// 最初の実測候補の提示からの経過時間の予算 [秒] (0 なら制限なし)
+		/// </summary>
+		double budget_time_sec = 0;
+		/// <summary>
+		/// 登録された実測の数 (低忠実度段，打ち切り，再計測を含む)
+		/// </summary>
+		std::size_t measured_num = 0;
+		/// <summary>
+		/// 最初の実測候補を提示済か
+		/// </summary>
+		bool is_search_started = false;
+		/// <summary>
+		/// 最初の実測候補を提示した時刻 (時間予算や残り時間の見積もりの基準)
+		/// </summary>
+		std::chrono::system_clock::time_point search_start_point;
+		/// <summary>
+		/// 実測された中で性能評価値が最良の点 (最高忠実度で打ち切らなかった実測のみ)
+		/// </summary>
+		coordinate best_measured_coordinate;
+		/// <summary>
+		/// 各実測の登録直後の最良値の推移 (最良の点が未定の間は NaN，残りの改善量の見積もりに用いる)
+		/// </summary>
+		std::vector<double> best_value_history;
+		/// <summary>
+		/// 次に発行する実測券の識別子
+		/// </summary>
+		std::size_t next_ticket_id = 0;
+		/// <summary>
+		/// 発行済で結果未登録の実測券 (識別子と実測座標の組)
+		/// </summary>
+		std::unordered_map<std::size_t, coordinate> issued_tickets;
+		/// <summary>
+		/// 座標ごとの実測中 (発行済で結果未登録) の実測券の数
+		/// </summary>
+		std::unordered_map<coordinate, std::size_t> in_flight_counts;
+		/// <summary>
+		/// 多忠実度探索の低忠実度段で発行した実測券の識別子と発行時の段の組
+		/// </summary>
+		std::unordered_map<std::size_t, std::size_t> screening_ticket_rungs;
+		/// <summary>
+		/// 発行済で結果未登録の実測券の発行時刻 (実測時間の記録に用いる)
+		/// </summary>
+		std::unordered_map<std::size_t, std::chrono::system_clock::time_point> ticket_issue_times;
+		/// <summary>
+		/// 実測券の発行・登録と代理モデルによる予測 (予測時に代理モデルが再推定される) を複数スレッドから行うための排他制御
+		/// </summary>
+		mutable std::mutex ticket_mutex;
+		/// <summary>
 		/// 指定された条件に合う探索機構を構築
 		/// </summary>
 		void buildOperator(void);
 		/// <summary>
+		/// 推奨モードが指定されている場合に，設定内容に応じて適切な探索モードを選択
+		/// </summary>
+		void resolveRecommendedMode(void);
+		/// <summary>
+		/// 多忠実度探索の低忠実度段を実行中かを判定し，必要に応じて逐次半減法の管理機構または探索機構を構築．<br/>
+		/// 低忠実度段を終えた時点で，生き残った設定値を最高忠実度での初期探索の配置とした探索機構を構築する
+		/// </summary>
+		/// <returns>低忠実度段を実行中なら true</returns>
+		bool prepareFidelityScreening(void);
+		/// <summary>
+		/// 多忠実度探索の低忠実度段を実行中か (探索機構は未構築)
+		/// </summary>
+		/// <returns>実行中なら true</returns>
+		bool inFidelityScreening(void) const;
+		/// <summary>
+		/// 次に実測値が登録される点の座標を取得
+		/// </summary>
+		/// <returns>再計測待ちの点，低忠実度段の提案，探索機構の提案のいずれか</returns>
+		coordinate getCurrentCoordinate(void) const;
+		/// <summary>
+		/// 実測値を登録．<br/>
+		/// 適応的再計測が有効な場合，信頼区間が基準点の値と重なる間は Operator に渡さずに再計測を要求
+		/// </summary>
+		/// <param name="measured_coordinate">実測した点の座標</param>
+		/// <param name="metric_value">実測した性能評価値</param>
+		void registerMetricValue(const coordinate& measured_coordinate, double metric_value);
+		/// <summary>
+		/// 実測を途中で打ち切ったデータを登録．<br/>
+		/// 打ち切った点は明らかに基準点より悪いため，適応的再計測の対象から外す
+		/// </summary>
+		/// <param name="measured_coordinate">実測を打ち切った点の座標</param>
+		/// <param name="bound">打ち切り時点の性能評価値の限界値</param>
+		void registerCensoredMetricValue(const coordinate& measured_coordinate, double bound);
+		/// <summary>
+		/// 実測の打ち切り期限を計算 (排他制御なし)
+		/// </summary>
+		/// <returns>打ち切り期限 (打ち切らない場合は無限大)</returns>
+		double calculateDeadline(void);
+		/// <summary>
+		/// 実測券に対応する結果を登録し，探索機構の状態を更新
+		/// </summary>
+		/// <param name="ticket_id">実測券の識別子</param>
+		/// <param name="metric_value">実測した性能評価値 (打ち切りの場合は限界値)</param>
+		/// <param name="is_censored">実測を打ち切った場合は true</param>
+		void finishTicket(std::size_t ticket_id, double metric_value, bool is_censored);
+		/// <summary>
+		/// 指定された点を再計測すべきかどうかを，探索機構のデータベースに登録された回数と分散，探索基準点およびそれまでの最良点の値から判定
+		/// </summary>
+		/// <param name="measured_coordinate">判定対象の点の座標</param>
+		/// <returns>再計測すべきなら true</returns>
+		bool needsRemeasurement(const coordinate& measured_coordinate) const;
+		/// <summary>
 		/// 現在の探索モードが逐次探索用か並列探索用かを判定
 		/// </summary>
 		/// <returns>逐次探索用なら true</returns>
 		constexpr bool forSequentialMode(void) const;
+		/// <summary>
+		/// 次に発行する実測券の実測座標を選択．<br/>
+		/// 再計測待ちの点，探索機構の提案の順に，実測中でない点を優先する
+		/// </summary>
+		/// <returns>実測座標</returns>
+		coordinate selectTicketCoordinate(void);
+		/// <summary>
+		/// 探索機構のデータベースに実測時間を記録 (探索機構の構築前の低忠実度段の実測は記録しない)
+		/// </summary>
+		/// <param name="measured_coordinate">実測した点の座標</param>
+		/// <param name="duration_sec">実測に要した時間 [秒]</param>
+		void recordMeasureDuration(const coordinate& measured_coordinate, double duration_sec);
+		/// <summary>
+		/// 候補の並べ替えに用いる実測時間の予測機構を取得
+		/// </summary>
+		/// <returns>探索機構のデータベース (並べ替えが無効，逐次探索用のモード，または予測に足る実測時間が記録されていない場合は nullptr)</returns>
+		std::shared_ptr<DatabaseMeasureDurationExtension> getDurationModel(void) const;
+		/// <summary>
+		/// 同程度に有望な候補の組ごとに，実測時間の予測が短い順に並べ替える
+		/// </summary>
+		/// <param name="candidates">優先度順の候補</param>
+		/// <param name="duration_model">実測時間の予測機構</param>
+		/// <returns>並べ替えた候補</returns>
+		coordinate_list orderByMeasureDuration(const coordinate_list& candidates, const DatabaseMeasureDurationExtension& duration_model) const;
+		/// <summary>
+		/// 最優先の候補を必ず含め，それより長くかからない候補を優先度順に選んで並列に実測する組を作る (足りなければ超過の小さい順に補う)．<br/>
+		/// 組の全実測がほぼ同時に終わるため，一覧単位で実測を待つ場合の実行資源の遊びを減らせる
+		/// </summary>
+		/// <param name="candidates">優先度順の候補</param>
+		/// <param name="suggested_num">組の大きさ</param>
+		/// <param name="duration_model">実測時間の予測機構</param>
+		/// <returns>選んだ候補 (優先度順)</returns>
+		coordinate_list packByMeasureDuration(const coordinate_list& candidates, std::size_t suggested_num, const DatabaseMeasureDurationExtension& duration_model) const;
+		/// <summary>
+		/// 最初の実測候補の提示であれば，時間予算の計測を開始
+		/// </summary>
+		void startSearchClock(void);
+		/// <summary>
+		/// 登録された実測を予算に計上し，最良の点と最良値の推移を更新して，探索機構に残りの予算を伝える
+		/// </summary>
+		/// <param name="measured_coordinate">実測した点の座標</param>
+		/// <param name="is_comparable">最高忠実度で打ち切らなかった実測であれば true (最良の点の候補とする)</param>
+		void countMeasurement(const coordinate& measured_coordinate, bool is_comparable);
+		/// <summary>
+		/// 実測数または時間の予算を使い切ったかを判定 (実測中の実測券も実測数に含める)
+		/// </summary>
+		/// <returns>使い切っていれば true</returns>
+		bool isBudgetExhausted(void) const;
 	public:
 		/// <summary>
 		/// 性能パラメタを後から指定するコンストラクタ
@@ -153,6 +448,125 @@ namespace dsice {
 		/// <param name="metric_type">DSICE のデータベースが保有する性能評価値のふるまい</param>
 		void config_setDatabaseMetricType(DatabaseMetricType metric_type);
 		/// <summary>
+		/// 適応的再計測を設定．<br/>
+		/// 性能評価値の信頼区間が探索基準点の値と重なる点のみ，最大計測回数に達するまで再計測を要求します．
+		/// </summary>
+		/// <param name="max_measurement_num">1 点あたりの最大計測回数 (1 以下なら再計測しない)</param>
+		/// <param name="z_value">信頼区間の幅を決める係数 (標準誤差の何倍か)</param>
+		void config_setAdaptiveRemeasurement(std::size_t max_measurement_num, double z_value = 1.96);
+		/// <summary>
+		/// 基準点移動前の有意差検定を設定 (S_2018 および P_2024B のみ有効)．<br/>
+		/// 改善候補と基準点を繰り返し実測し，Welch の t 検定で有意に良いと判定された場合のみ基準点を移動します．
+		/// </summary>
+		/// <param name="max_repetitions">1 点あたりの最大実測回数 (0 なら検定しない)</param>
+		/// <param name="significance_level">片側検定の有意水準 (繰り返す検定全体を通しての値)</param>
+		void config_setSignificanceTest(std::size_t max_repetitions, double significance_level = 0.05);
+		/// <summary>
+		/// ログ記録時のメモリ使用量に上限を設定 (ログ記録が有効な場合のみ有効)．<br/>
+		/// 上限を超えた古いログは圧縮したうえで指定ファイルへ書き出され，ログ出力時に逐次読み出されます．
+		/// </summary>
+		/// <param name="max_in_memory_base_point_num">メモリ上に保持する探索基準点ごとのログの最大数 (0 なら無制限)</param>
+		/// <param name="spill_file_path">書き出し先ファイルのパス</param>
+		void config_setLogMemoryLimit(std::size_t max_in_memory_base_point_num, const std::string& spill_file_path);
+		/// <summary>
+		/// 実測待ちの間に次の基準点の探索機構を別スレッドで先読み構築するかを設定 (P_2024B のみ有効)．<br/>
+		/// 先読みが当たった場合は，基準点移動時の探索機構の構築を待たずに次の候補を返せます．
+		/// </summary>
+		/// <param name="precomputation_on">先読みする場合は true</param>
+		void config_setPrecomputation(bool precomputation_on = true);
+		/// <summary>
+		/// 実測の打ち切り期限を設定 (低い値ほど良い場合のみ有効)．<br/>
+		/// 期限は現在の最良値の指定倍で，期限を超えた実測は打ち切って限界値のみを登録できます．
+		/// </summary>
+		/// <param name="deadline_factor">期限が最良値の何倍か (0 なら打ち切らない，それ以外は 1 より大きい値)</param>
+		void config_setDeadlineFactor(double deadline_factor);
+		/// <summary>
+		/// 同時に探索する開始点の数を設定 (P_MULTI_START のみ有効)．<br/>
+		/// 初期探索で良い値が得られた点から，互いに隣接しない点を指定数まで開始点とします．
+		/// </summary>
+		/// <param name="start_num">開始点の数 (1 以上)</param>
+		void config_setMultiStartNum(std::size_t start_num);
+		/// <summary>
+		/// 並列に実測できる数を設定 (S_IPPE，P_2024B，P_ASYNC，P_MULTI_START で有効)．<br/>
+		/// 直線探索の初期探索を，3 分割ではなく並列実測数に合わせた数の分割点による多分割探索で行います．
+		/// </summary>
+		/// <param name="worker_num">並列に実測できる数 (0 なら 3 分割)</param>
+		void config_setWorkerNum(std::size_t worker_num);
+		/// <summary>
+		/// 推奨モードで全探索 (P_FULL) を選ぶ探索空間の大きさを設定．<br/>
+		/// 並列探索が指定され，探索空間の点数が並列実測数の指定倍以下の場合に全探索を選びます．
+		/// </summary>
+		/// <param name="factor">並列実測数の何倍以下で全探索を選ぶか (0 なら選ばない)</param>
+		void config_setFullSearchFactor(std::size_t factor);
+		/// <summary>
+		/// 全探索 (P_FULL) の枝刈りを設定．<br/>
+		/// 点を通る各軸方向の直線上の実測値から d-Spline で推定した値がいずれも最良値より明らかに悪い (差が最良値の絶対値の指定倍を超える) 点は実測しません．
+		/// </summary>
+		/// <param name="margin">枝刈りの余裕 (0 なら枝刈りしない)</param>
+		void config_setFullSearchPruning(double margin);
+		/// <summary>
+		/// 探索機構の構築や状態更新に用いるスレッドプールの大きさを設定 (S_2017，S_2018，P_2024B，P_ASYNC，P_MULTI_START で有効)．<br/>
+		/// 高次元の探索空間で，方向ごとの探索機構の構築や d-Spline の再計算を並列に行います．
+		/// </summary>
+		/// <param name="thread_num">スレッド数 (0 ならスレッドプールを使わず逐次実行)</param>
+		void config_setThreadPoolSize(std::size_t thread_num);
+		/// <summary>
+		/// 放射状探索で探索する方向の間引きを設定 (P_2024B，P_ASYNC，P_MULTI_START で有効)．<br/>
+		/// 全周辺方向 (3^n - 1 方向) の代わりに，同時変化軸数が上限以下の方向を 1 巡あたりの上限数まで無作為に選びます．<br/>
+		/// 軸数ごとの方向数の配分はその軸数の方向がもたらした改善の割合に，軸の選ばれやすさはその軸を含む方向がもたらした改善の回数に応じて変わります．
+		/// </summary>
+		/// <param name="max_changed_axis_num">同時変化させる軸数の最大値 (0 なら間引かずに全周辺方向を探索)</param>
+		/// <param name="direction_budget">1 つの探索基準点での放射状探索あたりに選ぶ方向数の上限</param>
+		void config_setDirectionSampling(std::size_t max_changed_axis_num, std::size_t direction_budget = 64);
+		/// <summary>
+		/// 放射状探索の前に各性能パラメタの効果の大きさを並列実測で調べ，効果の小さい性能パラメタを暫定最良値に固定して残りの性能パラメタのみを探索するよう設定 (P_2024B のみ有効)
+		/// </summary>
+		/// <param name="threshold">効果の大きさが最大の効果に対してこの比未満の性能パラメタを固定する (0 以上 1 未満，0 なら選別しない)</param>
+		void config_setParameterScreening(double threshold);
+		/// <summary>
+		/// 各探索基準点で各軸の直線探索の近似曲線の傾きから最急降下方向を求め，その方向の直線探索で改善しなかった場合のみ全周辺方向を探索するかを設定 (P_2024B のみ有効)
+		/// </summary>
+		/// <param name="gradient_step_on">最急降下方向の直線探索を行う場合は true</param>
+		void config_setGradientStep(bool gradient_step_on = true);
+		/// <summary>
+		/// 実測済の標本全体から性能パラメタごとの d-Spline の和による代理モデルを推定するよう設定．<br/>
+		/// 代理モデルの予測値は predict() で取得でき，skip_confidence が正であれば予測上明らかに悪い点の実測を省略する (実測の省略は P_2024B のみ有効)
+		/// </summary>
+		/// <param name="max_pair_num">交互作用項として採用する性能パラメタ組の最大数 (0 なら主効果のみ)</param>
+		/// <param name="skip_confidence">予測値がこの標準偏差倍だけずれても暫定最良値より悪い点の実測を省略する (0 なら省略しない)</param>
+		void config_setSurrogate(std::size_t max_pair_num, double skip_confidence = 0);
+		/// <summary>
+		/// 初期探索を行い，その実測点の配置方法を設定 (S_2018, P_2024B, P_ASYNC, P_MULTI_START で有効)<br/>
+		/// データベースに実測済の点があれば最も近い配置点をその点で置き換え，同じシード値からは常に同じ配置を生成する
+		/// </summary>
+		/// <param name="design_type">初期探索で実測する点の配置方法</param>
+		/// <param name="point_num">配置する点の数 (0 なら最も長い性能パラメタの値の数，並列実測数の倍数に切り上げる)</param>
+		/// <param name="seed">配置の生成に用いる乱数のシード値 (同じ値なら同じ配置になる)</param>
+		void config_setInitialDesign(InitialDesignType design_type = InitialDesignType::MaximinLhd, std::size_t point_num = 0, std::uint64_t seed = 0);
+		/// <summary>
+		/// 問題サイズや反復回数などの忠実度を下げた安価な実測で多数の設定値を評価し，上位 1/eta のみを次の忠実度に昇格させる逐次半減法を探索前に行うよう設定．<br/>
+		/// 最高忠実度の 1 つ手前の段で生き残った設定値を最高忠実度での初期探索の配置とし，以降の探索は最高忠実度の実測値のみで行う (S_2018, P_2024B, P_ASYNC, P_MULTI_START で有効)．<br/>
+		/// 各提案の忠実度は getSuggestedFidelity() で取得できる
+		/// </summary>
+		/// <param name="fidelities">各段の忠実度 (昇順，末尾が最高忠実度，2 段以上)</param>
+		/// <param name="eta">各段で次の段に昇格させる割合の逆数 (2 以上)</param>
+		/// <param name="initial_num">最も低い忠実度で評価する設定値の数 (0 なら最も長い性能パラメタの値の数と並列実測数の大きい方の eta^(段数 - 1) 倍)</param>
+		void config_setMultiFidelity(const std::vector<double>& fidelities, std::size_t eta = 3, std::size_t initial_num = 0);
+		/// <summary>
+		/// 記録した実測時間から各候補の実測時間を予測し，同程度に有望な候補の中では短く済むものを先に実測するよう設定 (P_2024B, P_ASYNC, P_MULTI_START, P_FULL で有効)．<br/>
+		/// 件数指定の一覧では先頭 (件数 × window) 件から最優先の候補と同時に終わる組を選び，件数指定なしの一覧では先頭から window 件ごとに短く済む順に並べる (実測券の割り当て順は変えない)．<br/>
+		/// 実測時間は getSuggestedNext() から登録まで，または実測券の発行から登録までの経過時間として記録される (一覧で実測する場合は setMeasureDurationsList() で登録)
+		/// </summary>
+		/// <param name="window">同程度に有望とみなす範囲 (1 なら並べ替えない)</param>
+		void config_setCostAwareOrdering(std::size_t window = 2);
+		/// <summary>
+		/// 実測数と時間の予算を設定 (予算を使い切ると isSearchFinished() が true となり，getTentativeBestParameter() はそれまでに実測した最良の点を返す)．<br/>
+		/// 件数指定の一覧は残りの実測数までに切り詰め，P_2024B は予算が残りの直線の完了に足りなければ放射状探索の完了を待たずに良い点へ移動する
+		/// </summary>
+		/// <param name="max_measurement_num">実測数の上限 (低忠実度段，打ち切り，再計測を含む．0 なら制限なし)</param>
+		/// <param name="max_time_sec">最初の実測候補の提示からの経過時間の上限 [秒] (0 なら制限なし)</param>
+		void config_setBudget(std::size_t max_measurement_num, double max_time_sec = 0);
+		/// <summary>
 		/// 性能パラメタに設定すべき値を取得
 		/// </summary>
 		/// <returns>性能パラメタに設定すべき値</returns>
@@ -163,6 +577,18 @@ namespace dsice {
 		/// <returns>性能パラメタに設定すべき値の一覧</returns>
 		const std::vector<std::vector<T>>& getSuggestedList(void);
 		/// <summary>
+		/// 性能パラメタに設定すべき値の一覧を指定件数で取得．<br/>
+		/// P_2024B，P_ASYNC および P_MULTI_START では不足分を投機的な実測候補で補い，探索終了時や未実測の候補が尽きた場合を除き指定件数を返す
+		/// </summary>
+		/// <param name="suggested_num">取得する候補数</param>
+		/// <returns>性能パラメタに設定すべき値の一覧</returns>
+		const std::vector<std::vector<T>>& getSuggestedList(std::size_t suggested_num);
+		/// <summary>
+		/// 直近に提示した性能パラメタ設定値を実測すべき忠実度を取得
+		/// </summary>
+		/// <returns>忠実度 (多忠実度探索を設定していなければ 0)</returns>
+		double getSuggestedFidelity(void) const;
+		/// <summary>
 		/// 実測した性能評価値を登録
 		/// </summary>
 		/// <param name="metric_value">実測した性能評価値</param>
@@ -178,6 +604,53 @@ namespace dsice {
 		/// <param name="metric_values_list">実測した性能評価値の一覧</param>
 		void setMetricValuesList(const std::vector<double>& metric_values_list);
 		/// <summary>
+		/// 実測した性能評価値の一覧を，打ち切りの有無とともに登録．<br/>
+		/// 打ち切った実測の性能評価値には打ち切り時点の限界値を指定します．
+		/// </summary>
+		/// <param name="metric_values_list">実測した性能評価値の一覧</param>
+		/// <param name="censored_flags">各実測を打ち切ったかどうか (metric_values_list と同じ長さ)</param>
+		void setMetricValuesList(const std::vector<double>& metric_values_list, const std::vector<bool>& censored_flags);
+		/// <summary>
+		/// 直近に提示した一覧の各候補の実測に要した時間を登録 (実測時間の予測に用いる)．<br/>
+		/// setMetricValuesList() と同様に実測優先度順に対応付け，その前に呼び出すとログの実測開始時刻にも反映される
+		/// </summary>
+		/// <param name="durations_sec">各候補の実測に要した時間 [秒] の一覧</param>
+		void setMeasureDurationsList(const std::vector<double>& durations_sec);
+		/// <summary>
+		/// 現在の実測の打ち切り期限を取得
+		/// </summary>
+		/// <returns>打ち切り期限 (打ち切らない場合は無限大)</returns>
+		double getDeadline(void);
+		/// <summary>
+		/// 実測途中の性能評価値 (経過時間など) を報告し，打ち切るべきかを取得
+		/// </summary>
+		/// <param name="partial_value">実測途中の性能評価値</param>
+		/// <returns>打ち切り期限に達していれば true</returns>
+		bool reportPartial(double partial_value);
+		/// <summary>
+		/// 実測を途中で打ち切ったことを登録
+		/// </summary>
+		/// <param name="bound">打ち切り時点の性能評価値 (実際の値はこれより悪い)</param>
+		void setCensoredMetricValue(double bound);
+		/// <summary>
+		/// 実測券を発行．<br/>
+		/// 実測中の点と重複しない実測候補を選び，結果登録用の識別子とともに返す (複数スレッドから呼び出し可)
+		/// </summary>
+		/// <returns>実測券</returns>
+		Ticket<T> acquire(void);
+		/// <summary>
+		/// 実測券に対応する性能評価値を登録し，探索機構の状態を更新 (発行順によらず，複数スレッドから呼び出し可)
+		/// </summary>
+		/// <param name="ticket_id">実測券の識別子</param>
+		/// <param name="metric_value">実測した性能評価値</param>
+		void complete(std::size_t ticket_id, double metric_value);
+		/// <summary>
+		/// 実測券に対応する実測を途中で打ち切ったことを登録し，探索機構の状態を更新
+		/// </summary>
+		/// <param name="ticket_id">実測券の識別子</param>
+		/// <param name="bound">打ち切り時点の性能評価値 (実際の値はこれより悪い)</param>
+		void abort(std::size_t ticket_id, double bound);
+		/// <summary>
 		/// 登録済性能パラメタの数を取得
 		/// </summary>
 		/// <returns>登録済性能パラメタの数</returns>
@@ -199,11 +672,49 @@ namespace dsice {
 		/// <returns>性能パラメタの暫定最良設定値</returns>
 		std::vector<T> getTentativeBestParameter(void) const;
 		/// <summary>
+		/// 実測済の標本から推定した代理モデルによる性能評価値の予測値を取得
+		/// </summary>
+		/// <param name="parameter">予測対象の性能パラメタ設定値</param>
+		/// <returns>性能評価値の予測値</returns>
+		double predict(const std::vector<T>& parameter) const;
+		/// <summary>
+		/// 実測済の標本から推定した代理モデルによる性能評価値の予測値をまとめて取得
+		/// </summary>
+		/// <param name="parameters">予測対象の性能パラメタ設定値の一覧</param>
+		/// <returns>性能評価値の予測値の一覧</returns>
+		std::vector<double> predictBatch(const std::vector<std::vector<T>>& parameters) const;
+		/// <summary>
 		/// 探索アルゴリズムが終了条件を満たしたかを取得
 		/// </summary>
 		/// <returns>終了条件を満たしていれば true</returns>
 		bool isSearchFinished(void) const;
 		/// <summary>
+		/// 登録された実測の数を取得 (低忠実度段，打ち切り，再計測を含む)
+		/// </summary>
+		/// <returns>登録された実測の数</returns>
+		std::size_t getMeasuredNum(void) const;
+		/// <summary>
+		/// 予算内で実測できる残りの数を取得 (時間予算はこれまでの実測のペースから見積もる)
+		/// </summary>
+		/// <returns>残りの実測数 (予算を設定していない場合や見積もれない場合は std::numeric_limits&lt;std::size_t&gt;::max())</returns>
+		std::size_t getRemainingMeasurementNum(void) const;
+		/// <summary>
+		/// 最初の実測候補の提示からの経過時間を取得
+		/// </summary>
+		/// <returns>経過時間 [秒] (未提示なら 0)</returns>
+		double getElapsedTime(void) const;
+		/// <summary>
+		/// 予算を使い切るまでの残り時間の見込みを取得 (実測数の予算はこれまでの実測のペースから見積もる)
+		/// </summary>
+		/// <returns>残り時間の見込み [秒] (予算を設定していない場合や見積もれない場合は無限大)</returns>
+		double getEstimatedRemainingTime(void) const;
+		/// <summary>
+		/// 予算を使い切るまでに見込まれる最良値の改善量を取得．<br/>
+		/// 直近の 2 区間の改善量の比で改善が等比的に減っていくとみなし，残りの実測数の分だけ足し合わせる
+		/// </summary>
+		/// <returns>最良値の改善量の見込み (0 以上，見積もれない場合は無限大)</returns>
+		double getExpectedImprovement(void) const;
+		/// <summary>
 		/// チューニング結果を表示
 		/// </summary>
 		/// <param name="file_path">出力先ファイル名 (空文字で標準出力)</param>
@@ -0,0 +1,94 @@
+﻿#ifndef PARALLEL_OPERATOR_OPTIONS_HPP_
+#define PARALLEL_OPERATOR_OPTIONS_HPP_
+
+#include <memory>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_metric_type.hpp"
+#include "dsice_thread_pool.hpp"
+#include "initial_design.hpp"
+#include "dsice_operator.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 並列探索用の探索機構 (P_2024B, P_ASYNC, P_MULTI_START) の構築時設定．<br/>
+	/// 各探索機構は自身が用いる項目のみを参照し，それ以外は無視する
+	/// </summary>
+	struct ParallelOperatorOptions {
+		/// <summary>
+		/// 性能評価値が低い値ほど良いかどうか
+		/// </summary>
+		bool lower_is_better = true;
+		/// <summary>
+		/// ログを取るかどうか
+		/// </summary>
+		bool logging_on = false;
+		/// <summary>
+		/// 初期点の決定方法 (P_MULTI_START では常に初期探索)
+		/// </summary>
+		OperatorInitializeWay initialize_way = OperatorInitializeWay::CENTER;
+		/// <summary>
+		/// 近似関数の滑らかさを決定する重み係数 (小さいほどデータ追随，値が大きいほど滑らか)
+		/// </summary>
+		double alpha = 0.1;
+		/// <summary>
+		/// 性能パラメタの同一設定値に複数の性能評価値が登録された際の挙動
+		/// </summary>
+		DatabaseMetricType metric_type = DatabaseMetricType::AverageDouble;
+		/// <summary>
+		/// 初期点の座標 (初期点の決定方法が SPECIFIED の場合のみ参照)
+		/// </summary>
+		coordinate initial_coordinate;
+		/// <summary>
+		/// 基準点移動前の有意差検定で 1 点あたりに許す最大実測回数 (0 なら検定しない，P_2024B のみ)
+		/// </summary>
+		std::size_t significance_test_repetitions = 0;
+		/// <summary>
+		/// 基準点移動前の有意差検定の有意水準 (P_2024B のみ)
+		/// </summary>
+		double significance_level = 0.05;
+		/// <summary>
+		/// 実測待ちの間に次の基準点の探索機構を先読みで構築するかどうか (P_2024B のみ)
+		/// </summary>
+		bool precomputation_on = false;
+		/// <summary>
+		/// 並列に実測できる数 (0 なら直線探索の初期探索を 3 分割で行う)
+		/// </summary>
+		std::size_t worker_num = 0;
+		/// <summary>
+		/// 探索機構の構築や状態更新に用いるスレッドプール (nullptr の場合は逐次実行)
+		/// </summary>
+		std::shared_ptr<ThreadPool> thread_pool = nullptr;
+		/// <summary>
+		/// 方向を間引いて探索する場合に同時変化させる軸数の最大値 (0 なら間引かずに全周辺方向を探索)
+		/// </summary>
+		std::size_t sampled_max_changed_axis_num = 0;
+		/// <summary>
+		/// 方向を間引いて探索する場合の 1 巡あたりの方向数の上限
+		/// </summary>
+		std::size_t sampled_direction_budget = 0;
+		/// <summary>
+		/// 放射状探索前の性能パラメタの選別で固定する効果の大きさの閾値 (最大の効果に対する比，0 なら選別しない，P_2024B のみ)
+		/// </summary>
+		double screening_threshold = 0;
+		/// <summary>
+		/// 全周辺方向の探索の前に最急降下方向の直線探索を行うかどうか (P_2024B のみ)
+		/// </summary>
+		bool gradient_step_on = false;
+		/// <summary>
+		/// 代理モデルの予測値がこの標準偏差倍だけずれても基準点より悪い候補の実測を省略する (0 なら省略しない，P_2024B のみ)
+		/// </summary>
+		double surrogate_skip_confidence = 0;
+		/// <summary>
+		/// 同時に実行する放射状探索の最大数 (P_MULTI_START のみ)
+		/// </summary>
+		std::size_t start_num = 4;
+		/// <summary>
+		/// 初期探索で実測する点の配置 (nullptr なら性能パラメタの値の数が最も多い軸に合わせたランダムな LHD)
+		/// </summary>
+		std::shared_ptr<const InitialDesign> initial_design = nullptr;
+	};
+}
+
+#endif // !PARALLEL_OPERATOR_OPTIONS_HPP_
@@ -0,0 +1,262 @@
+﻿#include <memory>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "direction_line.hpp"
+#include "coordinate_line.hpp"
+#include "dsice_database_core.hpp"
+#include "dsice_searchers_manager.hpp"
+#include "line_single_tri_searcher.hpp"
+#include "parameter_screening_searcher.hpp"
+
+namespace dsice {
+
+	ParameterScreeningSearcher::ParameterScreeningSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& central_coordinate, bool low_value_is_better) :
+		database(search_database)
+	{
+		this->base_coordinate = central_coordinate;
+		this->lower_is_better = low_value_is_better;
+		this->best_point_coordinate = central_coordinate;
+
+		if (this->lower_is_better) {
+			this->best_point_value = std::numeric_limits<double>::max();
+		}
+		else {
+			this->best_point_value = std::numeric_limits<double>::lowest();
+		}
+
+		const space_size& space = this->database->getSpaceSize();
+
+		std::unordered_set<coordinate> listed;
+		this->target_coordinates.push_back(this->base_coordinate);
+		listed.insert(this->base_coordinate);
+
+		for (std::size_t axis = 0; axis < space.size(); axis++) {
+
+			if (space[axis] <= 1) {
+				continue;
+			}
+
+			std::vector<int> direction(space.size(), 0);
+			direction[axis] = 1;
+
+			std::shared_ptr<LineSingleTriSearcher> s = std::make_shared<LineSingleTriSearcher>(this->database, this->base_coordinate, DirectionLine(direction), this->lower_is_better);
+			this->searchers.emplace_back(s, !s->isSearchFinished());
+			this->searcher_axes.push_back(axis);
+
+			for (const coordinate& c : s->getLineInfomation().getPoints()) {
+				if (listed.insert(c).second) {
+					this->target_coordinates.push_back(c);
+				}
+			}
+		}
+
+		// 既に実測済の点から最良点を求めておく
+		for (const coordinate& c : this->target_coordinates) {
+			if (!this->database->hasSample(c)) {
+				continue;
+			}
+
+			double v = this->database->getSampleMetricValue(c);
+			if (this->lower_is_better ? v < this->best_point_value : v > this->best_point_value) {
+				this->best_point_coordinate = c;
+				this->best_point_value = v;
+			}
+		}
+
+		this->updateSuggestedList();
+	}
+
+	ParameterScreeningSearcher::ParameterScreeningSearcher(const ParameterScreeningSearcher& original) :
+		database(original.database)
+	{
+		this->base_coordinate = original.base_coordinate;
+		this->searcher_axes = original.searcher_axes;
+		this->target_coordinates = original.target_coordinates;
+		this->suggested_coordinates = original.suggested_coordinates;
+		this->measured_coordinates = original.measured_coordinates;
+		this->lower_is_better = original.lower_is_better;
+		this->measured_coordinate_buffer = original.measured_coordinate_buffer;
+		this->measured_metric_value_buffer = original.measured_metric_value_buffer;
+		this->best_point_coordinate = original.best_point_coordinate;
+		this->best_point_value = original.best_point_value;
+
+		for (const ManagedSearcher& ms : original.searchers) {
+			std::shared_ptr<LineSingleTriSearcher> s = std::dynamic_pointer_cast<LineSingleTriSearcher>(ms.getSearcher());
+			this->searchers.emplace_back(std::make_shared<LineSingleTriSearcher>(*s), ms.isRunning());
+		}
+	}
+
+	ParameterScreeningSearcher::ParameterScreeningSearcher(const ParameterScreeningSearcher& original, std::shared_ptr<const DatabaseCore> search_database) :
+		ParameterScreeningSearcher(original)
+	{
+		this->database = search_database;
+	}
+
+	ParameterScreeningSearcher::~ParameterScreeningSearcher(void) {
+		// DO_NOTHING
+	}
+
+	void ParameterScreeningSearcher::updateSuggestedList(void) {
+
+		this->suggested_coordinates.clear();
+		std::unordered_set<coordinate> listed;
+
+		if (!this->database->hasSample(this->base_coordinate)) {
+			this->suggested_coordinates.push_back(this->base_coordinate);
+			listed.insert(this->base_coordinate);
+		}
+
+		for (const ManagedSearcher& ms : this->searchers) {
+			if (!ms.isRunning()) {
+				continue;
+			}
+			for (const coordinate& c : ms.getSearcher()->getSuggestedList()) {
+				if (!this->database->hasSample(c) && listed.insert(c).second) {
+					this->suggested_coordinates.push_back(c);
+				}
+			}
+		}
+	}
+
+	const coordinate& ParameterScreeningSearcher::getSuggested(void) const {
+		if (this->suggested_coordinates.empty()) {
+			return this->best_point_coordinate;
+		}
+		else {
+			return this->suggested_coordinates.front();
+		}
+	}
+
+	const coordinate_list& ParameterScreeningSearcher::getSuggestedList(void) const {
+		return this->suggested_coordinates;
+	}
+
+	void ParameterScreeningSearcher::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
+		this->measured_coordinate_buffer.push_back(measured_coordinate);
+		this->measured_metric_value_buffer.push_back(metric_value);
+	}
+
+	bool ParameterScreeningSearcher::updateState(void) {
+
+		if (this->measured_coordinate_buffer.empty()) {
+			return false;
+		}
+
+		std::vector<bool> is_updated(this->searchers.size(), false);
+
+		for (std::size_t i = 0; i < this->measured_coordinate_buffer.size(); i++) {
+
+			const coordinate& c = this->measured_coordinate_buffer[i];
+			double v = this->measured_metric_value_buffer[i];
+
+			if (c.size() != this->base_coordinate.size()) {
+				continue;
+			}
+
+			// 探索基準点は全軸の直線上に，それ以外は基準点と異なる軸が 1 つだけの場合にその軸の直線上にある
+			std::size_t changed_num = 0;
+			std::size_t changed_axis = 0;
+			for (std::size_t axis = 0; axis < c.size(); axis++) {
+				if (c[axis] != this->base_coordinate[axis]) {
+					changed_num++;
+					changed_axis = axis;
+				}
+			}
+			if (changed_num > 1) {
+				continue;
+			}
+
+			this->measured_coordinates.insert(c);
+			if (this->lower_is_better ? v < this->best_point_value : v > this->best_point_value) {
+				this->best_point_coordinate = c;
+				this->best_point_value = v;
+			}
+
+			for (std::size_t j = 0; j < this->searchers.size(); j++) {
+				if (changed_num == 0 || this->searcher_axes[j] == changed_axis) {
+					this->searchers[j].getSearcher()->setMetricValue(c, v);
+					is_updated[j] = true;
+				}
+			}
+		}
+
+		this->measured_coordinate_buffer.clear();
+		this->measured_metric_value_buffer.clear();
+
+		for (std::size_t j = 0; j < this->searchers.size(); j++) {
+			if (is_updated[j]) {
+				this->searchers[j].getSearcher()->updateState();
+				this->searchers[j].setRunningState(!this->searchers[j].getSearcher()->isSearchFinished());
+			}
+		}
+
+		this->updateSuggestedList();
+
+		return true;
+	}
+
+	bool ParameterScreeningSearcher::isSearchFinished(void) const {
+		return this->database->hasSample(this->base_coordinate) && this->getRunningSearchersNum() == 0;
+	}
+
+	const coordinate_list& ParameterScreeningSearcher::getTargetCoordinate(void) const {
+		return this->target_coordinates;
+	}
+
+	const std::unordered_set<coordinate>& ParameterScreeningSearcher::getMeasuredCoordinates(void) const {
+		return this->measured_coordinates;
+	}
+
+	const coordinate& ParameterScreeningSearcher::getBestJudgedCoordinate(void) const {
+		return this->best_point_coordinate;
+	}
+
+	const coordinate& ParameterScreeningSearcher::getBestMeasuredCoordinate(void) const {
+		return this->best_point_coordinate;
+	}
+
+	std::size_t ParameterScreeningSearcher::getManagedSearchersNum(void) const {
+		return this->searchers.size();
+	}
+
+	std::size_t ParameterScreeningSearcher::getRunningSearchersNum(void) const {
+		return static_cast<std::size_t>(std::count_if(this->searchers.begin(), this->searchers.end(), [](const ManagedSearcher& ms) {
+			return ms.isRunning();
+		}));
+	}
+
+	std::size_t ParameterScreeningSearcher::getFinishedSearchersNum(void) const {
+		return this->searchers.size() - this->getRunningSearchersNum();
+	}
+
+	std::vector<double> ParameterScreeningSearcher::getEffectSizes(void) const {
+
+		std::vector<double> effect_sizes(this->base_coordinate.size(), 0);
+
+		for (std::size_t j = 0; j < this->searchers.size(); j++) {
+
+			std::shared_ptr<LineSingleTriSearcher> s = std::dynamic_pointer_cast<LineSingleTriSearcher>(this->searchers[j].getSearcher());
+
+			double max_value = std::numeric_limits<double>::lowest();
+			double min_value = std::numeric_limits<double>::max();
+			for (const coordinate& c : s->getLineInfomation().getPoints()) {
+				if (!this->database->hasSample(c)) {
+					continue;
+				}
+				double v = this->database->getSampleMetricValue(c);
+				max_value = std::max(max_value, v);
+				min_value = std::min(min_value, v);
+			}
+
+			if (max_value >= min_value) {
+				effect_sizes[this->searcher_axes[j]] = max_value - min_value;
+			}
+		}
+
+		return effect_sizes;
+	}
+}
@@ -0,0 +1,167 @@
+﻿#ifndef PARAMETER_SCREENING_SEARCHER_HPP_
+#define PARAMETER_SCREENING_SEARCHER_HPP_
+
+#include <memory>
+#include <vector>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_core.hpp"
+#include "dsice_searchers_manager.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 基準点を通る各軸上の 3 分割点を一斉に実測し，軸ごとの性能評価値の変動幅 (効果の大きさ) を求める探索機構．<br/>
+	/// 性能への影響が小さい性能パラメタを放射状探索の前に見つけるための予備探索であり，各軸の探索は LineSingleTriSearcher に任せる
+	/// </summary>
+	class ParameterScreeningSearcher final : public SearchersManager {
+	private:
+		/// <summary>
+		/// データベースへのアクセス
+		/// </summary>
+		std::shared_ptr<const DatabaseCore> database;
+		/// <summary>
+		/// 探索基準点
+		/// </summary>
+		coordinate base_coordinate;
+		/// <summary>
+		/// 管理中探索機構 (取りうる値が 2 つ以上ある軸ごとに 1 つ)
+		/// </summary>
+		std::vector<ManagedSearcher> searchers;
+		/// <summary>
+		/// 各探索機構が担当する軸の番号
+		/// </summary>
+		std::vector<std::size_t> searcher_axes;
+		/// <summary>
+		/// 担当する探索対象座標
+		/// </summary>
+		coordinate_list target_coordinates;
+		/// <summary>
+		/// 実測すべき点
+		/// </summary>
+		coordinate_list suggested_coordinates;
+		/// <summary>
+		/// 実測済点
+		/// </summary>
+		std::unordered_set<coordinate> measured_coordinates;
+		/// <summary>
+		/// 低い値ほど良いかどうか
+		/// </summary>
+		bool lower_is_better;
+		/// <summary>
+		/// 実測データの更新用バッファ (座標)
+		/// </summary>
+		std::vector<coordinate> measured_coordinate_buffer;
+		/// <summary>
+		/// 実測データの更新用バッファ (性能評価値)
+		/// </summary>
+		std::vector<double> measured_metric_value_buffer;
+		/// <summary>
+		/// 実測済の探索対象点の中で最良点の座標 (未実測の場合は探索基準点)
+		/// </summary>
+		coordinate best_point_coordinate;
+		/// <summary>
+		/// 最良点の値
+		/// </summary>
+		double best_point_value;
+		/// <summary>
+		/// 実測すべき点のリストを作り直す
+		/// </summary>
+		void updateSuggestedList(void);
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="search_database">データベース</param>
+		/// <param name="central_coordinate">探索基準点</param>
+		/// <param name="low_value_is_better">性能評価値が低い値ほど良いのであれば true</param>
+		ParameterScreeningSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& central_coordinate, bool low_value_is_better = true);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		ParameterScreeningSearcher(const ParameterScreeningSearcher& original);
+		/// <summary>
+		/// 参照するデータベースを差し替えるコピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		/// <param name="search_database">参照するデータベース (コピー元のデータベースを複製したもの)</param>
+		ParameterScreeningSearcher(const ParameterScreeningSearcher& original, std::shared_ptr<const DatabaseCore> search_database);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		/// <param name=""></param>
+		~ParameterScreeningSearcher(void);
+		/// <summary>
+		/// 次に実測すべき性能パラメタ性能値 (座標) を取得
+		/// </summary>
+		/// <returns>次に実測すべき性能パラメタ性能値 (座標)</returns>
+		const coordinate& getSuggested(void) const override;
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを取得．<br/>
+		/// 全軸の実測候補を一度に返すため，すべて並列に実測できる
+		/// </summary>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(void) const override;
+		/// <summary>
+		/// 実測データを記録
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void setMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// 状態を更新
+		/// </summary>
+		/// <returns>状態が更新されれば true</returns>
+		bool updateState(void) override;
+		/// <summary>
+		/// 探索基準点と全軸の 3 分割点が実測されたかを取得
+		/// </summary>
+		/// <returns>終了条件を満たしていれば true</returns>
+		bool isSearchFinished(void) const override;
+		/// <summary>
+		/// 探索対象座標のリストを取得
+		/// </summary>
+		/// <returns>探索対象座標のリスト</returns>
+		const coordinate_list& getTargetCoordinate(void) const override;
+		/// <summary>
+		/// 実測済座標を取得
+		/// </summary>
+		/// <returns>実測済座標</returns>
+		const std::unordered_set<coordinate>& getMeasuredCoordinates(void) const override;
+		/// <summary>
+		/// その時点で最良と判定している性能パラメタ設定値 (座標) を取得 (実測済の中での最良点)
+		/// </summary>
+		/// <returns>最良と判定している性能パラメタ設定値 (座標)</returns>
+		const coordinate& getBestJudgedCoordinate(void) const override;
+		/// <summary>
+		/// 実測された中で性能評価値が最良だった性能パラメタ設定値 (座標) を取得
+		/// </summary>
+		/// <returns>実測された中で性能評価値が最良だった性能パラメタ設定値 (座標)</returns>
+		const coordinate& getBestMeasuredCoordinate(void) const override;
+		/// <summary>
+		/// 管理中の内部探索機構の数を取得
+		/// </summary>
+		/// <returns>管理中の内部探索機構の数</returns>
+		std::size_t getManagedSearchersNum(void) const override;
+		/// <summary>
+		/// 管理中内部探索機構のうち，まだ終了条件を満たさずに稼働しているものの数を取得
+		/// </summary>
+		/// <returns>終了条件をまだ満たしていない内部探索機構の数</returns>
+		std::size_t getRunningSearchersNum(void) const override;
+		/// <summary>
+		/// 管理中内部探索機構のうち，終了条件を満たしたものの数を取得
+		/// </summary>
+		/// <returns>終了条件を満たした内部探索機構の数</returns>
+		std::size_t getFinishedSearchersNum(void) const override;
+		/// <summary>
+		/// 軸ごとの効果の大きさ (探索基準点を通る軸上の実測済点における性能評価値の最大値と最小値の差) を取得．<br/>
+		/// 取りうる値が 1 つしかない軸は 0 となる
+		/// </summary>
+		/// <returns>軸ごとの効果の大きさ</returns>
+		std::vector<double> getEffectSizes(void) const;
+	};
+}
+
+#endif // !PARAMETER_SCREENING_SEARCHER_HPP_
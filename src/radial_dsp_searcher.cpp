@@ -1,7 +1,12 @@
 ﻿#include <memory>
 #include <vector>
+#include <tuple>
+#include <map>
+#include <set>
 #include <unordered_map>
 #include <limits>
+#include <algorithm>
+#include <stdexcept>
 
 #include "dsice_search_space.hpp"
 #include "direction_line.hpp"
@@ -10,48 +15,48 @@
 #include "dsice_database_base_point_extension.hpp"
 #include "uni_measurer.hpp"
 #include "line_single_tri_searcher.hpp"
+#include "line_multi_section_searcher.hpp"
 #include "one_dim_dsp_searcher.hpp"
+#include "dsice_thread_pool.hpp"
 #include "radial_dsp_searcher.hpp"
 
 namespace dsice {
 
-	void RadialDspSearcher::updateSuggested(void) {
+	void RadialDspSearcher::requeueSuggestions(std::size_t axis_num, std::size_t searcher_idx) {
 
-		this->suggested_coordinates.clear();
+		// 同時変化軸数ごとに，各探索機構の提案を順位ごとに交互に並べる順序となるキー
+		for (std::size_t r = 0; r < this->queued_suggestion_num[axis_num][searcher_idx]; r++) {
 
-		for (std::size_t i = 0; i < this->searchers.size(); i++) {
-			
-			std::size_t max_suggested_length = 0;
-			std::vector<coordinate_list> suggested;
+			std::map<std::tuple<std::size_t, std::size_t, std::size_t>, coordinate>::iterator q = this->suggestion_queue.find(std::make_tuple(axis_num, r, searcher_idx));
 
-			for (std::size_t j = 0; j < this->searchers[i].size(); j++) {
-				if (this->searchers[i][j].isRunning()) {
-					
-					suggested.push_back(this->searchers[i][j].getSearcher()->getSuggestedList());
-					
-					if (suggested.back().size() > max_suggested_length) {
-						max_suggested_length = suggested.back().size();
-					}
+			// 同じ探索機構が同じ点を複数回提案している場合は既に取り除かれている
+			std::unordered_map<coordinate, std::set<std::pair<std::size_t, std::size_t>>>::iterator s = this->suggesting_searchers.find(q->second);
+			if (s != this->suggesting_searchers.end()) {
+				s->second.erase(std::pair<std::size_t, std::size_t>(axis_num, searcher_idx));
+				if (s->second.empty()) {
+					this->suggesting_searchers.erase(s);
 				}
 			}
 
-			for (std::size_t j = 0; j < max_suggested_length; j++) {
-				for (std::size_t k = 0; k < suggested.size(); k++) {
-					if (j < suggested[k].size()) {
-						this->suggested_coordinates.push_back(suggested[k][j]);
-					}
-				}
+			this->suggestion_queue.erase(q);
+		}
+		this->queued_suggestion_num[axis_num][searcher_idx] = 0;
+
+		if (this->searchers[axis_num][searcher_idx].isRunning()) {
+
+			const coordinate_list& suggested = this->searchers[axis_num][searcher_idx].getSearcher()->getSuggestedList();
+
+			for (std::size_t r = 0; r < suggested.size(); r++) {
+				this->suggestion_queue.emplace(std::make_tuple(axis_num, r, searcher_idx), suggested[r]);
+				this->suggesting_searchers[suggested[r]].emplace(axis_num, searcher_idx);
 			}
+			this->queued_suggestion_num[axis_num][searcher_idx] = suggested.size();
 		}
+
+		this->is_suggested_list_outdated = true;
 	}
 
-	RadialDspSearcher::RadialDspSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& central_coordinate, std::size_t max_changed_axis_num, bool low_value_is_better, double alpha):
-		database(search_database)
-	{
-		this->base_coordinate = central_coordinate;
-		this->lower_is_better = low_value_is_better;
-		this->dsp_alpha = alpha;
-		this->best_judged_point_coordinate = this->base_coordinate;
+	void RadialDspSearcher::initializeSearchers(const std::vector<DirectionLine>& target_lines, std::size_t max_changed_axis_num, std::size_t worker_num) {
 
 		// Searcher を入れる場所を作成 (0 に中心実測機構，1 から 1 次元探索機構)
 		for (std::size_t i = 0; i <= max_changed_axis_num; i++) {
@@ -76,47 +81,136 @@ namespace dsice {
 			this->searchers_of_direction.emplace(DirectionLine(this->base_coordinate, this->base_coordinate), std::pair<std::size_t, std::size_t>(0, 0));
 		}
 
+		std::size_t section_num = target_lines.empty() ? 0 : worker_num / target_lines.size();
+
+		// 各方向の探索機構はデータベースを読むだけで互いに独立なので並列に構築し，登録は方向順に行う
+		std::vector<std::shared_ptr<Searcher>> new_searchers(target_lines.size());
+		ThreadPool::run(this->thread_pool, target_lines.size(), [this, &target_lines, &new_searchers, section_num](std::size_t i) {
+
+			// 3 分割で足りる場合は従来の初期探索を使う
+			std::shared_ptr<Searcher> new_searcher1;
+			if (section_num > 2) {
+				new_searcher1 = std::make_shared<LineMultiSectionSearcher>(this->database, this->base_coordinate, target_lines[i], this->lower_is_better, section_num);
+			}
+			else {
+				new_searcher1 = std::make_shared<LineSingleTriSearcher>(this->database, this->base_coordinate, target_lines[i], this->lower_is_better);
+			}
+
+			if (new_searcher1->isSearchFinished()) {
+				new_searchers[i] = std::make_shared<OneDimDspSearcher>(this->database, this->base_coordinate, target_lines[i], this->lower_is_better, this->dsp_alpha);
+			}
+			else {
+				new_searchers[i] = new_searcher1;
+			}
+		});
+
+		for (std::size_t i = 0; i < target_lines.size(); i++) {
+
+			const DirectionLine& target_line = target_lines[i];
+
+			// 重複を避けて調査
+			if (!this->searchers_of_direction.contains(target_line) && !this->finished_direction.contains(target_line)) {
+
+				std::size_t axis_num = target_line.getDirectionDimension();
+				std::size_t idx = this->searchers[axis_num].size();
+
+				if (new_searchers[i]->isSearchFinished()) {
+					this->finished_direction.insert(target_line);
+				}
+				else {
+					this->searchers[axis_num].emplace_back(new_searchers[i]);
+					this->searchers_of_direction.emplace(target_line, std::pair<std::size_t, std::size_t>(axis_num, idx));
+					this->target_coorinates.insert(this->target_coorinates.end(), new_searchers[i]->getTargetCoordinate().begin(), new_searchers[i]->getTargetCoordinate().end());
+				}
+			}
+		}
+
+		for (std::size_t i = 0; i < this->searchers.size(); i++) {
+			this->queued_suggestion_num.emplace_back(this->searchers[i].size(), 0);
+			this->is_base_value_pending.emplace_back(this->searchers[i].size(), false);
+			for (std::size_t j = 0; j < this->searchers[i].size(); j++) {
+				this->requeueSuggestions(i, j);
+			}
+		}
+	}
+
+	void RadialDspSearcher::detachSearcher(std::size_t axis_num, std::size_t searcher_idx) {
+
+		ManagedSearcher& target = this->searchers[axis_num][searcher_idx];
+		bool is_borrowed = this->borrowed_searchers.erase(std::make_pair(axis_num, searcher_idx)) > 0;
+		if (!is_borrowed && !target.isSearcherShared()) {
+			return;
+		}
+
+		std::shared_ptr<Searcher> s0 = target.getSearcher();
+		if (std::shared_ptr<LineSingleTriSearcher> s1 = std::dynamic_pointer_cast<LineSingleTriSearcher>(s0)) {
+			target = ManagedSearcher(std::make_shared<LineSingleTriSearcher>(*s1), target.isRunning());
+		}
+		else if (std::shared_ptr<LineMultiSectionSearcher> s3 = std::dynamic_pointer_cast<LineMultiSectionSearcher>(s0)) {
+			target = ManagedSearcher(std::make_shared<LineMultiSectionSearcher>(*s3, this->database), target.isRunning());
+		}
+		else {
+			std::shared_ptr<OneDimDspSearcher> s2 = std::dynamic_pointer_cast<OneDimDspSearcher>(s0);
+			target = ManagedSearcher(std::make_shared<OneDimDspSearcher>(*s2, this->database), target.isRunning());
+		}
+	}
+
+	RadialDspSearcher::RadialDspSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& central_coordinate, std::size_t max_changed_axis_num, bool low_value_is_better, double alpha, const std::unordered_set<DirectionLine>& excluded_directions, std::size_t worker_num, std::shared_ptr<ThreadPool> pool):
+		database(search_database), thread_pool(pool)
+	{
+		this->base_coordinate = central_coordinate;
+		this->lower_is_better = low_value_is_better;
+		this->dsp_alpha = alpha;
+		this->best_judged_point_coordinate = this->base_coordinate;
+
 		AroundPoints around_points(this->database->getSpaceSize(), this->base_coordinate, max_changed_axis_num);
 		const coordinate_list& around_coordinates = around_points.getAroundPoints();
 		std::shared_ptr<const DatabaseBasePointExtension> tmp_basepoint_database = std::dynamic_pointer_cast<const DatabaseBasePointExtension>(this->database);
+
+		// 多分割数を決めるため，先に探索対象の方向を数える
+		std::vector<DirectionLine> target_lines;
+		std::unordered_set<DirectionLine> listed_lines;
 		for (const coordinate& one_coor : around_coordinates) {
 
 			DirectionLine target_line(this->base_coordinate, one_coor);
 
 			// 探索済方向はスキップ
-			if (tmp_basepoint_database->isSearchedDirection(this->base_coordinate, target_line)) {
+			if (tmp_basepoint_database->isSearchedDirection(this->base_coordinate, target_line) || excluded_directions.contains(target_line)) {
 				continue;
 			}
 
-			// 重複を避けて調査
-			if (!this->searchers_of_direction.contains(target_line) && !this->finished_direction.contains(target_line)) {
+			if (listed_lines.insert(target_line).second) {
+				target_lines.push_back(target_line);
+			}
+		}
 
-				std::size_t axis_num = target_line.getDirectionDimension();
-				std::size_t idx = this->searchers[axis_num].size();
+		this->initializeSearchers(target_lines, max_changed_axis_num, worker_num);
+	}
 
-				std::shared_ptr<LineSingleTriSearcher> new_searcher1 = std::make_shared<LineSingleTriSearcher>(this->database, this->base_coordinate, target_line, this->lower_is_better);
-				if (new_searcher1->isSearchFinished()) {
+	RadialDspSearcher::RadialDspSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& central_coordinate, const std::vector<DirectionLine>& target_directions, bool low_value_is_better, double alpha, std::size_t worker_num, std::shared_ptr<ThreadPool> pool) :
+		database(search_database), thread_pool(pool)
+	{
+		this->base_coordinate = central_coordinate;
+		this->lower_is_better = low_value_is_better;
+		this->dsp_alpha = alpha;
+		this->best_judged_point_coordinate = this->base_coordinate;
 
-					std::shared_ptr<OneDimDspSearcher> new_searcher2 = std::make_shared<OneDimDspSearcher>(this->database, this->base_coordinate, target_line, this->lower_is_better, this->dsp_alpha);
+		std::vector<DirectionLine> target_lines;
+		std::unordered_set<DirectionLine> listed_lines;
+		std::size_t max_changed_axis_num = 0;
+		for (const DirectionLine& target_line : target_directions) {
 
-					if (new_searcher2->isSearchFinished()) {
-						this->finished_direction.insert(target_line);
-					}
-					else {
-						this->searchers[axis_num].emplace_back(new_searcher2);
-						this->searchers_of_direction.emplace(target_line, std::pair<std::size_t, std::size_t>(axis_num, idx));
-						this->target_coorinates.insert(this->target_coorinates.end(), new_searcher2->getTargetCoordinate().begin(), new_searcher2->getTargetCoordinate().end());
-					}
-				}
-				else {
-					this->searchers[axis_num].emplace_back(new_searcher1);
-					this->searchers_of_direction.emplace(target_line, std::pair<std::size_t, std::size_t>(axis_num, idx));
-					this->target_coorinates.insert(this->target_coorinates.end(), new_searcher1->getTargetCoordinate().begin(), new_searcher1->getTargetCoordinate().end());
-				}
+			if (!target_line.hasDimension()) {
+				throw std::invalid_argument("target directions must not include zero direction.");
+			}
+
+			if (listed_lines.insert(target_line).second) {
+				target_lines.push_back(target_line);
+				max_changed_axis_num = std::max(max_changed_axis_num, target_line.getDirectionDimension());
 			}
 		}
 
-		this->updateSuggested();
+		this->initializeSearchers(target_lines, max_changed_axis_num, worker_num);
 	}
 
 	RadialDspSearcher::RadialDspSearcher(const RadialDspSearcher& original):
@@ -126,7 +220,12 @@ namespace dsice {
 		this->searchers_of_direction = original.searchers_of_direction;
 		this->finished_direction = original.finished_direction;
 		this->target_coorinates = original.target_coorinates;
+		this->suggestion_queue = original.suggestion_queue;
+		this->queued_suggestion_num = original.queued_suggestion_num;
+		this->suggesting_searchers = original.suggesting_searchers;
 		this->suggested_coordinates = original.suggested_coordinates;
+		this->is_suggested_list_outdated = original.is_suggested_list_outdated;
+		this->measured_coordinates = original.measured_coordinates;
 		this->lower_is_better = original.lower_is_better;
 		this->dsp_alpha = original.dsp_alpha;
 		this->measured_coordinate_buffer = original.measured_coordinate_buffer;
@@ -136,19 +235,24 @@ namespace dsice {
 		this->best_measured_point_coordinate = original.best_measured_point_coordinate;
 		this->best_point_value = original.best_point_value;
 		this->is_found_better_point = original.is_found_better_point;
+		this->base_metric_value = original.base_metric_value;
+		this->is_base_value_pending = original.is_base_value_pending;
+		this->thread_pool = original.thread_pool;
 
-		for (std::size_t i = 0; i < original.searchers.size(); i++) {
-			
-			this->searchers.emplace_back();
+		// 内部探索機構はコピー元と共有し，実測データを渡す時点で初めて複製する (detachSearcher())
+		this->searchers = original.searchers;
+		this->borrowed_searchers = original.borrowed_searchers;
+	}
 
-			for (std::size_t j = 0; j < original.searchers[i].size(); j++) {
-				if (std::shared_ptr<LineSingleTriSearcher> s1 = std::dynamic_pointer_cast<LineSingleTriSearcher>(original.searchers[i][j].getSearcher())) {
-					this->searchers[i].emplace_back(std::make_shared<LineSingleTriSearcher>(*s1), original.searchers[i][j].isRunning());
-				}
-				else {
-					std::shared_ptr<OneDimDspSearcher> s2 = std::dynamic_pointer_cast<OneDimDspSearcher>(original.searchers[i][j].getSearcher());
-					this->searchers[i].emplace_back(std::make_shared<OneDimDspSearcher>(*s2), original.searchers[i][j].isRunning());
-				}
+	RadialDspSearcher::RadialDspSearcher(const RadialDspSearcher& original, std::shared_ptr<const DatabaseCore> search_database) :
+		RadialDspSearcher(original)
+	{
+		this->database = search_database;
+
+		// 共有をやめた後もコピー元のデータベースを参照し続けないよう，引き継いだ内部探索機構はすべて複製対象とする
+		for (std::size_t i = 0; i < this->searchers.size(); i++) {
+			for (std::size_t j = 0; j < this->searchers[i].size(); j++) {
+				this->borrowed_searchers.emplace(i, j);
 			}
 		}
 	}
@@ -158,21 +262,57 @@ namespace dsice {
 	}
 
 	const coordinate& RadialDspSearcher::getSuggested(void) const {
-		if (this->suggested_coordinates.empty()) {
+		if (this->suggestion_queue.empty()) {
 			return this->best_judged_point_coordinate;
 		}
 		else {
-			return this->suggested_coordinates[0];
+			return this->suggestion_queue.begin()->second;
 		}
 	}
 
 	const coordinate_list& RadialDspSearcher::getSuggestedList(void) const {
+
+		if (this->is_suggested_list_outdated) {
+
+			this->suggested_coordinates.clear();
+			this->suggested_coordinates.reserve(this->suggestion_queue.size());
+
+			// 複数の探索機構が提案する点は 1 度だけ並べる (実測値は updateState() で提案しているすべての探索機構に渡される)
+			std::unordered_set<coordinate> listed(this->measured_coordinate_buffer.begin(), this->measured_coordinate_buffer.end());
+			for (const std::pair<const std::tuple<std::size_t, std::size_t, std::size_t>, coordinate>& q : this->suggestion_queue) {
+				if (!this->measured_coordinates.contains(q.second) && listed.insert(q.second).second) {
+					this->suggested_coordinates.push_back(q.second);
+				}
+			}
+
+			this->is_suggested_list_outdated = false;
+		}
+
 		return this->suggested_coordinates;
 	}
 
+	coordinate_list RadialDspSearcher::getSuggestedList(std::size_t max_num, const std::unordered_set<coordinate>& excluded_coordinates) const {
+
+		coordinate_list tmp_l;
+		std::unordered_set<coordinate> listed = excluded_coordinates;
+		listed.insert(this->measured_coordinate_buffer.begin(), this->measured_coordinate_buffer.end());
+
+		for (const std::pair<const std::tuple<std::size_t, std::size_t, std::size_t>, coordinate>& q : this->suggestion_queue) {
+			if (tmp_l.size() >= max_num) {
+				break;
+			}
+			if (!this->measured_coordinates.contains(q.second) && listed.insert(q.second).second) {
+				tmp_l.push_back(q.second);
+			}
+		}
+
+		return tmp_l;
+	}
+
 	void RadialDspSearcher::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
 		this->measured_coordinate_buffer.push_back(measured_coordinate);
 		this->measured_metric_value_buffer.push_back(metric_value);
+		this->is_suggested_list_outdated = true;
 	}
 
 	bool RadialDspSearcher::updateState(void) {
@@ -181,6 +321,11 @@ namespace dsice {
 			return false;
 		}
 
+		// 提案点が変わりうる探索機構 (データを渡したもの) のみキューを更新する
+		std::set<std::pair<std::size_t, std::size_t>> affected_searchers;
+		// 探索機構ごとに渡す実測データ (座標，値，渡した後に状態を更新するか) を実測順に並べたもの
+		std::map<std::pair<std::size_t, std::size_t>, std::vector<std::tuple<coordinate, double, bool>>> dispatched_data;
+
 		// データ登録
 		for (std::size_t i = 0; i < this->measured_coordinate_buffer.size(); i++) {
 
@@ -190,24 +335,92 @@ namespace dsice {
 
 			DirectionLine direction(this->base_coordinate, measured_coordinate);
 
-			if (!this->searchers_of_direction.contains(direction)) {
-				continue;
+			// 方向の担当に加え，同じ点を提案している探索機構すべてに 1 回の実測結果を渡す
+			std::set<std::pair<std::size_t, std::size_t>> interested_searchers;
+			bool is_managed_direction = this->searchers_of_direction.contains(direction);
+			if (is_managed_direction) {
+				interested_searchers.insert(this->searchers_of_direction.at(direction));
 			}
+			if (this->suggesting_searchers.contains(measured_coordinate)) {
+				const std::set<std::pair<std::size_t, std::size_t>>& s = this->suggesting_searchers.at(measured_coordinate);
+				interested_searchers.insert(s.begin(), s.end());
+			}
+
+			for (const std::pair<std::size_t, std::size_t>& searcher_idx : interested_searchers) {
+				if (this->searchers[searcher_idx.first][searcher_idx.second].isRunning()) {
+
+					// 渡していない基準点の値は，この実測値とまとめて 1 回の状態更新で反映させる
+					if (this->is_base_value_pending[searcher_idx.first][searcher_idx.second]) {
+						dispatched_data[searcher_idx].emplace_back(this->base_coordinate, this->base_metric_value, false);
+						this->is_base_value_pending[searcher_idx.first][searcher_idx.second] = false;
+					}
+
+					dispatched_data[searcher_idx].emplace_back(measured_coordinate, metric_value, true);
+					affected_searchers.insert(searcher_idx);
+				}
+			}
+
+			// 基準点の値は全方向で共有されるが，ここで全探索機構を再計算すると方向数に比例して重くなる．
+			// 基準点を待っていない探索機構には，次に実測値を渡す際にまとめて渡す
+			if (is_managed_direction && measured_coordinate == this->base_coordinate) {
 
-			const std::pair<std::size_t, std::size_t>& searcher_idx = this->searchers_of_direction.at(direction);
-			this->searchers[searcher_idx.first][searcher_idx.second].getSearcher()->setMetricValue(measured_coordinate, metric_value);
-			this->searchers[searcher_idx.first][searcher_idx.second].getSearcher()->updateState();
+				this->base_metric_value = metric_value;
 
-			if (measured_coordinate == this->base_coordinate) {
 				for (std::size_t j = 1; j < this->searchers.size();j++) {
 					for (std::size_t k = 0; k < this->searchers[j].size(); k++) {
-						this->searchers[j][k].getSearcher()->setMetricValue(measured_coordinate, metric_value);
-						this->searchers[j][k].getSearcher()->updateState();
+						if (!interested_searchers.contains(std::pair<std::size_t, std::size_t>(j, k))) {
+							this->is_base_value_pending[j][k] = true;
+						}
 					}
 				}
 			}
 		}
 
+		// 値を渡した探索機構の状態更新 (d-Spline の再計算など) は互いに独立なので並列に行う (各探索機構内では実測順に 1 件ずつ)
+		std::vector<std::pair<std::size_t, std::size_t>> update_targets;
+		for (const std::pair<const std::pair<std::size_t, std::size_t>, std::vector<std::tuple<coordinate, double, bool>>>& d : dispatched_data) {
+			update_targets.push_back(d.first);
+		}
+		for (const std::pair<std::size_t, std::size_t>& idx : update_targets) {
+			this->detachSearcher(idx.first, idx.second);
+		}
+		ThreadPool::run(this->thread_pool, update_targets.size(), [this, &update_targets, &dispatched_data](std::size_t k) {
+
+			std::shared_ptr<Searcher> s = this->searchers[update_targets[k].first][update_targets[k].second].getSearcher();
+
+			for (const std::tuple<coordinate, double, bool>& d : dispatched_data.at(update_targets[k])) {
+				s->setMetricValue(std::get<0>(d), std::get<1>(d));
+				if (std::get<2>(d)) {
+					s->updateState();
+				}
+			}
+		});
+
+		// 初期探索を終えた直線の d-Spline 探索機構の構築も並列に行う
+		std::vector<std::pair<std::size_t, std::size_t>> switching_targets;
+		for (std::size_t i = 1; i < this->searchers.size(); i++) {
+			for (std::size_t j = 0; j < this->searchers[i].size(); j++) {
+				if (this->searchers[i][j].isRunning() && this->searchers[i][j].getSearcher()->isSearchFinished()) {
+					std::shared_ptr<Searcher> s0 = this->searchers[i][j].getSearcher();
+					if (std::dynamic_pointer_cast<LineSingleTriSearcher>(s0) != nullptr || std::dynamic_pointer_cast<LineMultiSectionSearcher>(s0) != nullptr) {
+						switching_targets.emplace_back(i, j);
+					}
+				}
+			}
+		}
+
+		std::vector<std::shared_ptr<OneDimDspSearcher>> switched_searchers(switching_targets.size());
+		ThreadPool::run(this->thread_pool, switching_targets.size(), [this, &switching_targets, &switched_searchers](std::size_t k) {
+
+			std::shared_ptr<Searcher> s0 = this->searchers[switching_targets[k].first][switching_targets[k].second].getSearcher();
+			std::shared_ptr<LineSingleTriSearcher> s1 = std::dynamic_pointer_cast<LineSingleTriSearcher>(s0);
+			std::shared_ptr<LineMultiSectionSearcher> s3 = std::dynamic_pointer_cast<LineMultiSectionSearcher>(s0);
+			const DirectionLine& line_direction = s1 != nullptr ? s1->getLineInfomation().getLineDirection() : s3->getLineInfomation().getLineDirection();
+
+			switched_searchers[k] = std::make_shared<OneDimDspSearcher>(this->database, this->base_coordinate, line_direction, this->lower_is_better, this->dsp_alpha);
+		});
+
+		std::size_t switched_idx = 0;
 		std::vector<std::shared_ptr<Searcher>> tmp_finished_direction_searcher;
 
 		// 探索機構の終了チェック
@@ -221,6 +434,7 @@ namespace dsice {
 				}
 
 				this->searchers[0][0].setRunningState(false);
+				affected_searchers.emplace(0, 0);
 				this->searchers_of_direction.erase(DirectionLine(this->base_coordinate, this->base_coordinate));
 			}
 		}
@@ -232,18 +446,30 @@ namespace dsice {
 
 					if (s0->isSearchFinished()) {
 
-						if (std::shared_ptr<LineSingleTriSearcher> s1 = std::dynamic_pointer_cast<LineSingleTriSearcher>(s0)) {
+						std::shared_ptr<LineSingleTriSearcher> s1 = std::dynamic_pointer_cast<LineSingleTriSearcher>(s0);
+						std::shared_ptr<LineMultiSectionSearcher> s3 = std::dynamic_pointer_cast<LineMultiSectionSearcher>(s0);
 
-							std::shared_ptr<OneDimDspSearcher> new_searcher = std::make_shared<OneDimDspSearcher>(this->database, this->base_coordinate, s1->getLineInfomation().getLineDirection(), this->lower_is_better, this->dsp_alpha);
+						if (s1 != nullptr || s3 != nullptr) {
+
+							// コピーしておかないと Searcher の差し替えで参照先が消える
+							DirectionLine line_direction = s1 != nullptr ? s1->getLineInfomation().getLineDirection() : s3->getLineInfomation().getLineDirection();
+
+							std::shared_ptr<OneDimDspSearcher> new_searcher = switched_searchers[switched_idx];
+							switched_idx++;
 
 							if (new_searcher->isSearchFinished()) {
-								this->searchers[i][j].setRunningState(false);
-								this->searchers_of_direction.erase(s1->getLineInfomation().getLineDirection());
-								this->finished_direction.insert(s1->getLineInfomation().getLineDirection());
+								// 近似曲線を後から参照できるよう，終了済でも d-Spline 探索機構に差し替えておく
+								this->searchers[i][j] = ManagedSearcher(new_searcher, false);
+								this->borrowed_searchers.erase(std::make_pair(i, j));
+								this->searchers_of_direction.erase(line_direction);
+								this->finished_direction.insert(line_direction);
 								tmp_finished_direction_searcher.push_back(new_searcher);
 							}
 							else {
+								// データベースから作り直すため基準点の値も反映済
 								this->searchers[i][j] = ManagedSearcher(new_searcher);
+								this->borrowed_searchers.erase(std::make_pair(i, j));
+								this->is_base_value_pending[i][j] = false;
 							}
 						}
 						else {
@@ -281,10 +507,30 @@ namespace dsice {
 			}
 		}
 
-		this->updateSuggested();
+		for (const std::pair<std::size_t, std::size_t>& idx : affected_searchers) {
+			this->requeueSuggestions(idx.first, idx.second);
+		}
 
 		this->measured_coordinate_buffer.clear();
 		this->measured_metric_value_buffer.clear();
+		this->is_suggested_list_outdated = true;
+
+		// 他の探索 (多点開始型の他の開始点など) で実測済の点を新たに提案した探索機構には，再実測せずデータベースの値を渡して先へ進める
+		std::unordered_set<coordinate> fed_coordinates;
+		for (const std::pair<std::size_t, std::size_t>& idx : affected_searchers) {
+			for (std::size_t r = 0; r < this->queued_suggestion_num[idx.first][idx.second]; r++) {
+
+				const coordinate& c = this->suggestion_queue.at(std::make_tuple(idx.first, r, idx.second));
+
+				if (this->database->hasSample(c) && !this->measured_coordinates.contains(c) && fed_coordinates.insert(c).second) {
+					this->setMetricValue(c, this->database->getSampleMetricValue(c));
+				}
+			}
+		}
+
+		if (!this->measured_coordinate_buffer.empty()) {
+			this->updateState();
+		}
 
 		return true;
 	}
@@ -329,4 +575,111 @@ namespace dsice {
 		// 推定途中の方向はさらに良い値があってもおかしくないので返さない
 		return this->finished_direction;
 	}
+
+	std::unordered_map<std::size_t, double> RadialDspSearcher::getAxisSlopes(void) const {
+
+		std::unordered_map<std::size_t, double> slopes;
+
+		if (this->searchers.size() < 2) {
+			return slopes;
+		}
+
+		for (const ManagedSearcher& ms : this->searchers[1]) {
+
+			std::shared_ptr<OneDimDspSearcher> s = std::dynamic_pointer_cast<OneDimDspSearcher>(ms.getSearcher());
+			if (s == nullptr) {
+				continue;
+			}
+
+			const std::vector<long long>& direction = s->getLineInfomation().getLineDirection().getDirection();
+			for (std::size_t i = 0; i < direction.size(); i++) {
+				if (direction[i] != 0) {
+					slopes[i] = s->getFittedSlope(this->base_coordinate);
+					break;
+				}
+			}
+		}
+
+		return slopes;
+	}
+
+	coordinate_list RadialDspSearcher::getSpeculativeCandidates(const std::unordered_set<coordinate>& excluded_coordinates, std::size_t max_num) const {
+
+		coordinate_list tmp_l;
+		std::unordered_set<coordinate> listed = excluded_coordinates;
+
+		// 1. 探索中の直線上の点を，各直線の現在の提案点に近い順に直線間で交互に並べる
+		std::vector<coordinate_list> line_candidates;
+		std::size_t max_line_length = 0;
+		for (std::size_t i = 1; i < this->searchers.size(); i++) {
+			for (std::size_t j = 0; j < this->searchers[i].size(); j++) {
+				if (!this->searchers[i][j].isRunning()) {
+					continue;
+				}
+
+				std::shared_ptr<Searcher> s = this->searchers[i][j].getSearcher();
+				const coordinate& suggested = s->getSuggested();
+
+				std::vector<std::pair<std::size_t, coordinate>> ranked;
+				for (const coordinate& c : s->getTargetCoordinate()) {
+					if (this->database->hasSample(c)) {
+						continue;
+					}
+
+					std::size_t distance = 0;
+					for (std::size_t k = 0; k < c.size() && k < suggested.size(); k++) {
+						distance += c[k] > suggested[k] ? c[k] - suggested[k] : suggested[k] - c[k];
+					}
+					ranked.emplace_back(distance, c);
+				}
+				std::stable_sort(ranked.begin(), ranked.end(), [](const std::pair<std::size_t, coordinate>& a, const std::pair<std::size_t, coordinate>& b) {
+					return a.first < b.first;
+				});
+
+				line_candidates.emplace_back();
+				for (const std::pair<std::size_t, coordinate>& r : ranked) {
+					line_candidates.back().push_back(r.second);
+				}
+				if (line_candidates.back().size() > max_line_length) {
+					max_line_length = line_candidates.back().size();
+				}
+			}
+		}
+
+		for (std::size_t rank = 0; rank < max_line_length && tmp_l.size() < max_num; rank++) {
+			for (std::size_t k = 0; k < line_candidates.size() && tmp_l.size() < max_num; k++) {
+				if (rank < line_candidates[k].size() && listed.insert(line_candidates[k][rank]).second) {
+					tmp_l.push_back(line_candidates[k][rank]);
+				}
+			}
+		}
+
+		// 2. 次の基準点になる見込みが高い暫定最良点の隣接点
+		if (this->is_found_better_point && tmp_l.size() < max_num) {
+			AroundPoints next_base_around(this->database->getSpaceSize(), this->best_judged_point_coordinate, 1);
+			for (const coordinate& c : next_base_around.getAroundPoints()) {
+				if (tmp_l.size() >= max_num) {
+					break;
+				}
+				if (!this->database->hasSample(c) && listed.insert(c).second) {
+					tmp_l.push_back(c);
+				}
+			}
+		}
+
+		// 3. 過去の探索で探索済とされ直線探索の対象外となった方向も含めた基準点の周辺点
+		if (tmp_l.size() < max_num) {
+			AroundPoints base_around(this->database->getSpaceSize(), this->base_coordinate, this->searchers.size() - 1);
+			for (const coordinate& c : base_around.getAroundPoints()) {
+				if (tmp_l.size() >= max_num) {
+					break;
+				}
+				if (!this->database->hasSample(c) && listed.insert(c).second) {
+					tmp_l.push_back(c);
+				}
+			}
+		}
+
+		return tmp_l;
+	}
 }
\ No newline at end of file
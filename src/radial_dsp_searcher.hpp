@@ -3,6 +3,9 @@
 
 #include <memory>
 #include <vector>
+#include <tuple>
+#include <map>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -10,6 +13,7 @@
 #include "direction_line.hpp"
 #include "dsice_database_core.hpp"
 #include "dsice_searchers_manager.hpp"
+#include "dsice_thread_pool.hpp"
 
 namespace dsice {
 
@@ -43,9 +47,29 @@ namespace dsice {
 		/// </summary>
 		coordinate_list target_coorinates;
 		/// <summary>
-		/// 実測すべき点
+		/// 実測すべき点 (同時変化軸数，内部探索機構内での提案順位，内部探索機構の番号の順に並ぶ優先度付きキュー)
 		/// </summary>
-		coordinate_list suggested_coordinates;
+		std::map<std::tuple<std::size_t, std::size_t, std::size_t>, coordinate> suggestion_queue;
+		/// <summary>
+		/// 各内部探索機構がキューに登録している提案点の数
+		/// </summary>
+		std::vector<std::vector<std::size_t>> queued_suggestion_num;
+		/// <summary>
+		/// 座標ごとの，その座標を提案している内部探索機構 (同時変化軸数，番号)
+		/// </summary>
+		std::unordered_map<coordinate, std::set<std::pair<std::size_t, std::size_t>>> suggesting_searchers;
+		/// <summary>
+		/// コピー元から引き継ぎ，まだコピー元のデータベースを参照している内部探索機構 (同時変化軸数，番号)
+		/// </summary>
+		std::set<std::pair<std::size_t, std::size_t>> borrowed_searchers;
+		/// <summary>
+		/// 実測すべき点のリスト (キューから必要になった時点で作成)
+		/// </summary>
+		mutable coordinate_list suggested_coordinates;
+		/// <summary>
+		/// 実測すべき点のリストがキューの内容と一致していないかどうか
+		/// </summary>
+		mutable bool is_suggested_list_outdated = true;
 		/// <summary>
 		/// 実測済点
 		/// </summary>
@@ -88,9 +112,36 @@ namespace dsice {
 		/// </summary>
 		bool is_found_better_point = false;
 		/// <summary>
-		/// 各 Searcher の結果にしたがって探索対象をリストに追加
+		/// 探索基準点の実測値
+		/// </summary>
+		double base_metric_value = 0;
+		/// <summary>
+		/// 各内部探索機構に探索基準点の実測値をまだ渡していないかどうか (次にその探索機構へ実測値を渡す際にまとめて渡す)
+		/// </summary>
+		std::vector<std::vector<bool>> is_base_value_pending;
+		/// <summary>
+		/// 内部探索機構の構築と状態更新に用いるスレッドプール (nullptr の場合は逐次実行)
+		/// </summary>
+		std::shared_ptr<ThreadPool> thread_pool;
+		/// <summary>
+		/// 指定した内部探索機構の提案点をキューに登録し直す (終了済であれば取り除くのみ)
+		/// </summary>
+		/// <param name="axis_num">内部探索機構の同時変化軸数</param>
+		/// <param name="searcher_idx">内部探索機構の番号</param>
+		void requeueSuggestions(std::size_t axis_num, std::size_t searcher_idx);
+		/// <summary>
+		/// 基点と指定方向の内部探索機構を構築して登録 (コンストラクタの共通処理)
 		/// </summary>
-		void updateSuggested(void);
+		/// <param name="target_lines">探索対象の方向 (重複なし)</param>
+		/// <param name="max_changed_axis_num">探索対象の方向の同時変化軸数の最大値</param>
+		/// <param name="worker_num">並列に実測できる数</param>
+		void initializeSearchers(const std::vector<DirectionLine>& target_lines, std::size_t max_changed_axis_num, std::size_t worker_num);
+		/// <summary>
+		/// 内部探索機構をコピー元と共有している場合や，コピー元のデータベースを参照している場合，このインスタンスのデータベースを参照する複製に差し替える (実測データを渡す前に呼ぶ)
+		/// </summary>
+		/// <param name="axis_num">同時変化軸数</param>
+		/// <param name="searcher_idx">同時変化軸数内でのインデックス</param>
+		void detachSearcher(std::size_t axis_num, std::size_t searcher_idx);
 	public:
 		/// <summary>
 		/// コンストラクタ
@@ -100,13 +151,34 @@ namespace dsice {
 		/// <param name="max_changed_axis_num">同時変化させる軸数の最大値</param>
 		/// <param name="low_value_is_better">性能評価値が低い値ほど良いのであれば true</param>
 		/// <param name="alpha">近似関数の滑らかさを決定する重み係数 (小さいほどデータ追随，値が大きいほど滑らか)</param>
-		RadialDspSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& central_coordinate, std::size_t max_changed_axis_num, bool low_value_is_better = true, double alpha = 0.1);
+		/// <param name="excluded_directions">データベースに未記録だが探索済として扱う方向</param>
+		/// <param name="worker_num">並列に実測できる数 (方向数で割った数が 2 より大きい場合，各直線の初期探索を 3 分割ではなくその数の分割点による多分割探索で行う)</param>
+		/// <param name="pool">内部探索機構の構築と状態更新に用いるスレッドプール (nullptr の場合は逐次実行)</param>
+		RadialDspSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& central_coordinate, std::size_t max_changed_axis_num, bool low_value_is_better = true, double alpha = 0.1, const std::unordered_set<DirectionLine>& excluded_directions = {}, std::size_t worker_num = 0, std::shared_ptr<ThreadPool> pool = nullptr);
+		/// <summary>
+		/// 探索する方向を明示するコンストラクタ (周辺点を列挙しないため，パラメタ数が多い場合に方向を間引いて探索する際に用いる)
+		/// </summary>
+		/// <param name="search_database">データベース</param>
+		/// <param name="central_coordinate">基点座標</param>
+		/// <param name="target_directions">探索する方向 (探索済かどうかは確認しない)</param>
+		/// <param name="low_value_is_better">性能評価値が低い値ほど良いのであれば true</param>
+		/// <param name="alpha">近似関数の滑らかさを決定する重み係数 (小さいほどデータ追随，値が大きいほど滑らか)</param>
+		/// <param name="worker_num">並列に実測できる数 (方向数で割った数が 2 より大きい場合，各直線の初期探索を 3 分割ではなくその数の分割点による多分割探索で行う)</param>
+		/// <param name="pool">内部探索機構の構築と状態更新に用いるスレッドプール (nullptr の場合は逐次実行)</param>
+		RadialDspSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate& central_coordinate, const std::vector<DirectionLine>& target_directions, bool low_value_is_better = true, double alpha = 0.1, std::size_t worker_num = 0, std::shared_ptr<ThreadPool> pool = nullptr);
 		/// <summary>
 		/// コピーコンストラクタ
 		/// </summary>
 		/// <param name="original">コピー元</param>
 		RadialDspSearcher(const RadialDspSearcher& original);
 		/// <summary>
+		/// 参照するデータベースを差し替えるコピーコンストラクタ．<br/>
+		/// 内部探索機構はコピー元と共有し，実測データを渡す時点で初めて複製する
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		/// <param name="search_database">参照するデータベース (コピー元のデータベースを複製したもの)</param>
+		RadialDspSearcher(const RadialDspSearcher& original, std::shared_ptr<const DatabaseCore> search_database);
+		/// <summary>
 		/// デストラクタ
 		/// </summary>
 		~RadialDspSearcher(void);
@@ -116,12 +188,23 @@ namespace dsice {
 		/// <returns>次に実測すべき性能パラメタ性能値 (座標)</returns>
 		const coordinate& getSuggested(void) const override;
 		/// <summary>
-		/// 実測すべき性能パラメタ性能値 (座標) のリストを取得
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを優先度順に重複なく取得．<br/>
+		/// 実測済および値を受け取って状態更新待ちの点は含めない
 		/// </summary>
 		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
 		const coordinate_list& getSuggestedList(void) const override;
 		/// <summary>
-		/// 実測データをデータベースと次回更新用バッファに記録
+		/// 実測すべき性能パラメタ性能値 (座標) を優先度順に重複なく指定数まで取得．<br/>
+		/// 全体のリストを作成せずにキューの先頭から取り出し，実測済の点と除外指定された点は含めない
+		/// </summary>
+		/// <param name="max_num">取得する最大数</param>
+		/// <param name="excluded_coordinates">除外する座標 (実測中の点など)</param>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		coordinate_list getSuggestedList(std::size_t max_num, const std::unordered_set<coordinate>& excluded_coordinates = {}) const;
+		/// <summary>
+		/// 実測データをデータベースと次回更新用バッファに記録．<br/>
+		/// 状態更新時，実測データはその方向の内部探索機構と，その点を提案しているすべての内部探索機構に渡される．
+		/// 更新後に他の探索で実測済の点を提案した内部探索機構には，データベースの値が渡される
 		/// </summary>
 		/// <param name="measured_coordinate">実測した座標</param>
 		/// <param name="metric_value">実測した値</param>
@@ -183,6 +266,19 @@ namespace dsice {
 		/// </summary>
 		/// <returns>この機構により探索が完了した方向情報</returns>
 		const std::unordered_set<DirectionLine>& getFinishedDirections(void) const;
+		/// <summary>
+		/// 1 軸のみ変化させる方向のうち d-Spline 近似を行った方向について，探索基準点における近似曲線の傾きを取得
+		/// </summary>
+		/// <returns>軸の番号と，その軸の正の向きへ 1 点進むあたりの性能評価値の変化量の組</returns>
+		std::unordered_map<std::size_t, double> getAxisSlopes(void) const;
+		/// <summary>
+		/// 提案リストに含まれない未実測点のうち，次に実測される見込みが高い点 (投機的実測候補) を優先度順に取得．<br/>
+		/// 探索中の直線上で現在の提案に近い点，暫定最良点の隣接点，基準点の周辺点の順に並べる
+		/// </summary>
+		/// <param name="excluded_coordinates">候補から除外する座標 (提案済の点など)</param>
+		/// <param name="max_num">取得する候補の最大数</param>
+		/// <returns>投機的実測候補のリスト</returns>
+		coordinate_list getSpeculativeCandidates(const std::unordered_set<coordinate>& excluded_coordinates, std::size_t max_num) const;
 	};
 }
 
@@ -0,0 +1,350 @@
+﻿#ifndef SHARED_SHARD_MAP_HPP_
+#define SHARED_SHARD_MAP_HPP_
+
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <functional>
+#include <unordered_map>
+
+#include "copy_on_write.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// コピー元とコピー先で要素を共有する連想配列．<br/>
+	/// 要素をキーのハッシュ値で区画に分けて区画ごとに共有し，更新時は更新する要素を含む区画のみを複製する (コピーオンライト)．<br/>
+	/// コピー自体は区画のポインタを複製するだけなので要素数によらない
+	/// </summary>
+	/// <typeparam name="Key">キーの型</typeparam>
+	/// <typeparam name="Value">値の型</typeparam>
+	/// <typeparam name="Hash">キーのハッシュ関数</typeparam>
+	template <typename Key, typename Value, typename Hash = std::hash<Key>>
+	class SharedShardMap final {
+	public:
+		/// <summary>
+		/// 区画 1 つ分の連想配列の型
+		/// </summary>
+		using shard_type = std::unordered_map<Key, Value, Hash>;
+		/// <summary>
+		/// 区画数の 2 の対数
+		/// </summary>
+		static constexpr std::size_t SHARD_BITS = 6;
+		/// <summary>
+		/// 区画数
+		/// </summary>
+		static constexpr std::size_t SHARD_NUM = static_cast<std::size_t>(1) << SHARD_BITS;
+		/// <summary>
+		/// 全区画の要素を順に辿る読み取り専用の反復子
+		/// </summary>
+		class const_iterator {
+		private:
+			/// <summary>
+			/// 辿る連想配列
+			/// </summary>
+			const SharedShardMap* map = nullptr;
+			/// <summary>
+			/// 辿っている区画のインデックス (末尾では SHARD_NUM)
+			/// </summary>
+			std::size_t shard_idx = SHARD_NUM;
+			/// <summary>
+			/// 辿っている区画内の位置
+			/// </summary>
+			typename shard_type::const_iterator element;
+			/// <summary>
+			/// 要素を指していなければ，次に要素がある区画の先頭まで進める
+			/// </summary>
+			void skipEmptyShards(void) {
+				while (this->shard_idx < SHARD_NUM) {
+					const std::shared_ptr<shard_type>& shard = this->map->shards[this->shard_idx];
+					if (shard != nullptr && this->element != shard->end()) {
+						return;
+					}
+					this->shard_idx++;
+					if (this->shard_idx < SHARD_NUM && this->map->shards[this->shard_idx] != nullptr) {
+						this->element = this->map->shards[this->shard_idx]->begin();
+					}
+				}
+			}
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = typename shard_type::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const value_type*;
+			using reference = const value_type&;
+			/// <summary>
+			/// コンストラクタ (末尾を指す)
+			/// </summary>
+			const_iterator(void) {
+				// DO_NOTHING
+			}
+			/// <summary>
+			/// コンストラクタ
+			/// </summary>
+			/// <param name="target_map">辿る連想配列</param>
+			/// <param name="start_shard_idx">辿り始める区画のインデックス</param>
+			const_iterator(const SharedShardMap* target_map, std::size_t start_shard_idx) {
+				this->map = target_map;
+				this->shard_idx = start_shard_idx;
+				if (this->shard_idx < SHARD_NUM && this->map->shards[this->shard_idx] != nullptr) {
+					this->element = this->map->shards[this->shard_idx]->begin();
+				}
+				this->skipEmptyShards();
+			}
+			reference operator*(void) const {
+				return *this->element;
+			}
+			pointer operator->(void) const {
+				return &(*this->element);
+			}
+			const_iterator& operator++(void) {
+				++this->element;
+				this->skipEmptyShards();
+				return *this;
+			}
+			const_iterator operator++(int) {
+				const_iterator previous = *this;
+				++(*this);
+				return previous;
+			}
+			bool operator==(const const_iterator& other) const {
+				return this->shard_idx == other.shard_idx && (this->shard_idx >= SHARD_NUM || this->element == other.element);
+			}
+			bool operator!=(const const_iterator& other) const {
+				return !(*this == other);
+			}
+		};
+	private:
+		/// <summary>
+		/// 各区画 (要素のない区画は nullptr)
+		/// </summary>
+		std::array<std::shared_ptr<shard_type>, SHARD_NUM> shards;
+		/// <summary>
+		/// 全区画の要素数
+		/// </summary>
+		std::size_t element_num = 0;
+		/// <summary>
+		/// キーが属する区画のインデックスを取得 (区画内の連想配列とハッシュ値の下位ビットが偏らないよう上位ビットを使う)
+		/// </summary>
+		/// <param name="key">キー</param>
+		/// <returns>区画のインデックス</returns>
+		static std::size_t getShardIndex(const Key& key);
+		/// <summary>
+		/// 更新用に区画を取得．他のインスタンスと共有している場合は複製してから返す
+		/// </summary>
+		/// <param name="shard_idx">区画のインデックス</param>
+		/// <returns>区画</returns>
+		shard_type& getWritableShard(std::size_t shard_idx);
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		SharedShardMap(void);
+		/// <summary>
+		/// コピーコンストラクタ (区画はコピー元と共有)
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		SharedShardMap(const SharedShardMap& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~SharedShardMap(void);
+		/// <summary>
+		/// コピー代入演算子 (区画はコピー元と共有)
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		/// <returns>代入先 (*this)</returns>
+		SharedShardMap& operator=(const SharedShardMap& original);
+		/// <summary>
+		/// キーが登録されているか
+		/// </summary>
+		/// <param name="key">キー</param>
+		/// <returns>登録されていれば true</returns>
+		bool contains(const Key& key) const;
+		/// <summary>
+		/// 参照のみの値の取得
+		/// </summary>
+		/// <param name="key">キー (未登録の場合は std::out_of_range を送出)</param>
+		/// <returns>値</returns>
+		const Value& at(const Key& key) const;
+		/// <summary>
+		/// 更新を伴う値の取得 (区画を共有している場合は複製してから返す)
+		/// </summary>
+		/// <param name="key">キー (未登録の場合は std::out_of_range を送出)</param>
+		/// <returns>値</returns>
+		Value& getWritable(const Key& key);
+		/// <summary>
+		/// 更新を伴う値の取得 (未登録の場合は既定値で登録してから返す)
+		/// </summary>
+		/// <param name="key">キー</param>
+		/// <returns>値</returns>
+		Value& operator[](const Key& key);
+		/// <summary>
+		/// 要素を登録 (登録済のキーであれば何もしない)
+		/// </summary>
+		/// <param name="key">キー</param>
+		/// <param name="value">値</param>
+		/// <returns>登録した場合は true</returns>
+		bool emplace(const Key& key, const Value& value);
+		/// <summary>
+		/// 要素を削除 (未登録のキーであれば区画を複製せず何もしない)
+		/// </summary>
+		/// <param name="key">キー</param>
+		/// <returns>削除した要素数</returns>
+		std::size_t erase(const Key& key);
+		/// <summary>
+		/// 要素数を取得
+		/// </summary>
+		/// <returns>要素数</returns>
+		std::size_t size(void) const;
+		/// <summary>
+		/// 要素がないか
+		/// </summary>
+		/// <returns>要素がなければ true</returns>
+		bool empty(void) const;
+		/// <summary>
+		/// 先頭の要素を指す反復子を取得 (要素の順序は不定)
+		/// </summary>
+		/// <returns>反復子</returns>
+		const_iterator begin(void) const;
+		/// <summary>
+		/// 末尾を指す反復子を取得
+		/// </summary>
+		/// <returns>反復子</returns>
+		const_iterator end(void) const;
+	};
+
+	template <typename Key, typename Value, typename Hash>
+	std::size_t SharedShardMap<Key, Value, Hash>::getShardIndex(const Key& key) {
+		std::uint64_t hash_value = static_cast<std::uint64_t>(Hash()(key));
+		return static_cast<std::size_t>((hash_value * 0x9E3779B97F4A7C15ULL) >> (64 - SHARD_BITS));
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	typename SharedShardMap<Key, Value, Hash>::shard_type& SharedShardMap<Key, Value, Hash>::getWritableShard(std::size_t shard_idx) {
+
+		std::shared_ptr<shard_type>& shard = this->shards[shard_idx];
+		if (shard == nullptr) {
+			shard = std::make_shared<shard_type>();
+		}
+		else if (isShared(shard)) {
+			shard = std::make_shared<shard_type>(*shard);
+		}
+
+		return *shard;
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	SharedShardMap<Key, Value, Hash>::SharedShardMap(void) {
+		// DO_NOTHING
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	SharedShardMap<Key, Value, Hash>::SharedShardMap(const SharedShardMap& original) {
+		this->shards = original.shards;
+		this->element_num = original.element_num;
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	SharedShardMap<Key, Value, Hash>::~SharedShardMap(void) {
+		// DO_NOTHING
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	SharedShardMap<Key, Value, Hash>& SharedShardMap<Key, Value, Hash>::operator=(const SharedShardMap& original) {
+
+		this->shards = original.shards;
+		this->element_num = original.element_num;
+
+		return *this;
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	bool SharedShardMap<Key, Value, Hash>::contains(const Key& key) const {
+		const std::shared_ptr<shard_type>& shard = this->shards[getShardIndex(key)];
+		return shard != nullptr && shard->contains(key);
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	const Value& SharedShardMap<Key, Value, Hash>::at(const Key& key) const {
+
+		const std::shared_ptr<shard_type>& shard = this->shards[getShardIndex(key)];
+		if (shard == nullptr) {
+			throw std::out_of_range("The specified key is not found.");
+		}
+
+		return shard->at(key);
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	Value& SharedShardMap<Key, Value, Hash>::getWritable(const Key& key) {
+
+		if (!this->contains(key)) {
+			throw std::out_of_range("The specified key is not found.");
+		}
+
+		return this->getWritableShard(getShardIndex(key)).at(key);
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	Value& SharedShardMap<Key, Value, Hash>::operator[](const Key& key) {
+
+		shard_type& shard = this->getWritableShard(getShardIndex(key));
+		std::size_t previous_size = shard.size();
+		Value& value = shard[key];
+		this->element_num += shard.size() - previous_size;
+
+		return value;
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	bool SharedShardMap<Key, Value, Hash>::emplace(const Key& key, const Value& value) {
+
+		if (this->contains(key)) {
+			return false;
+		}
+
+		this->getWritableShard(getShardIndex(key)).emplace(key, value);
+		this->element_num++;
+
+		return true;
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	std::size_t SharedShardMap<Key, Value, Hash>::erase(const Key& key) {
+
+		if (!this->contains(key)) {
+			return 0;
+		}
+
+		this->getWritableShard(getShardIndex(key)).erase(key);
+		this->element_num--;
+
+		return 1;
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	std::size_t SharedShardMap<Key, Value, Hash>::size(void) const {
+		return this->element_num;
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	bool SharedShardMap<Key, Value, Hash>::empty(void) const {
+		return this->element_num == 0;
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	typename SharedShardMap<Key, Value, Hash>::const_iterator SharedShardMap<Key, Value, Hash>::begin(void) const {
+		return const_iterator(this, 0);
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	typename SharedShardMap<Key, Value, Hash>::const_iterator SharedShardMap<Key, Value, Hash>::end(void) const {
+		return const_iterator();
+	}
+}
+
+#endif // !SHARED_SHARD_MAP_HPP_
@@ -1,6 +1,7 @@
 ﻿#include <stdexcept>
 #include <memory>
 #include <limits>
+#include <vector>
 #include <algorithm>
 
 #include "dsice_search_space.hpp"
@@ -8,11 +9,12 @@
 #include "direction_line.hpp"
 #include "coordinate_line.hpp"
 #include "around_points.hpp"
+#include "dsice_thread_pool.hpp"
 #include "simple_direction_searcher.hpp"
 
 namespace dsice {
 
-	SimpleDirectionSearcher::SimpleDirectionSearcher(std::shared_ptr<const DatabaseStandardFunctions> search_database, const coordinate& target_coordinate, std::size_t max_changed_axis_num, bool low_value_is_better) {
+	SimpleDirectionSearcher::SimpleDirectionSearcher(std::shared_ptr<const DatabaseStandardFunctions> search_database, const coordinate& target_coordinate, std::size_t max_changed_axis_num, bool low_value_is_better, std::shared_ptr<ThreadPool> pool) {
 
 		this->base_coordinate = target_coordinate;
 		this->lower_is_better = low_value_is_better;
@@ -34,19 +36,40 @@ namespace dsice {
 		AroundPoints points(search_database->getSpaceSize(), target_coordinate, max_changed_axis_num);
 		this->around_coordinates = points.getAroundPoints();
 
-		for (const coordinate& c : this->around_coordinates) {
+		// 周辺点ごとのデータベース参照は互いに独立なので並列に行い，結果の反映は周辺点の順に行う
+		// (0: 探索済方向，1: 未実測，2: 実測済)
+		std::vector<int> point_states(this->around_coordinates.size());
+		std::vector<double> point_values(this->around_coordinates.size());
+		ThreadPool::run(pool, this->around_coordinates.size(), [this, &search_database, &point_states, &point_values](std::size_t i) {
+
+			const coordinate& c = this->around_coordinates[i];
+
+			if (search_database->isSearchedDirection(this->base_coordinate, DirectionLine(this->base_coordinate, c))) {
+				point_states[i] = 0;
+			}
+			else if (search_database->hasSample(c)) {
+				point_states[i] = 2;
+				point_values[i] = search_database->getSampleMetricValue(c);
+			}
+			else {
+				point_states[i] = 1;
+			}
+		});
+
+		for (std::size_t i = 0; i < this->around_coordinates.size(); i++) {
+
+			const coordinate& c = this->around_coordinates[i];
 
 			// 探索済方向は除外
-			DirectionLine direction(this->base_coordinate, c);
-			if (search_database->isSearchedDirection(this->base_coordinate, direction)) {
+			if (point_states[i] == 0) {
 				continue;
 			}
 
-			if (search_database->hasSample(c)) {
+			if (point_states[i] == 2) {
 
 				this->measured_coordinates.insert(c);
-				this->measured_line.insert(direction);
-				double v = search_database->getSampleMetricValue(c);
+				this->measured_line.insert(DirectionLine(this->base_coordinate, c));
+				double v = point_values[i];
 
 				if (this->lower_is_better) {
 
@@ -67,30 +67,51 @@ namespace dsice {
 				tmp.push_back(indexes[j][looped_idx]);
 			}
 
-			this->target_coordinates.push_back(tmp);
+			this->addTargetCoordinate(*search_database, tmp);
+		}
+	}
 
-			if (search_database->hasSample(tmp)) {
+	SimpleLhdSearcher::SimpleLhdSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate_list& design_coordinates, bool low_value_is_better) {
 
-				this->measured_coordinates.insert(tmp);
-				double v = search_database->getSampleMetricValue(tmp);
+		this->lower_is_better = low_value_is_better;
 
-				if (this->lower_is_better) {
-					if (v < this->best_point_value) {
-						this->best_point_coordinate = tmp;
-						this->best_point_value = v;
-					}
-				}
-				else {
-					if (v > this->best_point_value) {
-						this->best_point_coordinate = tmp;
-						this->best_point_value = v;
-					}
+		if (this->lower_is_better) {
+			this->best_point_value = std::numeric_limits<double>::max();
+		}
+		else {
+			this->best_point_value = std::numeric_limits<double>::lowest();
+		}
+
+		for (const coordinate& c : design_coordinates) {
+			this->addTargetCoordinate(*search_database, c);
+		}
+	}
+
+	void SimpleLhdSearcher::addTargetCoordinate(const DatabaseCore& search_database, const coordinate& target_coordinate) {
+
+		this->target_coordinates.push_back(target_coordinate);
+
+		if (search_database.hasSample(target_coordinate)) {
+
+			this->measured_coordinates.insert(target_coordinate);
+			double v = search_database.getSampleMetricValue(target_coordinate);
+
+			if (this->lower_is_better) {
+				if (v < this->best_point_value) {
+					this->best_point_coordinate = target_coordinate;
+					this->best_point_value = v;
 				}
 			}
 			else {
-				this->suggest_coordinates.push_back(tmp);
+				if (v > this->best_point_value) {
+					this->best_point_coordinate = target_coordinate;
+					this->best_point_value = v;
+				}
 			}
 		}
+		else {
+			this->suggest_coordinates.push_back(target_coordinate);
+		}
 	}
 
 	SimpleLhdSearcher::SimpleLhdSearcher(const SimpleLhdSearcher& original) {
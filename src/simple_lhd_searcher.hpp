@@ -48,6 +48,12 @@ namespace dsice {
 		/// 最良点の値
 		/// </summary>
 		double best_point_value;
+		/// <summary>
+		/// 座標を探索対象に追加 (データベースに実測済であれば探索済として扱う)
+		/// </summary>
+		/// <param name="search_database">データベース</param>
+		/// <param name="target_coordinate">追加する座標</param>
+		void addTargetCoordinate(const DatabaseCore& search_database, const coordinate& target_coordinate);
 	public:
 		/// <summary>
 		/// コンストラクタ
@@ -56,6 +62,13 @@ namespace dsice {
 		/// <param name="low_value_is_better">性能評価値が低い値ほど良いのであれば true</param>
 		SimpleLhdSearcher(std::shared_ptr<const DatabaseCore> search_database, bool low_value_is_better = true);
 		/// <summary>
+		/// コンストラクタ (探索対象を外部で生成した配置とする)
+		/// </summary>
+		/// <param name="search_database">データベース</param>
+		/// <param name="design_coordinates">探索対象とする座標リスト</param>
+		/// <param name="low_value_is_better">性能評価値が低い値ほど良いのであれば true</param>
+		SimpleLhdSearcher(std::shared_ptr<const DatabaseCore> search_database, const coordinate_list& design_coordinates, bool low_value_is_better = true);
+		/// <summary>
 		/// コピーコンストラクタ
 		/// </summary>
 		/// <param name="original">コピー元</param>
@@ -0,0 +1,111 @@
+﻿#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "direction_line.hpp"
+#include "dsice_database_standard_functions.hpp"
+#include "skipped_sample_database.hpp"
+
+namespace dsice {
+
+	SkippedSampleDatabase::SkippedSampleDatabase(std::shared_ptr<DatabaseStandardFunctions> base_database) {
+		this->database = base_database;
+	}
+
+	SkippedSampleDatabase::SkippedSampleDatabase(const SkippedSampleDatabase& original, std::shared_ptr<DatabaseStandardFunctions> base_database) {
+		this->database = base_database;
+		this->skipped_samples = original.skipped_samples;
+	}
+
+	SkippedSampleDatabase::~SkippedSampleDatabase(void) {
+		// DO_NOTHING
+	}
+
+	void SkippedSampleDatabase::setSkippedSample(const coordinate& target_coordinate, double bound) {
+		this->skipped_samples[target_coordinate] = bound;
+	}
+
+	dimension_size SkippedSampleDatabase::getSpaceDimension(void) const {
+		return this->database->getSpaceDimension();
+	}
+
+	const space_size& SkippedSampleDatabase::getSpaceSize(void) const {
+		return this->database->getSpaceSize();
+	}
+
+	void SkippedSampleDatabase::setSampleMetricValue(const coordinate& target_coordinate, double metric_value) {
+		this->database->setSampleMetricValue(target_coordinate, metric_value);
+	}
+
+	bool SkippedSampleDatabase::hasSample(const coordinate& target_coordinate) const {
+		return this->database->hasSample(target_coordinate) || this->skipped_samples.contains(target_coordinate);
+	}
+
+	std::size_t SkippedSampleDatabase::getExistSamplesNum(void) const {
+
+		std::size_t sample_num = this->database->getExistSamplesNum();
+		for (const std::pair<const coordinate, double>& skipped : this->skipped_samples) {
+			if (!this->database->hasSample(skipped.first)) {
+				sample_num++;
+			}
+		}
+
+		return sample_num;
+	}
+
+	coordinate_list SkippedSampleDatabase::getExistSampleCoordinates(void) const {
+
+		coordinate_list sample_coordinates = this->database->getExistSampleCoordinates();
+		for (const std::pair<const coordinate, double>& skipped : this->skipped_samples) {
+			if (!this->database->hasSample(skipped.first)) {
+				sample_coordinates.push_back(skipped.first);
+			}
+		}
+
+		return sample_coordinates;
+	}
+
+	double SkippedSampleDatabase::getSampleMetricValue(const coordinate& target_coordinate) const {
+
+		// 省略後に実測された場合は実測値を優先
+		if (this->database->hasSample(target_coordinate) || !this->skipped_samples.contains(target_coordinate)) {
+			return this->database->getSampleMetricValue(target_coordinate);
+		}
+
+		return this->skipped_samples.at(target_coordinate);
+	}
+
+	void SkippedSampleDatabase::setSampleCensored(const coordinate& target_coordinate) {
+		this->database->setSampleCensored(target_coordinate);
+	}
+
+	bool SkippedSampleDatabase::isSampleCensored(const coordinate& target_coordinate) const {
+
+		if (this->database->hasSample(target_coordinate)) {
+			return this->database->isSampleCensored(target_coordinate);
+		}
+
+		return this->skipped_samples.contains(target_coordinate);
+	}
+
+	void SkippedSampleDatabase::setBasePoint(const coordinate& target_coordinate) {
+		this->database->setBasePoint(target_coordinate);
+	}
+
+	const std::unordered_map<coordinate, std::unordered_set<DirectionLine>>& SkippedSampleDatabase::getBasePoints(void) const {
+		return this->database->getBasePoints();
+	}
+
+	bool SkippedSampleDatabase::hasBeenBasePoint(const coordinate& target_coordinate) const {
+		return this->database->hasBeenBasePoint(target_coordinate);
+	}
+
+	void SkippedSampleDatabase::recordSearchedDirection(const coordinate& base_coordinate, const DirectionLine& line_info) {
+		this->database->recordSearchedDirection(base_coordinate, line_info);
+	}
+
+	bool SkippedSampleDatabase::isSearchedDirection(const coordinate& base_coordinate, const DirectionLine& line_info) const {
+		return this->database->isSearchedDirection(base_coordinate, line_info);
+	}
+}
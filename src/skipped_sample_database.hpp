@@ -0,0 +1,133 @@
+﻿#ifndef SKIPPED_SAMPLE_DATABASE_HPP_
+#define SKIPPED_SAMPLE_DATABASE_HPP_
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "direction_line.hpp"
+#include "dsice_database_base_point_extension.hpp"
+#include "dsice_database_censored_sample_extension.hpp"
+#include "dsice_database_standard_functions.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 代理モデルの予測により実測を省略した点を，1 回の放射状探索の間だけ打ち切り標本として見せるデータベースの覆い．<br/>
+	/// 省略した点は覆いの中にのみ保持し，元のデータベースには標本としてもログとしても登録しない
+	/// </summary>
+	class SkippedSampleDatabase final : public DatabaseCensoredSampleExtension, public DatabaseBasePointExtension {
+	private:
+		/// <summary>
+		/// 元のデータベース
+		/// </summary>
+		std::shared_ptr<DatabaseStandardFunctions> database;
+		/// <summary>
+		/// 実測を省略した点と，予測値から求めた性能評価値の限界値
+		/// </summary>
+		std::unordered_map<coordinate, double> skipped_samples;
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="base_database">元のデータベース</param>
+		SkippedSampleDatabase(std::shared_ptr<DatabaseStandardFunctions> base_database);
+		/// <summary>
+		/// 元のデータベースを差し替えるコピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		/// <param name="base_database">元のデータベース (コピー元のデータベースを複製したもの)</param>
+		SkippedSampleDatabase(const SkippedSampleDatabase& original, std::shared_ptr<DatabaseStandardFunctions> base_database);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~SkippedSampleDatabase(void);
+		/// <summary>
+		/// 実測を省略した点を登録
+		/// </summary>
+		/// <param name="target_coordinate">実測を省略した点の座標</param>
+		/// <param name="bound">予測値から求めた性能評価値の限界値</param>
+		void setSkippedSample(const coordinate& target_coordinate, double bound);
+		/// <summary>
+		/// 探索空間の次元数 (探索対象のパラメタ数) を取得
+		/// </summary>
+		/// <returns>探索空間の次元数 (探索対象のパラメタ数)</returns>
+		dimension_size getSpaceDimension(void) const override;
+		/// <summary>
+		/// 探索空間の大きさ (各性能パラメタの取りうる値の数) を取得
+		/// </summary>
+		/// <returns>探索空間の大きさ (各性能パラメタの取りうる値の数)</returns>
+		const space_size& getSpaceSize(void) const override;
+		/// <summary>
+		/// 標本データを元のデータベースに登録
+		/// </summary>
+		/// <param name="target_coordinate">標本データの座標</param>
+		/// <param name="metric_value">性能評価値</param>
+		void setSampleMetricValue(const coordinate& target_coordinate, double metric_value) override;
+		/// <summary>
+		/// 標本点が登録済または実測を省略済かどうか
+		/// </summary>
+		/// <param name="target_coordinates">標本点の座標</param>
+		/// <returns>登録済または実測を省略済なら true</returns>
+		bool hasSample(const coordinate& target_coordinate) const override;
+		/// <summary>
+		/// 実測を省略した点を含めた登録済標本点の数を取得
+		/// </summary>
+		/// <returns>登録済標本点の数</returns>
+		std::size_t getExistSamplesNum(void) const override;
+		/// <summary>
+		/// 実測を省略した点を含めた登録済標本点の座標一覧を取得
+		/// </summary>
+		/// <returns>登録済標本点の座標一覧 (順序は不定)</returns>
+		coordinate_list getExistSampleCoordinates(void) const override;
+		/// <summary>
+		/// 登録済の標本の性能評価値を取得 (実測を省略した点は限界値)
+		/// </summary>
+		/// <param name="target_coordinate">取得したい標本データの座標</param>
+		/// <returns>当該標本の性能評価値</returns>
+		double getSampleMetricValue(const coordinate& target_coordinate) const override;
+		/// <summary>
+		/// 元のデータベースで，直近に登録した標本点の性能評価値を打ち切り時点の限界値として扱うよう設定
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		void setSampleCensored(const coordinate& target_coordinate) override;
+		/// <summary>
+		/// 標本点の性能評価値が打ち切り時点の限界値かどうか (実測を省略した点も含む)
+		/// </summary>
+		/// <param name="target_coordinate">標本点の座標</param>
+		/// <returns>打ち切り標本または実測を省略した点なら true</returns>
+		bool isSampleCensored(const coordinate& target_coordinate) const override;
+		/// <summary>
+		/// 指定座標を元のデータベースに探索基準点として登録
+		/// </summary>
+		/// <param name="target_coordinates">探索基準点の座標</param>
+		void setBasePoint(const coordinate& target_coordinate) override;
+		/// <summary>
+		/// 基準点およびその探索済方向の一覧を取得
+		/// </summary>
+		/// <returns>基準点およびその探索済方向の一覧</returns>
+		const std::unordered_map<coordinate, std::unordered_set<DirectionLine>>& getBasePoints(void) const override;
+		/// <summary>
+		/// 指定座標が探索基準点になったことがあるか
+		/// </summary>
+		/// <param name="target_coordinates">調べる座標</param>
+		/// <returns>過去に探索基準点となったことがあれば true</returns>
+		bool hasBeenBasePoint(const coordinate& target_coordinate) const override;
+		/// <summary>
+		/// 指定座標を通る直線のうち，指定直線を元のデータベースに探索済として登録
+		/// </summary>
+		/// <param name="base_coordinates">基準となる探索基準点</param>
+		/// <param name="line_info">探索した直線</param>
+		void recordSearchedDirection(const coordinate& base_coordinate, const DirectionLine& line_info) override;
+		/// <summary>
+		/// 指定座標を通る直線のうち，指定直線が探索済かどうかを判定
+		/// </summary>
+		/// <param name="base_coordinates">基準となる探索基準点</param>
+		/// <param name="line_info">判定する直線</param>
+		/// <returns>指定直線が探索済なら true</returns>
+		bool isSearchedDirection(const coordinate& base_coordinate, const DirectionLine& line_info) const override;
+	};
+}
+
+#endif // !SKIPPED_SAMPLE_DATABASE_HPP_
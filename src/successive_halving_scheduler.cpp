@@ -0,0 +1,148 @@
+﻿#include <stdexcept>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "dsice_standard_database.hpp"
+#include "initial_design.hpp"
+#include "dsice_thread_pool.hpp"
+#include "successive_halving_scheduler.hpp"
+
+namespace dsice {
+
+	SuccessiveHalvingScheduler::SuccessiveHalvingScheduler(const space_size& search_space, const std::vector<double>& fidelities, std::size_t eta, const InitialDesign& first_rung_design, bool low_value_is_better, std::shared_ptr<ThreadPool> pool) {
+
+		if (fidelities.size() < 2) {
+			throw std::invalid_argument("need two fidelities at least.");
+		}
+		if (eta < 2) {
+			throw std::invalid_argument("eta must be 2 or more.");
+		}
+
+		this->fidelities = fidelities;
+		this->eta = eta;
+		this->lower_is_better = low_value_is_better;
+
+		// 最も低い忠実度の段は空のデータベースに対して配置を生成
+		StandardDatabase empty_database(search_space);
+		this->rung_coordinates = first_rung_design.generate(empty_database, pool);
+		this->rung_coordinate_set.insert(this->rung_coordinates.begin(), this->rung_coordinates.end());
+		this->suggest_coordinates = this->rung_coordinates;
+	}
+
+	SuccessiveHalvingScheduler::SuccessiveHalvingScheduler(const SuccessiveHalvingScheduler& original) {
+		this->fidelities = original.fidelities;
+		this->eta = original.eta;
+		this->lower_is_better = original.lower_is_better;
+		this->rung = original.rung;
+		this->rung_coordinates = original.rung_coordinates;
+		this->rung_coordinate_set = original.rung_coordinate_set;
+		this->rung_values = original.rung_values;
+		this->suggest_coordinates = original.suggest_coordinates;
+		this->best_coordinate = original.best_coordinate;
+	}
+
+	SuccessiveHalvingScheduler::~SuccessiveHalvingScheduler(void) {
+		// DO_NOTHING
+	}
+
+	const coordinate& SuccessiveHalvingScheduler::getSuggested(void) const {
+
+		if (this->suggest_coordinates.empty()) {
+			return this->getBestCoordinate();
+		}
+
+		return this->suggest_coordinates.front();
+	}
+
+	const coordinate_list& SuccessiveHalvingScheduler::getSuggestedList(void) const {
+		return this->suggest_coordinates;
+	}
+
+	double SuccessiveHalvingScheduler::getFidelity(void) const {
+		return this->fidelities[this->rung];
+	}
+
+	std::size_t SuccessiveHalvingScheduler::getRung(void) const {
+		return this->rung;
+	}
+
+	void SuccessiveHalvingScheduler::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
+
+		if (this->isFinished() || !this->rung_coordinate_set.contains(measured_coordinate)) {
+			return;
+		}
+
+		this->rung_values[measured_coordinate] = metric_value;
+
+		auto target = std::find(this->suggest_coordinates.begin(), this->suggest_coordinates.end(), measured_coordinate);
+		if (target != this->suggest_coordinates.end()) {
+			this->suggest_coordinates.erase(target);
+		}
+	}
+
+	bool SuccessiveHalvingScheduler::updateState(void) {
+
+		if (this->isFinished() || !this->suggest_coordinates.empty()) {
+			return false;
+		}
+
+		// 良い順に並べ，上位 1/eta (少なくとも 1 つ) を次の段に残す
+		// 打ち切りなどで評価値が NaN となった設定値は最下位とし，全てが NaN でない限り昇格させない
+		coordinate_list ranked = this->rung_coordinates;
+		std::stable_sort(ranked.begin(), ranked.end(), [this](const coordinate& a, const coordinate& b) {
+			double a_value = this->rung_values.at(a);
+			double b_value = this->rung_values.at(b);
+			if (std::isnan(a_value) || std::isnan(b_value)) {
+				return !std::isnan(a_value) && std::isnan(b_value);
+			}
+			return this->lower_is_better ? a_value < b_value : a_value > b_value;
+		});
+
+		std::size_t valid_num = static_cast<std::size_t>(std::count_if(ranked.begin(), ranked.end(), [this](const coordinate& c) {
+			return !std::isnan(this->rung_values.at(c));
+		}));
+		std::size_t survivor_num = std::max<std::size_t>(1, std::min(ranked.size() / this->eta, valid_num));
+		ranked.resize(survivor_num);
+
+		this->best_coordinate = ranked.front();
+		this->rung++;
+		this->rung_coordinates = ranked;
+		this->rung_coordinate_set.clear();
+		this->rung_coordinate_set.insert(ranked.begin(), ranked.end());
+		this->rung_values.clear();
+
+		// 最高忠実度の段は探索機構が評価する
+		if (!this->isFinished()) {
+			this->suggest_coordinates = ranked;
+		}
+
+		return true;
+	}
+
+	bool SuccessiveHalvingScheduler::isFinished(void) const {
+		return this->rung + 1 >= this->fidelities.size();
+	}
+
+	coordinate_list SuccessiveHalvingScheduler::getSurvivors(void) const {
+
+		if (!this->isFinished()) {
+			return coordinate_list();
+		}
+
+		return this->rung_coordinates;
+	}
+
+	const coordinate& SuccessiveHalvingScheduler::getBestCoordinate(void) const {
+
+		if (this->best_coordinate.empty() && !this->suggest_coordinates.empty()) {
+			return this->suggest_coordinates.front();
+		}
+
+		return this->best_coordinate;
+	}
+}
@@ -0,0 +1,127 @@
+﻿#ifndef SUCCESSIVE_HALVING_SCHEDULER_HPP_
+#define SUCCESSIVE_HALVING_SCHEDULER_HPP_
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "initial_design.hpp"
+#include "dsice_thread_pool.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 問題サイズなどの忠実度を下げた安価な実測で多数の設定値を評価し，上位 1/eta のみを次の忠実度に昇格させる逐次半減法の管理機構．<br/>
+	/// 最高忠実度の 1 つ手前の段まで管理し，そこで生き残った設定値は最高忠実度での初期探索の配置として探索機構に引き渡す
+	/// </summary>
+	class SuccessiveHalvingScheduler final {
+	private:
+		/// <summary>
+		/// 各段の忠実度 (昇順，末尾が最高忠実度)
+		/// </summary>
+		std::vector<double> fidelities;
+		/// <summary>
+		/// 各段で次の段に昇格させる割合の逆数
+		/// </summary>
+		std::size_t eta = 3;
+		/// <summary>
+		/// 低い値ほど良いかどうか
+		/// </summary>
+		bool lower_is_better = true;
+		/// <summary>
+		/// 現在の段
+		/// </summary>
+		std::size_t rung = 0;
+		/// <summary>
+		/// 現在の段で評価する設定値 (座標) のリスト
+		/// </summary>
+		coordinate_list rung_coordinates;
+		/// <summary>
+		/// 現在の段で評価中の設定値 (座標)
+		/// </summary>
+		std::unordered_set<coordinate> rung_coordinate_set;
+		/// <summary>
+		/// 現在の段で評価済の設定値 (座標) と性能評価値
+		/// </summary>
+		std::unordered_map<coordinate, double> rung_values;
+		/// <summary>
+		/// 現在の段で未評価の設定値 (座標) のリスト
+		/// </summary>
+		coordinate_list suggest_coordinates;
+		/// <summary>
+		/// 評価を終えた段のうち最も忠実度が高い段での最良の設定値 (座標)
+		/// </summary>
+		coordinate best_coordinate;
+	public:
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="search_space">探索空間の各次元の長さ</param>
+		/// <param name="fidelities">各段の忠実度 (昇順，末尾が最高忠実度，2 段以上)</param>
+		/// <param name="eta">各段で次の段に昇格させる割合の逆数 (2 以上)</param>
+		/// <param name="first_rung_design">最も低い忠実度で評価する設定値の配置</param>
+		/// <param name="low_value_is_better">性能評価値が低い値ほど良いのであれば true</param>
+		/// <param name="pool">配置の生成に用いるスレッドプール (nullptr の場合は逐次実行)</param>
+		SuccessiveHalvingScheduler(const space_size& search_space, const std::vector<double>& fidelities, std::size_t eta, const InitialDesign& first_rung_design, bool low_value_is_better = true, std::shared_ptr<ThreadPool> pool = nullptr);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		SuccessiveHalvingScheduler(const SuccessiveHalvingScheduler& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~SuccessiveHalvingScheduler(void);
+		/// <summary>
+		/// 次に評価すべき設定値 (座標) を取得
+		/// </summary>
+		/// <returns>次に評価すべき設定値 (座標)，終了後は最良の設定値</returns>
+		const coordinate& getSuggested(void) const;
+		/// <summary>
+		/// 現在の段で未評価の設定値 (座標) のリストを取得
+		/// </summary>
+		/// <returns>未評価の設定値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(void) const;
+		/// <summary>
+		/// 現在の段の忠実度を取得
+		/// </summary>
+		/// <returns>現在の段の忠実度 (終了後は最高忠実度)</returns>
+		double getFidelity(void) const;
+		/// <summary>
+		/// 現在の段の番号を取得
+		/// </summary>
+		/// <returns>現在の段の番号 (最も低い忠実度の段が 0)</returns>
+		std::size_t getRung(void) const;
+		/// <summary>
+		/// 評価結果を登録 (現在の段の設定値でなければ無視する)
+		/// </summary>
+		/// <param name="measured_coordinate">評価した設定値 (座標)</param>
+		/// <param name="metric_value">性能評価値</param>
+		void setMetricValue(const coordinate& measured_coordinate, double metric_value);
+		/// <summary>
+		/// 現在の段の全設定値を評価し終えていれば，上位の設定値を次の段に昇格させる<br/>
+		/// 性能評価値が NaN の設定値は最下位として扱い，全ての設定値が NaN である場合を除き昇格させない
+		/// </summary>
+		/// <returns>段が進んだら true</returns>
+		bool updateState(void);
+		/// <summary>
+		/// 最高忠実度の 1 つ手前の段まで評価し終えたか
+		/// </summary>
+		/// <returns>終了していれば true</returns>
+		bool isFinished(void) const;
+		/// <summary>
+		/// 最高忠実度で評価すべき，生き残った設定値 (座標) のリストを取得
+		/// </summary>
+		/// <returns>生き残った設定値 (座標) のリスト (良い順，終了前は空)</returns>
+		coordinate_list getSurvivors(void) const;
+		/// <summary>
+		/// 評価を終えた段のうち最も忠実度が高い段での最良の設定値 (座標) を取得
+		/// </summary>
+		/// <returns>最良の設定値 (座標)，評価を終えた段がなければ次に評価すべき設定値</returns>
+		const coordinate& getBestCoordinate(void) const;
+	};
+}
+
+#endif // !SUCCESSIVE_HALVING_SCHEDULER_HPP_
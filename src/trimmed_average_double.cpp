@@ -0,0 +1,89 @@
+﻿#include <cstddef>
+#include "trimmed_average_double.hpp"
+
+namespace dsice {
+
+	TrimmedAverageDouble::TrimmedAverageDouble(void) {
+		// DO_NOTHING
+	}
+
+	TrimmedAverageDouble::TrimmedAverageDouble(double init_value) {
+		this->count = 1;
+		this->sum = init_value;
+		this->minimum = init_value;
+		this->maximum = init_value;
+	}
+
+	TrimmedAverageDouble::TrimmedAverageDouble(const TrimmedAverageDouble& original) {
+		this->sum = original.sum;
+		this->minimum = original.minimum;
+		this->maximum = original.maximum;
+		this->count = original.count;
+		this->squared_deviation_sum = original.squared_deviation_sum;
+	}
+
+	TrimmedAverageDouble::~TrimmedAverageDouble(void) {
+		// DO_NOTHING
+	}
+
+	TrimmedAverageDouble::operator double() const {
+		return this->getValue();
+	}
+
+	double TrimmedAverageDouble::getValue(void) const {
+
+		if (this->count == 0) {
+			return 0;
+		}
+
+		// 両端を除くと値が残らない場合は単純な平均値
+		if (this->count <= 2) {
+			return this->sum / this->count;
+		}
+
+		return (this->sum - this->minimum - this->maximum) / (this->count - 2);
+	}
+
+	void TrimmedAverageDouble::setValue(double metric_value) {
+
+		// 信頼区間の推定用に分散を更新 (Welford のアルゴリズム，平均値は総和から求める)
+		double old_mean = (this->count == 0) ? 0 : this->sum / this->count;
+		double new_mean = (this->sum + metric_value) / (this->count + 1);
+		this->squared_deviation_sum += (metric_value - old_mean) * (metric_value - new_mean);
+
+		if (this->count == 0) {
+			this->minimum = metric_value;
+			this->maximum = metric_value;
+		}
+		else {
+
+			if (metric_value < this->minimum) {
+				this->minimum = metric_value;
+			}
+
+			if (metric_value > this->maximum) {
+				this->maximum = metric_value;
+			}
+		}
+
+		this->sum += metric_value;
+		this->count++;
+	}
+
+	std::size_t TrimmedAverageDouble::getRecordedCount(void) const {
+		return this->count;
+	}
+
+	double TrimmedAverageDouble::getVariance(void) const {
+
+		if (this->count < 2) {
+			return 0;
+		}
+
+		return this->squared_deviation_sum / (this->count - 1);
+	}
+
+	std::shared_ptr<Metric> TrimmedAverageDouble::makeCopy(void) const {
+		return std::make_shared<TrimmedAverageDouble>(*this);
+	}
+}
@@ -0,0 +1,88 @@
+﻿#ifndef TRIMMED_AVERAGE_DOUBLE_HPP_
+#define TRIMMED_AVERAGE_DOUBLE_HPP_
+
+#include <cstddef>
+#include "dsice_metric.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 倍精度浮動小数について最大値と最小値を 1 つずつ除いた平均をとり続ける蓄積数値型．<br/>
+	/// 過去の生データを保持せず，総和と両端の値のみで計算する．登録数が 2 以下の場合は単純な平均値となる
+	/// </summary>
+	class TrimmedAverageDouble final : public Metric {
+	private:
+		/// <summary>
+		/// 過去に登録された性能評価値の総和
+		/// </summary>
+		double sum = 0;
+		/// <summary>
+		/// 過去に登録された性能評価値の最小値
+		/// </summary>
+		double minimum = 0;
+		/// <summary>
+		/// 過去に登録された性能評価値の最大値
+		/// </summary>
+		double maximum = 0;
+		/// <summary>
+		/// 性能評価値を登録した回数
+		/// </summary>
+		std::size_t count = 0;
+		/// <summary>
+		/// 平均値からの偏差の 2 乗和 (Welford のアルゴリズムで逐次更新，両端の値も含む)
+		/// </summary>
+		double squared_deviation_sum = 0;
+	public:
+		/// <summary>
+		/// 値無しの場合のコンストラクタ．<br/>
+		/// 初期値は 0 ですが，値は以降の計算に用いられません．
+		/// </summary>
+		TrimmedAverageDouble(void);
+		/// <summary>
+		/// 初期値を指定するコンストラクタ
+		/// </summary>
+		/// <param name="init_value">初期値</param>
+		TrimmedAverageDouble(double init_value);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		TrimmedAverageDouble(const TrimmedAverageDouble& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~TrimmedAverageDouble(void);
+		/// <summary>
+		/// double 型への型変換 (getValue() の省略) を許可
+		/// </summary>
+		operator double() const override;
+		/// <summary>
+		/// 倍精度浮動小数点数表現を取得
+		/// </summary>
+		/// <returns>倍精度浮動小数点数で表現した場合の値</returns>
+		double getValue(void) const override;
+		/// <summary>
+		/// 性能評価値を登録
+		/// </summary>
+		/// <param name="value">性能評価値</param>
+		void setValue(double metric_value) override;
+		/// <summary>
+		/// 過去に保存されたデータの数を取得
+		/// </summary>
+		/// <returns>過去に保存されたデータの数</returns>
+		std::size_t getRecordedCount(void) const override;
+		/// <summary>
+		/// 過去に登録された性能評価値の不偏分散を取得 (信頼区間の推定用)．<br/>
+		/// 登録数が 2 未満の場合は 0
+		/// </summary>
+		/// <returns>過去に登録された性能評価値の不偏分散</returns>
+		double getVariance(void) const;
+		/// <summary>
+		/// コピーされた新しいインスタンスを Metric 型として作成．コピーコンストラクタ用．
+		/// </summary>
+		/// <returns>コピーされたインスタンス</returns>
+		std::shared_ptr<Metric> makeCopy(void) const override;
+	};
+}
+
+#endif // !TRIMMED_AVERAGE_DOUBLE_HPP_
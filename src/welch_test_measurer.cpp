@@ -0,0 +1,320 @@
+﻿#include <stdexcept>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_core.hpp"
+#include "average_double.hpp"
+#include "dsice_database_sample_statistics_extension.hpp"
+#include "welch_test_measurer.hpp"
+
+namespace dsice {
+
+	WelchTestMeasurer::WelchTestMeasurer(std::shared_ptr<const DatabaseCore> search_database, const coordinate& base, const coordinate& challenger, bool low_value_is_better, std::size_t max_repetition_num, double significance_level) {
+
+		if (significance_level <= 0 || significance_level >= 1) {
+			throw std::invalid_argument("significance_level must be between 0 and 1.");
+		}
+
+		this->base_coordinate = base;
+		this->challenger_coordinate = challenger;
+		this->target_coordinates = { base, challenger };
+		this->lower_is_better = low_value_is_better;
+		this->max_repetitions = max_repetition_num;
+
+		// 登録済の値は登録回数と分散を引き継ぐ
+		if (search_database->hasSample(base)) {
+			this->base_samples = WelchTestMeasurer::restoreSamples(search_database, base);
+			this->measured_coordinates.insert(base);
+		}
+
+		if (search_database->hasSample(challenger)) {
+			this->challenger_samples = WelchTestMeasurer::restoreSamples(search_database, challenger);
+			this->measured_coordinates.insert(challenger);
+		}
+
+		// 検定は実測回数の小さい方が 2 回目から最大回数に達するまでの各回で行うため，その回数で有意水準を等分
+		std::size_t first_tested_num = std::max<std::size_t>(2, std::min(this->base_samples->getRecordedCount(), this->challenger_samples->getRecordedCount()));
+		std::size_t planned_test_num = 1;
+		if (this->max_repetitions > first_tested_num) {
+			planned_test_num = this->max_repetitions - first_tested_num + 1;
+		}
+		this->test_significance_level = significance_level / planned_test_num;
+
+		this->judge();
+	}
+
+	WelchTestMeasurer::WelchTestMeasurer(const WelchTestMeasurer& original) {
+		this->base_coordinate = original.base_coordinate;
+		this->challenger_coordinate = original.challenger_coordinate;
+		this->target_coordinates = original.target_coordinates;
+		this->suggested_coordinates = original.suggested_coordinates;
+		this->measured_coordinates = original.measured_coordinates;
+		this->base_samples = std::make_shared<AverageDouble>(*(original.base_samples));
+		this->challenger_samples = std::make_shared<AverageDouble>(*(original.challenger_samples));
+		this->lower_is_better = original.lower_is_better;
+		this->max_repetitions = original.max_repetitions;
+		this->test_significance_level = original.test_significance_level;
+		this->tested_repetition_num = original.tested_repetition_num;
+		this->measured_coordinate_buffer = original.measured_coordinate_buffer;
+		this->measured_metric_value_buffer = original.measured_metric_value_buffer;
+		this->is_significant = original.is_significant;
+		this->is_finish_searching = original.is_finish_searching;
+	}
+
+	WelchTestMeasurer::~WelchTestMeasurer(void) {
+		// DO_NOTHING
+	}
+
+	std::shared_ptr<AverageDouble> WelchTestMeasurer::restoreSamples(std::shared_ptr<const DatabaseCore> search_database, const coordinate& target_coordinate) {
+
+		double value = search_database->getSampleMetricValue(target_coordinate);
+
+		if (std::shared_ptr<const DatabaseSampleStatisticsExtension> statistics_database = std::dynamic_pointer_cast<const DatabaseSampleStatisticsExtension>(search_database)) {
+			double variance = statistics_database->getSampleVariance(target_coordinate);
+			if (!std::isnan(variance)) {
+				return std::make_shared<AverageDouble>(value, statistics_database->getSampleRecordedCount(target_coordinate), variance);
+			}
+		}
+
+		// 分散が不明な値 (分散を保持しない型で集計した値など) は 1 回分の実測として扱う
+		return std::make_shared<AverageDouble>(value);
+	}
+
+	void WelchTestMeasurer::judge(void) {
+
+		std::size_t base_num = this->base_samples->getRecordedCount();
+		std::size_t challenger_num = this->challenger_samples->getRecordedCount();
+		std::size_t repetition_num = std::min(base_num, challenger_num);
+
+		// 両点で分散が得られ，かつ実測回数の小さい方が増えた場合のみ検定 (実測のたびに検定すると誤判定率が膨らむため)
+		if (repetition_num >= 2 && repetition_num > this->tested_repetition_num) {
+
+			this->tested_repetition_num = repetition_num;
+
+			// 挑戦点の方が良い場合に正となる差
+			double improvement = this->base_samples->getValue() - this->challenger_samples->getValue();
+			if (!this->lower_is_better) {
+				improvement = -improvement;
+			}
+
+			double base_error = this->base_samples->getVariance() / base_num;
+			double challenger_error = this->challenger_samples->getVariance() / challenger_num;
+			double squared_error = base_error + challenger_error;
+
+			if (squared_error == 0) {
+				this->is_significant = improvement > 0;
+			}
+			else {
+
+				// Welch-Satterthwaite の式による自由度
+				double degrees_of_freedom = squared_error * squared_error / (base_error * base_error / (base_num - 1) + challenger_error * challenger_error / (challenger_num - 1));
+				double t_value = improvement / std::sqrt(squared_error);
+
+				this->is_significant = t_value > WelchTestMeasurer::studentQuantile(this->test_significance_level, degrees_of_freedom);
+			}
+		}
+
+		if (this->is_significant || (base_num >= this->max_repetitions && challenger_num >= this->max_repetitions)) {
+			this->is_finish_searching = true;
+			this->suggested_coordinates = { this->getBestJudgedCoordinate() };
+			return;
+		}
+
+		// 実測数の少ない点を優先 (同数なら両点)
+		if (base_num < challenger_num) {
+			this->suggested_coordinates = { this->base_coordinate };
+		}
+		else if (challenger_num < base_num) {
+			this->suggested_coordinates = { this->challenger_coordinate };
+		}
+		else {
+			this->suggested_coordinates = { this->challenger_coordinate, this->base_coordinate };
+		}
+	}
+
+	double WelchTestMeasurer::regularizedIncompleteBeta(double a, double b, double x) {
+
+		if (x <= 0) {
+			return 0;
+		}
+		if (x >= 1) {
+			return 1;
+		}
+
+		// 連分数が速く収束する側で計算し，反対側は対称性 I_x(a, b) = 1 - I_{1-x}(b, a) で求める
+		if (x > (a + 1) / (a + b + 2)) {
+			return 1 - WelchTestMeasurer::regularizedIncompleteBeta(b, a, 1 - x);
+		}
+
+		constexpr int max_iteration = 300;
+		constexpr double epsilon = 1e-15;
+		constexpr double tiny = 1e-300;
+
+		double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log1p(-x)) / a;
+
+		double c = 1;
+		double d = 1 - (a + b) * x / (a + 1);
+		if (std::abs(d) < tiny) {
+			d = tiny;
+		}
+		d = 1 / d;
+		double f = d;
+
+		for (int m = 1; m <= max_iteration; m++) {
+
+			// 偶数項
+			double numerator = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+			d = 1 + numerator * d;
+			if (std::abs(d) < tiny) {
+				d = tiny;
+			}
+			c = 1 + numerator / c;
+			if (std::abs(c) < tiny) {
+				c = tiny;
+			}
+			d = 1 / d;
+			f *= d * c;
+
+			// 奇数項
+			numerator = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+			d = 1 + numerator * d;
+			if (std::abs(d) < tiny) {
+				d = tiny;
+			}
+			c = 1 + numerator / c;
+			if (std::abs(c) < tiny) {
+				c = tiny;
+			}
+			d = 1 / d;
+			double delta = d * c;
+			f *= delta;
+
+			if (std::abs(delta - 1) < epsilon) {
+				break;
+			}
+		}
+
+		return front * f;
+	}
+
+	double WelchTestMeasurer::studentQuantile(double upper_probability, double degrees_of_freedom) {
+
+		constexpr double pi = 3.14159265358979323846;
+		double v = degrees_of_freedom;
+
+		// 自由度 1 (Cauchy 分布) と 2 は閉形式
+		if (v == 1) {
+			return 1 / std::tan(pi * upper_probability);
+		}
+		if (v == 2) {
+			return (1 - 2 * upper_probability) / std::sqrt(2 * upper_probability * (1 - upper_probability));
+		}
+
+		// 上側確率は P(T > t) = I_x(v/2, 1/2) / 2 (x = v / (v + t^2)) で表され，I_x は x について単調増加のため二分法で x を逆算
+		double target = 2 * upper_probability;
+		double lower_x = 0;
+		double upper_x = 1;
+		for (int i = 0; i < 200; i++) {
+			double middle_x = (lower_x + upper_x) / 2;
+			if (WelchTestMeasurer::regularizedIncompleteBeta(v / 2, 0.5, middle_x) < target) {
+				lower_x = middle_x;
+			}
+			else {
+				upper_x = middle_x;
+			}
+			if (upper_x - lower_x <= upper_x * 1e-12) {
+				break;
+			}
+		}
+
+		double x = (lower_x + upper_x) / 2;
+		return std::sqrt(v * (1 - x) / x);
+	}
+
+	const coordinate& WelchTestMeasurer::getSuggested(void) const {
+		return this->suggested_coordinates[0];
+	}
+
+	const coordinate_list& WelchTestMeasurer::getSuggestedList(void) const {
+		return this->suggested_coordinates;
+	}
+
+	void WelchTestMeasurer::setMetricValue(const coordinate& measured_coordinate, double metric_value) {
+		this->measured_coordinate_buffer.push_back(measured_coordinate);
+		this->measured_metric_value_buffer.push_back(metric_value);
+	}
+
+	bool WelchTestMeasurer::updateState(void) {
+
+		if (this->measured_coordinate_buffer.empty()) {
+			return false;
+		}
+
+		for (std::size_t i = 0; i < this->measured_coordinate_buffer.size(); i++) {
+
+			const coordinate& measured_coordinate = this->measured_coordinate_buffer[i];
+
+			if (measured_coordinate == this->base_coordinate) {
+				this->base_samples->setValue(this->measured_metric_value_buffer[i]);
+				this->measured_coordinates.insert(measured_coordinate);
+			}
+			else if (measured_coordinate == this->challenger_coordinate) {
+				this->challenger_samples->setValue(this->measured_metric_value_buffer[i]);
+				this->measured_coordinates.insert(measured_coordinate);
+			}
+		}
+
+		this->measured_coordinate_buffer.clear();
+		this->measured_metric_value_buffer.clear();
+
+		if (!this->is_finish_searching) {
+			this->judge();
+		}
+
+		return true;
+	}
+
+	bool WelchTestMeasurer::isSearchFinished(void) const {
+		return this->is_finish_searching;
+	}
+
+	const coordinate_list& WelchTestMeasurer::getTargetCoordinate(void) const {
+		return this->target_coordinates;
+	}
+
+	const std::unordered_set<coordinate>& WelchTestMeasurer::getMeasuredCoordinates(void) const {
+		return this->measured_coordinates;
+	}
+
+	const coordinate& WelchTestMeasurer::getBestJudgedCoordinate(void) const {
+
+		if (this->is_significant) {
+			return this->challenger_coordinate;
+		}
+		else {
+			return this->base_coordinate;
+		}
+	}
+
+	const coordinate& WelchTestMeasurer::getBestMeasuredCoordinate(void) const {
+
+		if (this->lower_is_better) {
+			if (this->challenger_samples->getValue() < this->base_samples->getValue()) {
+				return this->challenger_coordinate;
+			}
+		}
+		else {
+			if (this->challenger_samples->getValue() > this->base_samples->getValue()) {
+				return this->challenger_coordinate;
+			}
+		}
+
+		return this->base_coordinate;
+	}
+
+	bool WelchTestMeasurer::isSignificant(void) const {
+		return this->is_significant;
+	}
+}
@@ -0,0 +1,185 @@
+﻿#ifndef WELCH_TEST_MEASURER_HPP_
+#define WELCH_TEST_MEASURER_HPP_
+
+#include <memory>
+#include <vector>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "dsice_database_core.hpp"
+#include "average_double.hpp"
+#include "dsice_search_engine.hpp"
+
+namespace dsice {
+
+	/// <summary>
+	/// 基準点と挑戦点の 2 点を交互に繰り返し実測し，挑戦点が有意に良いかを Welch の t 検定で判定する機構．<br/>
+	/// 雑音の範囲内の差で基準点を移動しないために用いる．<br/>
+	/// 検定は両点の実測回数がそろって増えるたびに行うため，有意水準を予定検定回数で等分 (Bonferroni 補正) し，全体の誤判定率を抑える
+	/// </summary>
+	class WelchTestMeasurer final : public SearchEngine {
+	private:
+		/// <summary>
+		/// 基準点の座標
+		/// </summary>
+		coordinate base_coordinate;
+		/// <summary>
+		/// 挑戦点 (基準点より良いと見込まれる点) の座標
+		/// </summary>
+		coordinate challenger_coordinate;
+		/// <summary>
+		/// 実測対象座標 (基準点，挑戦点の順)
+		/// </summary>
+		coordinate_list target_coordinates;
+		/// <summary>
+		/// 次に実測すべき座標のリスト (実測数の少ない点から順)
+		/// </summary>
+		coordinate_list suggested_coordinates;
+		/// <summary>
+		/// 探索済点
+		/// </summary>
+		std::unordered_set<coordinate> measured_coordinates;
+		/// <summary>
+		/// 基準点で得られた性能評価値の平均と分散
+		/// </summary>
+		std::shared_ptr<AverageDouble> base_samples = std::make_shared<AverageDouble>();
+		/// <summary>
+		/// 挑戦点で得られた性能評価値の平均と分散
+		/// </summary>
+		std::shared_ptr<AverageDouble> challenger_samples = std::make_shared<AverageDouble>();
+		/// <summary>
+		/// 低い値ほど良いかどうか
+		/// </summary>
+		bool lower_is_better;
+		/// <summary>
+		/// 1 点あたりの最大実測回数 (データベースに登録済の値を含む)
+		/// </summary>
+		std::size_t max_repetitions;
+		/// <summary>
+		/// 1 回の検定に割り当てた有意水準 (片側の上側確率)
+		/// </summary>
+		double test_significance_level;
+		/// <summary>
+		/// 直近に検定した時点での，両点の実測回数の小さい方 (未検定なら 0)
+		/// </summary>
+		std::size_t tested_repetition_num = 0;
+		/// <summary>
+		/// 実測データの更新用バッファ (座標)
+		/// </summary>
+		std::vector<coordinate> measured_coordinate_buffer;
+		/// <summary>
+		/// 実測データの更新用バッファ (性能評価値)
+		/// </summary>
+		std::vector<double> measured_metric_value_buffer;
+		/// <summary>
+		/// 挑戦点が有意に良いと判定されたかどうか
+		/// </summary>
+		bool is_significant = false;
+		/// <summary>
+		/// 判定が終了したかどうか
+		/// </summary>
+		bool is_finish_searching = false;
+		/// <summary>
+		/// データベースに登録済の値から実測データを復元．<br/>
+		/// 登録回数と分散が得られる場合はそれを引き継ぎ，分散が得られない場合は 1 回分の実測として扱う
+		/// </summary>
+		/// <param name="search_database">探索に用いるデータベース</param>
+		/// <param name="target_coordinate">復元する点の座標</param>
+		/// <returns>復元した実測データ</returns>
+		static std::shared_ptr<AverageDouble> restoreSamples(std::shared_ptr<const DatabaseCore> search_database, const coordinate& target_coordinate);
+		/// <summary>
+		/// 両点の実測回数の小さい方が増えた場合のみ検定を行い，終了判定と次の実測候補を更新
+		/// </summary>
+		void judge(void);
+		/// <summary>
+		/// 正則化不完全ベータ関数 I_x(a, b) を連分数展開 (修正 Lentz 法) で計算
+		/// </summary>
+		/// <param name="a">第 1 形状パラメタ (正)</param>
+		/// <param name="b">第 2 形状パラメタ (正)</param>
+		/// <param name="x">積分の上端 (0 以上 1 以下)</param>
+		/// <returns>I_x(a, b)</returns>
+		static double regularizedIncompleteBeta(double a, double b, double x);
+		/// <summary>
+		/// t 分布の上側確率に対応する分位点を計算．<br/>
+		/// 自由度 1, 2 は閉形式で厳密に求め，それ以外は正則化不完全ベータ関数を二分法で逆算する (相対誤差 1e-10 程度)
+		/// </summary>
+		/// <param name="upper_probability">上側確率 (0 より大きく 0.5 未満)</param>
+		/// <param name="degrees_of_freedom">自由度 (Welch-Satterthwaite の式による非整数値も可)</param>
+		/// <returns>t 分布の分位点</returns>
+		static double studentQuantile(double upper_probability, double degrees_of_freedom);
+	public:
+		/// <summary>
+		/// コンストラクタ．データベースに登録済の値は，その登録回数と分散を引き継ぐ (分散が得られない場合は 1 回分の実測として扱う)
+		/// </summary>
+		/// <param name="search_database">探索に用いるデータベース</param>
+		/// <param name="base">基準点の座標</param>
+		/// <param name="challenger">挑戦点の座標</param>
+		/// <param name="low_value_is_better">低い値ほど良いかどうか</param>
+		/// <param name="max_repetition_num">1 点あたりの最大実測回数</param>
+		/// <param name="significance_level">片側検定の有意水準 (全検定を通しての値)</param>
+		WelchTestMeasurer(std::shared_ptr<const DatabaseCore> search_database, const coordinate& base, const coordinate& challenger, bool low_value_is_better = true, std::size_t max_repetition_num = 5, double significance_level = 0.05);
+		/// <summary>
+		/// コピーコンストラクタ
+		/// </summary>
+		/// <param name="original">コピー元</param>
+		WelchTestMeasurer(const WelchTestMeasurer& original);
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~WelchTestMeasurer(void);
+		/// <summary>
+		/// 次に実測すべき性能パラメタ性能値 (座標) を取得
+		/// </summary>
+		/// <returns>次に実測すべき性能パラメタ性能値 (座標)</returns>
+		const coordinate& getSuggested(void) const override;
+		/// <summary>
+		/// 実測すべき性能パラメタ性能値 (座標) のリストを取得
+		/// </summary>
+		/// <returns>実測すべき性能パラメタ性能値 (座標) のリスト</returns>
+		const coordinate_list& getSuggestedList(void) const override;
+		/// <summary>
+		/// 実測データを記録
+		/// </summary>
+		/// <param name="measured_coordinate">実測した座標</param>
+		/// <param name="metric_value">実測した値</param>
+		void setMetricValue(const coordinate& measured_coordinate, double metric_value) override;
+		/// <summary>
+		/// 記録されている実測データを用いて状態を更新
+		/// </summary>
+		/// <returns>更新用バッファにデータがあり，更新されたら true</returns>
+		bool updateState(void) override;
+		/// <summary>
+		/// 判定が終了したかどうか
+		/// </summary>
+		/// <returns>判定が終了したら true</returns>
+		bool isSearchFinished(void) const override;
+		/// <summary>
+		/// 探索機構が探索対象とする座標リストを取得
+		/// </summary>
+		/// <returns>探索機構が探索対象とする座標リスト</returns>
+		const coordinate_list& getTargetCoordinate(void) const override;
+		/// <summary>
+		/// 対象座標内で探索済の座標リストを取得
+		/// </summary>
+		/// <returns>対象座標内で探索済の座標リスト</returns>
+		const std::unordered_set<coordinate>& getMeasuredCoordinates(void) const override;
+		/// <summary>
+		/// 検定結果に基づく最良点を取得．<br/>
+		/// 挑戦点が有意に良い場合のみ挑戦点を，それ以外は基準点を返します．
+		/// </summary>
+		/// <returns>検定結果に基づく最良点</returns>
+		const coordinate& getBestJudgedCoordinate(void) const override;
+		/// <summary>
+		/// 2 点のうち，性能評価値の平均が良い点を取得
+		/// </summary>
+		/// <returns>性能評価値の平均が良い点</returns>
+		const coordinate& getBestMeasuredCoordinate(void) const override;
+		/// <summary>
+		/// 挑戦点が有意に良いと判定されたかどうか
+		/// </summary>
+		/// <returns>挑戦点が有意に良い場合 true</returns>
+		bool isSignificant(void) const;
+	};
+}
+
+#endif // !WELCH_TEST_MEASURER_HPP_
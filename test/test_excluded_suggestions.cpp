@@ -0,0 +1,90 @@
+﻿#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+#include "dsice_search_space.hpp"
+#include "dsice_operator.hpp"
+#include "parallel_operator_options.hpp"
+#include "dsice_operator_p_async.hpp"
+#include "dsice_operator_p_full.hpp"
+#include "dsice_operator_p_multi_start.hpp"
+
+namespace {
+
+	/// <summary>
+	/// 実測中の点を除外した指定件数のリストに，除外した点や重複が含まれず，件数が満たされるかを探索終了まで確認
+	/// </summary>
+	/// <param name="name">確認対象の探索モード名</param>
+	/// <param name="search_operator">確認対象の Operator</param>
+	/// <returns>問題がなければ true</returns>
+	bool checkExcludedCoordinates(const std::string& name, dsice::Operator& search_operator) {
+
+		const std::size_t suggested_num = 8;
+		const std::size_t excluded_num = 3;
+
+		for (std::size_t round = 0; round < 200 && !search_operator.isSearchFinished(); round++) {
+
+			// 除外指定なしのリストの先頭を実測中の点とみなす
+			dsice::coordinate_list in_flight = search_operator.getSuggestedList(suggested_num, std::unordered_set<dsice::coordinate>());
+			if (in_flight.size() > excluded_num) {
+				in_flight.resize(excluded_num);
+			}
+			std::unordered_set<dsice::coordinate> excluded(in_flight.begin(), in_flight.end());
+
+			dsice::coordinate_list suggested = search_operator.getSuggestedList(suggested_num, excluded);
+
+			std::unordered_set<dsice::coordinate> listed;
+			for (const dsice::coordinate& c : suggested) {
+				if (excluded.contains(c)) {
+					std::cerr << name << " : round " << round << " suggested an excluded coordinate." << std::endl;
+					return false;
+				}
+				if (!listed.insert(c).second) {
+					std::cerr << name << " : round " << round << " suggested the same coordinate twice." << std::endl;
+					return false;
+				}
+			}
+
+			// 未実測点が十分に残る初回は，除外した分だけ件数が減ってはならない
+			if (round == 0 && suggested.size() != suggested_num) {
+				std::cerr << name << " : expected " << suggested_num << " coordinates, got " << suggested.size() << "." << std::endl;
+				return false;
+			}
+
+			// 実測中の点と提示された点をまとめて実測したものとして登録
+			suggested.insert(suggested.end(), in_flight.begin(), in_flight.end());
+			for (const dsice::coordinate& c : suggested) {
+				double value = 0;
+				for (std::size_t i = 0; i < c.size(); i++) {
+					value += (static_cast<double>(c[i]) - 3.0 - i) * (static_cast<double>(c[i]) - 3.0 - i);
+				}
+				search_operator.setMetricValue(c, value);
+			}
+			search_operator.updateState();
+		}
+
+		return true;
+	}
+}
+
+int main(void) {
+
+	const dsice::space_size parameters = { 10, 10, 10 };
+	bool is_passed = true;
+
+	dsice::ParallelOperatorOptions options;
+	options.worker_num = 8;
+
+	dsice::Operator_P_Async async_operator(parameters, options);
+	is_passed = checkExcludedCoordinates("P_ASYNC", async_operator) && is_passed;
+
+	dsice::Operator_P_MultiStart multi_start_operator(parameters, options);
+	is_passed = checkExcludedCoordinates("P_MULTI_START", multi_start_operator) && is_passed;
+
+	dsice::Operator_P_Full full_operator(parameters);
+	is_passed = checkExcludedCoordinates("P_FULL", full_operator) && is_passed;
+
+	return is_passed ? 0 : 1;
+}